@@ -2759,8 +2759,7 @@ int main(int argc, char **argv) {
 		// Refresh video
 		//
 		if(remainingTime > 0.0) {
-			uint32_t msToSleep = (uint32_t)(remainingTime * 1000.0);
-			fplThreadSleep(msToSleep);
+			fplSleepPrecise((uint64_t)(remainingTime * 1000000000.0));
 		}
 		remainingTime = DEFAULT_REFRESH_RATE;
 		if(!state.isPaused || state.forceRefresh) {
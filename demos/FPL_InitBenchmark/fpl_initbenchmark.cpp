@@ -0,0 +1,112 @@
+/*
+*******************************************************************************
+FPL Init Benchmark
+*******************************************************************************
+This demo measures how long fplPlatformInit() takes for several init flag combinations.
+
+- The first iteration of each combination is reported as cold, all following iterations as warm
+- For each combination the time of each init phase is printed, see fplGetInitTimings()
+- For real cold numbers, run the benchmark in a fresh process after a reboot, because the dynamic loader caches the system libraries
+- Combinations which cannot be initialized (e.g. no display or audio device) are reported as failed
+*/
+
+#define FPL_IMPLEMENTATION
+#include <final_platform_layer.h>
+
+static const uint32_t WarmIterationCount = 10;
+
+struct InitCombination {
+	const char *name;
+	fplInitFlags flags;
+};
+
+static const InitCombination Combinations[] = {
+	{ "None", fplInitFlags_None },
+	{ "Window", fplInitFlags_Window },
+	{ "Video", fplInitFlags_Video },
+	{ "Audio", fplInitFlags_Audio },
+	{ "Window+Audio", (fplInitFlags)(fplInitFlags_Window | fplInitFlags_Audio) },
+	{ "All", fplInitFlags_All },
+};
+
+struct InitMeasurement {
+	fplInitTimings timings;
+	uint64_t releaseTime;
+};
+
+static double ToMilliseconds(const uint64_t nanoseconds) {
+	double result = (double)nanoseconds / 1000000.0;
+	return(result);
+}
+
+static bool MeasureInit(const fplInitFlags flags, InitMeasurement *outMeasurement) {
+	fplClearPlatformErrors();
+	if(fplPlatformInit(flags, fpl_null) != fplInitResultType_Success) {
+		return false;
+	}
+	fplGetInitTimings(&outMeasurement->timings);
+	uint64_t releaseStartTime = fplGetTimeInNanoseconds();
+	fplPlatformRelease();
+	outMeasurement->releaseTime = fplGetTimeInNanoseconds() - releaseStartTime;
+	return true;
+}
+
+static void PrintMeasurement(const char *name, const char *kind, const InitMeasurement *measurement) {
+	const fplInitTimings *timings = &measurement->timings;
+	fplConsoleFormatOut("%-14s %-5s %9.3f %9.3f %9.3f %9.3f %9.3f %9.3f %s\n",
+						name, kind,
+						ToMilliseconds(timings->total),
+						ToMilliseconds(timings->platform),
+						ToMilliseconds(timings->window),
+						ToMilliseconds(timings->video),
+						ToMilliseconds(timings->audio),
+						ToMilliseconds(measurement->releaseTime),
+						timings->isAudioParallel ? "(parallel audio)" : "");
+}
+
+int main(int argc, char *args[]) {
+	fplConsoleFormatOut("%-14s %-5s %9s %9s %9s %9s %9s %9s\n", "Flags", "Run", "Total", "Platform", "Window", "Video", "Audio", "Release");
+	for(uint32_t combinationIndex = 0; combinationIndex < FPL_ARRAYCOUNT(Combinations); ++combinationIndex) {
+		const InitCombination *combination = &Combinations[combinationIndex];
+
+		InitMeasurement cold = {};
+		if(!MeasureInit(combination->flags, &cold)) {
+			fplConsoleFormatOut("%-14s failed: %s\n", combination->name, fplGetPlatformError());
+			continue;
+		}
+		PrintMeasurement(combination->name, "cold", &cold);
+
+		InitMeasurement warmMin = {};
+		InitMeasurement warmSum = {};
+		uint32_t warmCount = 0;
+		for(uint32_t iteration = 0; iteration < WarmIterationCount; ++iteration) {
+			InitMeasurement warm = {};
+			if(!MeasureInit(combination->flags, &warm)) {
+				break;
+			}
+			if(warmCount == 0 || warm.timings.total < warmMin.timings.total) {
+				warmMin = warm;
+			}
+			warmSum.timings.total += warm.timings.total;
+			warmSum.timings.platform += warm.timings.platform;
+			warmSum.timings.window += warm.timings.window;
+			warmSum.timings.video += warm.timings.video;
+			warmSum.timings.audio += warm.timings.audio;
+			warmSum.timings.isAudioParallel = warm.timings.isAudioParallel;
+			warmSum.releaseTime += warm.releaseTime;
+			++warmCount;
+		}
+		if(warmCount > 0) {
+			InitMeasurement warmAvg = warmSum;
+			warmAvg.timings.total /= warmCount;
+			warmAvg.timings.platform /= warmCount;
+			warmAvg.timings.window /= warmCount;
+			warmAvg.timings.video /= warmCount;
+			warmAvg.timings.audio /= warmCount;
+			warmAvg.releaseTime /= warmCount;
+			PrintMeasurement(combination->name, "avg", &warmAvg);
+			PrintMeasurement(combination->name, "min", &warmMin);
+		}
+	}
+	return 0;
+}
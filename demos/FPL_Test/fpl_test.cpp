@@ -1,7 +1,11 @@
 #define FPL_IMPLEMENTATION
-#define FPL_NO_AUDIO
+// Only the null audio driver, so the tests does not depend on any audio hardware
+#define FPL_NO_AUDIO_DIRECTSOUND
+#define FPL_NO_AUDIO_ALSA
 #define FPL_NO_VIDEO
 #define FPL_NO_WINDOW
+#define FPL_LOGGING
+#define FPL_PROFILER
 #include <final_platform_layer.h>
 
 #define FT_IMPLEMENTATION
@@ -12,7 +16,10 @@ static void TestInit() {
 	ft::Msg("Test InitPlatform with All init flags\n");
 	{
 		fplClearPlatformErrors();
-		fplInitResultType result = fplPlatformInit(fplInitFlags_All, nullptr);
+		fplSettings settings;
+		fplSetDefaultSettings(&settings);
+		settings.audio.driver = fplAudioDriverType_Null;
+		fplInitResultType result = fplPlatformInit(fplInitFlags_All, &settings);
 		FT_ASSERT(result == fplInitResultType_Success);
 		const char *errorStr = fplGetPlatformError();
 		ft::AssertStringEquals("", errorStr);
@@ -25,6 +32,48 @@ static void TestInit() {
 		FT_ASSERT(result == fplInitResultType_Success);
 		const char *errorStr = fplGetPlatformError();
 		ft::AssertStringEquals("", errorStr);
+		fplInitTimings timings = {};
+		FT_IS_TRUE(fplGetInitTimings(&timings));
+		FT_IS_TRUE(timings.total >= timings.platform);
+		FT_EXPECTS(0, timings.window + timings.video + timings.audio);
+		fplPlatformRelease();
+		FT_IS_FALSE(fplGetInitTimings(&timings));
+	}
+}
+
+static void ErrorThreadProc(const fplThreadHandle *context, void *data) {
+	fplFormatAnsiString(fpl_null, 0, "");
+	*(fplPlatformErrorType *)data = fplGetPlatformErrorType();
+}
+
+static void TestErrors() {
+	ft::Line();
+	ft::Msg("Test argument error type and string\n");
+	{
+		fplClearPlatformErrors();
+		FT_EXPECTS(fplPlatformErrorType_None, fplGetPlatformErrorType());
+		fplFormatAnsiString(fpl_null, 0, "");
+		FT_EXPECTS(1, fplGetPlatformErrorCount());
+		FT_EXPECTS(fplPlatformErrorType_ArgumentNull, fplGetPlatformErrorType());
+		ft::AssertStringEquals("Ansi dest buffer parameter are not allowed to be null", fplGetPlatformError());
+		char buffer[4];
+		fplFormatAnsiString(buffer, FPL_ARRAYCOUNT(buffer), "%s", "Hello");
+		FT_EXPECTS(fplPlatformErrorType_ArgumentTooSmall, fplGetPlatformErrorType());
+		ft::AssertStringEquals("Max ansi dest len parameter '4' must be greater or equal than '6'", fplGetPlatformError());
+		FT_EXPECTS(fplPlatformErrorType_ArgumentNull, fplGetPlatformErrorTypeFromIndex(0));
+		fplClearPlatformErrors();
+		FT_EXPECTS(0, fplGetPlatformErrorCount());
+		ft::AssertStringEquals("", fplGetPlatformError());
+	}
+	ft::Msg("Test errors are stored per thread\n");
+	if(fplPlatformInit(fplInitFlags_None, fpl_null)) {
+		fplClearPlatformErrors();
+		fplPlatformErrorType threadErrorType = fplPlatformErrorType_None;
+		fplThreadHandle *thread = fplThreadCreate(ErrorThreadProc, &threadErrorType);
+		fplThreadWaitForOne(thread, FPL_TIMEOUT_INFINITE);
+		fplThreadTerminate(thread);
+		FT_EXPECTS(fplPlatformErrorType_ArgumentNull, threadErrorType);
+		FT_EXPECTS(0, fplGetPlatformErrorCount());
 		fplPlatformRelease();
 	}
 }
@@ -299,6 +348,64 @@ static void TestMemory() {
 	}
 }
 
+static void TestRingBuffer() {
+	ft::Line();
+	ft::Msg("Test ring buffer init and release\n");
+	{
+		fplRingBuffer ringBuffer;
+		FT_IS_TRUE(fplRingBufferInit(&ringBuffer, 100));
+		FT_IS_NOT_NULL(ringBuffer.data);
+		FT_IS_TRUE(ringBuffer.capacity >= 100);
+		ft::AssertSizeEquals(0, ringBuffer.capacity & (ringBuffer.capacity - 1));
+		ft::AssertSizeEquals(0, fplRingBufferGetReadAvailable(&ringBuffer));
+		ft::AssertSizeEquals(ringBuffer.capacity, fplRingBufferGetWriteAvailable(&ringBuffer));
+		fplRingBufferRelease(&ringBuffer);
+		FT_IS_NULL(ringBuffer.data);
+	}
+	ft::Msg("Test ring buffer write and read across the wrap point\n");
+	{
+		fplRingBuffer ringBuffer;
+		FT_IS_TRUE(fplRingBufferInit(&ringBuffer, 1));
+		size_t capacity = ringBuffer.capacity;
+		size_t chunkSize = (capacity / 4) * 3;
+		uint8_t *source = (uint8_t *)fplMemoryAllocate(chunkSize);
+		uint8_t *target = (uint8_t *)fplMemoryAllocate(chunkSize);
+		for(int round = 0; round < 4; ++round) {
+			for(size_t i = 0; i < chunkSize; ++i) {
+				source[i] = (uint8_t)(i + round);
+			}
+			ft::AssertSizeEquals(chunkSize, fplRingBufferWrite(&ringBuffer, source, chunkSize));
+			ft::AssertSizeEquals(chunkSize, fplRingBufferGetReadAvailable(&ringBuffer));
+			ft::AssertSizeEquals(capacity - chunkSize, fplRingBufferWrite(&ringBuffer, source, capacity));
+			ft::AssertSizeEquals(0, fplRingBufferGetWriteAvailable(&ringBuffer));
+			ft::AssertSizeEquals(chunkSize, fplRingBufferRead(&ringBuffer, target, chunkSize));
+			for(size_t i = 0; i < chunkSize; ++i) {
+				ft::AssertU8Equals(source[i], target[i]);
+			}
+			ft::AssertSizeEquals(capacity - chunkSize, fplRingBufferRead(&ringBuffer, target, chunkSize));
+			ft::AssertSizeEquals(0, fplRingBufferRead(&ringBuffer, target, chunkSize));
+		}
+		if(ringBuffer.isMirrored) {
+			ft::Msg("Test mirrored ring buffer regions are contiguous\n");
+			size_t regionSize;
+			uint8_t *writeRegion = fplRingBufferBeginWrite(&ringBuffer, &regionSize);
+			ft::AssertSizeEquals(capacity, regionSize);
+			for(size_t i = 0; i < regionSize; ++i) {
+				writeRegion[i] = 0xAB;
+			}
+			fplRingBufferEndWrite(&ringBuffer, regionSize);
+			const uint8_t *readRegion = fplRingBufferBeginRead(&ringBuffer, &regionSize);
+			ft::AssertSizeEquals(capacity, regionSize);
+			ft::AssertU8Equals(0xAB, readRegion[0]);
+			ft::AssertU8Equals(0xAB, readRegion[regionSize - 1]);
+			fplRingBufferEndRead(&ringBuffer, regionSize);
+		}
+		fplMemoryFree(target);
+		fplMemoryFree(source);
+		fplRingBufferRelease(&ringBuffer);
+	}
+}
+
 static void TestPaths() {
     ft::Line();
 	if(fplPlatformInit(fplInitFlags_None, fpl_null)) {
@@ -343,6 +450,48 @@ static void TestPaths() {
 	}
 }
 
+static void TestTimings() {
+	ft::Line();
+	if(fplPlatformInit(fplInitFlags_None, fpl_null)) {
+		ft::Msg("Test nanoseconds are monotonic\n");
+		{
+			uint64_t first = fplGetTimeInNanoseconds();
+			fplThreadSleep(2);
+			uint64_t second = fplGetTimeInNanoseconds();
+			FT_IS_TRUE(second > first);
+			FT_IS_TRUE((second - first) >= 1000000ULL);
+		}
+		ft::Msg("Test cycle counter\n");
+		{
+			uint64_t first = fplGetCycleCounter();
+			uint64_t second = fplGetCycleCounter();
+			FT_IS_TRUE(second >= first);
+			uint64_t frequency = fplGetCycleCounterFrequency();
+			FT_IS_TRUE(frequency > 0);
+			ft::Msg("Cycle counter frequency: %llu Hz, invariant: %s\n", (unsigned long long)frequency, fplIsCycleCounterInvariant() ? "yes" : "no");
+		}
+		ft::Msg("Test precise sleep\n");
+		{
+			uint64_t first = fplGetTimeInNanoseconds();
+			fplSleepPrecise(1500000ULL);
+			uint64_t second = fplGetTimeInNanoseconds();
+			FT_IS_TRUE((second - first) >= 1500000ULL);
+		}
+		ft::Msg("Test frame pacer\n");
+		{
+			fplFramePacer pacer;
+			fplFramePacerInit(&pacer, 500.0);
+			FT_EXPECTS(2000000ULL, pacer.frameDuration);
+			for(int i = 0; i < 3; ++i) {
+				fplFramePacerWait(&pacer);
+			}
+			FT_EXPECTS(3ULL, pacer.frameCount);
+			FT_IS_TRUE(pacer.missedCount <= pacer.frameCount);
+		}
+		fplPlatformRelease();
+	}
+}
+
 static void TestHardware() {
     ft::Line();
 
@@ -367,6 +516,27 @@ static void TestHardware() {
 	fplArchType archType = fplGetRunningArchitecture();
 	const char *archStr = fplGetArchTypeString(archType);
 	ft::Msg("System archicture: %s\n", archStr);
+
+	FT_IS_FALSE(fplGetCPUInfo(nullptr));
+	fplCPUInfo cpuInfo;
+	FT_IS_TRUE(fplGetCPUInfo(&cpuInfo));
+	ft::Msg("CPU vendor: %s\n", cpuInfo.vendorName);
+	ft::Msg("CPU brand: %s\n", cpuInfo.brandName);
+	ft::Msg("CPU topology (logical/physical/packages/numa): %d/%d/%d/%d\n", cpuInfo.logicalCoreCount, cpuInfo.physicalCoreCount, cpuInfo.packageCount, cpuInfo.numaNodeCount);
+	ft::Msg("CPU caches (L1d/L1i/L2/L3/line): %d/%d/%d/%d/%d\n", cpuInfo.l1DataCacheSize, cpuInfo.l1InstructionCacheSize, cpuInfo.l2CacheSize, cpuInfo.l3CacheSize, cpuInfo.cacheLineSize);
+	ft::Msg("CPU features: %x\n", (uint32_t)cpuInfo.features);
+	FT_IS_TRUE(cpuInfo.logicalCoreCount >= 1);
+	FT_IS_TRUE(cpuInfo.physicalCoreCount >= 1);
+	FT_IS_TRUE(cpuInfo.physicalCoreCount <= cpuInfo.logicalCoreCount);
+	FT_IS_TRUE(cpuInfo.packageCount >= 1);
+	FT_IS_TRUE(cpuInfo.numaNodeCount >= 1);
+#if defined(FPL_ARCH_X64)
+	// SSE2 is part of the X64 baseline
+	FT_IS_TRUE(cpuInfo.features & fplCPUFeatureFlags_SSE2);
+#endif
+#if defined(FPL_ARCH_ARM64)
+	FT_IS_TRUE(cpuInfo.features & fplCPUFeatureFlags_NEON);
+#endif
 }
 
 static void EmptyThreadproc(const fplThreadHandle *context, void *data) {
@@ -1058,6 +1228,133 @@ static void TestStrings() {
 		bool res = fplIsStringEqualLen("Hello", 3, "Hello", 3);
 		FT_EXPECTS(true, res);
 	}
+	{
+		bool res = fplIsStringEqual("The quick brown fox jumps over the lazy dog", "The quick brown fox jumps over the lazy dog");
+		FT_EXPECTS(true, res);
+	}
+	{
+		bool res = fplIsStringEqual("The quick brown fox jumps over the lazy dog", "The quick brown fox jumps over the lazy cat");
+		FT_EXPECTS(false, res);
+	}
+	{
+		bool res = fplIsStringEqual("The quick brown fox jumps over the lazy dog", "The quick brown fox jumps over the lazy");
+		FT_EXPECTS(false, res);
+	}
+	{
+		bool res = fplIsStringEqualLen("The quick brown fox jumps over the lazy dog", 40, "The quick brown fox jumps over the lazy cat", 40);
+		FT_EXPECTS(true, res);
+	}
+
+	ft::Msg("Test ansi string length on every alignment\n");
+	{
+		char buffer[128];
+		for(size_t offset = 0; offset < 16; ++offset) {
+			for(size_t len = 0; len < 64; ++len) {
+				for(size_t i = 0; i < FPL_ARRAYCOUNT(buffer); ++i) {
+					buffer[i] = 'X';
+				}
+				buffer[offset + len] = 0;
+				size_t actual = fplGetAnsiStringLength(buffer + offset);
+				ft::AssertSizeEquals(len, actual);
+			}
+		}
+	}
+
+	ft::Msg("Test find char\n");
+	{
+		FT_IS_NULL(fplFindChar(nullptr, 'A'));
+		FT_IS_NULL(fplFindChar("", 'A'));
+		FT_IS_NULL(fplFindChar("Hello World", 'X'));
+		const char *str = "Hello World, this is a longer string with a comma, and more";
+		FT_EXPECTS(str + 4, fplFindChar(str, 'o'));
+		FT_EXPECTS(str + 11, fplFindChar(str, ','));
+		FT_EXPECTS(str + fplGetAnsiStringLength(str), fplFindChar(str, 0));
+		FT_EXPECTS(str + 49, fplFindLastChar(str, ','));
+		FT_EXPECTS(str + 57, fplFindLastChar(str, 'r'));
+		FT_IS_NULL(fplFindLastChar(str, 'X'));
+		FT_EXPECTS(str + 11, fplFindCharLen(str, 20, ','));
+		FT_IS_NULL(fplFindCharLen(str, 11, ','));
+	}
+
+	ft::Msg("Test find substring\n");
+	{
+		const char *str = "Hello World, this is a longer string with a comma, and more";
+		FT_IS_NULL(fplFindSubstring(nullptr, "A"));
+		FT_EXPECTS(str, fplFindSubstring(str, ""));
+		FT_EXPECTS(str, fplFindSubstring(str, "Hello"));
+		FT_EXPECTS(str + 6, fplFindSubstring(str, "World"));
+		FT_EXPECTS(str + 44, fplFindSubstring(str, "comma"));
+		FT_EXPECTS(str + 55, fplFindSubstring(str, "more"));
+		FT_IS_NULL(fplFindSubstring(str, "mores"));
+		FT_IS_NULL(fplFindSubstring(str, "World!"));
+		FT_IS_NULL(fplFindSubstringLen(str, 47, "comma", 5));
+	}
+
+	ft::Msg("Test UTF transcoding\n");
+	{
+		// "Grüße €𝄞" in UTF-8, contains 2, 3 and 4 byte sequences
+		const char *utf8 = "Gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC\xF0\x9D\x84\x9E";
+		size_t utf8Len = fplGetAnsiStringLength(utf8);
+		ft::AssertSizeEquals(8, fplUTF8ToUTF32(utf8, utf8Len, nullptr, 0));
+		ft::AssertSizeEquals(9, fplUTF8ToUTF16(utf8, utf8Len, nullptr, 0));
+
+		uint32_t utf32[16];
+		ft::AssertSizeEquals(8, fplUTF8ToUTF32(utf8, utf8Len, utf32, FPL_ARRAYCOUNT(utf32)));
+		FT_EXPECTS(0xFCU, utf32[2]);
+		FT_EXPECTS(0x20ACU, utf32[6]);
+		FT_EXPECTS(0x1D11EU, utf32[7]);
+		FT_EXPECTS(0U, utf32[8]);
+
+		uint16_t utf16[16];
+		ft::AssertSizeEquals(9, fplUTF8ToUTF16(utf8, utf8Len, utf16, FPL_ARRAYCOUNT(utf16)));
+		FT_EXPECTS(0xD834, utf16[7]);
+		FT_EXPECTS(0xDD1E, utf16[8]);
+
+		char back[32];
+		ft::AssertSizeEquals(utf8Len, fplUTF16ToUTF8(utf16, 9, back, FPL_ARRAYCOUNT(back)));
+		FT_IS_TRUE(fplIsStringEqual(utf8, back));
+		ft::AssertSizeEquals(utf8Len, fplUTF32ToUTF8(utf32, 8, back, FPL_ARRAYCOUNT(back)));
+		FT_IS_TRUE(fplIsStringEqual(utf8, back));
+
+		// Destination too small for the null terminator
+		ft::AssertSizeEquals(0, fplUTF8ToUTF32(utf8, utf8Len, utf32, 8));
+	}
+	{
+		// Long ASCII runs are converted in blocks
+		const char *ascii = "The quick brown fox jumps over the lazy dog 0123456789";
+		size_t asciiLen = fplGetAnsiStringLength(ascii);
+		uint16_t utf16[64];
+		ft::AssertSizeEquals(asciiLen, fplUTF8ToUTF16(ascii, asciiLen, utf16, FPL_ARRAYCOUNT(utf16)));
+		FT_EXPECTS((uint16_t)'9', utf16[asciiLen - 1]);
+		char back[64];
+		ft::AssertSizeEquals(asciiLen, fplUTF16ToUTF8(utf16, asciiLen, back, FPL_ARRAYCOUNT(back)));
+		FT_IS_TRUE(fplIsStringEqual(ascii, back));
+	}
+	{
+		// Invalid sequences
+		uint32_t utf32[8];
+		ft::AssertSizeEquals(0, fplUTF8ToUTF32("\xC0\xAF", 2, utf32, FPL_ARRAYCOUNT(utf32)));
+		ft::AssertSizeEquals(0, fplUTF8ToUTF32("\xED\xA0\x80", 3, utf32, FPL_ARRAYCOUNT(utf32)));
+		ft::AssertSizeEquals(0, fplUTF8ToUTF32("\xF4\x90\x80\x80", 4, utf32, FPL_ARRAYCOUNT(utf32)));
+		ft::AssertSizeEquals(0, fplUTF8ToUTF32("\xE2\x82", 2, utf32, FPL_ARRAYCOUNT(utf32)));
+		ft::AssertSizeEquals(0, fplUTF8ToUTF32("\x80", 1, utf32, FPL_ARRAYCOUNT(utf32)));
+		const uint16_t loneSurrogate[] = { 'A', 0xD800, 'B' };
+		char utf8[8];
+		ft::AssertSizeEquals(0, fplUTF16ToUTF8(loneSurrogate, 3, utf8, FPL_ARRAYCOUNT(utf8)));
+		const uint32_t tooBig[] = { 0x110000 };
+		ft::AssertSizeEquals(0, fplUTF32ToUTF8(tooBig, 1, utf8, FPL_ARRAYCOUNT(utf8)));
+	}
+	{
+		// Wide strings
+		const wchar_t *wide = L"Grüße €";
+		char utf8[32];
+		FT_IS_NOT_NULL(fplWideStringToUTF8String(wide, fplGetWideStringLength(wide), utf8, FPL_ARRAYCOUNT(utf8)));
+		FT_IS_TRUE(fplIsStringEqual("Gr\xC3\xBC\xC3\x9F" "e \xE2\x82\xAC", utf8));
+		wchar_t wideBack[32];
+		FT_IS_NOT_NULL(fplUTF8StringToWideString(utf8, fplGetAnsiStringLength(utf8), wideBack, FPL_ARRAYCOUNT(wideBack)));
+		ft::AssertSizeEquals(fplGetWideStringLength(wide), fplGetWideStringLength(wideBack));
+		FT_EXPECTS(wide[6], wideBack[6]);
+	}
 
 	ft::Msg("Test format ansi string\n");
 	{
@@ -1111,17 +1408,318 @@ static void TestStrings() {
 }
 
 
+struct TestLogSink {
+	char lastMessage[256];
+	char lastCategory[64];
+	fplLogLevel levels[16];
+	volatile uint32_t entryCount;
+	volatile uint32_t threadIndexZeroCount;
+	volatile uint32_t isBlocked;
+	volatile uint32_t isInside;
+};
+
+static void TestLogSinkCallback(const fplLogEntry *entry, void *userData) {
+	TestLogSink *sink = (TestLogSink *)userData;
+	fplAtomicStoreU32(&sink->isInside, 1);
+	while(fplAtomicLoadU32(&sink->isBlocked)) {
+		fplThreadSleep(1);
+	}
+	fplCopyAnsiString(entry->message, sink->lastMessage, FPL_ARRAYCOUNT(sink->lastMessage));
+	fplCopyAnsiString(entry->category, sink->lastCategory, FPL_ARRAYCOUNT(sink->lastCategory));
+	if(sink->entryCount < FPL_ARRAYCOUNT(sink->levels)) {
+		sink->levels[sink->entryCount] = entry->level;
+	}
+	if(entry->threadIndex == 0) {
+		++sink->threadIndexZeroCount;
+	}
+	++sink->entryCount;
+}
+
+static void LogThreadProc(const fplThreadHandle *context, void *data) {
+	fplLogWrite(fplLogLevel_Info, "Thread", "Thread %d", *(int *)data);
+}
+
+static void SetTestLogSink(TestLogSink *sink, const fplLogLevel maxLevel) {
+	fplLogFlush();
+	fplMemoryClear(sink, sizeof(*sink));
+	fplLogSettings settings;
+	fplSetDefaultLogSettings(&settings);
+	settings.sinks = fplLogSinkFlags_Custom;
+	settings.maxLevel = maxLevel;
+	settings.callback = TestLogSinkCallback;
+	settings.userData = sink;
+	fplSetLogSettings(&settings);
+}
+
+static void TestLogging() {
+	if(fplPlatformInit(fplInitFlags_None, fpl_null)) {
+		static TestLogSink sink;
+
+		ft::Line();
+		ft::Msg("Test log formatting\n");
+		{
+			SetTestLogSink(&sink, fplLogLevel_Debug);
+			fplLogWrite(fplLogLevel_Info, "Test", "%s|%d|%llu|%f|%*d|%%", "Hello", -42, 18446744073709551615ULL, 1.5, 5, 42);
+			fplLogFlush();
+			ft::AssertU32Equals(1, sink.entryCount);
+			ft::AssertStringEquals("Test", sink.lastCategory);
+			ft::AssertStringEquals("Hello|-42|18446744073709551615|1.500000|   42|%", sink.lastMessage);
+			FT_EXPECTS(fplLogLevel_Info, sink.levels[0]);
+			fplClearPlatformErrors();
+			fplLogWrite(fplLogLevel_Info, "Test", "[%s]", "");
+			fplLogFlush();
+			ft::AssertStringEquals("", fplGetPlatformError());
+			ft::AssertStringEquals("[]", sink.lastMessage);
+		}
+
+		ft::Msg("Test log level filtering\n");
+		{
+			SetTestLogSink(&sink, fplLogLevel_Warning);
+			fplLogWrite(fplLogLevel_Error, "Test", "Error %d", 1);
+			fplLogWrite(fplLogLevel_Warning, "Test", "Warning %d", 2);
+			fplLogWrite(fplLogLevel_Info, "Test", "Info %d", 3);
+			fplLogWrite(fplLogLevel_Debug, "Test", "Debug %d", 4);
+			fplLogFlush();
+			ft::AssertU32Equals(2, sink.entryCount);
+			FT_EXPECTS(fplLogLevel_Error, sink.levels[0]);
+			FT_EXPECTS(fplLogLevel_Warning, sink.levels[1]);
+			ft::AssertStringEquals("Warning 2", sink.lastMessage);
+		}
+
+		ft::Msg("Test log records are dropped, when the writer is blocked\n");
+		{
+			SetTestLogSink(&sink, fplLogLevel_Debug);
+			uint32_t droppedBefore = fplGetLogDroppedCount();
+			fplAtomicStoreU32(&sink.isBlocked, 1);
+			fplLogWrite(fplLogLevel_Info, "Test", "Blocking");
+			while(!fplAtomicLoadU32(&sink.isInside)) {
+				fplThreadSleep(1);
+			}
+			const uint32_t recordCount = 10000;
+			for(uint32_t i = 0; i < recordCount; ++i) {
+				fplLogWrite(fplLogLevel_Info, "Test", "Record %u of %u: %s", i, recordCount, "Some text to fill up the log ring much faster");
+			}
+			fplAtomicStoreU32(&sink.isBlocked, 0);
+			fplLogFlush();
+			uint32_t droppedCount = fplGetLogDroppedCount() - droppedBefore;
+			FT_IS_TRUE(droppedCount > 0);
+			ft::AssertU32Equals(recordCount + 1, sink.entryCount + droppedCount);
+		}
+
+		ft::Msg("Test log rings of exited threads are reused\n");
+		{
+			SetTestLogSink(&sink, fplLogLevel_Debug);
+			const int threadCount = 100;
+			for(int i = 0; i < threadCount; ++i) {
+				fplThreadHandle *thread = fplThreadCreate(LogThreadProc, &i);
+				FT_IS_NOT_NULL(thread);
+				fplThreadWaitForOne(thread, FPL_TIMEOUT_INFINITE);
+				fplThreadTerminate(thread);
+			}
+			fplLogFlush();
+			ft::AssertU32Equals(threadCount, sink.entryCount);
+			ft::AssertU32Equals(0, sink.threadIndexZeroCount);
+			ft::AssertStringEquals("Thread 99", sink.lastMessage);
+		}
+
+		fplLogSettings defaultSettings;
+		fplSetDefaultLogSettings(&defaultSettings);
+		fplSetLogSettings(&defaultSettings);
+
+		fplPlatformRelease();
+	}
+}
+
+static uint32_t NullAudioClientRead(const fplAudioDeviceFormat *deviceFormat, const uint32_t frameCount, void *outputSamples, void *userData) {
+	uint32_t sampleCount = frameCount * deviceFormat->channels;
+	int16_t *samples = (int16_t *)outputSamples;
+	for(uint32_t i = 0; i < sampleCount; ++i) {
+		samples[i] = (int16_t)(i & 0x7FFF);
+	}
+	return frameCount;
+}
+
+static uint32_t ReadLittleEndianU32(const uint8_t *p) {
+	uint32_t result = (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+	return(result);
+}
+
+static void TestNullAudio() {
+	ft::Line();
+	ft::Msg("Test null audio driver unthrottled into a WAV file\n");
+	{
+		const char *wavFilePath = "fpl_test_null_audio.wav";
+		fplSettings settings;
+		fplSetDefaultSettings(&settings);
+		settings.audio.driver = fplAudioDriverType_Null;
+		settings.audio.deviceFormat.type = fplAudioFormatType_S16;
+		settings.audio.clientReadCallback = NullAudioClientRead;
+		settings.audio.specific.nullDriver.isUnthrottled = true;
+		fplCopyAnsiString(wavFilePath, settings.audio.specific.nullDriver.wavFilePath, FPL_ARRAYCOUNT(settings.audio.specific.nullDriver.wavFilePath));
+
+		fplClearPlatformErrors();
+		fplInitResultType initResult = fplPlatformInit(fplInitFlags_Audio, &settings);
+		FT_ASSERT(initResult == fplInitResultType_Success);
+		ft::AssertStringEquals("", fplGetPlatformError());
+		fplAudioDeviceFormat format = fplGetAudioHardwareFormat();
+		ft::AssertU32Equals(2, format.periods);
+		uint32_t periodSizeInFrames = format.bufferSizeInFrames / format.periods;
+		uint32_t bytesPerFrame = fplGetAudioSampleSizeInBytes(format.type) * format.channels;
+		FT_IS_TRUE(periodSizeInFrames > 0);
+
+		const uint64_t minPeriodCount = 100;
+		FT_EXPECTS(fplAudioResult_Success, fplPlayAudio());
+		fplNullAudioStats nullStats;
+		do {
+			fplThreadSleep(1);
+			FT_IS_TRUE(fplGetNullAudioStats(&nullStats));
+		} while(nullStats.periodCount < minPeriodCount);
+		FT_EXPECTS(fplAudioResult_Success, fplStopAudio());
+
+		FT_IS_TRUE(fplGetNullAudioStats(&nullStats));
+		FT_IS_TRUE(nullStats.periodCount >= minPeriodCount);
+		ft::AssertU64Equals(nullStats.periodCount * periodSizeInFrames, nullStats.framesRead);
+		ft::AssertU64Equals(nullStats.framesRead * bytesPerFrame, nullStats.wavBytesWritten);
+		ft::AssertU64Equals(0, nullStats.periodLateness.sampleCount);
+
+		fplAudioStats audioStats;
+		FT_IS_TRUE(fplGetAudioStats(&audioStats));
+		ft::AssertU64Equals(nullStats.periodCount, audioStats.periodCount);
+		ft::AssertU64Equals(nullStats.framesRead, audioStats.framesDelivered);
+
+		// The final sizes are patched into the header, when the driver is released
+		fplPlatformRelease();
+
+		uint32_t dataSize = (uint32_t)nullStats.wavBytesWritten;
+		ft::AssertU32Equals(44 + dataSize, fplGetFileSizeFromPath32(wavFilePath));
+		fplFileHandle wavFile;
+		FT_IS_TRUE(fplOpenAnsiBinaryFile(wavFilePath, &wavFile));
+		uint8_t header[44];
+		ft::AssertU32Equals(sizeof(header), fplReadFileBlock32(&wavFile, sizeof(header), header, sizeof(header)));
+		fplCloseFile(&wavFile);
+		FT_IS_TRUE(fplIsStringEqualLen((const char *)header + 0, 4, "RIFF", 4));
+		ft::AssertU32Equals(36 + dataSize, ReadLittleEndianU32(header + 4));
+		FT_IS_TRUE(fplIsStringEqualLen((const char *)header + 8, 4, "WAVE", 4));
+		ft::AssertU32Equals(format.sampleRate, ReadLittleEndianU32(header + 24));
+		FT_IS_TRUE(fplIsStringEqualLen((const char *)header + 36, 4, "data", 4));
+		ft::AssertU32Equals(dataSize, ReadLittleEndianU32(header + 40));
+		FT_IS_TRUE(fplFileDelete(wavFilePath));
+	}
+}
+
+static uint32_t CountSubstrings(const char *str, const char *subStr) {
+	uint32_t result = 0;
+	size_t subLen = fplGetAnsiStringLength(subStr);
+	const char *p = fplFindSubstring(str, subStr);
+	while(p != fpl_null) {
+		++result;
+		p = fplFindSubstring(p + subLen, subStr);
+	}
+	return(result);
+}
+
+static char *ReadChromeTrace(const char *filePath) {
+	uint32_t fileSize = fplGetFileSizeFromPath32(filePath);
+	FT_IS_TRUE(fileSize > 0);
+	char *result = (char *)fplMemoryAllocate(fileSize + 1);
+	fplFileHandle file;
+	FT_IS_TRUE(fplOpenAnsiBinaryFile(filePath, &file));
+	ft::AssertU32Equals(fileSize, fplReadFileBlock32(&file, fileSize, result, fileSize));
+	fplCloseFile(&file);
+	result[fileSize] = 0;
+	return(result);
+}
+
+static void ProfilerThreadProc(const fplThreadHandle *context, void *data) {
+	FPL_PROFILE_ZONE("ThreadZone");
+}
+
+static void TestProfiler() {
+	if(fplPlatformInit(fplInitFlags_None, fpl_null)) {
+		const char *traceFilePath = "fpl_test_profiler.json";
+
+		ft::Line();
+		ft::Msg("Test profiler nested zones into a chrome trace\n");
+		{
+			fplProfilerReset();
+			FPL_PROFILE_BEGIN("Outer");
+			FPL_PROFILE_BEGIN("InnerA");
+			FPL_PROFILE_END();
+			FPL_PROFILE_BEGIN("InnerB");
+			FPL_PROFILE_END();
+			FPL_PROFILE_END();
+			// Unbalanced end is ignored
+			FPL_PROFILE_END();
+			FPL_PROFILE_BEGIN("Quote\"Back\\slash\n");
+			FPL_PROFILE_END();
+
+			fplThreadHandle *thread = fplThreadCreate(ProfilerThreadProc, fpl_null);
+			FT_IS_NOT_NULL(thread);
+			fplThreadWaitForOne(thread, FPL_TIMEOUT_INFINITE);
+			fplThreadTerminate(thread);
+
+			// Exporting twice must not record the zones of the export itself
+			FT_IS_TRUE(fplProfilerWriteChromeTrace(traceFilePath));
+			FT_IS_TRUE(fplProfilerWriteChromeTrace(traceFilePath));
+			char *trace = ReadChromeTrace(traceFilePath);
+			FT_IS_TRUE(fplIsStringEqualLen(trace, 16, "{\"traceEvents\":[", 16));
+			ft::AssertU32Equals(5, CountSubstrings(trace, "\"ph\":\"B\""));
+			ft::AssertU32Equals(5, CountSubstrings(trace, "\"ph\":\"E\""));
+			ft::AssertU32Equals(1, CountSubstrings(trace, "\"name\":\"Quote\\\"Back\\\\slash\\u000a\""));
+			const char *outer = fplFindSubstring(trace, "\"name\":\"Outer\"");
+			const char *innerA = fplFindSubstring(trace, "\"name\":\"InnerA\"");
+			const char *innerB = fplFindSubstring(trace, "\"name\":\"InnerB\"");
+			FT_IS_NOT_NULL(outer);
+			FT_IS_NOT_NULL(innerA);
+			FT_IS_NOT_NULL(innerB);
+			FT_IS_TRUE(outer < innerA && innerA < innerB);
+			ft::AssertU32Equals(1, CountSubstrings(trace, "\"name\":\"ThreadZone\""));
+			fplMemoryFree(trace);
+		}
+
+		ft::Msg("Test profiler trace stays balanced when the buffer is full\n");
+		{
+			fplProfilerReset();
+			FPL_PROFILE_BEGIN("Frame");
+			for(uint32_t i = 0; i < 50000; ++i) {
+				FPL_PROFILE_BEGIN("Work");
+				FPL_PROFILE_BEGIN("SubWork");
+				FPL_PROFILE_END();
+				FPL_PROFILE_END();
+			}
+			FPL_PROFILE_END();
+			FT_IS_TRUE(fplProfilerWriteChromeTrace(traceFilePath));
+			char *trace = ReadChromeTrace(traceFilePath);
+			uint32_t beginCount = CountSubstrings(trace, "\"ph\":\"B\"");
+			uint32_t endCount = CountSubstrings(trace, "\"ph\":\"E\"");
+			FT_IS_TRUE(beginCount > 0 && beginCount < 100001);
+			ft::AssertU32Equals(beginCount, endCount);
+			fplMemoryFree(trace);
+		}
+
+		fplProfilerReset();
+		FT_IS_TRUE(fplFileDelete(traceFilePath));
+		fplPlatformRelease();
+	}
+}
+
 int main(int argc, char *args[]) {
 	TestOSInfos();
 	TestHardware();
+	TestTimings();
 	TestSizes();
 	TestMacros();
 	TestAtomics();
 	TestMemory();
+	TestRingBuffer();
 	TestPaths();
 	TestFiles();
 	TestStrings();
 	TestThreading();
+	TestLogging();
+	TestProfiler();
+	TestNullAudio();
+	TestErrors();
 	TestInit();
 	return 0;
 }
@@ -0,0 +1,713 @@
+/*
+*******************************************************************************
+FTT Benchmark
+*******************************************************************************
+This demo measures the tile tracer on generated tile maps and checks its output against golden files.
+
+- Random, cave, maze and checkerboard maps are generated from 64x64 up to 4096x4096 tiles, always with the same seed
+- Init, trace and simplify of the tile tracer are timed separately, TraceContours() is timed as a whole
+- Vertices per second are the traced chain vertices divided by the trace time
+- Peak memory is the highest number of heap bytes, which was allocated while processing a map
+- The chain segments are hashed and compared to the golden file, a mismatch results in a exit code of 1
+- The smaller maps are checked further, a failed check results in a exit code of 1 as well:
+  - ContourMap: Seeded batches of tile edits are applied with UpdateContourMap() and compared against TraceContours() of the edited map
+  - Chunked: TraceContoursChunked() must be identical to TraceContours() for several chunk sizes and thread counts
+  - Shapes: Solid tiles get random shapes and one-way platforms, the layers of TraceShapeLayers() are hashed and compared to the golden file
+  - Triangles: TriangulateChainSegments() and DecomposeChainSegments() of the contours are hashed and compared to the golden file, their area must equal the solid tiles
+  - Cache: The contours must be equal after WriteContourCache() and ReadContourCache(), other keys, truncated and corrupted blobs must be rejected
+
+Usage: FTT_Benchmark [golden file] [-update]
+- Without a golden file argument, "ftt_benchmark_golden.txt" in the current directory is used
+- With -update the golden file is written from the current results instead of being checked
+*/
+
+#define FPL_IMPLEMENTATION
+#define FPL_NO_WINDOW
+#define FPL_NO_AUDIO
+#include <final_platform_layer.h>
+
+#define FTT_IMPLEMENTATION
+#include <final_tiletrace.hpp>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include <algorithm>
+#include <vector>
+
+//
+// Heap tracking
+//
+static size_t CurrentHeapBytes = 0;
+static size_t PeakHeapBytes = 0;
+
+// Each allocation stores its size in front of the returned memory, padded to keep the alignment
+static const size_t HeapHeaderSize = 16;
+
+void *operator new(size_t size) {
+	uint8_t *block = (uint8_t *)malloc(size + HeapHeaderSize);
+	if(block == fpl_null) {
+		throw std::bad_alloc();
+	}
+	*(size_t *)block = size;
+	CurrentHeapBytes += size;
+	if(CurrentHeapBytes > PeakHeapBytes) {
+		PeakHeapBytes = CurrentHeapBytes;
+	}
+	return block + HeapHeaderSize;
+}
+
+void operator delete(void *ptr) noexcept {
+	if(ptr != fpl_null) {
+		void *block = (void *)((uintptr_t)ptr - HeapHeaderSize);
+		CurrentHeapBytes -= *(size_t *)block;
+		free(block);
+	}
+}
+
+//
+// Map generation
+//
+static uint32_t RandomState = 0;
+
+static uint32_t NextRandom() {
+	// Xorshift32, so the maps are the same on every platform
+	uint32_t x = RandomState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	RandomState = x;
+	return(x);
+}
+
+static void GenerateRandomMap(uint32_t size, uint8_t *tiles) {
+	for(uint32_t tileIndex = 0; tileIndex < size * size; ++tileIndex) {
+		tiles[tileIndex] = (NextRandom() % 100) < 45 ? 1 : 0;
+	}
+}
+
+static void GenerateCaveMap(uint32_t size, uint8_t *tiles) {
+	// Cellular automaton, a tile becomes solid when at least 5 of its 9 neighbors (itself included) are solid. Outside is solid.
+	GenerateRandomMap(size, tiles);
+	uint8_t *nextTiles = new uint8_t[size * size];
+	for(uint32_t iteration = 0; iteration < 4; ++iteration) {
+		for(int32_t y = 0; y < (int32_t)size; ++y) {
+			for(int32_t x = 0; x < (int32_t)size; ++x) {
+				uint32_t solidCount = 0;
+				for(int32_t offsetY = -1; offsetY <= 1; ++offsetY) {
+					for(int32_t offsetX = -1; offsetX <= 1; ++offsetX) {
+						int32_t neighborX = x + offsetX;
+						int32_t neighborY = y + offsetY;
+						if(neighborX < 0 || neighborY < 0 || neighborX >= (int32_t)size || neighborY >= (int32_t)size) {
+							++solidCount;
+						} else {
+							solidCount += tiles[neighborY * size + neighborX];
+						}
+					}
+				}
+				nextTiles[y * size + x] = solidCount >= 5 ? 1 : 0;
+			}
+		}
+		memcpy(tiles, nextTiles, size * size);
+	}
+	delete[] nextTiles;
+}
+
+static void GenerateMazeMap(uint32_t size, uint8_t *tiles) {
+	// Depth-first maze, the cells are the tiles with odd coordinates and everything else is wall
+	memset(tiles, 1, size * size);
+	uint32_t cellCount = (size - 1) / 2;
+	uint32_t *stack = new uint32_t[cellCount * cellCount];
+	uint32_t stackCount = 0;
+	tiles[1 * size + 1] = 0;
+	stack[stackCount++] = 0;
+	while(stackCount > 0) {
+		uint32_t cell = stack[stackCount - 1];
+		uint32_t cellX = cell % cellCount;
+		uint32_t cellY = cell / cellCount;
+		uint32_t neighbors[4];
+		uint32_t neighborCount = 0;
+		if(cellX > 0 && tiles[(cellY * 2 + 1) * size + cellX * 2 - 1]) {
+			neighbors[neighborCount++] = cell - 1;
+		}
+		if(cellX + 1 < cellCount && tiles[(cellY * 2 + 1) * size + cellX * 2 + 3]) {
+			neighbors[neighborCount++] = cell + 1;
+		}
+		if(cellY > 0 && tiles[(cellY * 2 - 1) * size + cellX * 2 + 1]) {
+			neighbors[neighborCount++] = cell - cellCount;
+		}
+		if(cellY + 1 < cellCount && tiles[(cellY * 2 + 3) * size + cellX * 2 + 1]) {
+			neighbors[neighborCount++] = cell + cellCount;
+		}
+		if(neighborCount == 0) {
+			--stackCount;
+			continue;
+		}
+		uint32_t next = neighbors[NextRandom() % neighborCount];
+		uint32_t nextX = next % cellCount;
+		uint32_t nextY = next / cellCount;
+		tiles[(cellY + nextY + 1) * size + cellX + nextX + 1] = 0;
+		tiles[(nextY * 2 + 1) * size + nextX * 2 + 1] = 0;
+		stack[stackCount++] = next;
+	}
+	delete[] stack;
+}
+
+static void GenerateCheckerboardMap(uint32_t size, uint8_t *tiles) {
+	// Worst case: Every solid tile touches its neighbors diagonally only
+	for(uint32_t y = 0; y < size; ++y) {
+		for(uint32_t x = 0; x < size; ++x) {
+			tiles[y * size + x] = (x + y) & 1;
+		}
+	}
+}
+
+typedef void (GenerateMapFunc)(uint32_t size, uint8_t *tiles);
+
+struct MapKind {
+	const char *name;
+	GenerateMapFunc *generate;
+};
+
+static const MapKind MapKinds[] = {
+	{ "random", GenerateRandomMap },
+	{ "cave", GenerateCaveMap },
+	{ "maze", GenerateMazeMap },
+	{ "checkerboard", GenerateCheckerboardMap },
+};
+
+static const uint32_t MapSizes[] = { 64, 256, 1024, 4096 };
+
+// The checks run on the smaller maps only
+static const uint32_t CheckSizes[] = { 64, 256 };
+
+//
+// Measurement
+//
+struct MapResult {
+	uint64_t initTime;
+	uint64_t traceTime;
+	uint64_t simplifyTime;
+	uint64_t contoursTime;
+	size_t peakBytes;
+	uint32_t segmentCount;
+	uint32_t vertexCount;
+	uint64_t tracerHash;
+	uint64_t contoursHash;
+};
+
+static uint64_t HashBytes(uint64_t hash, const void *data, size_t size) {
+	// FNV-1a
+	const uint8_t *bytes = (const uint8_t *)data;
+	for(size_t byteIndex = 0; byteIndex < size; ++byteIndex) {
+		hash ^= bytes[byteIndex];
+		hash *= 0x100000001b3ULL;
+	}
+	return(hash);
+}
+
+static const uint64_t HashSeed = 0xcbf29ce484222325ULL;
+
+static uint64_t HashVertices(uint64_t hash, const ftt::Vec2i *vertices, uint32_t vertexCount) {
+	hash = HashBytes(hash, &vertexCount, sizeof(vertexCount));
+	for(uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+		hash = HashBytes(hash, &vertices[vertexIndex].x, sizeof(int32_t));
+		hash = HashBytes(hash, &vertices[vertexIndex].y, sizeof(int32_t));
+	}
+	return(hash);
+}
+
+static void MeasureMap(uint32_t size, uint8_t *tiles, MapResult *outResult) {
+	ftt::Vec2u tileCount = { size, size };
+	size_t baseBytes = CurrentHeapBytes;
+	PeakHeapBytes = CurrentHeapBytes;
+
+	// Tile tracer
+	{
+		ftt::TileTracerData tracer = {};
+		uint64_t startTime = fplGetTimeInNanoseconds();
+		ftt::InitTileTracer(&tracer, tileCount, tiles);
+		uint64_t initTime = fplGetTimeInNanoseconds();
+		ftt::RunTileTracer(&tracer);
+		uint64_t traceTime = fplGetTimeInNanoseconds();
+		ftt::SimplifyTileTracerChains(&tracer, 0.0f);
+		uint64_t simplifyTime = fplGetTimeInNanoseconds();
+		outResult->initTime = initTime - startTime;
+		outResult->traceTime = traceTime - initTime;
+		outResult->simplifyTime = simplifyTime - traceTime;
+
+		outResult->segmentCount = (uint32_t)tracer.chainSegments.size();
+		outResult->vertexCount = 0;
+		outResult->tracerHash = HashBytes(HashSeed, &outResult->segmentCount, sizeof(outResult->segmentCount));
+		for(size_t segmentIndex = 0; segmentIndex < tracer.chainSegments.size(); ++segmentIndex) {
+			const ftt::ChainRange &range = tracer.chainSegments[segmentIndex];
+			outResult->tracerHash = HashVertices(outResult->tracerHash, &tracer.chainVertices[range.firstVertex], range.vertexCount);
+			outResult->vertexCount += range.vertexCount;
+		}
+	}
+
+	// Single pass contour tracing
+	{
+		std::vector<ftt::ChainSegment> chainSegments;
+		uint64_t startTime = fplGetTimeInNanoseconds();
+		ftt::TraceContours(tileCount, tiles, &chainSegments);
+		outResult->contoursTime = fplGetTimeInNanoseconds() - startTime;
+
+		uint32_t segmentCount = (uint32_t)chainSegments.size();
+		outResult->contoursHash = HashBytes(HashSeed, &segmentCount, sizeof(segmentCount));
+		for(size_t segmentIndex = 0; segmentIndex < chainSegments.size(); ++segmentIndex) {
+			const std::vector<ftt::Vec2i> &vertices = chainSegments[segmentIndex].vertices;
+			outResult->contoursHash = HashVertices(outResult->contoursHash, vertices.data(), (uint32_t)vertices.size());
+		}
+	}
+
+	outResult->peakBytes = PeakHeapBytes - baseBytes;
+}
+
+//
+// Golden file
+//
+// Golden entries of the checks store their own counts and hashes in the same columns, e.g. "cave-shapes 64 ..."
+struct GoldenEntry {
+	char name[32];
+	uint32_t size;
+	uint32_t segmentCount;
+	uint32_t vertexCount;
+	uint64_t tracerHash;
+	uint64_t contoursHash;
+};
+
+static const uint32_t GoldenCheckCount = 2;
+static const uint32_t MaxGoldenEntryCount = FPL_ARRAYCOUNT(MapKinds) * (FPL_ARRAYCOUNT(MapSizes) + FPL_ARRAYCOUNT(CheckSizes) * GoldenCheckCount);
+
+static uint32_t LoadGoldenFile(const char *filePath, GoldenEntry *outEntries) {
+	FILE *file = fopen(filePath, "r");
+	if(file == fpl_null) {
+		return 0;
+	}
+	uint32_t result = 0;
+	GoldenEntry entry;
+	unsigned long long tracerHash, contoursHash;
+	while(result < MaxGoldenEntryCount && fscanf(file, "%31s %u %u %u %llx %llx", entry.name, &entry.size, &entry.segmentCount, &entry.vertexCount, &tracerHash, &contoursHash) == 6) {
+		entry.tracerHash = tracerHash;
+		entry.contoursHash = contoursHash;
+		outEntries[result++] = entry;
+	}
+	fclose(file);
+	return(result);
+}
+
+static bool SaveGoldenFile(const char *filePath, const GoldenEntry *entries, uint32_t entryCount) {
+	FILE *file = fopen(filePath, "w");
+	if(file == fpl_null) {
+		return false;
+	}
+	for(uint32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex) {
+		const GoldenEntry &entry = entries[entryIndex];
+		fprintf(file, "%s %u %u %u %016llx %016llx\n", entry.name, entry.size, entry.segmentCount, entry.vertexCount, (unsigned long long)entry.tracerHash, (unsigned long long)entry.contoursHash);
+	}
+	fclose(file);
+	return true;
+}
+
+static const GoldenEntry *FindGoldenEntry(const GoldenEntry *entries, uint32_t entryCount, const char *name, uint32_t size) {
+	for(uint32_t entryIndex = 0; entryIndex < entryCount; ++entryIndex) {
+		if(strcmp(entries[entryIndex].name, name) == 0 && entries[entryIndex].size == size) {
+			return &entries[entryIndex];
+		}
+	}
+	return fpl_null;
+}
+
+static const char *CompareGoldenEntry(const GoldenEntry *entries, uint32_t entryCount, const GoldenEntry &entry) {
+	const GoldenEntry *golden = FindGoldenEntry(entries, entryCount, entry.name, entry.size);
+	if(golden == fpl_null) {
+		return "missing";
+	}
+	if(golden->segmentCount != entry.segmentCount || golden->vertexCount != entry.vertexCount || golden->tracerHash != entry.tracerHash || golden->contoursHash != entry.contoursHash) {
+		return "MISMATCH";
+	}
+	return "ok";
+}
+
+//
+// Checks
+//
+static bool IsChainSegmentLess(const ftt::ChainSegment &a, const ftt::ChainSegment &b) {
+	if(a.vertices.size() != b.vertices.size()) {
+		return a.vertices.size() < b.vertices.size();
+	}
+	for(size_t vertexIndex = 0; vertexIndex < a.vertices.size(); ++vertexIndex) {
+		const ftt::Vec2i &vertexA = a.vertices[vertexIndex];
+		const ftt::Vec2i &vertexB = b.vertices[vertexIndex];
+		if(vertexA.y != vertexB.y) {
+			return vertexA.y < vertexB.y;
+		}
+		if(vertexA.x != vertexB.x) {
+			return vertexA.x < vertexB.x;
+		}
+	}
+	return false;
+}
+
+static bool IsChainSegmentsEqual(const std::vector<ftt::ChainSegment> &a, const std::vector<ftt::ChainSegment> &b) {
+	if(a.size() != b.size()) {
+		return false;
+	}
+	for(size_t segmentIndex = 0; segmentIndex < a.size(); ++segmentIndex) {
+		if(IsChainSegmentLess(a[segmentIndex], b[segmentIndex]) || IsChainSegmentLess(b[segmentIndex], a[segmentIndex])) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool CheckContourMap(uint32_t size, const uint8_t *tiles) {
+	// Applies seeded batches of clustered tile edits and compares the updated contours against a full trace of the edited map.
+	// The ids of the contour map are not in trace order, so both are compared sorted.
+	ftt::Vec2u tileCount = { size, size };
+	std::vector<uint8_t> editedTiles(tiles, tiles + size * size);
+	ftt::ContourMap contourMap = {};
+	ftt::InitContourMap(&contourMap, tileCount, editedTiles.data());
+	std::vector<ftt::ChainSegment> expected;
+	std::vector<ftt::ChainSegment> actual;
+	for(uint32_t batchIndex = 0; batchIndex < 16; ++batchIndex) {
+		uint32_t editCount = 1 + NextRandom() % 48;
+		int32_t centerX = (int32_t)(NextRandom() % size);
+		int32_t centerY = (int32_t)(NextRandom() % size);
+		for(uint32_t editIndex = 0; editIndex < editCount; ++editIndex) {
+			int32_t x = centerX + (int32_t)(NextRandom() % 9) - 4;
+			int32_t y = centerY + (int32_t)(NextRandom() % 9) - 4;
+			if(x < 0 || y < 0 || x >= (int32_t)size || y >= (int32_t)size) {
+				continue;
+			}
+			uint8_t value = (uint8_t)(NextRandom() & 1);
+			editedTiles[y * size + x] = value;
+			ftt::SetContourMapTile(&contourMap, (uint32_t)x, (uint32_t)y, value);
+		}
+		ftt::ContourChanges changes;
+		ftt::UpdateContourMap(&contourMap, &changes);
+
+		ftt::TraceContours(tileCount, editedTiles.data(), &expected);
+		actual.clear();
+		for(size_t segmentId = 0; segmentId < contourMap.chainSegments.size(); ++segmentId) {
+			if(contourMap.chainSegments[segmentId].vertices.size() > 0) {
+				actual.push_back(contourMap.chainSegments[segmentId]);
+			}
+		}
+		std::sort(expected.begin(), expected.end(), IsChainSegmentLess);
+		std::sort(actual.begin(), actual.end(), IsChainSegmentLess);
+		if(!IsChainSegmentsEqual(expected, actual)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+// Tile values of the shape maps, 0 is empty and 15 has no definition. Layer 0 is solid and layer 1 contains one-way platforms.
+static const ftt::TileDefinition ShapeDefinitions[] = {
+	{ ftt::TileShapes::Empty, 0 },
+	{ ftt::TileShapes::Block, 1 },
+	{ ftt::TileShapes::HalfBottom, 1 },
+	{ ftt::TileShapes::HalfTop, 1 },
+	{ ftt::TileShapes::HalfLeft, 1 },
+	{ ftt::TileShapes::HalfRight, 1 },
+	{ ftt::TileShapes::SlopeUpRight, 1 },
+	{ ftt::TileShapes::SlopeUpLeft, 1 },
+	{ ftt::TileShapes::CeilingDownRight, 1 },
+	{ ftt::TileShapes::CeilingDownLeft, 1 },
+	{ ftt::TileShapes::SlopeUpRightLow, 1 },
+	{ ftt::TileShapes::SlopeUpRightHigh, 1 },
+	{ ftt::TileShapes::SlopeUpLeftLow, 1 },
+	{ ftt::TileShapes::SlopeUpLeftHigh, 1 },
+	{ ftt::TileShapes::HalfTop, 2 },
+};
+static const uint32_t ShapeLayerCount = 2;
+
+static void TraceShapeMap(const char *kindName, uint32_t size, const uint8_t *tiles, GoldenEntry *outEntry) {
+	// Every solid tile gets a random tile value, so all shapes are next to each other and to the platforms
+	std::vector<uint8_t> shapeTiles(size * size);
+	for(uint32_t tileIndex = 0; tileIndex < size * size; ++tileIndex) {
+		shapeTiles[tileIndex] = tiles[tileIndex] ? (uint8_t)(1 + NextRandom() % FPL_ARRAYCOUNT(ShapeDefinitions)) : 0;
+	}
+	ftt::Vec2u tileCount = { size, size };
+	std::vector<ftt::TileLayer> layers;
+	ftt::TraceShapeLayers(tileCount, shapeTiles.data(), ShapeDefinitions, FPL_ARRAYCOUNT(ShapeDefinitions), ShapeLayerCount, &layers);
+
+	// The hash of the solid layer is stored in the tracer column and the hash of the platforms in the contours column
+	fplFormatAnsiString(outEntry->name, sizeof(outEntry->name), "%s-shapes", kindName);
+	outEntry->size = size;
+	outEntry->segmentCount = 0;
+	outEntry->vertexCount = 0;
+	uint64_t layerHashes[ShapeLayerCount];
+	for(uint32_t layerIndex = 0; layerIndex < ShapeLayerCount; ++layerIndex) {
+		const std::vector<ftt::ChainSegment> &chainSegments = layers[layerIndex].chainSegments;
+		uint32_t segmentCount = (uint32_t)chainSegments.size();
+		layerHashes[layerIndex] = HashBytes(HashSeed, &segmentCount, sizeof(segmentCount));
+		for(size_t segmentIndex = 0; segmentIndex < chainSegments.size(); ++segmentIndex) {
+			const std::vector<ftt::Vec2i> &vertices = chainSegments[segmentIndex].vertices;
+			layerHashes[layerIndex] = HashVertices(layerHashes[layerIndex], vertices.data(), (uint32_t)vertices.size());
+			outEntry->vertexCount += (uint32_t)vertices.size();
+		}
+		outEntry->segmentCount += segmentCount;
+	}
+	outEntry->tracerHash = layerHashes[0];
+	outEntry->contoursHash = layerHashes[1];
+}
+
+static int64_t ComputeDoubleArea(const ftt::Vec2i *vertices, uint32_t vertexCount) {
+	int64_t result = 0;
+	for(uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+		const ftt::Vec2i &a = vertices[vertexIndex];
+		const ftt::Vec2i &b = vertices[(vertexIndex + 1) % vertexCount];
+		result += (int64_t)a.x * b.y - (int64_t)b.x * a.y;
+	}
+	return(result < 0 ? -result : result);
+}
+
+static bool TriangulateMap(const char *kindName, uint32_t size, const uint8_t *tiles, GoldenEntry *outEntry) {
+	// The triangles and convex polygons of the traced contours are hashed, the triangle count is stored in the segment column and the polygon count in the vertex column.
+	// Returns false when the triangles or polygons do not cover exactly the solid tiles.
+	ftt::Vec2u tileCount = { size, size };
+	std::vector<ftt::ChainSegment> chainSegments;
+	ftt::TraceContours(tileCount, tiles, &chainSegments);
+	std::vector<ftt::Triangle> triangles;
+	ftt::TriangulateChainSegments(chainSegments, &triangles);
+	std::vector<ftt::ConvexPolygon> polygons;
+	ftt::DecomposeChainSegments(chainSegments, &polygons);
+
+	int64_t solidDoubleArea = 0;
+	for(uint32_t tileIndex = 0; tileIndex < size * size; ++tileIndex) {
+		solidDoubleArea += tiles[tileIndex] ? 2 : 0;
+	}
+
+	fplFormatAnsiString(outEntry->name, sizeof(outEntry->name), "%s-triangles", kindName);
+	outEntry->size = size;
+	outEntry->segmentCount = (uint32_t)triangles.size();
+	outEntry->vertexCount = (uint32_t)polygons.size();
+	outEntry->tracerHash = HashBytes(HashSeed, &outEntry->segmentCount, sizeof(outEntry->segmentCount));
+	int64_t triangleDoubleArea = 0;
+	for(size_t triangleIndex = 0; triangleIndex < triangles.size(); ++triangleIndex) {
+		outEntry->tracerHash = HashVertices(outEntry->tracerHash, triangles[triangleIndex].verts, 3);
+		triangleDoubleArea += ComputeDoubleArea(triangles[triangleIndex].verts, 3);
+	}
+	outEntry->contoursHash = HashBytes(HashSeed, &outEntry->vertexCount, sizeof(outEntry->vertexCount));
+	int64_t polygonDoubleArea = 0;
+	for(size_t polygonIndex = 0; polygonIndex < polygons.size(); ++polygonIndex) {
+		const std::vector<ftt::Vec2i> &vertices = polygons[polygonIndex].vertices;
+		outEntry->contoursHash = HashVertices(outEntry->contoursHash, vertices.data(), (uint32_t)vertices.size());
+		polygonDoubleArea += ComputeDoubleArea(vertices.data(), (uint32_t)vertices.size());
+	}
+	bool result = triangleDoubleArea == solidDoubleArea && polygonDoubleArea == solidDoubleArea;
+	return(result);
+}
+
+static bool CheckContourCache(uint32_t size, const uint8_t *tiles) {
+	// The contours must survive a cache round-trip, while other keys, truncated, extended and corrupted blobs must be rejected
+	ftt::Vec2u tileCount = { size, size };
+	std::vector<ftt::ChainSegment> expected;
+	ftt::TraceContours(tileCount, tiles, &expected);
+	ftt::ContourCacheOptions options = {};
+	uint64_t key = ftt::ComputeContourCacheKey(tileCount, tiles, options);
+	options.simplifyTolerance = 0.5f;
+	if(ftt::ComputeContourCacheKey(tileCount, tiles, options) == key) {
+		return false;
+	}
+	std::vector<uint8_t> blob;
+	ftt::WriteContourCache(key, expected, &blob);
+
+	std::vector<ftt::ChainSegment> actual;
+	if(!ftt::ReadContourCache(blob.data(), blob.size(), key, &actual) || !IsChainSegmentsEqual(expected, actual)) {
+		return false;
+	}
+	if(ftt::ReadContourCache(blob.data(), blob.size(), key ^ 1, &actual)) {
+		return false;
+	}
+	for(size_t truncatedSize = 0; truncatedSize < blob.size(); ++truncatedSize) {
+		if(ftt::ReadContourCache(blob.data(), truncatedSize, key, &actual)) {
+			return false;
+		}
+	}
+	std::vector<uint8_t> damagedBlob = blob;
+	damagedBlob.push_back(0);
+	if(ftt::ReadContourCache(damagedBlob.data(), damagedBlob.size(), key, &actual)) {
+		return false;
+	}
+
+	// The magic and seeded bits in the second half, which is always vertex data
+	for(uint32_t corruptIndex = 0; corruptIndex < 64; ++corruptIndex) {
+		size_t byteIndex = corruptIndex == 0 ? 0 : blob.size() / 2 + NextRandom() % (blob.size() - blob.size() / 2);
+		damagedBlob = blob;
+		damagedBlob[byteIndex] ^= (uint8_t)(1 << (NextRandom() % 8));
+		if(ftt::ReadContourCache(damagedBlob.data(), damagedBlob.size(), key, &actual)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+static bool CheckChunkedContours(uint32_t size, const uint8_t *tiles) {
+	// The chunked trace must be identical to the serial one in order, for every chunk size and thread count
+	static const ftt::Vec2u ChunkSizes[] = { { 64, 1 }, { 64, 64 }, { 100, 37 }, { 1024, 1024 } };
+	static const uint32_t ThreadCounts[] = { 1, 2, 3, 0 };
+	ftt::Vec2u tileCount = { size, size };
+	std::vector<ftt::ChainSegment> expected;
+	ftt::TraceContours(tileCount, tiles, &expected);
+	std::vector<ftt::ChainSegment> actual;
+	for(uint32_t chunkSizeIndex = 0; chunkSizeIndex < FPL_ARRAYCOUNT(ChunkSizes); ++chunkSizeIndex) {
+		for(uint32_t threadCountIndex = 0; threadCountIndex < FPL_ARRAYCOUNT(ThreadCounts); ++threadCountIndex) {
+			ftt::TraceContoursChunked(tileCount, tiles, ChunkSizes[chunkSizeIndex], ThreadCounts[threadCountIndex], &actual);
+			if(!IsChainSegmentsEqual(expected, actual)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+static double ToMilliseconds(const uint64_t nanoseconds) {
+	double result = (double)nanoseconds / 1000000.0;
+	return(result);
+}
+
+int main(int argc, char *args[]) {
+	const char *goldenFilePath = "ftt_benchmark_golden.txt";
+	bool updateGolden = false;
+	for(int argIndex = 1; argIndex < argc; ++argIndex) {
+		if(strcmp(args[argIndex], "-update") == 0) {
+			updateGolden = true;
+		} else {
+			goldenFilePath = args[argIndex];
+		}
+	}
+
+	if(fplPlatformInit(fplInitFlags_None, fpl_null) != fplInitResultType_Success) {
+		fplConsoleFormatError("Failed initializing the platform: %s\n", fplGetPlatformError());
+		return 1;
+	}
+
+	static GoldenEntry goldenEntries[MaxGoldenEntryCount];
+	uint32_t goldenEntryCount = 0;
+	if(!updateGolden) {
+		goldenEntryCount = LoadGoldenFile(goldenFilePath, goldenEntries);
+		if(goldenEntryCount == 0) {
+			fplConsoleFormatError("No golden entries found in '%s', run with -update to create them\n", goldenFilePath);
+		}
+	}
+
+	static GoldenEntry newEntries[MaxGoldenEntryCount];
+	uint32_t newEntryCount = 0;
+	uint32_t mismatchCount = 0;
+
+	fplConsoleFormatOut("%-12s %5s %10s %10s %10s %10s %9s %10s %9s %9s %s\n", "Map", "Size", "Init", "Trace", "Simplify", "Contours", "Segments", "Vertices", "MVerts/s", "Peak MB", "Golden");
+	for(uint32_t kindIndex = 0; kindIndex < FPL_ARRAYCOUNT(MapKinds); ++kindIndex) {
+		const MapKind &kind = MapKinds[kindIndex];
+		for(uint32_t sizeIndex = 0; sizeIndex < FPL_ARRAYCOUNT(MapSizes); ++sizeIndex) {
+			uint32_t size = MapSizes[sizeIndex];
+			uint8_t *tiles = new uint8_t[size * size];
+			RandomState = 0x9E3779B9u ^ (kindIndex * 7919u + size);
+			kind.generate(size, tiles);
+
+			MapResult result = {};
+			MeasureMap(size, tiles, &result);
+			delete[] tiles;
+
+			GoldenEntry &entry = newEntries[newEntryCount++];
+			strncpy(entry.name, kind.name, sizeof(entry.name) - 1);
+			entry.name[sizeof(entry.name) - 1] = 0;
+			entry.size = size;
+			entry.segmentCount = result.segmentCount;
+			entry.vertexCount = result.vertexCount;
+			entry.tracerHash = result.tracerHash;
+			entry.contoursHash = result.contoursHash;
+
+			const char *goldenState = "updated";
+			if(!updateGolden) {
+				const GoldenEntry *golden = FindGoldenEntry(goldenEntries, goldenEntryCount, kind.name, size);
+				if(golden == fpl_null) {
+					goldenState = "missing";
+					++mismatchCount;
+				} else if(golden->segmentCount != entry.segmentCount || golden->vertexCount != entry.vertexCount || golden->tracerHash != entry.tracerHash) {
+					goldenState = "TRACER MISMATCH";
+					++mismatchCount;
+				} else if(golden->contoursHash != entry.contoursHash) {
+					goldenState = "CONTOURS MISMATCH";
+					++mismatchCount;
+				} else {
+					goldenState = "ok";
+				}
+			}
+
+			double verticesPerSecond = result.traceTime > 0 ? (double)result.vertexCount / ((double)result.traceTime / 1000000000.0) : 0.0;
+			fplConsoleFormatOut("%-12s %5u %10.3f %10.3f %10.3f %10.3f %9u %10u %9.2f %9.2f %s\n",
+								kind.name, size,
+								ToMilliseconds(result.initTime),
+								ToMilliseconds(result.traceTime),
+								ToMilliseconds(result.simplifyTime),
+								ToMilliseconds(result.contoursTime),
+								result.segmentCount, result.vertexCount,
+								verticesPerSecond / 1000000.0,
+								(double)result.peakBytes / (1024.0 * 1024.0),
+								goldenState);
+		}
+	}
+
+	uint32_t failedCheckCount = 0;
+	uint32_t checkCount = 0;
+	fplConsoleFormatOut("\n%-12s %5s %10s %10s %10s %10s %10s\n", "Map", "Size", "ContourMap", "Chunked", "Shapes", "Triangles", "Cache");
+	for(uint32_t kindIndex = 0; kindIndex < FPL_ARRAYCOUNT(MapKinds); ++kindIndex) {
+		const MapKind &kind = MapKinds[kindIndex];
+		for(uint32_t sizeIndex = 0; sizeIndex < FPL_ARRAYCOUNT(CheckSizes); ++sizeIndex) {
+			uint32_t size = CheckSizes[sizeIndex];
+			uint8_t *tiles = new uint8_t[size * size];
+			RandomState = 0x9E3779B9u ^ (kindIndex * 7919u + size);
+			kind.generate(size, tiles);
+
+			bool contourMapPassed = CheckContourMap(size, tiles);
+			bool chunkedPassed = CheckChunkedContours(size, tiles);
+
+			GoldenEntry &shapesEntry = newEntries[newEntryCount++];
+			TraceShapeMap(kind.name, size, tiles, &shapesEntry);
+			const char *shapesState = updateGolden ? "updated" : CompareGoldenEntry(goldenEntries, goldenEntryCount, shapesEntry);
+			if(!updateGolden && strcmp(shapesState, "ok") != 0) {
+				++mismatchCount;
+			}
+
+			GoldenEntry &trianglesEntry = newEntries[newEntryCount++];
+			bool areaPassed = TriangulateMap(kind.name, size, tiles, &trianglesEntry);
+			const char *trianglesState = updateGolden ? "updated" : CompareGoldenEntry(goldenEntries, goldenEntryCount, trianglesEntry);
+			if(!updateGolden && strcmp(trianglesState, "ok") != 0) {
+				++mismatchCount;
+			}
+			if(!areaPassed) {
+				trianglesState = "AREA FAILED";
+			}
+
+			bool cachePassed = CheckContourCache(size, tiles);
+			delete[] tiles;
+
+			checkCount += 4;
+			failedCheckCount += (contourMapPassed ? 0 : 1) + (chunkedPassed ? 0 : 1) + (areaPassed ? 0 : 1) + (cachePassed ? 0 : 1);
+			fplConsoleFormatOut("%-12s %5u %10s %10s %10s %10s %10s\n", kind.name, size, contourMapPassed ? "ok" : "FAILED", chunkedPassed ? "ok" : "FAILED", shapesState, trianglesState, cachePassed ? "ok" : "FAILED");
+		}
+	}
+
+	int exitCode = 0;
+	if(failedCheckCount > 0) {
+		fplConsoleFormatError("%u of %u checks failed\n", failedCheckCount, checkCount);
+		exitCode = 1;
+	}
+	if(updateGolden) {
+		if(!SaveGoldenFile(goldenFilePath, newEntries, newEntryCount)) {
+			fplConsoleFormatError("Failed writing the golden file '%s'\n", goldenFilePath);
+			exitCode = 1;
+		}
+	} else if(mismatchCount > 0) {
+		fplConsoleFormatError("%u of %u entries do not match the golden file '%s'\n", mismatchCount, newEntryCount, goldenFilePath);
+		exitCode = 1;
+	}
+
+	fplPlatformRelease();
+	return exitCode;
+}
@@ -180,8 +180,7 @@ int main(int argc, char **args) {
 				for (int x = 0; x < TileMapCountW; ++x) {
 					uint8_t tileValue = TileMap[y * TileMapCountW + x];
 					if (tileValue) {
-						const ftt::Tile &tile = tracer.GetTile(x, y);
-						if (tile.isSolid == -1) {
+						if (!tracer.IsTileSolid(x, y)) {
 							glColor3f(0.75f, 0.775f, 0.75f);
 						} else {
 							glColor3f(0.5f, 0.5f, 0.5f);
@@ -208,18 +207,19 @@ int main(int argc, char **args) {
 			}
 
 			// Draw start
-			ftt::Tile *startTile = tracer.GetStartTile();
-			if (startTile) {
+			uint32_t startTile = tracer.GetStartTile();
+			if (startTile != ftt::INVALID_INDEX) {
+				ftt::Vec2i startTilePos = tracer.GetTilePosition(startTile);
 				glColor3f(1.0f, 0.5f, 1.0f);
-				DrawTile(startTile->x, startTile->y, true);
+				DrawTile(startTilePos.x, startTilePos.y, true);
 			}
 
 			// Draw open list
 			glColor3f(0.0f, 0.0f, 0.0f);
 			glLineWidth(2.0f);
 			for (uint32_t index = 0, count = (uint32_t)tracer.GetOpenTileCount(); index < count; ++index) {
-				ftt::Tile *openTile = tracer.GetOpenTile(index);
-				DrawTile(openTile->x, openTile->y, false);
+				ftt::Vec2i openTilePos = tracer.GetTilePosition(tracer.GetOpenTile(index));
+				DrawTile(openTilePos.x, openTilePos.y, false);
 			}
 			glLineWidth(1.0f);
 
@@ -227,10 +227,10 @@ int main(int argc, char **args) {
 			glColor3f(1.0f, 0.0f, 0.0f);
 			glLineWidth(3.0f);
 			for (uint32_t index = 0, count = (uint32_t)tracer.GetEdgeCount(); index < count; ++index) {
-				const ftt::Edge &edge = tracer.GetEdge(index);
+				ftt::Edge edge = tracer.GetEdge(index);
 				if (!edge.isInvalid) {
-					const ftt::Vec2i &v0 = tracer.GetVertex(edge.vertIndex0);
-					const ftt::Vec2i &v1 = tracer.GetVertex(edge.vertIndex1);
+					ftt::Vec2i v0 = tracer.GetVertex(edge.vertIndex0);
+					ftt::Vec2i v1 = tracer.GetVertex(edge.vertIndex1);
 					glBegin(GL_LINES);
 					glVertex2f(-halfAreaWidth + v0.x * TileSize, -halfAreaHeight + v0.y * TileSize);
 					glVertex2f(-halfAreaWidth + v1.x * TileSize, -halfAreaHeight + v1.y * TileSize);
@@ -243,10 +243,10 @@ int main(int argc, char **args) {
 			glColor3f(0.0f, 1.0f, 0.0f);
 			glLineWidth(3.0f);
 			for (uint32_t segmentIndex = 0, count = (uint32_t)tracer.GetChainSegmentCount(); segmentIndex < count; ++segmentIndex) {
-				const ftt::ChainSegment &segment = tracer.GetChainSegment(segmentIndex);
+				const ftt::ChainRange &segment = tracer.GetChainSegment(segmentIndex);
 				glBegin(GL_LINE_LOOP);
-				for (uint32_t vertexIndex = 0; vertexIndex < segment.vertices.size(); ++vertexIndex) {
-					const ftt::Vec2i &v = segment.vertices[vertexIndex];
+				for (uint32_t vertexIndex = 0; vertexIndex < segment.vertexCount; ++vertexIndex) {
+					const ftt::Vec2i &v = tracer.GetChainVertex(segment.firstVertex + vertexIndex);
 					glVertex2f(-halfAreaWidth + v.x * TileSize, -halfAreaHeight + v.y * TileSize);
 				}
 				glEnd();
@@ -254,11 +254,12 @@ int main(int argc, char **args) {
 			glLineWidth(1.0f);
 
 			// Draw current tile
-			ftt::Tile *curTile = tracer.GetCurrentTile();
-			if (curTile) {
+			uint32_t curTile = tracer.GetCurrentTile();
+			if (curTile != ftt::INVALID_INDEX) {
+				ftt::Vec2i curTilePos = tracer.GetTilePosition(curTile);
 				glColor3f(1.0f, 1.0f, 0.0f);
 				glLineWidth(2.0f);
-				DrawTile(curTile->x, curTile->y, false);
+				DrawTile(curTilePos.x, curTilePos.y, false);
 				glLineWidth(1.0f);
 			}
 
@@ -144,6 +144,49 @@ SOFTWARE.
 	- New: Added fplConditionBroadcast()
     - New: Added typedef fplTimeoutValue
     - New: Added constant FPL_TIMEOUT_INFINITE
+	- New: Added struct fplRingBuffer
+	- New: Added fplRingBufferInit()
+	- New: Added fplRingBufferRelease()
+	- New: Added fplRingBufferGetReadAvailable()
+	- New: Added fplRingBufferGetWriteAvailable()
+	- New: Added fplRingBufferBeginWrite()/fplRingBufferEndWrite()
+	- New: Added fplRingBufferBeginRead()/fplRingBufferEndRead()
+	- New: Added fplRingBufferWrite()
+	- New: Added fplRingBufferRead()
+	- New: Added enum fplAudioDeviceType and field deviceType in fplAudioSettings
+	- New: Added typedef fpl_audio_client_capture_callback and field clientCaptureCallback in fplAudioSettings
+	- New: Added fplSetAudioClientCaptureCallback()
+	- New: Added fplGetAudioXRunCounters() and struct fplAudioXRunCounters
+	- New: Added event type fplEventType_Audio and struct fplAudioEvent
+	- New: Added audio driver fplAudioDriverType_Null with optional WAV output and fplNullAudioSettings
+	- New: Added fplGetNullAudioStats() with struct fplNullAudioStats and fplAudioTimingHistogram
+	- New: Added fplGetAudioStats() with struct fplAudioStats for measuring the client callbacks
+	- New: Added fplReadAudioPeriodRecords() with struct fplAudioPeriodRecord
+	- New: Added fplGetAudioTimingAverage()
+	- New: Added fplGetTimeInNanoseconds()
+	- New: Added fplGetCycleCounter()/fplGetCycleCounterFrequency()/fplIsCycleCounterInvariant()
+	- New: Added built-in profiler (FPL_PROFILER) with FPL_PROFILE_ZONE/FPL_PROFILE_BEGIN/FPL_PROFILE_END and Chrome trace export
+	- New: Added fplSleepPrecise()
+	- New: Added fplFramePacerInit()/fplFramePacerWait() with struct fplFramePacer
+	- New: Added fplGetPlatformErrorType()/fplGetPlatformErrorTypeFromIndex() and enum fplPlatformErrorType
+	- Changed: Errors are stored per thread now and argument errors are formatted on demand only
+	- Changed: Reduced the error states from 256 to 16 entries per thread
+	- Fixed: Error state ring was reset when it was full
+	- New: Added asynchronous logging backend with per-thread binary rings and a writer thread
+	- New: Added fplLogWrite()/fplLogFlush()/fplSetLogSettings()/fplSetDefaultLogSettings()/fplGetLogDroppedCount()
+	- New: Added struct fplLogSettings, fplLogEntry and enums fplLogLevel, fplLogSinkFlags
+	- New: Added FPL_LOG_CRITICAL/FPL_LOG_ERROR/FPL_LOG_WARN/FPL_LOG_INFO/FPL_LOG_VERBOSE/FPL_LOG_DEBUG macros with compile-time stripping by FPL_LOG_MAX_LEVEL
+	- Changed: FPL_LOG writes info entries into the logging backend instead of printing into the console directly
+	- New: Added function fplGetTimeToFirstFrame()
+	- New: Added struct fplInitTimings and function fplGetInitTimings()
+	- New: Added functions fplFindChar(), fplFindCharLen(), fplFindLastChar(), fplFindSubstring() and fplFindSubstringLen()
+	- Changed: fplGetAnsiStringLength(), fplIsStringEqual() and fplIsStringEqualLen() uses SSE2 when available
+	- Changed: Path functions uses fplFindChar() and fplFindLastChar() instead of scanning every character manually
+	- Fixed: fplGetAnsiStringLength() and fplGetWideStringLength() truncated the length to 32-bit
+	- New: Added validating UTF transcoders fplUTF8ToUTF16(), fplUTF16ToUTF8(), fplUTF8ToUTF32() and fplUTF32ToUTF8()
+	- New: Added fplGetCPUInfo() for CPU features (SSE2 to AVX-512, NEON), cache sizes and core topology
+	- Changed: fplPlatformInit() initializes the audio in parallel to the window and the video on non-win32 platforms
+	- Fixed: fplPlatformInit() crashed when the audio failed to initialize and no settings was passed
 
 	- Changed: [Win32] Thread resources are automatically cleaned up when a thread is done running
 	- Changed: [POSIX] Thread resources are automatically cleaned up when a thread is done running
@@ -153,6 +196,29 @@ SOFTWARE.
 	- New: [Linux] Implemented fplGetCurrentUsername
 	- New: [Win32] Implemented all fplCondition*
 	- New: [POSIX] Implemented all fplCondition*
+	- New: [Win32] Implemented fplRingBufferInit/fplRingBufferRelease using a mirrored pagefile mapping
+	- New: [POSIX] Implemented fplRingBufferInit/fplRingBufferRelease using a mirrored memfd mapping on Linux
+	- New: [ALSA] Added support for capture devices and full-duplex mode using linked PCM devices
+	- New: [ALSA] Lost devices are reopened automatically with backoff and fallback to the default device
+	- Fixed: [POSIX] fplOpenAnsiBinaryFile/fplOpenWideBinaryFile/fplCreateAnsiBinaryFile/fplCreateWideBinaryFile was implemented with wrong names
+	- Fixed: [Win32] fplGetTimeInMillisecondsHP() had only a precision of one second
+	- Changed: [POSIX] fplGetTimeInSeconds()/fplGetTimeInMilliseconds() uses the monotonic clock instead of gettimeofday()
+	- New: [Win32] Implemented fplGetTimeInNanoseconds()
+	- New: [POSIX] Implemented fplGetTimeInNanoseconds() using CLOCK_MONOTONIC, the same clock as fplSleepPrecise()
+	- New: [Win32] Implemented fplSleepPrecise()
+	- New: [POSIX] Implemented fplSleepPrecise() using clock_nanosleep with an absolute deadline
+	- Changed: [POSIX] PThread api is loaded on its first use instead of in fplPlatformInit()
+	- Changed: [POSIX] Library file names which was loaded successfully are cached and tried first on the next load
+	- Changed: [X11] X11 api is loaded when the window is created instead of in fplPlatformInit()
+	- Fixed: [POSIX] pthread_yield is optional now, because it was removed in newer glibc versions
+	- Changed: [POSIX] Wide/UTF-8 string conversions does not use wcstombs/mbstowcs anymore and are independent of setlocale()
+	- Changed: [POSIX] Wide file functions are not limited to 1024 characters anymore
+	- Changed: [Win32] fplWideStringToUTF8String() and fplUTF8StringToWideString() validates the input and works without the C-Runtime
+	- New: [X11] Implemented fplSetWindowWideTitle()
+	- New: [Win32] Implemented fplGetCPUInfo() using GetLogicalProcessorInformation()
+	- New: [Linux] Implemented fplGetCPUInfo() using sysfs topology, caches and NUMA nodes
+	- New: [Unix] Implemented fplGetCPUInfo() with CPUID features and cache sizes only, the core topology is detected on Linux and Win32 only
+	- Fixed: [Linux] ALSA api tries to load libasound.so.2 first, because libasound.so only exists with the development package
 
 	## v0.7.5.0 beta:
 	- Changed: Updated documentations
@@ -854,7 +920,6 @@ SOFTWARE.
 //
 #if defined(FPL_NO_CRT)
 #	undef FPL_SUBPLATFORM_STD_CONSOLE
-#	undef FPL_SUBPLATFORM_STD_STRINGS
 #	if !defined(FPL_USERFUNC_vsnprintf)
 #		error "You need to provide a replacement for vsnprintf() by defining FPL_USERFUNC_vsnprintf!"
 #	endif
@@ -984,6 +1049,10 @@ SOFTWARE.
 		//! ALSA support is only available on POSIX
 #		define FPL_SUPPORT_AUDIO_ALSA
 #	endif
+#	if !defined(FPL_NO_AUDIO_NULL)
+		//! Null audio support is available on all platforms
+#		define FPL_SUPPORT_AUDIO_NULL
+#	endif
 #endif // FPL_SUPPORT_AUDIO
 
 // Remove video support when window is disabled
@@ -1033,6 +1102,10 @@ SOFTWARE.
 		//! Enable ALSA Audio
 #		define FPL_ENABLE_AUDIO_ALSA
 #	endif
+#	if defined(FPL_SUPPORT_AUDIO_NULL)
+		//! Enable Null Audio
+#		define FPL_ENABLE_AUDIO_NULL
+#	endif
 #endif // FPL_SUPPORT_AUDIO
 
 #if !defined(FPL_NO_ERROR_IN_CONSOLE)
@@ -1132,6 +1205,14 @@ SOFTWARE.
 #   define FPL_ENABLE_LOGGING
 #endif
 
+//
+// Profiler
+//
+#if defined(FPL_PROFILER)
+	//! Enable the built-in profiler
+#   define FPL_ENABLE_PROFILER
+#endif
+
 //
 // Types & Limits
 //
@@ -1610,6 +1691,84 @@ typedef enum fplArchType {
 	fplArchType_Arm64,
 } fplArchType;
 
+//! CPU feature flags
+typedef enum fplCPUFeatureFlags {
+	//! No features
+	fplCPUFeatureFlags_None = 0,
+	//! MMX
+	fplCPUFeatureFlags_MMX = 1 << 0,
+	//! SSE
+	fplCPUFeatureFlags_SSE = 1 << 1,
+	//! SSE2
+	fplCPUFeatureFlags_SSE2 = 1 << 2,
+	//! SSE3
+	fplCPUFeatureFlags_SSE3 = 1 << 3,
+	//! Supplemental SSE3
+	fplCPUFeatureFlags_SSSE3 = 1 << 4,
+	//! SSE4.1
+	fplCPUFeatureFlags_SSE4_1 = 1 << 5,
+	//! SSE4.2
+	fplCPUFeatureFlags_SSE4_2 = 1 << 6,
+	//! Population count instruction
+	fplCPUFeatureFlags_POPCNT = 1 << 7,
+	//! AES instructions
+	fplCPUFeatureFlags_AES = 1 << 8,
+	//! AVX (Supported by the CPU and enabled by the OS)
+	fplCPUFeatureFlags_AVX = 1 << 9,
+	//! Fused multiply add (FMA3)
+	fplCPUFeatureFlags_FMA3 = 1 << 10,
+	//! Half precision float conversions
+	fplCPUFeatureFlags_F16C = 1 << 11,
+	//! AVX2 (Supported by the CPU and enabled by the OS)
+	fplCPUFeatureFlags_AVX2 = 1 << 12,
+	//! Bit manipulation instructions 1
+	fplCPUFeatureFlags_BMI1 = 1 << 13,
+	//! Bit manipulation instructions 2
+	fplCPUFeatureFlags_BMI2 = 1 << 14,
+	//! AVX-512 foundation (Supported by the CPU and enabled by the OS)
+	fplCPUFeatureFlags_AVX512F = 1 << 15,
+	//! AVX-512 doubleword and quadword instructions
+	fplCPUFeatureFlags_AVX512DQ = 1 << 16,
+	//! AVX-512 conflict detection instructions
+	fplCPUFeatureFlags_AVX512CD = 1 << 17,
+	//! AVX-512 byte and word instructions
+	fplCPUFeatureFlags_AVX512BW = 1 << 18,
+	//! AVX-512 vector length extensions
+	fplCPUFeatureFlags_AVX512VL = 1 << 19,
+	//! ARM NEON (Advanced SIMD)
+	fplCPUFeatureFlags_NEON = 1 << 20,
+} fplCPUFeatureFlags;
+//! fplCPUFeatureFlags operator overloads for C++
+FPL_ENUM_AS_FLAGS_OPERATORS(fplCPUFeatureFlags);
+
+//! CPU informations, including features, caches and topology
+typedef struct fplCPUInfo {
+	//! Vendor name (GenuineIntel, AuthenticAMD, etc.)
+	char vendorName[16];
+	//! Brand name
+	char brandName[64];
+	//! Supported features
+	fplCPUFeatureFlags features;
+	//! Number of logical processors (Hardware threads)
+	uint32_t logicalCoreCount;
+	//! Number of physical cores
+	uint32_t physicalCoreCount;
+	//! Number of physical packages (Sockets)
+	uint32_t packageCount;
+	//! Number of NUMA nodes
+	uint32_t numaNodeCount;
+	//! Size of the L1 data cache per core in bytes
+	uint32_t l1DataCacheSize;
+	//! Size of the L1 instruction cache per core in bytes
+	uint32_t l1InstructionCacheSize;
+	//! Size of the L2 cache in bytes
+	uint32_t l2CacheSize;
+	//! Size of the L3 cache in bytes
+	uint32_t l3CacheSize;
+	//! Size of a cache line in bytes
+	uint32_t cacheLineSize;
+} fplCPUInfo;
+
 /**
   * \brief Returns the string representation of the given architecture type
   * \param type Architecture type
@@ -1659,6 +1818,15 @@ fpl_platform_api bool fplGetRunningMemoryInfos(fplMemoryInfos *outInfos);
   */
 fpl_platform_api fplArchType fplGetRunningArchitecture();
 
+/**
+  * \brief Retrieves the CPU features, cache sizes and the core topology.
+  * \param outInfo Pointer to a \ref fplCPUInfo structure
+  * \return Returns true when the CPU informations could be retrieved, false otherwise.
+  * \note Values which cannot be detected on the running platform are left zero, except the core, package and NUMA node counts which are at least one.
+  * \note The core topology is detected on Linux and Win32 only, other platforms report the logical cores only.
+  */
+fpl_platform_api bool fplGetCPUInfo(fplCPUInfo *outInfo);
+
 /** \}*/
 
 // ----------------------------------------------------------------------------
@@ -1799,6 +1967,8 @@ typedef enum fplAudioDriverType {
 	fplAudioDriverType_DirectSound,
 	//! ALSA
 	fplAudioDriverType_Alsa,
+	//! Null (No output device, driven by a timer, optionally writes a WAV file)
+	fplAudioDriverType_Null,
 } fplAudioDriverType;
 
 //! Audio format type
@@ -1867,11 +2037,25 @@ typedef struct fplAlsaAudioSettings {
 } fplAlsaAudioSettings;
 #endif
 
+#if defined(FPL_ENABLE_AUDIO_NULL)
+//! Null driver specific settings
+typedef struct fplNullAudioSettings {
+	//! Optional path to a WAV file, which receives all frames read from the client
+	char wavFilePath[1024];
+	//! Read periods as fast as possible instead of waiting for the period timer
+	bool isUnthrottled;
+} fplNullAudioSettings;
+#endif
+
 //! Driver specific audio settings
 typedef union fplSpecificAudioSettings {
 #if defined(FPL_ENABLE_AUDIO_ALSA)
 	//! Alsa specific settings
 	fplAlsaAudioSettings alsa;
+#endif
+#if defined(FPL_ENABLE_AUDIO_NULL)
+	//! Null driver specific settings
+	fplNullAudioSettings nullDriver;
 #endif
 	//! Dummy field (When no drivers are available)
 	int dummy;
@@ -1879,6 +2063,34 @@ typedef union fplSpecificAudioSettings {
 
 //! Audio Client Read Callback Function
 typedef uint32_t(fpl_audio_client_read_callback)(const fplAudioDeviceFormat *deviceFormat, const uint32_t frameCount, void *outputSamples, void *userData);
+//! Audio Client Capture Callback Function
+typedef void(fpl_audio_client_capture_callback)(const fplAudioDeviceFormat *deviceFormat, const uint32_t frameCount, const void *inputSamples, void *userData);
+
+//! Audio device type
+typedef enum fplAudioDeviceType {
+	//! Playback device
+	fplAudioDeviceType_Playback = 0,
+	//! Capture device (Recording)
+	fplAudioDeviceType_Capture,
+	//! Full-duplex device (Capture and playback in one thread, sharing the same clock and format)
+	fplAudioDeviceType_Duplex,
+} fplAudioDeviceType;
+
+//! Audio event type (DeviceLost, DeviceChanged)
+typedef enum fplAudioEventType {
+	//! No audio event
+	fplAudioEventType_None = 0,
+	//! Audio device was lost (Unplugged or failed repeatedly), the device is reopened automatically
+	fplAudioEventType_DeviceLost,
+	//! Audio device was reopened, this may be a fallback device with a different format (See \ref fplGetAudioHardwareFormat())
+	fplAudioEventType_DeviceChanged,
+} fplAudioEventType;
+
+//! Audio event data (Type)
+typedef struct fplAudioEvent {
+	//! Audio event type
+	fplAudioEventType type;
+} fplAudioEvent;
 
 //! Audio settings
 typedef struct fplAudioSettings {
@@ -1890,13 +2102,17 @@ typedef struct fplAudioSettings {
 	fplSpecificAudioSettings specific;
 	//! The callback for retrieving audio data from the client
 	fpl_audio_client_read_callback *clientReadCallback;
+	//! The callback for sending captured audio data to the client
+	fpl_audio_client_capture_callback *clientCaptureCallback;
+	//! The device type (Playback, Capture or Duplex)
+	fplAudioDeviceType deviceType;
 	//! The targeted driver
 	fplAudioDriverType driver;
 	//! Audio buffer in milliseconds
 	uint32_t bufferSizeInMilliSeconds;
 	//! Is exclude mode prefered
 	bool preferExclusiveMode;
-	//! User data pointer for client read callback
+	//! User data pointer for client read and capture callback
 	void *userData;
 } fplAudioSettings;
 
@@ -2015,6 +2231,22 @@ fpl_inline const char *fplGetPlatformTypeString(const fplPlatformType type) {
 	}
 }
 
+//! Time in nanoseconds the phases of \ref fplPlatformInit() has taken
+typedef struct fplInitTimings {
+	//! Total time of \ref fplPlatformInit()
+	uint64_t total;
+	//! Time for initializing the sub-platforms and the platform, including loading the system libraries
+	uint64_t platform;
+	//! Time for creating the window
+	uint64_t window;
+	//! Time for loading the video api and initializing the video driver
+	uint64_t video;
+	//! Time for initializing the audio driver
+	uint64_t audio;
+	//! Is true when the audio was initialized in parallel to the window and the video
+	bool isAudioParallel;
+} fplInitTimings;
+
 /**
   * \brief Initializes the platform layer.
   * \param initFlags Optional init flags used for enable certain features, like video/audio etc. (Default: \ref fplInitFlags_All)
@@ -2033,6 +2265,13 @@ fpl_common_api void fplPlatformRelease();
   * \return \ref fplPlatformType
   */
 fpl_common_api fplPlatformType fplGetPlatformType();
+/**
+  * \brief Retrieves the time each phase of \ref fplPlatformInit() has taken.
+  * \param outTimings The target \ref fplInitTimings structure
+  * \return Returns false when the platform is not initialized or the argument is null.
+  * \note Phases which was skipped due to the init flags, have a time of zero.
+  */
+fpl_common_api bool fplGetInitTimings(fplInitTimings *outTimings);
 
 /** \}*/
 
@@ -2044,27 +2283,57 @@ fpl_common_api fplPlatformType fplGetPlatformType();
   */
 // ----------------------------------------------------------------------------
 
+//! An enumeration of platform error types
+typedef enum fplPlatformErrorType {
+	//! No error
+	fplPlatformErrorType_None = 0,
+	//! Generic failure, the error string contains the details
+	fplPlatformErrorType_Failed,
+	//! Argument is null
+	fplPlatformErrorType_ArgumentNull,
+	//! Argument is zero
+	fplPlatformErrorType_ArgumentZero,
+	//! Argument is too small
+	fplPlatformErrorType_ArgumentTooSmall,
+	//! Argument is too big
+	fplPlatformErrorType_ArgumentTooBig,
+} fplPlatformErrorType;
+
   /**
-	* \brief Returns the last internal error string
+	* \brief Returns the last internal error string of the calling thread
 	* \note This function can be called regardless of the initialization state!
+	* \note Errors are stored per thread, the returned string is valid until the next error is pushed on this thread.
 	* \return Last error string or empty string when there was no error.
 	*/
 fpl_common_api const char *fplGetPlatformError();
 /**
-  * \brief Returns the last error string from the given index
-  * \param index The index
+  * \brief Returns the error string from the given index of the calling thread
+  * \param index The index, zero is the oldest error
   * \note This function can be called regardless of the initialization state!
-  * \return Last error string from the given index or empty when there was no error.
+  * \return Error string from the given index or empty when there was no error.
   */
 fpl_common_api const char *fplGetPlatformErrorFromIndex(const size_t index);
 /**
-  * \brief Returns the count of total last errors
+  * \brief Returns the last error type of the calling thread, without formatting any error string
+  * \note This function can be called regardless of the initialization state!
+  * \return Last error type or \ref fplPlatformErrorType_None when there was no error.
+  */
+fpl_common_api fplPlatformErrorType fplGetPlatformErrorType();
+/**
+  * \brief Returns the error type from the given index of the calling thread
+  * \param index The index, zero is the oldest error
+  * \note This function can be called regardless of the initialization state!
+  * \return Error type from the given index or \ref fplPlatformErrorType_None when there was no error.
+  */
+fpl_common_api fplPlatformErrorType fplGetPlatformErrorTypeFromIndex(const size_t index);
+/**
+  * \brief Returns the count of total last errors of the calling thread
   * \note This function can be called regardless of the initialization state!
   * \return Number of last errors or zero when there was no error.
   */
 fpl_common_api size_t fplGetPlatformErrorCount();
 /**
-  * \brief Clears all the current errors in the platform
+  * \brief Clears all the current errors of the calling thread
   * \note This function can be called regardless of the initialization state!
   */
 fpl_common_api void fplClearPlatformErrors();
@@ -2208,6 +2477,314 @@ fpl_platform_api uint64_t fplGetTimeInMillisecondsLP();
   * \note Can only be used to calculate a difference in time!
   */
 fpl_platform_api uint64_t fplGetTimeInMilliseconds();
+/**
+  * \brief Returns the current monotonic clock in nanoseconds
+  * \return Returns number of nanoseconds since some fixed starting point (OS start, System start, etc).
+  * \note Can only be used to calculate a difference in time! Unlike the floating point versions, this does not lose precision after a long uptime.
+  */
+fpl_platform_api uint64_t fplGetTimeInNanoseconds();
+/**
+  * \brief Returns the current value of the CPU cycle counter (RDTSCP/RDTSC on x86/x64)
+  * \return Returns the number of cycles since some fixed starting point.
+  * \note This is much cheaper than any clock function, but the result is only meaningful when \ref fplIsCycleCounterInvariant() returns true. On unsupported architectures this falls back to \ref fplGetTimeInNanoseconds().
+  */
+fpl_common_api uint64_t fplGetCycleCounter();
+/**
+  * \brief Returns the frequency of the CPU cycle counter in cycles per second
+  * \return Returns the number of cycles per second.
+  * \note The frequency is calibrated against \ref fplGetTimeInNanoseconds() on the first call, which blocks for a few milliseconds.
+  */
+fpl_common_api uint64_t fplGetCycleCounterFrequency();
+/**
+  * \brief Returns true when the CPU cycle counter runs at a constant rate, regardless of power states and frequency scaling.
+  * \return Returns true when the cycle counter is invariant, false otherwise.
+  */
+fpl_common_api bool fplIsCycleCounterInvariant();
+
+//! Frame pacer for running a loop at a fixed rate
+typedef struct fplFramePacer {
+	//! Target duration of one frame in nanoseconds
+	uint64_t frameDuration;
+	//! Time in nanoseconds when the next frame should start
+	uint64_t nextFrameTime;
+	//! Time in nanoseconds when the last frame has started
+	uint64_t lastFrameTime;
+	//! Actual duration of the last frame in nanoseconds
+	uint64_t lastFrameDelta;
+	//! Number of frames
+	uint64_t frameCount;
+	//! Number of frames which missed its deadline
+	uint64_t missedCount;
+} fplFramePacer;
+
+/**
+  * \brief Initializes the given frame pacer for the given rate.
+  * \param pacer Frame pacer
+  * \param framesPerSecond Target frame rate. When set to zero, the refresh rate of the display is used (Win32 only, otherwise 60 Hz).
+  */
+fpl_common_api void fplFramePacerInit(fplFramePacer *pacer, const double framesPerSecond);
+/**
+  * \brief Waits precisely until the next frame should start.
+  * \param pacer Frame pacer
+  * \return Returns true when the deadline was met, false when the frame was too late (Then the pacer restarts from the current time).
+  */
+fpl_common_api bool fplFramePacerWait(fplFramePacer *pacer);
+
+/** \}*/
+
+// ----------------------------------------------------------------------------
+/**
+  * \defgroup Profiler Profiler functions
+  * \brief Functions and macros for measuring nested zones and exporting them as Chrome trace (chrome://tracing)
+  * \note The profiler is only available when FPL_PROFILER is defined, otherwise all FPL_PROFILE_* macros expand to nothing.
+  * \{
+  */
+// ----------------------------------------------------------------------------
+
+#if defined(FPL_ENABLE_PROFILER)
+/**
+  * \brief Begins a new zone on the current thread, which is nested in the last zone not ended yet.
+  * \param name Zone name, this must be a string literal or must outlive the profiler.
+  * \note Every thread records into its own buffer without any locking. When the buffer is full, zones are dropped.
+  * \note At most 64 threads can record zones over the lifetime of the process. Each buffer holds 65536 events (1 MiB) and is kept until the process exits, even when its thread has exited, because the zones are exported later.
+  */
+fpl_common_api void fplProfilerBeginZone(const char *name);
+/**
+  * \brief Ends the last zone started on the current thread.
+  */
+fpl_common_api void fplProfilerEndZone();
+/**
+  * \brief Writes all recorded zones from all threads into a Chrome trace_event JSON file.
+  * \param filePath Ansi path to the JSON file.
+  * \return Returns true when the file was written, false otherwise.
+  */
+fpl_common_api bool fplProfilerWriteChromeTrace(const char *filePath);
+/**
+  * \brief Sets the path for the Chrome trace file, which is written automatically in \ref fplPlatformRelease().
+  * \param filePath Ansi path to the JSON file or \ref fpl_null to disable it.
+  */
+fpl_common_api void fplProfilerSetTraceFilePath(const char *filePath);
+/**
+  * \brief Removes all recorded zones.
+  * \note Must not be called while any other thread is inside a zone.
+  */
+fpl_common_api void fplProfilerReset();
+
+//! Begins a named profiler zone on the current thread
+#	define FPL_PROFILE_BEGIN(name) fplProfilerBeginZone(name)
+//! Ends the last profiler zone on the current thread
+#	define FPL_PROFILE_END() fplProfilerEndZone()
+
+#	if defined(FPL_IS_CPP)
+//! Profiler zone which ends automatically when it goes out of scope
+struct fplProfilerScopedZone {
+	fplProfilerScopedZone(const char *name) {
+		fplProfilerBeginZone(name);
+	}
+	~fplProfilerScopedZone() {
+		fplProfilerEndZone();
+	}
+};
+#		define FPL__PROFILE_ZONE_NAME2(line) fpl__profileZone##line
+#		define FPL__PROFILE_ZONE_NAME(line) FPL__PROFILE_ZONE_NAME2(line)
+//! Profiler zone for the current scope (C++ only, use FPL_PROFILE_BEGIN/FPL_PROFILE_END in C)
+#		define FPL_PROFILE_ZONE(name) fplProfilerScopedZone FPL__PROFILE_ZONE_NAME(__LINE__)(name)
+#	endif
+#else
+//! Begins a named profiler zone on the current thread
+#	define FPL_PROFILE_BEGIN(name)
+//! Ends the last profiler zone on the current thread
+#	define FPL_PROFILE_END()
+//! Profiler zone for the current scope (C++ only, use FPL_PROFILE_BEGIN/FPL_PROFILE_END in C)
+#	define FPL_PROFILE_ZONE(name)
+#endif // FPL_ENABLE_PROFILER
+
+/** \}*/
+
+// ----------------------------------------------------------------------------
+/**
+  * \defgroup Logging Logging functions
+  * \brief Functions and macros for asynchronous logging into the console, a file or a custom callback
+  * \note Logging is only available when FPL_LOGGING is defined, otherwise all FPL_LOG_* macros expand to nothing.
+  * \{
+  */
+// ----------------------------------------------------------------------------
+
+//! Critical log level value, used for \ref FPL_LOG_MAX_LEVEL
+#define FPL_LOG_LEVEL_CRITICAL 0
+//! Error log level value, used for \ref FPL_LOG_MAX_LEVEL
+#define FPL_LOG_LEVEL_ERROR 1
+//! Warning log level value, used for \ref FPL_LOG_MAX_LEVEL
+#define FPL_LOG_LEVEL_WARNING 2
+//! Info log level value, used for \ref FPL_LOG_MAX_LEVEL
+#define FPL_LOG_LEVEL_INFO 3
+//! Verbose log level value, used for \ref FPL_LOG_MAX_LEVEL
+#define FPL_LOG_LEVEL_VERBOSE 4
+//! Debug log level value, used for \ref FPL_LOG_MAX_LEVEL
+#define FPL_LOG_LEVEL_DEBUG 5
+
+#if !defined(FPL_LOG_MAX_LEVEL)
+	//! Maximum log level which is compiled in, all log macros above this level expands to nothing
+#	define FPL_LOG_MAX_LEVEL FPL_LOG_LEVEL_DEBUG
+#endif
+
+//! An enumeration of log levels
+typedef enum fplLogLevel {
+	//! Critical
+	fplLogLevel_Critical = FPL_LOG_LEVEL_CRITICAL,
+	//! Error
+	fplLogLevel_Error = FPL_LOG_LEVEL_ERROR,
+	//! Warning
+	fplLogLevel_Warning = FPL_LOG_LEVEL_WARNING,
+	//! Info
+	fplLogLevel_Info = FPL_LOG_LEVEL_INFO,
+	//! Verbose
+	fplLogLevel_Verbose = FPL_LOG_LEVEL_VERBOSE,
+	//! Debug
+	fplLogLevel_Debug = FPL_LOG_LEVEL_DEBUG,
+} fplLogLevel;
+
+//! Returns the string representation of a \ref fplLogLevel
+fpl_inline const char *fplGetLogLevelString(const fplLogLevel level) {
+	switch(level) {
+		case fplLogLevel_Critical:
+			return "Critical";
+		case fplLogLevel_Error:
+			return "Error";
+		case fplLogLevel_Warning:
+			return "Warning";
+		case fplLogLevel_Info:
+			return "Info";
+		case fplLogLevel_Verbose:
+			return "Verbose";
+		case fplLogLevel_Debug:
+			return "Debug";
+		default:
+			return "";
+	}
+}
+
+//! An enumeration of log sink flags
+typedef enum fplLogSinkFlags {
+	//! No sinks
+	fplLogSinkFlags_None = 0,
+	//! Standard console (Errors and criticals goes into the error console)
+	fplLogSinkFlags_Console = 1 << 0,
+	//! File, see \ref fplLogSettings.filePath
+	fplLogSinkFlags_File = 1 << 1,
+	//! User callback, see \ref fplLogSettings.callback
+	fplLogSinkFlags_Custom = 1 << 2,
+} fplLogSinkFlags;
+//! fplLogSinkFlags operator overloads for C++
+FPL_ENUM_AS_FLAGS_OPERATORS(fplLogSinkFlags);
+
+//! A stored log entry, passed to the custom log sink
+typedef struct fplLogEntry {
+	//! Time in nanoseconds (See \ref fplGetTimeInNanoseconds()) or zero when the platform was not initialized yet
+	uint64_t time;
+	//! Category name
+	const char *category;
+	//! Formatted message
+	const char *message;
+	//! Log level
+	fplLogLevel level;
+	//! Index of the thread which has written the entry, starting at one (Zero when the thread has no own log ring). Indices of exited threads are reused.
+	uint32_t threadIndex;
+} fplLogEntry;
+
+//! Custom log sink callback, called from the log writer thread
+typedef void (fpl_log_sink_callback)(const fplLogEntry *entry, void *userData);
+
+//! Log settings
+typedef struct fplLogSettings {
+	//! Active sinks
+	fplLogSinkFlags sinks;
+	//! Maximum log level which is written at runtime
+	fplLogLevel maxLevel;
+	//! Ansi path to the log file, used for \ref fplLogSinkFlags_File (The file is recreated by \ref fplSetLogSettings())
+	char filePath[1024];
+	//! Callback, used for \ref fplLogSinkFlags_Custom
+	fpl_log_sink_callback *callback;
+	//! User data passed to the callback
+	void *userData;
+} fplLogSettings;
+
+#if defined(FPL_ENABLE_LOGGING)
+/**
+  * \brief Resets the given log settings to the defaults (Console sink, all levels)
+  * \param settings Pointer to the log settings
+  */
+fpl_common_api void fplSetDefaultLogSettings(fplLogSettings *settings);
+/**
+  * \brief Changes the log settings, all pending entries are written with the old settings first.
+  * \param settings Pointer to the log settings
+  * \note This function can be called regardless of the initialization state!
+  */
+fpl_common_api void fplSetLogSettings(const fplLogSettings *settings);
+/**
+  * \brief Writes a log entry.
+  * \param level Log level
+  * \param category Category name, this must be a string literal or must outlive the logging.
+  * \param format Format string, this must be a string literal or must outlive the logging.
+  * \param ... The arguments for the format string
+  * \note The arguments are stored binary into a ring of the calling thread without any locking and formatted on the log writer thread later.
+  * When the ring is full, the entry is dropped. Before \ref fplPlatformInit() and after \ref fplPlatformRelease() the entry is written immediately.
+  */
+fpl_common_api void fplLogWrite(const fplLogLevel level, const char *category, const char *format, ...);
+/**
+  * \brief Writes all pending log entries from all threads, in the order of their timestamps.
+  */
+fpl_common_api void fplLogFlush();
+/**
+  * \brief Returns the number of log entries which were dropped, because the ring of the writing thread was full.
+  * \return Number of dropped log entries
+  */
+fpl_common_api uint32_t fplGetLogDroppedCount();
+
+#	if FPL_LOG_MAX_LEVEL >= FPL_LOG_LEVEL_CRITICAL
+//! Writes a critical log entry
+#		define FPL_LOG_CRITICAL(what, format, ...) fplLogWrite(fplLogLevel_Critical, what, format, ## __VA_ARGS__)
+#	endif
+#	if FPL_LOG_MAX_LEVEL >= FPL_LOG_LEVEL_ERROR
+//! Writes a error log entry
+#		define FPL_LOG_ERROR(what, format, ...) fplLogWrite(fplLogLevel_Error, what, format, ## __VA_ARGS__)
+#	endif
+#	if FPL_LOG_MAX_LEVEL >= FPL_LOG_LEVEL_WARNING
+//! Writes a warning log entry
+#		define FPL_LOG_WARN(what, format, ...) fplLogWrite(fplLogLevel_Warning, what, format, ## __VA_ARGS__)
+#	endif
+#	if FPL_LOG_MAX_LEVEL >= FPL_LOG_LEVEL_INFO
+//! Writes a info log entry
+#		define FPL_LOG_INFO(what, format, ...) fplLogWrite(fplLogLevel_Info, what, format, ## __VA_ARGS__)
+#	endif
+#	if FPL_LOG_MAX_LEVEL >= FPL_LOG_LEVEL_VERBOSE
+//! Writes a verbose log entry
+#		define FPL_LOG_VERBOSE(what, format, ...) fplLogWrite(fplLogLevel_Verbose, what, format, ## __VA_ARGS__)
+#	endif
+#	if FPL_LOG_MAX_LEVEL >= FPL_LOG_LEVEL_DEBUG
+//! Writes a debug log entry
+#		define FPL_LOG_DEBUG(what, format, ...) fplLogWrite(fplLogLevel_Debug, what, format, ## __VA_ARGS__)
+#	endif
+#endif // FPL_ENABLE_LOGGING
+
+#if !defined(FPL_LOG_CRITICAL)
+#	define FPL_LOG_CRITICAL(what, format, ...)
+#endif
+#if !defined(FPL_LOG_ERROR)
+#	define FPL_LOG_ERROR(what, format, ...)
+#endif
+#if !defined(FPL_LOG_WARN)
+#	define FPL_LOG_WARN(what, format, ...)
+#endif
+#if !defined(FPL_LOG_INFO)
+#	define FPL_LOG_INFO(what, format, ...)
+#endif
+#if !defined(FPL_LOG_VERBOSE)
+#	define FPL_LOG_VERBOSE(what, format, ...)
+#endif
+#if !defined(FPL_LOG_DEBUG)
+#	define FPL_LOG_DEBUG(what, format, ...)
+#endif
 
 /** \}*/
 
@@ -2364,6 +2941,12 @@ fpl_platform_api fplThreadHandle *fplThreadCreate(fpl_run_thread_function *runFu
   * \note There is no guarantee that the OS sleeps for the exact amount of milliseconds! This can vary based on the OS scheduler granularity.
   */
 fpl_platform_api void fplThreadSleep(const uint32_t milliseconds);
+/**
+  * \brief Let the current thread sleep for the given amount of nanoseconds with high precision.
+  * \param nanoseconds Number of nanoseconds to sleep
+  * \note The OS is asked to wake up shortly before the deadline, the remaining time is spent in a busy loop. This costs some CPU time, but does not overshoot by a scheduler quantum like \ref fplThreadSleep().
+  */
+fpl_platform_api void fplSleepPrecise(const uint64_t nanoseconds);
 /**
   * \brief Forced the given thread to stop and release all underlying resources.
   * \param thread Thread handle
@@ -2565,6 +3148,123 @@ fpl_common_api void fplMemoryAlignedFree(void *ptr);
 
 /** \}*/
 
+// ----------------------------------------------------------------------------
+/**
+  * \defgroup RingBuffer Ring buffer
+  * \brief Lock-free single producer/single consumer ring buffer, for streaming audio samples or any other data between two threads
+  * \{
+  */
+// ----------------------------------------------------------------------------
+
+//! Internal ring buffer handle union
+typedef union fplInternalRingBufferHandle {
+#if defined(FPL_PLATFORM_WIN32)
+	//! Win32 file mapping handle
+	HANDLE win32MappingHandle;
+#elif defined(FPL_SUBPLATFORM_POSIX)
+	//! Posix dummy field
+	int posixDummy;
+#endif
+} fplInternalRingBufferHandle;
+
+//! Single producer/single consumer ring buffer
+typedef struct fplRingBuffer {
+	//! The internal handle
+	fplInternalRingBufferHandle internalHandle;
+	//! Pointer to the first byte (When mirrored, the same memory is mapped twice in a row)
+	uint8_t *data;
+	//! Capacity in bytes (Always a power of two)
+	size_t capacity;
+	//! Mask for wrapping a position into the capacity
+	size_t mask;
+	//! Is the memory mapped twice in a row, so that reads and writes never wrap
+	bool isMirrored;
+	//! Padding to keep the write index on its own cache line
+	uint8_t padding0[64];
+	//! Total number of bytes written, changed by the producer only
+	volatile uint64_t writeIndex;
+	//! Padding to keep the read index on its own cache line
+	uint8_t padding1[64 - sizeof(uint64_t)];
+	//! Total number of bytes read, changed by the consumer only
+	volatile uint64_t readIndex;
+	//! Padding to keep the read index on its own cache line
+	uint8_t padding2[64 - sizeof(uint64_t)];
+} fplRingBuffer;
+
+/**
+  * \brief Initializes the given ring buffer with at least the given capacity.
+  * \param ringBuffer Pointer to the ring buffer structure.
+  * \param minCapacity Minimum capacity in bytes.
+  * \note The capacity is rounded up to the next power of two, but is never less than the page size (Allocation granularity on Win32).
+  * \note The memory is mapped twice in a row when the platform supports it, otherwise it falls back to a single allocation.
+  * \return Returns true when the ring buffer was initialized or false otherwise.
+  */
+fpl_platform_api bool fplRingBufferInit(fplRingBuffer *ringBuffer, const size_t minCapacity);
+/**
+  * \brief Releases the memory of the given ring buffer.
+  * \param ringBuffer Pointer to the ring buffer structure.
+  * \warning Neither the producer nor the consumer may access the ring buffer anymore!
+  */
+fpl_platform_api void fplRingBufferRelease(fplRingBuffer *ringBuffer);
+/**
+  * \brief Returns the number of bytes which can be read by the consumer.
+  * \param ringBuffer Pointer to the ring buffer structure.
+  * \return Number of bytes available for reading.
+  */
+fpl_common_api size_t fplRingBufferGetReadAvailable(fplRingBuffer *ringBuffer);
+/**
+  * \brief Returns the number of bytes which can be written by the producer.
+  * \param ringBuffer Pointer to the ring buffer structure.
+  * \return Number of bytes available for writing.
+  */
+fpl_common_api size_t fplRingBufferGetWriteAvailable(fplRingBuffer *ringBuffer);
+/**
+  * \brief Returns a pointer to the contiguous writable region of the ring buffer. Producer only.
+  * \param ringBuffer Pointer to the ring buffer structure.
+  * \param outSize Pointer to the resulting number of bytes which can be written directly.
+  * \note When the ring buffer is not mirrored, the region may be smaller than \ref fplRingBufferGetWriteAvailable() returns.
+  * \return Pointer to the first writable byte or fpl_null when the ring buffer is full.
+  */
+fpl_common_api uint8_t *fplRingBufferBeginWrite(fplRingBuffer *ringBuffer, size_t *outSize);
+/**
+  * \brief Publishes the given number of bytes written into the region from \ref fplRingBufferBeginWrite() to the consumer. Producer only.
+  * \param ringBuffer Pointer to the ring buffer structure.
+  * \param size Number of bytes written.
+  */
+fpl_common_api void fplRingBufferEndWrite(fplRingBuffer *ringBuffer, const size_t size);
+/**
+  * \brief Returns a pointer to the contiguous readable region of the ring buffer. Consumer only.
+  * \param ringBuffer Pointer to the ring buffer structure.
+  * \param outSize Pointer to the resulting number of bytes which can be read directly.
+  * \note When the ring buffer is not mirrored, the region may be smaller than \ref fplRingBufferGetReadAvailable() returns.
+  * \return Pointer to the first readable byte or fpl_null when the ring buffer is empty.
+  */
+fpl_common_api const uint8_t *fplRingBufferBeginRead(fplRingBuffer *ringBuffer, size_t *outSize);
+/**
+  * \brief Releases the given number of bytes read from the region from \ref fplRingBufferBeginRead() back to the producer. Consumer only.
+  * \param ringBuffer Pointer to the ring buffer structure.
+  * \param size Number of bytes read.
+  */
+fpl_common_api void fplRingBufferEndRead(fplRingBuffer *ringBuffer, const size_t size);
+/**
+  * \brief Copies up to the given number of bytes into the ring buffer. Producer only.
+  * \param ringBuffer Pointer to the ring buffer structure.
+  * \param sourceMem Pointer to the source memory to copy from.
+  * \param sourceSize Number of bytes to write.
+  * \return Number of bytes actually written, which is less than sourceSize when the ring buffer is full.
+  */
+fpl_common_api size_t fplRingBufferWrite(fplRingBuffer *ringBuffer, const void *sourceMem, const size_t sourceSize);
+/**
+  * \brief Copies up to the given number of bytes out of the ring buffer. Consumer only.
+  * \param ringBuffer Pointer to the ring buffer structure.
+  * \param targetMem Pointer to the target memory to copy to.
+  * \param targetSize Number of bytes to read.
+  * \return Number of bytes actually read, which is less than targetSize when the ring buffer is empty.
+  */
+fpl_common_api size_t fplRingBufferRead(fplRingBuffer *ringBuffer, void *targetMem, const size_t targetSize);
+
+/** \}*/
+
 // ----------------------------------------------------------------------------
 /**
   * \defgroup Strings String manipulation functions
@@ -2604,6 +3304,45 @@ fpl_common_api size_t fplGetAnsiStringLength(const char *str);
   * \return Returns the character length or zero when the input string is fpl_null.
   */
 fpl_common_api size_t fplGetWideStringLength(const wchar_t *str);
+/**
+  * \brief Returns the first occurrence of the given character in the given 8-bit ansi string.
+  * \param str The 8-bit ansi string
+  * \param ch The character to search for
+  * \return Returns the pointer to the first occurrence or fpl_null when the character was not found.
+  */
+fpl_common_api const char *fplFindChar(const char *str, const char ch);
+/**
+  * \brief Returns the first occurrence of the given character in the given 8-bit ansi string with enforcing the given length.
+  * \param str The 8-bit ansi string
+  * \param len Number of characters to search
+  * \param ch The character to search for
+  * \note Null characters are not treated as terminator!
+  * \return Returns the pointer to the first occurrence or fpl_null when the character was not found.
+  */
+fpl_common_api const char *fplFindCharLen(const char *str, const size_t len, const char ch);
+/**
+  * \brief Returns the last occurrence of the given character in the given 8-bit ansi string.
+  * \param str The 8-bit ansi string
+  * \param ch The character to search for
+  * \return Returns the pointer to the last occurrence or fpl_null when the character was not found.
+  */
+fpl_common_api const char *fplFindLastChar(const char *str, const char ch);
+/**
+  * \brief Returns the first occurrence of the given sub string in the given 8-bit ansi string.
+  * \param str The 8-bit ansi string
+  * \param subStr The 8-bit ansi string to search for
+  * \return Returns the pointer to the first occurrence or fpl_null when the sub string was not found. An empty sub string is always found at the start.
+  */
+fpl_common_api const char *fplFindSubstring(const char *str, const char *subStr);
+/**
+  * \brief Returns the first occurrence of the given sub string in the given 8-bit ansi string with enforcing the given lengths.
+  * \param str The 8-bit ansi string
+  * \param len Number of characters of the string
+  * \param subStr The 8-bit ansi string to search for
+  * \param subLen Number of characters of the sub string
+  * \return Returns the pointer to the first occurrence or fpl_null when the sub string was not found. An empty sub string is always found at the start.
+  */
+fpl_common_api const char *fplFindSubstringLen(const char *str, const size_t len, const char *subStr, const size_t subLen);
 /**
   * \brief Copies the given 8-bit source ansi string with a fixed length into a destination ansi string.
   * \param source The 8-bit source ansi string.
@@ -2682,6 +3421,46 @@ fpl_platform_api wchar_t *fplAnsiStringToWideString(const char *ansiSource, cons
   * \return Returns the pointer to the first character in the destination buffer or fpl_null when either the dest buffer is too small or the source string is invalid.
   */
 fpl_platform_api wchar_t *fplUTF8StringToWideString(const char *utf8Source, const size_t utf8SourceLen, wchar_t *wideDest, const size_t maxWideDestLen);
+/**
+  * \brief Converts the given UTF-8 string with length into a UTF-16 string.
+  * \param utf8Source The UTF-8 source string.
+  * \param utf8SourceLen The number of bytes of the source string.
+  * \param utf16Dest The UTF-16 destination buffer or fpl_null to compute the required length only.
+  * \param maxUtf16DestLen The total number of code units available in the destination buffer.
+  * \note The source is validated, overlong sequences, surrogates and code points above U+10FFFF are rejected. Null terminator is included always. Does not allocate any memory and does not depend on the C-Runtime.
+  * \return Returns the number of code units without the null terminator or zero when the source is empty or invalid or the destination buffer is too small.
+  */
+fpl_common_api size_t fplUTF8ToUTF16(const char *utf8Source, const size_t utf8SourceLen, uint16_t *utf16Dest, const size_t maxUtf16DestLen);
+/**
+  * \brief Converts the given UTF-16 string with length into a UTF-8 string.
+  * \param utf16Source The UTF-16 source string.
+  * \param utf16SourceLen The number of code units of the source string.
+  * \param utf8Dest The UTF-8 destination buffer or fpl_null to compute the required length only.
+  * \param maxUtf8DestLen The total number of bytes available in the destination buffer.
+  * \note The source is validated, unpaired surrogates are rejected. Null terminator is included always. Does not allocate any memory and does not depend on the C-Runtime.
+  * \return Returns the number of bytes without the null terminator or zero when the source is empty or invalid or the destination buffer is too small.
+  */
+fpl_common_api size_t fplUTF16ToUTF8(const uint16_t *utf16Source, const size_t utf16SourceLen, char *utf8Dest, const size_t maxUtf8DestLen);
+/**
+  * \brief Converts the given UTF-8 string with length into a UTF-32 string.
+  * \param utf8Source The UTF-8 source string.
+  * \param utf8SourceLen The number of bytes of the source string.
+  * \param utf32Dest The UTF-32 destination buffer or fpl_null to compute the required length only.
+  * \param maxUtf32DestLen The total number of code points available in the destination buffer.
+  * \note The source is validated, overlong sequences, surrogates and code points above U+10FFFF are rejected. Null terminator is included always. Does not allocate any memory and does not depend on the C-Runtime.
+  * \return Returns the number of code points without the null terminator or zero when the source is empty or invalid or the destination buffer is too small.
+  */
+fpl_common_api size_t fplUTF8ToUTF32(const char *utf8Source, const size_t utf8SourceLen, uint32_t *utf32Dest, const size_t maxUtf32DestLen);
+/**
+  * \brief Converts the given UTF-32 string with length into a UTF-8 string.
+  * \param utf32Source The UTF-32 source string.
+  * \param utf32SourceLen The number of code points of the source string.
+  * \param utf8Dest The UTF-8 destination buffer or fpl_null to compute the required length only.
+  * \param maxUtf8DestLen The total number of bytes available in the destination buffer.
+  * \note The source is validated, surrogates and code points above U+10FFFF are rejected. Null terminator is included always. Does not allocate any memory and does not depend on the C-Runtime.
+  * \return Returns the number of bytes without the null terminator or zero when the source is empty or invalid or the destination buffer is too small.
+  */
+fpl_common_api size_t fplUTF32ToUTF8(const uint32_t *utf32Source, const size_t utf32SourceLen, char *utf8Dest, const size_t maxUtf8DestLen);
 /**
   * \brief Fills out the given destination ansi string buffer with a formatted string, using the format specifier and variable arguments.
   * \param ansiDestBuffer The 8-bit destination ansi string buffer.
@@ -3381,6 +4160,8 @@ typedef enum fplEventType {
 	fplEventType_Mouse,
 	//! Gamepad event
 	fplEventType_Gamepad,
+	//! Audio event
+	fplEventType_Audio,
 } fplEventType;
 
 //! Event data (Type, Window, Keyboard, Mouse, etc.)
@@ -3396,6 +4177,8 @@ typedef struct fplEvent {
 		fplMouseEvent mouse;
 		//! Gamepad event data
 		fplGamepadEvent gamepad;
+		//! Audio event data
+		fplAudioEvent audio;
 	};
 } fplEvent;
 
@@ -3674,6 +4457,12 @@ fpl_common_api fplVideoDriverType fplGetVideoDriver();
   */
 fpl_common_api void fplVideoFlip();
 
+/**
+  * \brief Returns the time in nanoseconds from the start of \ref fplPlatformInit() to the first \ref fplVideoFlip() call.
+  * \return The time to the first frame in nanoseconds or zero when no frame was presented yet.
+  */
+fpl_common_api uint64_t fplGetTimeToFirstFrame();
+
 /** \}*/
 #endif // FPL_ENABLE_VIDEO
 
@@ -3699,6 +4488,83 @@ typedef enum fplAudioResult {
 	fplAudioResult_Failed,
 } fplAudioResult;
 
+//! Audio xrun and recovery counters
+typedef struct fplAudioXRunCounters {
+	//! Number of playback buffer underruns
+	uint32_t underrunCount;
+	//! Number of capture buffer overruns
+	uint32_t overrunCount;
+	//! Number of times the audio device was lost
+	uint32_t deviceLostCount;
+	//! Number of times the audio device was reopened successfully
+	uint32_t reopenCount;
+} fplAudioXRunCounters;
+
+//! Number of buckets in a \ref fplAudioTimingHistogram
+#define FPL_AUDIO_TIMING_BUCKET_COUNT 24
+
+//! Audio timing histogram, bucket N counts durations in the range of [2^N, 2^(N+1)) microseconds
+typedef struct fplAudioTimingHistogram {
+	//! Number of samples per bucket, the first bucket also counts durations below one microsecond and the last bucket counts everything above
+	uint64_t buckets[FPL_AUDIO_TIMING_BUCKET_COUNT];
+	//! Total number of samples
+	uint64_t sampleCount;
+	//! Smallest duration in microseconds
+	uint64_t minMicroseconds;
+	//! Largest duration in microseconds
+	uint64_t maxMicroseconds;
+	//! Sum of all durations in microseconds
+	uint64_t totalMicroseconds;
+} fplAudioTimingHistogram;
+
+//! Audio period record, written for every client callback
+typedef struct fplAudioPeriodRecord {
+	//! Start time of the client callback in milliseconds (See \ref fplGetTimeInMillisecondsHP())
+	double startTime;
+	//! Time spent in the client callback in microseconds
+	uint32_t durationInMicroseconds;
+	//! Number of frames the device requested
+	uint32_t framesRequested;
+	//! Number of frames the client delivered
+	uint32_t framesDelivered;
+	//! Number of frames queued in the device before this period (Device delay)
+	uint32_t deviceDelayInFrames;
+} fplAudioPeriodRecord;
+
+//! Audio statistics since the audio system was initialized
+typedef struct fplAudioStats {
+	//! Time spent in the client callbacks
+	fplAudioTimingHistogram callbackDuration;
+	//! Difference between the actual and the expected time between two client callbacks
+	fplAudioTimingHistogram callbackJitter;
+	//! Xrun and recovery counters
+	fplAudioXRunCounters xruns;
+	//! Number of client callbacks
+	uint64_t periodCount;
+	//! Total number of frames the device requested
+	uint64_t framesRequested;
+	//! Total number of frames the client delivered
+	uint64_t framesDelivered;
+	//! Number of period records which was dropped, because nobody read them in time
+	uint32_t droppedRecordCount;
+} fplAudioStats;
+
+#if defined(FPL_ENABLE_AUDIO_NULL)
+//! Null audio driver statistics
+typedef struct fplNullAudioStats {
+	//! Time the period timer fired too late, always empty in unthrottled mode
+	fplAudioTimingHistogram periodLateness;
+	//! Number of periods processed
+	uint64_t periodCount;
+	//! Number of frames read from the client
+	uint64_t framesRead;
+	//! Number of bytes written to the WAV file
+	uint64_t wavBytesWritten;
+	//! Number of times the client was too slow to keep up with the period timer
+	uint32_t underrunCount;
+} fplNullAudioStats;
+#endif
+
 /**
   * \brief Start playing asyncronous audio.
   * \return Audio result code.
@@ -3721,6 +4587,40 @@ fpl_common_api fplAudioDeviceFormat fplGetAudioHardwareFormat();
   * \note This has no effect when audio is already playing, you have to call it when audio is in a stopped state!
   */
 fpl_common_api void fplSetAudioClientReadCallback(fpl_audio_client_read_callback *newCallback, void *userData);
+/**
+  * \brief Overwrites the audio client capture callback.
+  * \param newCallback Pointer to the client capture callback.
+  * \param userData Pointer to the client/user data.
+  * \note This has no effect when audio is already playing, you have to call it when audio is in a stopped state!
+  */
+fpl_common_api void fplSetAudioClientCaptureCallback(fpl_audio_client_capture_callback *newCallback, void *userData);
+/**
+  * \brief Returns the xrun and recovery counters since the audio system was initialized.
+  * \return Copy of the audio xrun counters.
+  */
+fpl_common_api fplAudioXRunCounters fplGetAudioXRunCounters();
+/**
+  * \brief Gets the client callback timing statistics and xrun counters.
+  * \param outStats Target statistics.
+  * \return Returns true when the audio system is initialized, false otherwise.
+  */
+fpl_common_api bool fplGetAudioStats(fplAudioStats *outStats);
+/**
+  * \brief Reads and removes the oldest period records, which was written by the audio thread.
+  * \param outRecords Target record array.
+  * \param maxRecordCount Total number of records available in the target array.
+  * \return Number of records read.
+  * \note Only one thread at a time may read the records. When the records are not read in time, new records are dropped.
+  */
+fpl_common_api uint32_t fplReadAudioPeriodRecords(fplAudioPeriodRecord *outRecords, const uint32_t maxRecordCount);
+#if defined(FPL_ENABLE_AUDIO_NULL)
+/**
+  * \brief Gets the timing statistics from the null audio driver.
+  * \param outStats Target statistics.
+  * \return Returns true when the null audio driver is active, false otherwise.
+  */
+fpl_common_api bool fplGetNullAudioStats(fplNullAudioStats *outStats);
+#endif
 /**
   * \brief Gets all playback audio devices.
   * \param devices Target device id array.
@@ -3729,6 +4629,19 @@ fpl_common_api void fplSetAudioClientReadCallback(fpl_audio_client_read_callback
   */
 fpl_common_api uint32_t fplGetAudioDevices(fplAudioDeviceInfo *devices, uint32_t maxDeviceCount);
 
+/**
+  * \brief Returns the average duration in microseconds from the given timing histogram
+  * \param histogram The timing histogram
+  * \return Average duration in microseconds or zero when the histogram is empty
+  */
+fpl_inline double fplGetAudioTimingAverage(const fplAudioTimingHistogram *histogram) {
+	double result = 0.0;
+	if(histogram->sampleCount > 0) {
+		result = (double)histogram->totalMicroseconds / (double)histogram->sampleCount;
+	}
+	return(result);
+}
+
 /**
   * \brief Returns the number of bytes required to write one sample with one channel
   * \param format The audio format
@@ -3790,6 +4703,10 @@ fpl_inline const char *fplGetAudioDriverString(fplAudioDriverType driver) {
 			return "Auto";
 		case fplAudioDriverType_DirectSound:
 			return "DirectSound";
+		case fplAudioDriverType_Alsa:
+			return "ALSA";
+		case fplAudioDriverType_Null:
+			return "Null";
 		case fplAudioDriverType_None:
 			return "None";
 		default:
@@ -3898,18 +4815,15 @@ fpl_inline uint32_t fplGetAudioBufferSizeInBytes(const fplAudioFormatType format
 // Only include C-Runtime functions when CRT is enabled
 #if !defined(FPL_NO_CRT)
 #	include <stdio.h> // stdin, stdout, stderr, fprintf, vfprintf, vsnprintf, getchar
-#	include <stdlib.h> // wcstombs, mbstowcs, getenv
+#	include <stdlib.h> // getenv
 #endif
 
 //
-// Very simple logging system
+// Internal logging, see the Logging group for the backend
 //
 #if defined(FPL_ENABLE_LOGGING)
-#	define FPL_LOG_FORMAT(what, format) "[" what "] " format "\n"
-#   define FPL_LOG(what, format, ...) do { \
-		fplConsoleFormatOut(FPL_LOG_FORMAT(what, format), ## __VA_ARGS__); \
-	} while (0)
-#   define FPL_LOG_FUNCTION_N(what, name) fplConsoleFormatOut("> %s %s\n", what, name)
+#   define FPL_LOG(what, format, ...) FPL_LOG_INFO(what, format, ## __VA_ARGS__)
+#   define FPL_LOG_FUNCTION_N(what, name) FPL_LOG_DEBUG("Function", "> %s %s", what, name)
 #   define FPL_LOG_FUNCTION(what) FPL_LOG_FUNCTION_N(what, FPL_FUNCTION_NAME)
 
 #if defined(FPL_IS_CPP)
@@ -4619,6 +5533,7 @@ typedef struct fpl__Win32WindowState {
 #	include <dlfcn.h> // dlopen, dlclose
 #	include <fcntl.h> // open
 #	include <unistd.h> // read, write, close, access, rmdir
+#	include <sys/syscall.h> // SYS_memfd_create
 
 // Little macro to not write 5 lines of code all the time
 #define FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, target, type, name) \
@@ -4627,6 +5542,58 @@ typedef struct fpl__Win32WindowState {
 		fpl__PushError("Failed getting '%s' from library '%s'", name, libName); \
 		break; \
 	}
+// Same as FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK, but for functions which may not exist
+#define FPL__POSIX_GET_FUNCTION_ADDRESS_OPTIONAL(libHandle, target, type, name) \
+	target = (type *)dlsym(libHandle, name)
+
+// Cached result from probing a list of library file names
+typedef struct fpl__PosixLibraryProbe {
+	// Time in nanoseconds the last load has taken
+	uint64_t loadTime;
+	// Index of the library file name which was loaded successfully the last time, this is tried first
+	uint32_t lastIndex;
+	// Is set when none of the library file names could be loaded, so we dont probe again
+	bool isUnavailable;
+} fpl__PosixLibraryProbe;
+
+fpl_internal_inline uint32_t fpl__PosixGetProbeIndex(const fpl__PosixLibraryProbe *probe, const uint32_t iteration, const uint32_t count) {
+	uint32_t result = (probe->lastIndex + iteration) % count;
+	return(result);
+}
+
+//
+// Apis which are loaded on their first use
+//
+#define FPL__POSIX_LAZYAPI_UNLOADED 0
+#define FPL__POSIX_LAZYAPI_LOADING 1
+#define FPL__POSIX_LAZYAPI_LOADED 2
+#define FPL__POSIX_LAZYAPI_FAILED 3
+
+// Returns true when the caller must load the api and must call fpl__PosixEndLazyLoad() afterwards
+fpl_internal bool fpl__PosixBeginLazyLoad(volatile uint32_t *state) {
+	uint32_t current = fplAtomicLoadU32(state);
+	if(current == FPL__POSIX_LAZYAPI_LOADED || current == FPL__POSIX_LAZYAPI_FAILED) {
+		return false;
+	}
+	if(fplAtomicCompareAndExchangeU32(state, FPL__POSIX_LAZYAPI_UNLOADED, FPL__POSIX_LAZYAPI_LOADING) == FPL__POSIX_LAZYAPI_UNLOADED) {
+		return true;
+	}
+	// Another thread is loading it right now
+	while(fplAtomicLoadU32(state) == FPL__POSIX_LAZYAPI_LOADING) {
+		struct timespec t = { 0, 100000 };
+		nanosleep(&t, fpl_null);
+	}
+	return false;
+}
+
+fpl_internal void fpl__PosixEndLazyLoad(volatile uint32_t *state, const bool success) {
+	fplAtomicStoreU32(state, success ? FPL__POSIX_LAZYAPI_LOADED : FPL__POSIX_LAZYAPI_FAILED);
+}
+
+fpl_internal_inline bool fpl__PosixIsLazyLoaded(volatile uint32_t *state) {
+	bool result = fplAtomicLoadU32(state) == FPL__POSIX_LAZYAPI_LOADED;
+	return(result);
+}
 
 #define FPL__FUNC_PTHREAD_CREATE(name) int name(pthread_t *, const pthread_attr_t *, void *(*__start_routine) (void *), void *)
 typedef FPL__FUNC_PTHREAD_CREATE(fpl__pthread_func_pthread_create);
@@ -4695,13 +5662,22 @@ fpl_internal void fpl__PThreadUnloadApi(fpl__PThreadApi *pthreadApi) {
 	FPL_CLEAR_STRUCT(pthreadApi);
 }
 
+fpl_globalvar fpl__PosixLibraryProbe fpl__global__PThreadLibraryProbe = FPL_ZERO_INIT;
+
 fpl_internal bool fpl__PThreadLoadApi(fpl__PThreadApi *pthreadApi) {
+	fpl__PosixLibraryProbe *probe = &fpl__global__PThreadLibraryProbe;
+	if(probe->isUnavailable) {
+		return false;
+	}
 	const char* libpthreadFileNames[] = {
-		"libpthread.so",
 		"libpthread.so.0",
+		"libpthread.so",
 	};
+	uint64_t startTime = fplGetTimeInNanoseconds();
+	uint32_t libCount = FPL_ARRAYCOUNT(libpthreadFileNames);
 	bool result = false;
-	for(uint32_t index = 0; index < FPL_ARRAYCOUNT(libpthreadFileNames); ++index) {
+	for(uint32_t iteration = 0; iteration < libCount; ++iteration) {
+		uint32_t index = fpl__PosixGetProbeIndex(probe, iteration, libCount);
 		const char * libName = libpthreadFileNames[index];
 		void *libHandle = pthreadApi->libHandle = dlopen(libName, FPL__POSIX_DL_LOADTYPE);
 		if(libHandle != fpl_null) {
@@ -4711,7 +5687,8 @@ fpl_internal bool fpl__PThreadLoadApi(fpl__PThreadApi *pthreadApi) {
 				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, pthreadApi->pthread_kill, fpl__pthread_func_pthread_kill, "pthread_kill");
 				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, pthreadApi->pthread_join, fpl__pthread_func_pthread_join, "pthread_join");
 				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, pthreadApi->pthread_exit, fpl__pthread_func_pthread_exit, "pthread_exit");
-				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, pthreadApi->pthread_yield, fpl__pthread_func_pthread_yield, "pthread_yield");
+				// @NOTE(final): pthread_yield was removed in glibc 2.34, so its optional
+				FPL__POSIX_GET_FUNCTION_ADDRESS_OPTIONAL(libHandle, pthreadApi->pthread_yield, fpl__pthread_func_pthread_yield, "pthread_yield");
 
 				// pthread_mutex_t
 				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, pthreadApi->pthread_mutex_init, fpl__pthread_func_pthread_mutex_init, "pthread_mutex_init");
@@ -4730,11 +5707,14 @@ fpl_internal bool fpl__PThreadLoadApi(fpl__PThreadApi *pthreadApi) {
 				result = true;
 			} while(0);
 			if(result) {
+				probe->lastIndex = index;
 				break;
 			}
 		}
 		fpl__PThreadUnloadApi(pthreadApi);
 	}
+	probe->isUnavailable = !result;
+	probe->loadTime = fplGetTimeInNanoseconds() - startTime;
 	return(result);
 }
 
@@ -4745,6 +5725,8 @@ typedef struct fpl__PosixInitState {
 
 typedef struct fpl__PosixAppState {
 	fpl__PThreadApi pthreadApi;
+	// Lazy load state of the pthread api, see FPL__POSIX_LAZYAPI_*
+	volatile uint32_t pthreadApiState;
 } fpl__PosixAppState;
 #endif // FPL_SUBPLATFORM_POSIX
 
@@ -4885,16 +5867,26 @@ fpl_internal void fpl__UnloadX11Api(fpl__X11Api *x11Api) {
 	FPL_CLEAR_STRUCT(x11Api);
 }
 
+fpl_globalvar fpl__PosixLibraryProbe fpl__global__X11LibraryProbe = FPL_ZERO_INIT;
+
 fpl_internal bool fpl__LoadX11Api(fpl__X11Api *x11Api) {
-	// @TODO(final): Correct order of libX11*.so files to prope
+	fpl__PosixLibraryProbe *probe = &fpl__global__X11LibraryProbe;
+	if(probe->isUnavailable) {
+		return false;
+	}
+	// @NOTE(final): The versioned runtime names comes first, because the unversioned name only exists when the development package is installed.
+	// The name which was loaded successfully is cached in the probe and tried first next time.
 	const char* libFileNames[] = {
+		"libX11.so.6",
 		"libX11.so",
 		"libX11.so.7",
-		"libX11.so.6",
 		"libX11.so.5",
 	};
+	uint64_t startTime = fplGetTimeInNanoseconds();
+	uint32_t libCount = FPL_ARRAYCOUNT(libFileNames);
 	bool result = false;
-	for(uint32_t index = 0; index < FPL_ARRAYCOUNT(libFileNames); ++index) {
+	for(uint32_t iteration = 0; iteration < libCount; ++iteration) {
+		uint32_t index = fpl__PosixGetProbeIndex(probe, iteration, libCount);
 		const char *libName = libFileNames[index];
 		void *libHandle = x11Api->libHandle = dlopen(libName, FPL__POSIX_DL_LOADTYPE);
 		if(libHandle != fpl_null) {
@@ -4928,16 +5920,21 @@ fpl_internal bool fpl__LoadX11Api(fpl__X11Api *x11Api) {
 				result = true;
 			} while(0);
 			if(result) {
+				probe->lastIndex = index;
 				break;
 			}
 		}
 		fpl__UnloadX11Api(x11Api);
 	}
+	probe->isUnavailable = !result;
+	probe->loadTime = fplGetTimeInNanoseconds() - startTime;
 	return(result);
 }
 
 typedef struct fpl__X11SubplatformState {
 	fpl__X11Api api;
+	// Lazy load state of the x11 api, see FPL__POSIX_LAZYAPI_*
+	volatile uint32_t apiState;
 } fpl__X11SubplatformState;
 
 typedef struct fpl__X11WindowState {
@@ -5051,6 +6048,11 @@ struct fpl__PlatformAppState {
 	fplSettings currentSettings;
 	fplInitFlags initFlags;
 
+	// Timings in nanoseconds
+	fplInitTimings initTimings;
+	uint64_t initStartTime;
+	uint64_t firstFrameTime;
+
 	// Platforms
 	union {
 #	if defined(FPL_PLATFORM_WIN32)
@@ -5162,48 +6164,110 @@ typedef struct fpl__SetupWindowCallbacks {
 //
 #define FPL__MAX_LAST_ERROR_STRING_LENGTH 1024
 #if defined(FPL_ENABLE_MULTIPLE_ERRORSTATES)
-#	define FPL__MAX_ERRORSTATE_COUNT 256
+#	define FPL__MAX_ERRORSTATE_COUNT 16
 #else
 #	define FPL__MAX_ERRORSTATE_COUNT 1
 #endif
 
+#if defined(FPL_COMPILER_MSVC)
+#	define fpl__thread_local __declspec(thread)
+#else
+#	define fpl__thread_local __thread
+#endif
+
+typedef struct fpl__ErrorEntry {
+	char message[FPL__MAX_LAST_ERROR_STRING_LENGTH];
+	// Format string when the message is not formatted yet, otherwise null
+	const char *format;
+	// Arguments for the deferred format string
+	const char *paramName;
+	size_t values[2];
+	fplPlatformErrorType type;
+} fpl__ErrorEntry;
+
 typedef struct fpl__ErrorState {
-	char errors[FPL__MAX_ERRORSTATE_COUNT][FPL__MAX_LAST_ERROR_STRING_LENGTH];
+	fpl__ErrorEntry entries[FPL__MAX_ERRORSTATE_COUNT];
+	uint32_t writeIndex;
 	uint32_t count;
 } fpl__ErrorState;
 
-fpl_globalvar fpl__ErrorState fpl__global__LastErrorState;
+// @NOTE(final): Each thread has its own error state, so pushing an error never requires any synchronization
+fpl_globalvar fpl__thread_local fpl__ErrorState fpl__global__LastErrorState;
 
-#if defined(FPL_ENABLE_MULTIPLE_ERRORSTATES)
-fpl_internal void fpl__PushError_Formatted(const char *format, va_list argList) {
+// Returns the number of characters written, the result is truncated when the buffer is too small
+fpl_internal size_t fpl__FormatAnsiStringQuiet(char *buffer, const size_t maxBufferLen, const char *format, ...) {
+	// @NOTE(final): Not using fplFormatAnsiStringArgs(), because that pushes errors by itself
+	FPL_ASSERT(maxBufferLen > 0);
+	va_list argList;
+	va_start(argList, format);
+	buffer[0] = 0;
+	int charCount = 0;
+#	if defined(FPL_NO_CRT)
+#		if defined(FPL_USERFUNC_vsnprintf)
+	charCount = FPL_USERFUNC_vsnprintf(buffer, maxBufferLen, format, argList);
+#		endif
+#	else
+	charCount = vsnprintf(buffer, maxBufferLen, format, argList);
+#	endif
+	va_end(argList);
+	buffer[maxBufferLen - 1] = 0;
+	size_t result = 0;
+	if(charCount > 0) {
+		result = (size_t)charCount < maxBufferLen ? (size_t)charCount : maxBufferLen - 1;
+	}
+	return(result);
+}
+
+fpl_internal const char *fpl__GetErrorMessage(fpl__ErrorEntry *entry) {
+	if(entry->format != fpl_null) {
+		// Deferred formatting, extra arguments are ignored by the format string
+		fpl__FormatAnsiStringQuiet(entry->message, FPL__MAX_LAST_ERROR_STRING_LENGTH, entry->format, entry->paramName, entry->values[0], entry->values[1]);
+		entry->format = fpl_null;
+	}
+	return(entry->message);
+}
+
+fpl_internal fpl__ErrorEntry *fpl__GetErrorEntry(const size_t index) {
 	fpl__ErrorState *state = &fpl__global__LastErrorState;
-	FPL_ASSERT(format != fpl_null);
-	char buffer[FPL__MAX_LAST_ERROR_STRING_LENGTH] = FPL_ZERO_INIT;
-	fplFormatAnsiStringArgs(buffer, FPL_ARRAYCOUNT(buffer), format, argList);
-	size_t messageLen = fplGetAnsiStringLength(buffer);
-	FPL_ASSERT(state->count < FPL__MAX_ERRORSTATE_COUNT);
-	size_t errorIndex = state->count;
-	state->count = (state->count + 1) % FPL__MAX_ERRORSTATE_COUNT;
-	fplCopyAnsiStringLen(buffer, messageLen, state->errors[errorIndex], FPL__MAX_LAST_ERROR_STRING_LENGTH);
+	FPL_ASSERT(index < state->count);
+	uint32_t oldestIndex = (state->writeIndex + FPL__MAX_ERRORSTATE_COUNT - state->count) % FPL__MAX_ERRORSTATE_COUNT;
+	fpl__ErrorEntry *result = &state->entries[(oldestIndex + index) % FPL__MAX_ERRORSTATE_COUNT];
+	return(result);
+}
+
+fpl_internal fpl__ErrorEntry *fpl__PushErrorEntry(const fplPlatformErrorType type) {
+	fpl__ErrorState *state = &fpl__global__LastErrorState;
+	fpl__ErrorEntry *result = &state->entries[state->writeIndex];
+	state->writeIndex = (state->writeIndex + 1) % FPL__MAX_ERRORSTATE_COUNT;
+	if(state->count < FPL__MAX_ERRORSTATE_COUNT) {
+		++state->count;
+	}
+	result->type = type;
+	result->format = fpl_null;
+	result->message[0] = 0;
+	return(result);
+}
+
+fpl_internal void fpl__PrintErrorEntry(fpl__ErrorEntry *entry) {
 #if defined(FPL_ENABLE_ERROR_IN_CONSOLE)
-	const char *platformName = FPL_PLATFORM_NAME;
-	fplConsoleFormatError("FPL Error[%s]: %s\n", platformName, buffer);
+	fplConsoleFormatError("FPL Error[%s]: %s\n", FPL_PLATFORM_NAME, fpl__GetErrorMessage(entry));
 #endif
 }
-#else
+
 fpl_internal void fpl__PushError_Formatted(const char *format, va_list argList) {
-	ErrorState *state = fpl__global__LastErrorState;
 	FPL_ASSERT(format != fpl_null);
-	char buffer[FPL__MAX_LAST_ERROR_STRING_LENGTH];
-	fplFormatAnsiStringArgs(buffer, FPL_ARRAYCOUNT(buffer), format, argList);
-	uint32_t messageLen = fplGetAnsiStringLength(buffer);
-	state->count = 1;
-	fplCopyAnsiStringLen(buffer, messageLen, state->errors[0], FPL__MAX_LAST_ERROR_STRING_LENGTH);
-#if defined(FPL_ENABLE_ERROR_IN_CONSOLE)
-	fplConsoleFormatError("FPL Error[%s]: %s\h", FPL_PLATFORM_NAME, buffer);
-#endif
+	fpl__ErrorEntry *entry = fpl__PushErrorEntry(fplPlatformErrorType_Failed);
+	// @NOTE(final): Generic errors are formatted immediately, because string arguments may not live long enough
+#	if defined(FPL_NO_CRT)
+#		if defined(FPL_USERFUNC_vsnprintf)
+	FPL_USERFUNC_vsnprintf(entry->message, FPL__MAX_LAST_ERROR_STRING_LENGTH, format, argList);
+#		endif
+#	else
+	vsnprintf(entry->message, FPL__MAX_LAST_ERROR_STRING_LENGTH, format, argList);
+#	endif
+	entry->message[FPL__MAX_LAST_ERROR_STRING_LENGTH - 1] = 0;
+	fpl__PrintErrorEntry(entry);
 }
-#endif // FPL_ENABLE_MULTIPLE_ERRORSTATES
 
 fpl_internal void fpl__PushError(const char *format, ...) {
 	va_list valist;
@@ -5212,17 +6276,27 @@ fpl_internal void fpl__PushError(const char *format, ...) {
 	va_end(valist);
 }
 
+fpl_internal void fpl__PushArgumentError(const fplPlatformErrorType type, const char *format, const char *paramName, const size_t value, const size_t limit) {
+	// @NOTE(final): Argument errors are formatted on demand only, the parameter names are always string literals
+	fpl__ErrorEntry *entry = fpl__PushErrorEntry(type);
+	entry->format = format;
+	entry->paramName = paramName;
+	entry->values[0] = value;
+	entry->values[1] = limit;
+	fpl__PrintErrorEntry(entry);
+}
+
 fpl_internal void fpl__ArgumentNullError(const char *paramName) {
-	fpl__PushError("%s parameter are not allowed to be null", paramName);
+	fpl__PushArgumentError(fplPlatformErrorType_ArgumentNull, "%s parameter are not allowed to be null", paramName, 0, 0);
 }
 fpl_internal void fpl__ArgumentZeroError(const char *paramName) {
-	fpl__PushError("%s parameter must be greater than zero", paramName);
+	fpl__PushArgumentError(fplPlatformErrorType_ArgumentZero, "%s parameter must be greater than zero", paramName, 0, 0);
 }
 fpl_internal void fpl__ArgumentSizeTooSmallError(const char *paramName, const size_t value, const size_t minValue) {
-	fpl__PushError("%s parameter '%zu' must be greater or equal than '%zu'", paramName, value, minValue);
+	fpl__PushArgumentError(fplPlatformErrorType_ArgumentTooSmall, "%s parameter '%zu' must be greater or equal than '%zu'", paramName, value, minValue);
 }
 fpl_internal void fpl__ArgumentSizeTooBigError(const char *paramName, const size_t value, const size_t maxValue) {
-	fpl__PushError("%s parameter '%zu' must be less or equal than '%zu'", paramName, value, maxValue);
+	fpl__PushArgumentError(fplPlatformErrorType_ArgumentTooBig, "%s parameter '%zu' must be less or equal than '%zu'", paramName, value, maxValue);
 }
 
 // Maximum number of active threads you can have in your process
@@ -5268,6 +6342,52 @@ fpl_internal_inline fplKey fpl__GetMappedKey(const fpl__PlatformWindowState *win
 #if !defined(FPL__COMMON_STRINGS_DEFINED)
 #define FPL__COMMON_STRINGS_DEFINED
 
+// @NOTE(final): SSE2 is always available on x64, so we dont need any runtime detection here.
+#if defined(FPL_ARCH_X64) || (defined(FPL_ARCH_X86) && (defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))))
+#	define FPL__STRINGS_SSE2
+#	include <emmintrin.h> // _mm_load_si128, _mm_cmpeq_epi8, _mm_movemask_epi8
+#endif
+
+// @NOTE(final): The null-terminated SSE2 functions reads aligned 16 byte blocks past the terminator.
+// This never crosses a page boundary, so its safe - but the address sanitizer does not know that.
+#if defined(FPL__STRINGS_SSE2) && (defined(FPL_COMPILER_GCC) || defined(FPL_COMPILER_CLANG) || defined(FPL_COMPILER_MINGW))
+#	define fpl__no_sanitize_address __attribute__((no_sanitize_address))
+#else
+#	define fpl__no_sanitize_address
+#endif
+
+#if defined(FPL__STRINGS_SSE2)
+// Returns the index of the lowest set bit, value must not be zero
+fpl_internal_inline uint32_t fpl__FindFirstBit32(const uint32_t value) {
+	FPL_ASSERT(value != 0);
+#	if defined(FPL_COMPILER_MSVC)
+	unsigned long result;
+	_BitScanForward(&result, value);
+	return (uint32_t)result;
+#	else
+	return (uint32_t)__builtin_ctz(value);
+#	endif
+}
+
+// Returns the index of the highest set bit, value must not be zero
+fpl_internal_inline uint32_t fpl__FindLastBit32(const uint32_t value) {
+	FPL_ASSERT(value != 0);
+#	if defined(FPL_COMPILER_MSVC)
+	unsigned long result;
+	_BitScanReverse(&result, value);
+	return (uint32_t)result;
+#	else
+	return 31 - (uint32_t)__builtin_clz(value);
+#	endif
+}
+
+// Returns true when a 16 byte read at the given address does not cross a page boundary
+fpl_internal_inline bool fpl__IsSafeBlockRead(const char *p) {
+	bool result = ((uintptr_t)p & 4095) <= (4096 - 16);
+	return(result);
+}
+#endif // FPL__STRINGS_SSE2
+
 fpl_common_api bool fplIsStringEqualLen(const char *a, const size_t aLen, const char *b, const size_t bLen) {
 	if((a == fpl_null) || (b == fpl_null)) {
 		return (a == b);
@@ -5276,8 +6396,18 @@ fpl_common_api bool fplIsStringEqualLen(const char *a, const size_t aLen, const
 		return false;
 	}
 	FPL_ASSERT(aLen == bLen);
+	size_t index = 0;
+#if defined(FPL__STRINGS_SSE2)
+	for(; (index + 16) <= aLen; index += 16) {
+		__m128i aBlock = _mm_loadu_si128((const __m128i *)(a + index));
+		__m128i bBlock = _mm_loadu_si128((const __m128i *)(b + index));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi8(aBlock, bBlock)) != 0xFFFF) {
+			return false;
+		}
+	}
+#endif
 	bool result = true;
-	for(size_t index = 0; index < aLen; ++index) {
+	for(; index < aLen; ++index) {
 		char aChar = a[index];
 		char bChar = b[index];
 		if(aChar != bChar) {
@@ -5288,12 +6418,30 @@ fpl_common_api bool fplIsStringEqualLen(const char *a, const size_t aLen, const
 	return(result);
 }
 
-fpl_common_api bool fplIsStringEqual(const char *a, const char *b) {
+fpl_common_api fpl__no_sanitize_address bool fplIsStringEqual(const char *a, const char *b) {
 	if((a == fpl_null) || (b == fpl_null)) {
 		return (a == b);
 	}
 	bool result = true;
 	for(;;) {
+#if defined(FPL__STRINGS_SSE2)
+		// Both strings may have a different alignment, so we compare blocks only when neither read crosses a page
+		if(fpl__IsSafeBlockRead(a) && fpl__IsSafeBlockRead(b)) {
+			__m128i aBlock = _mm_loadu_si128((const __m128i *)a);
+			__m128i bBlock = _mm_loadu_si128((const __m128i *)b);
+			uint32_t diffMask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(aBlock, bBlock)) ^ 0xFFFF;
+			uint32_t zeroMask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(aBlock, _mm_setzero_si128()));
+			uint32_t stopMask = diffMask | zeroMask;
+			if(stopMask != 0) {
+				uint32_t index = fpl__FindFirstBit32(stopMask);
+				result = (a[index] == b[index]);
+				break;
+			}
+			a += 16;
+			b += 16;
+			continue;
+		}
+#endif
 		const char aChar = *(a++);
 		const char bChar = *(b++);
 		if(aChar == 0 || bChar == 0) {
@@ -5308,18 +6456,37 @@ fpl_common_api bool fplIsStringEqual(const char *a, const char *b) {
 	return(result);
 }
 
-fpl_common_api size_t fplGetAnsiStringLength(const char *str) {
-	uint32_t result = 0;
+fpl_common_api fpl__no_sanitize_address size_t fplGetAnsiStringLength(const char *str) {
+	size_t result = 0;
 	if(str != fpl_null) {
+#if defined(FPL__STRINGS_SSE2)
+		// Aligned loads never crosses a page boundary, the bytes before the string are masked out
+		const __m128i zero = _mm_setzero_si128();
+		uintptr_t misalignment = (uintptr_t)str & 15;
+		const __m128i *block = (const __m128i *)(str - misalignment);
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(block), zero)) >> misalignment;
+		if(mask != 0) {
+			return fpl__FindFirstBit32(mask);
+		}
+		for(;;) {
+			++block;
+			mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_load_si128(block), zero));
+			if(mask != 0) {
+				result = (size_t)((const char *)block - str) + fpl__FindFirstBit32(mask);
+				break;
+			}
+		}
+#else
 		while(*str++) {
 			result++;
 		}
+#endif
 	}
 	return(result);
 }
 
 fpl_common_api size_t fplGetWideStringLength(const wchar_t *str) {
-	uint32_t result = 0;
+	size_t result = 0;
 	if(str != fpl_null) {
 		while(*str++) {
 			result++;
@@ -5328,183 +6495,677 @@ fpl_common_api size_t fplGetWideStringLength(const wchar_t *str) {
 	return(result);
 }
 
-fpl_common_api char *fplCopyAnsiStringLen(const char *source, const size_t sourceLen, char *dest, const size_t maxDestLen) {
-	if(source != fpl_null && dest != fpl_null) {
-		size_t requiredLen = sourceLen + 1;
-		if(maxDestLen < requiredLen) {
-			fpl__ArgumentSizeTooSmallError("Max dest len", maxDestLen, requiredLen);
-			return fpl_null;
+fpl_common_api fpl__no_sanitize_address const char *fplFindChar(const char *str, const char ch) {
+	if(str == fpl_null) {
+		return fpl_null;
+	}
+#if defined(FPL__STRINGS_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i search = _mm_set1_epi8(ch);
+	uintptr_t misalignment = (uintptr_t)str & 15;
+	const __m128i *block = (const __m128i *)(str - misalignment);
+	__m128i data = _mm_load_si128(block);
+	uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(data, zero), _mm_cmpeq_epi8(data, search)));
+	mask = (mask >> misalignment) << misalignment;
+	while(mask == 0) {
+		++block;
+		data = _mm_load_si128(block);
+		mask = (uint32_t)_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(data, zero), _mm_cmpeq_epi8(data, search)));
+	}
+	// The first hit is either the character or the terminator
+	const char *result = (const char *)block + fpl__FindFirstBit32(mask);
+	return (*result == ch) ? result : fpl_null;
+#else
+	for(;;) {
+		if(*str == ch) {
+			return str;
 		}
-		char *result = dest;
-		size_t index = 0;
-		while(index++ < sourceLen) {
-			*dest++ = *source++;
+		if(*str == 0) {
+			return fpl_null;
 		}
-		*dest = 0;
-		return(result);
-	} else {
-		return(fpl_null);
+		++str;
 	}
+#endif
 }
 
-fpl_common_api char *fplCopyAnsiString(const char *source, char *dest, const size_t maxDestLen) {
-	char *result = fpl_null;
-	if(source != fpl_null) {
-		size_t sourceLen = fplGetAnsiStringLength(source);
-		result = fplCopyAnsiStringLen(source, sourceLen, dest, maxDestLen);
+fpl_common_api const char *fplFindCharLen(const char *str, const size_t len, const char ch) {
+	if(str == fpl_null) {
+		return fpl_null;
 	}
-	return(result);
-}
-
-fpl_common_api wchar_t *fplCopyWideStringLen(const wchar_t *source, const size_t sourceLen, wchar_t *dest, const size_t maxDestLen) {
-	if(source != fpl_null && dest != fpl_null) {
-		size_t requiredLen = sourceLen + 1;
-		if(maxDestLen < requiredLen) {
-			fpl__ArgumentSizeTooSmallError("Max dest len", maxDestLen, requiredLen);
-			return fpl_null;
+	size_t index = 0;
+#if defined(FPL__STRINGS_SSE2)
+	const __m128i search = _mm_set1_epi8(ch);
+	for(; (index + 16) <= len; index += 16) {
+		__m128i data = _mm_loadu_si128((const __m128i *)(str + index));
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(data, search));
+		if(mask != 0) {
+			return str + index + fpl__FindFirstBit32(mask);
 		}
-		wchar_t *result = dest;
-		size_t index = 0;
-		while(index++ < sourceLen) {
-			*dest++ = *source++;
+	}
+#endif
+	for(; index < len; ++index) {
+		if(str[index] == ch) {
+			return str + index;
 		}
-		*dest = 0;
-		return(result);
-	} else {
-		return(fpl_null);
 	}
+	return fpl_null;
 }
 
-fpl_common_api wchar_t *fplCopyWideString(const wchar_t *source, wchar_t *dest, const size_t maxDestLen) {
-	wchar_t *result = fpl_null;
-	if(source != fpl_null) {
-		size_t sourceLen = fplGetWideStringLength(source);
-		result = fplCopyWideStringLen(source, sourceLen, dest, maxDestLen);
+fpl_common_api fpl__no_sanitize_address const char *fplFindLastChar(const char *str, const char ch) {
+	if(str == fpl_null) {
+		return fpl_null;
+	}
+	if(ch == 0) {
+		return str + fplGetAnsiStringLength(str);
+	}
+	const char *result = fpl_null;
+#if defined(FPL__STRINGS_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i search = _mm_set1_epi8(ch);
+	uintptr_t misalignment = (uintptr_t)str & 15;
+	const __m128i *block = (const __m128i *)(str - misalignment);
+	uint32_t startMask = 0xFFFF << misalignment;
+	for(;;) {
+		__m128i data = _mm_load_si128(block);
+		uint32_t zeroMask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(data, zero)) & startMask;
+		uint32_t charMask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(data, search)) & startMask;
+		if(zeroMask != 0) {
+			// Only matches before the terminator are valid
+			uint32_t firstZeroBit = zeroMask & (~zeroMask + 1);
+			charMask &= firstZeroBit - 1;
+		}
+		if(charMask != 0) {
+			result = (const char *)block + fpl__FindLastBit32(charMask);
+		}
+		if(zeroMask != 0) {
+			break;
+		}
+		startMask = 0xFFFF;
+		++block;
+	}
+#else
+	while(*str) {
+		if(*str == ch) {
+			result = str;
+		}
+		++str;
 	}
+#endif
 	return(result);
 }
 
-fpl_common_api char *fplFormatAnsiStringArgs(char *ansiDestBuffer, const size_t maxAnsiDestBufferLen, const char *format, va_list argList) {
-	if(ansiDestBuffer == fpl_null) {
-		fpl__ArgumentNullError("Ansi dest buffer");
+fpl_common_api const char *fplFindSubstringLen(const char *str, const size_t len, const char *subStr, const size_t subLen) {
+	if(str == fpl_null || subStr == fpl_null) {
 		return fpl_null;
 	}
-	if(maxAnsiDestBufferLen == 0) {
-		fpl__ArgumentZeroError("Max ansi dest len");
-		return fpl_null;
-	}
-	if(format == fpl_null) {
-		fpl__ArgumentNullError("Format");
-		return fpl_null;
+	if(subLen == 0) {
+		return str;
 	}
-	if(argList == fpl_null) {
-		fpl__ArgumentNullError("Arg list");
+	if(subLen > len) {
 		return fpl_null;
 	}
-	// @NOTE(final): Need to clear the first character, otherwise vsnprintf() does weird things... O_o
-	ansiDestBuffer[0] = 0;
-
-	int charCount = 0;
-#	if defined(FPL_NO_CRT)
-#		if defined(FPL_USERFUNC_vsnprintf)
-	charCount = FPL_USERFUNC_vsnprintf(ansiDestBuffer, maxAnsiDestBufferLen, format, argList);
-#		else
-	charCount = 0;
-#		endif
-#	else
-	charCount = vsnprintf(ansiDestBuffer, maxAnsiDestBufferLen, format, argList);
-#	endif
-
-	if(charCount < 0) {
-		fpl__PushError("Format parameter are '%s' are invalid!", format);
-		return fpl_null;
+	size_t lastIndex = len - subLen;
+	size_t index = 0;
+#if defined(FPL__STRINGS_SSE2)
+	// @NOTE(final): Compare the first and the last character of the sub string for 16 positions at once and verify the candidates only
+	const __m128i first = _mm_set1_epi8(subStr[0]);
+	const __m128i last = _mm_set1_epi8(subStr[subLen - 1]);
+	for(; (index + 15) <= lastIndex; index += 16) {
+		__m128i firstBlock = _mm_loadu_si128((const __m128i *)(str + index));
+		__m128i lastBlock = _mm_loadu_si128((const __m128i *)(str + index + subLen - 1));
+		uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(firstBlock, first), _mm_cmpeq_epi8(lastBlock, last)));
+		while(mask != 0) {
+			uint32_t bit = fpl__FindFirstBit32(mask);
+			const char *candidate = str + index + bit;
+			if(fplIsStringEqualLen(candidate, subLen, subStr, subLen)) {
+				return candidate;
+			}
+			mask &= mask - 1;
+		}
 	}
-	size_t requiredMaxAnsiDestBufferLen = charCount + 1;
-	if(maxAnsiDestBufferLen < requiredMaxAnsiDestBufferLen) {
-		fpl__ArgumentSizeTooSmallError("Max ansi dest len", maxAnsiDestBufferLen, requiredMaxAnsiDestBufferLen);
-		return fpl_null;
+#endif
+	for(; index <= lastIndex; ++index) {
+		if(str[index] == subStr[0] && fplIsStringEqualLen(str + index, subLen, subStr, subLen)) {
+			return str + index;
+		}
 	}
-	ansiDestBuffer[charCount] = 0;
-	char *result = ansiDestBuffer;
-	return(result);
+	return fpl_null;
 }
 
-fpl_common_api char *fplFormatAnsiString(char *ansiDestBuffer, const size_t maxAnsiDestBufferLen, const char *format, ...) {
-	if(ansiDestBuffer == fpl_null) {
-		fpl__ArgumentNullError("Ansi dest buffer");
-		return fpl_null;
-	}
-	if(maxAnsiDestBufferLen == 0) {
-		fpl__ArgumentZeroError("Max ansi dest len");
-		return fpl_null;
-	}
-	if(format == fpl_null) {
-		fpl__ArgumentNullError("Format");
+fpl_common_api const char *fplFindSubstring(const char *str, const char *subStr) {
+	if(str == fpl_null || subStr == fpl_null) {
 		return fpl_null;
 	}
-	va_list argList;
-	va_start(argList, format);
-	char *result = fplFormatAnsiStringArgs(ansiDestBuffer, maxAnsiDestBufferLen, format, argList);
-	va_end(argList);
+	size_t len = fplGetAnsiStringLength(str);
+	size_t subLen = fplGetAnsiStringLength(subStr);
+	const char *result = fplFindSubstringLen(str, len, subStr, subLen);
 	return(result);
 }
-#endif // FPL__COMMON_STRINGS_DEFINED
 
 //
-// Common Console
+// UTF transcoding
 //
-#if !defined(FPL__COMMON_CONSOLE_DEFINED)
-#define FPL__COMMON_CONSOLE_DEFINED
+typedef enum fpl__UTFType {
+	fpl__UTFType_8 = 1,
+	fpl__UTFType_16 = 2,
+	fpl__UTFType_32 = 4,
+} fpl__UTFType;
+
+// wchar_t is UTF-16 on win32 and UTF-32 everywhere else
+#if WCHAR_MAX > 0xFFFF
+#	define FPL__WIDE_UTF_TYPE fpl__UTFType_32
+#else
+#	define FPL__WIDE_UTF_TYPE fpl__UTFType_16
+#endif
 
-fpl_common_api void fplConsoleFormatOut(const char *format, ...) {
-	char buffer[1024 * 10];
-	va_list argList;
-	va_start(argList, format);
-	char *str = fplFormatAnsiStringArgs(buffer, FPL_ARRAYCOUNT(buffer), format, argList);
-	va_end(argList);
-	if(str != fpl_null) {
-		fplConsoleOut(str);
-	}
-}
+#define FPL__UTF_MAX_CODEPOINT 0x10FFFF
+#define FPL__UTF_IS_SURROGATE(cp) (((cp) >= 0xD800) && ((cp) <= 0xDFFF))
 
-fpl_common_api void fplConsoleFormatError(const char *format, ...) {
-	char buffer[1024];
-	va_list argList;
-	va_start(argList, format);
-	char *str = fplFormatAnsiStringArgs(buffer, FPL_ARRAYCOUNT(buffer), format, argList);
-	va_end(argList);
-	if(str != fpl_null) {
-		fplConsoleError(str);
-	}
-}
-#endif // FPL__COMMON_CONSOLE_DEFINED
+// Decodes and validates the next code point, returns false for invalid or truncated sequences
+fpl_internal_inline bool fpl__DecodeUTF(const void *source, const size_t sourceLen, const fpl__UTFType type, size_t *index, uint32_t *outCodePoint) {
+	size_t i = *index;
+	uint32_t cp;
+	switch(type) {
+		case fpl__UTFType_8:
+		{
+			const uint8_t *s = (const uint8_t *)source;
+			uint8_t c = s[i++];
+			if(c < 0x80) {
+				cp = c;
+				break;
+			}
+			uint32_t count;
+			uint32_t minCodePoint;
+			if((c & 0xE0) == 0xC0) {
+				count = 1;
+				minCodePoint = 0x80;
+				cp = c & 0x1F;
+			} else if((c & 0xF0) == 0xE0) {
+				count = 2;
+				minCodePoint = 0x800;
+				cp = c & 0x0F;
+			} else if((c & 0xF8) == 0xF0) {
+				count = 3;
+				minCodePoint = 0x10000;
+				cp = c & 0x07;
+			} else {
+				return false;
+			}
+			if((sourceLen - i) < count) {
+				return false;
+			}
+			for(uint32_t n = 0; n < count; ++n) {
+				uint8_t continuation = s[i++];
+				if((continuation & 0xC0) != 0x80) {
+					return false;
+				}
+				cp = (cp << 6) | (continuation & 0x3F);
+			}
+			// Overlong sequences
+			if(cp < minCodePoint) {
+				return false;
+			}
+		} break;
 
-//
-// Common Memory
-//
-#if !defined(FPL__COMMON_MEMORY_DEFINED)
-#define FPL__COMMON_MEMORY_DEFINED
+		case fpl__UTFType_16:
+		{
+			const uint16_t *s = (const uint16_t *)source;
+			cp = s[i++];
+			if(FPL__UTF_IS_SURROGATE(cp)) {
+				// Must be a high surrogate followed by a low surrogate
+				if(cp > 0xDBFF || i >= sourceLen) {
+					return false;
+				}
+				uint32_t low = s[i++];
+				if(low < 0xDC00 || low > 0xDFFF) {
+					return false;
+				}
+				cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+			}
+		} break;
 
-fpl_common_api void *fplMemoryAlignedAllocate(const size_t size, const size_t alignment) {
-	if(!size) {
-		fpl__ArgumentZeroError("Size");
-		return fpl_null;
-	}
-	if(!alignment) {
-		fpl__ArgumentZeroError("Alignment");
-		return fpl_null;
+		default:
+		{
+			FPL_ASSERT(type == fpl__UTFType_32);
+			const uint32_t *s = (const uint32_t *)source;
+			cp = s[i++];
+		} break;
 	}
-	if(alignment & (alignment - 1)) {
-		fpl__PushError("Alignment parameter '%zu' must be a power of two", alignment);
-		return fpl_null;
+	if(cp > FPL__UTF_MAX_CODEPOINT || FPL__UTF_IS_SURROGATE(cp)) {
+		return false;
 	}
+	*index = i;
+	*outCodePoint = cp;
+	return true;
+}
 
-	// Allocate empty memory to hold a size of a pointer + the actual size + alignment padding 
-	size_t newSize = sizeof(void *) + size + (alignment << 1);
-	void *basePtr = fplMemoryAllocate(newSize);
+// Encodes the given valid code point and returns the number of code units, dest may be fpl_null to compute the length only
+fpl_internal_inline size_t fpl__EncodeUTF(const uint32_t cp, const fpl__UTFType type, void *dest, const size_t destIndex) {
+	switch(type) {
+		case fpl__UTFType_8:
+		{
+			uint8_t *d = (uint8_t *)dest + destIndex;
+			if(cp < 0x80) {
+				if(dest != fpl_null) {
+					d[0] = (uint8_t)cp;
+				}
+				return 1;
+			} else if(cp < 0x800) {
+				if(dest != fpl_null) {
+					d[0] = (uint8_t)(0xC0 | (cp >> 6));
+					d[1] = (uint8_t)(0x80 | (cp & 0x3F));
+				}
+				return 2;
+			} else if(cp < 0x10000) {
+				if(dest != fpl_null) {
+					d[0] = (uint8_t)(0xE0 | (cp >> 12));
+					d[1] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+					d[2] = (uint8_t)(0x80 | (cp & 0x3F));
+				}
+				return 3;
+			} else {
+				if(dest != fpl_null) {
+					d[0] = (uint8_t)(0xF0 | (cp >> 18));
+					d[1] = (uint8_t)(0x80 | ((cp >> 12) & 0x3F));
+					d[2] = (uint8_t)(0x80 | ((cp >> 6) & 0x3F));
+					d[3] = (uint8_t)(0x80 | (cp & 0x3F));
+				}
+				return 4;
+			}
+		}
 
-	// The resulting address starts after the stored base pointer
-	void *alignedPtr = (void *)((uint8_t *)basePtr + sizeof(void *));
+		case fpl__UTFType_16:
+		{
+			uint16_t *d = (uint16_t *)dest + destIndex;
+			if(cp < 0x10000) {
+				if(dest != fpl_null) {
+					d[0] = (uint16_t)cp;
+				}
+				return 1;
+			}
+			if(dest != fpl_null) {
+				uint32_t v = cp - 0x10000;
+				d[0] = (uint16_t)(0xD800 + (v >> 10));
+				d[1] = (uint16_t)(0xDC00 + (v & 0x3FF));
+			}
+			return 2;
+		}
+
+		default:
+		{
+			FPL_ASSERT(type == fpl__UTFType_32);
+			if(dest != fpl_null) {
+				((uint32_t *)dest)[destIndex] = cp;
+			}
+			return 1;
+		}
+	}
+}
+
+// Converts a block of ASCII characters at once and returns the number of characters converted, dest may be fpl_null
+fpl_internal_inline size_t fpl__ConvertASCIIBlock(const void *source, const size_t sourceLen, const size_t sourceIndex, const fpl__UTFType sourceType, void *dest, const size_t destIndex, const fpl__UTFType destType) {
+#if defined(FPL__STRINGS_SSE2)
+	const __m128i zero = _mm_setzero_si128();
+	if(sourceType == fpl__UTFType_8 && (sourceIndex + 16) <= sourceLen) {
+		__m128i data = _mm_loadu_si128((const __m128i *)((const uint8_t *)source + sourceIndex));
+		if(_mm_movemask_epi8(data) != 0) {
+			return 0;
+		}
+		if(dest != fpl_null) {
+			__m128i lo = _mm_unpacklo_epi8(data, zero);
+			__m128i hi = _mm_unpackhi_epi8(data, zero);
+			if(destType == fpl__UTFType_16) {
+				uint16_t *d = (uint16_t *)dest + destIndex;
+				_mm_storeu_si128((__m128i *)d, lo);
+				_mm_storeu_si128((__m128i *)(d + 8), hi);
+			} else if(destType == fpl__UTFType_32) {
+				uint32_t *d = (uint32_t *)dest + destIndex;
+				_mm_storeu_si128((__m128i *)d, _mm_unpacklo_epi16(lo, zero));
+				_mm_storeu_si128((__m128i *)(d + 4), _mm_unpackhi_epi16(lo, zero));
+				_mm_storeu_si128((__m128i *)(d + 8), _mm_unpacklo_epi16(hi, zero));
+				_mm_storeu_si128((__m128i *)(d + 12), _mm_unpackhi_epi16(hi, zero));
+			} else {
+				_mm_storeu_si128((__m128i *)((uint8_t *)dest + destIndex), data);
+			}
+		}
+		return 16;
+	}
+	if(sourceType == fpl__UTFType_16 && destType == fpl__UTFType_8 && (sourceIndex + 8) <= sourceLen) {
+		__m128i data = _mm_loadu_si128((const __m128i *)((const uint16_t *)source + sourceIndex));
+		__m128i highBits = _mm_and_si128(data, _mm_set1_epi16((short)0xFF80));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi16(highBits, zero)) != 0xFFFF) {
+			return 0;
+		}
+		if(dest != fpl_null) {
+			_mm_storel_epi64((__m128i *)((uint8_t *)dest + destIndex), _mm_packus_epi16(data, data));
+		}
+		return 8;
+	}
+	if(sourceType == fpl__UTFType_32 && destType == fpl__UTFType_8 && (sourceIndex + 4) <= sourceLen) {
+		__m128i data = _mm_loadu_si128((const __m128i *)((const uint32_t *)source + sourceIndex));
+		__m128i highBits = _mm_and_si128(data, _mm_set1_epi32((int)0xFFFFFF80));
+		if(_mm_movemask_epi8(_mm_cmpeq_epi32(highBits, zero)) != 0xFFFF) {
+			return 0;
+		}
+		if(dest != fpl_null) {
+			__m128i packed16 = _mm_packs_epi32(data, data);
+			__m128i packed8 = _mm_packus_epi16(packed16, packed16);
+			int value = _mm_cvtsi128_si32(packed8);
+			fplMemoryCopy(&value, 4, (uint8_t *)dest + destIndex);
+		}
+		return 4;
+	}
+#endif // FPL__STRINGS_SSE2
+	return 0;
+}
+
+// Validates and converts the source into the dest, which may be fpl_null to compute the required length only
+fpl_internal bool fpl__ConvertUTF(const void *source, const size_t sourceLen, const fpl__UTFType sourceType, void *dest, const size_t maxDestLen, const fpl__UTFType destType, size_t *outLen) {
+	// First pass validates and computes the exact length
+	size_t requiredLen = 0;
+	size_t sourceIndex = 0;
+	while(sourceIndex < sourceLen) {
+		size_t asciiCount = fpl__ConvertASCIIBlock(source, sourceLen, sourceIndex, sourceType, fpl_null, 0, destType);
+		if(asciiCount > 0) {
+			sourceIndex += asciiCount;
+			requiredLen += asciiCount;
+			continue;
+		}
+		uint32_t cp;
+		size_t startIndex = sourceIndex;
+		if(!fpl__DecodeUTF(source, sourceLen, sourceType, &sourceIndex, &cp)) {
+			fpl__PushError("Invalid UTF-%d sequence at index %zu", (int)sourceType * 8, startIndex);
+			return false;
+		}
+		requiredLen += fpl__EncodeUTF(cp, destType, fpl_null, 0);
+	}
+	*outLen = requiredLen;
+	if(dest == fpl_null) {
+		return true;
+	}
+	size_t minRequiredLen = requiredLen + 1;
+	if(maxDestLen < minRequiredLen) {
+		fpl__ArgumentSizeTooSmallError("Max dest len", maxDestLen, minRequiredLen);
+		return false;
+	}
+
+	// Second pass writes the valid source
+	size_t destIndex = 0;
+	sourceIndex = 0;
+	while(sourceIndex < sourceLen) {
+		size_t asciiCount = fpl__ConvertASCIIBlock(source, sourceLen, sourceIndex, sourceType, dest, destIndex, destType);
+		if(asciiCount > 0) {
+			sourceIndex += asciiCount;
+			destIndex += asciiCount;
+			continue;
+		}
+		uint32_t cp = 0;
+		fpl__DecodeUTF(source, sourceLen, sourceType, &sourceIndex, &cp);
+		destIndex += fpl__EncodeUTF(cp, destType, dest, destIndex);
+	}
+	FPL_ASSERT(destIndex == requiredLen);
+	fpl__EncodeUTF(0, destType, dest, destIndex);
+	return true;
+}
+
+fpl_common_api size_t fplUTF8ToUTF16(const char *utf8Source, const size_t utf8SourceLen, uint16_t *utf16Dest, const size_t maxUtf16DestLen) {
+	if(utf8Source == fpl_null) {
+		fpl__ArgumentNullError("UTF8 source");
+		return 0;
+	}
+	size_t result = 0;
+	if(!fpl__ConvertUTF(utf8Source, utf8SourceLen, fpl__UTFType_8, utf16Dest, maxUtf16DestLen, fpl__UTFType_16, &result)) {
+		return 0;
+	}
+	return(result);
+}
+
+fpl_common_api size_t fplUTF16ToUTF8(const uint16_t *utf16Source, const size_t utf16SourceLen, char *utf8Dest, const size_t maxUtf8DestLen) {
+	if(utf16Source == fpl_null) {
+		fpl__ArgumentNullError("UTF16 source");
+		return 0;
+	}
+	size_t result = 0;
+	if(!fpl__ConvertUTF(utf16Source, utf16SourceLen, fpl__UTFType_16, utf8Dest, maxUtf8DestLen, fpl__UTFType_8, &result)) {
+		return 0;
+	}
+	return(result);
+}
+
+fpl_common_api size_t fplUTF8ToUTF32(const char *utf8Source, const size_t utf8SourceLen, uint32_t *utf32Dest, const size_t maxUtf32DestLen) {
+	if(utf8Source == fpl_null) {
+		fpl__ArgumentNullError("UTF8 source");
+		return 0;
+	}
+	size_t result = 0;
+	if(!fpl__ConvertUTF(utf8Source, utf8SourceLen, fpl__UTFType_8, utf32Dest, maxUtf32DestLen, fpl__UTFType_32, &result)) {
+		return 0;
+	}
+	return(result);
+}
+
+fpl_common_api size_t fplUTF32ToUTF8(const uint32_t *utf32Source, const size_t utf32SourceLen, char *utf8Dest, const size_t maxUtf8DestLen) {
+	if(utf32Source == fpl_null) {
+		fpl__ArgumentNullError("UTF32 source");
+		return 0;
+	}
+	size_t result = 0;
+	if(!fpl__ConvertUTF(utf32Source, utf32SourceLen, fpl__UTFType_32, utf8Dest, maxUtf8DestLen, fpl__UTFType_8, &result)) {
+		return 0;
+	}
+	return(result);
+}
+
+// Converts between UTF-8 and wide strings, with the same argument checks as the public wide string functions
+fpl_internal char *fpl__WideStringToUTF8(const wchar_t *wideSource, const size_t wideSourceLen, char *utf8Dest, const size_t maxUtf8DestLen) {
+	if(wideSource == fpl_null) {
+		fpl__ArgumentNullError("Wide source");
+		return fpl_null;
+	}
+	if(utf8Dest == fpl_null) {
+		fpl__ArgumentNullError("UTF8 dest");
+		return fpl_null;
+	}
+	size_t len;
+	if(!fpl__ConvertUTF(wideSource, wideSourceLen, FPL__WIDE_UTF_TYPE, utf8Dest, maxUtf8DestLen, fpl__UTFType_8, &len)) {
+		return fpl_null;
+	}
+	return(utf8Dest);
+}
+
+fpl_internal wchar_t *fpl__UTF8ToWideString(const char *utf8Source, const size_t utf8SourceLen, wchar_t *wideDest, const size_t maxWideDestLen) {
+	if(utf8Source == fpl_null) {
+		fpl__ArgumentNullError("UTF8 source");
+		return fpl_null;
+	}
+	if(wideDest == fpl_null) {
+		fpl__ArgumentNullError("Wide dest");
+		return fpl_null;
+	}
+	size_t len;
+	if(!fpl__ConvertUTF(utf8Source, utf8SourceLen, fpl__UTFType_8, wideDest, maxWideDestLen, FPL__WIDE_UTF_TYPE, &len)) {
+		return fpl_null;
+	}
+	return(wideDest);
+}
+
+fpl_common_api char *fplCopyAnsiStringLen(const char *source, const size_t sourceLen, char *dest, const size_t maxDestLen) {
+	if(source != fpl_null && dest != fpl_null) {
+		size_t requiredLen = sourceLen + 1;
+		if(maxDestLen < requiredLen) {
+			fpl__ArgumentSizeTooSmallError("Max dest len", maxDestLen, requiredLen);
+			return fpl_null;
+		}
+		char *result = dest;
+		size_t index = 0;
+		while(index++ < sourceLen) {
+			*dest++ = *source++;
+		}
+		*dest = 0;
+		return(result);
+	} else {
+		return(fpl_null);
+	}
+}
+
+fpl_common_api char *fplCopyAnsiString(const char *source, char *dest, const size_t maxDestLen) {
+	char *result = fpl_null;
+	if(source != fpl_null) {
+		size_t sourceLen = fplGetAnsiStringLength(source);
+		result = fplCopyAnsiStringLen(source, sourceLen, dest, maxDestLen);
+	}
+	return(result);
+}
+
+fpl_common_api wchar_t *fplCopyWideStringLen(const wchar_t *source, const size_t sourceLen, wchar_t *dest, const size_t maxDestLen) {
+	if(source != fpl_null && dest != fpl_null) {
+		size_t requiredLen = sourceLen + 1;
+		if(maxDestLen < requiredLen) {
+			fpl__ArgumentSizeTooSmallError("Max dest len", maxDestLen, requiredLen);
+			return fpl_null;
+		}
+		wchar_t *result = dest;
+		size_t index = 0;
+		while(index++ < sourceLen) {
+			*dest++ = *source++;
+		}
+		*dest = 0;
+		return(result);
+	} else {
+		return(fpl_null);
+	}
+}
+
+fpl_common_api wchar_t *fplCopyWideString(const wchar_t *source, wchar_t *dest, const size_t maxDestLen) {
+	wchar_t *result = fpl_null;
+	if(source != fpl_null) {
+		size_t sourceLen = fplGetWideStringLength(source);
+		result = fplCopyWideStringLen(source, sourceLen, dest, maxDestLen);
+	}
+	return(result);
+}
+
+fpl_common_api char *fplFormatAnsiStringArgs(char *ansiDestBuffer, const size_t maxAnsiDestBufferLen, const char *format, va_list argList) {
+	if(ansiDestBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ansi dest buffer");
+		return fpl_null;
+	}
+	if(maxAnsiDestBufferLen == 0) {
+		fpl__ArgumentZeroError("Max ansi dest len");
+		return fpl_null;
+	}
+	if(format == fpl_null) {
+		fpl__ArgumentNullError("Format");
+		return fpl_null;
+	}
+	if(argList == fpl_null) {
+		fpl__ArgumentNullError("Arg list");
+		return fpl_null;
+	}
+	// @NOTE(final): Need to clear the first character, otherwise vsnprintf() does weird things... O_o
+	ansiDestBuffer[0] = 0;
+
+	int charCount = 0;
+#	if defined(FPL_NO_CRT)
+#		if defined(FPL_USERFUNC_vsnprintf)
+	charCount = FPL_USERFUNC_vsnprintf(ansiDestBuffer, maxAnsiDestBufferLen, format, argList);
+#		else
+	charCount = 0;
+#		endif
+#	else
+	charCount = vsnprintf(ansiDestBuffer, maxAnsiDestBufferLen, format, argList);
+#	endif
+
+	if(charCount < 0) {
+		fpl__PushError("Format parameter are '%s' are invalid!", format);
+		return fpl_null;
+	}
+	size_t requiredMaxAnsiDestBufferLen = charCount + 1;
+	if(maxAnsiDestBufferLen < requiredMaxAnsiDestBufferLen) {
+		fpl__ArgumentSizeTooSmallError("Max ansi dest len", maxAnsiDestBufferLen, requiredMaxAnsiDestBufferLen);
+		return fpl_null;
+	}
+	ansiDestBuffer[charCount] = 0;
+	char *result = ansiDestBuffer;
+	return(result);
+}
+
+fpl_common_api char *fplFormatAnsiString(char *ansiDestBuffer, const size_t maxAnsiDestBufferLen, const char *format, ...) {
+	if(ansiDestBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ansi dest buffer");
+		return fpl_null;
+	}
+	if(maxAnsiDestBufferLen == 0) {
+		fpl__ArgumentZeroError("Max ansi dest len");
+		return fpl_null;
+	}
+	if(format == fpl_null) {
+		fpl__ArgumentNullError("Format");
+		return fpl_null;
+	}
+	va_list argList;
+	va_start(argList, format);
+	char *result = fplFormatAnsiStringArgs(ansiDestBuffer, maxAnsiDestBufferLen, format, argList);
+	va_end(argList);
+	return(result);
+}
+#endif // FPL__COMMON_STRINGS_DEFINED
+
+//
+// Common Console
+//
+#if !defined(FPL__COMMON_CONSOLE_DEFINED)
+#define FPL__COMMON_CONSOLE_DEFINED
+
+fpl_common_api void fplConsoleFormatOut(const char *format, ...) {
+	char buffer[1024 * 10];
+	va_list argList;
+	va_start(argList, format);
+	char *str = fplFormatAnsiStringArgs(buffer, FPL_ARRAYCOUNT(buffer), format, argList);
+	va_end(argList);
+	if(str != fpl_null) {
+		fplConsoleOut(str);
+	}
+}
+
+fpl_common_api void fplConsoleFormatError(const char *format, ...) {
+	char buffer[1024];
+	va_list argList;
+	va_start(argList, format);
+	char *str = fplFormatAnsiStringArgs(buffer, FPL_ARRAYCOUNT(buffer), format, argList);
+	va_end(argList);
+	if(str != fpl_null) {
+		fplConsoleError(str);
+	}
+}
+#endif // FPL__COMMON_CONSOLE_DEFINED
+
+//
+// Common Memory
+//
+#if !defined(FPL__COMMON_MEMORY_DEFINED)
+#define FPL__COMMON_MEMORY_DEFINED
+
+fpl_common_api void *fplMemoryAlignedAllocate(const size_t size, const size_t alignment) {
+	if(!size) {
+		fpl__ArgumentZeroError("Size");
+		return fpl_null;
+	}
+	if(!alignment) {
+		fpl__ArgumentZeroError("Alignment");
+		return fpl_null;
+	}
+	if(alignment & (alignment - 1)) {
+		fpl__PushError("Alignment parameter '%zu' must be a power of two", alignment);
+		return fpl_null;
+	}
+
+	// Allocate empty memory to hold a size of a pointer + the actual size + alignment padding 
+	size_t newSize = sizeof(void *) + size + (alignment << 1);
+	void *basePtr = fplMemoryAllocate(newSize);
+
+	// The resulting address starts after the stored base pointer
+	void *alignedPtr = (void *)((uint8_t *)basePtr + sizeof(void *));
 
 	// Move the resulting address to a aligned one when not aligned
 	uintptr_t mask = alignment - 1;
@@ -5513,162 +7174,1673 @@ fpl_common_api void *fplMemoryAlignedAllocate(const size_t size, const size_t al
 		alignedPtr = (uint8_t *)alignedPtr + offset;
 	}
 
-	// Write the base pointer before the alignment pointer
-	*(void **)((void *)((uint8_t *)alignedPtr - sizeof(void *))) = basePtr;
+	// Write the base pointer before the alignment pointer
+	*(void **)((void *)((uint8_t *)alignedPtr - sizeof(void *))) = basePtr;
+
+	// Ensure alignment
+	FPL_ASSERT(FPL_IS_ALIGNED(alignedPtr, alignment));
+
+	return(alignedPtr);
+}
+
+fpl_common_api void fplMemoryAlignedFree(void *ptr) {
+	if(ptr == fpl_null) {
+		fpl__ArgumentNullError("Pointer");
+		return;
+	}
+
+	// Free the base pointer which is stored to the left from the given pointer
+	void *basePtr = *(void **)((void *)((uint8_t *)ptr - sizeof(void *)));
+	FPL_ASSERT(basePtr != fpl_null);
+	fplMemoryFree(basePtr);
+}
+
+#define FPL__MEM_SHIFT_64 3
+#define FPL__MEM_MASK_64 0x00000007
+#define FPL__MEM_SHIFT_32 2
+#define FPL__MEM_MASK_32 0x00000003
+#define FPL__MEM_SHIFT_16 1
+#define FPL__MEM_MASK_16 0x0000000
+
+fpl_common_api void fplMemorySet(void *mem, const uint8_t value, const size_t size) {
+	if(mem == fpl_null) {
+		fpl__ArgumentNullError("Memory");
+		return;
+	}
+	if(size == 0) {
+		fpl__ArgumentSizeTooSmallError("Size", size, 1);
+		return;
+	}
+	if(size % 8 == 0) {
+		FPL__MEMORY_SET(uint64_t, mem, size, FPL__MEM_SHIFT_64, FPL__MEM_MASK_64, value);
+	} else if(size % 4 == 0) {
+		FPL__MEMORY_SET(uint32_t, mem, size, FPL__MEM_SHIFT_32, FPL__MEM_MASK_32, value);
+	} else if(size % 2 == 0) {
+		FPL__MEMORY_SET(uint16_t, mem, size, FPL__MEM_SHIFT_16, FPL__MEM_MASK_16, value);
+	} else {
+		FPL__MEMORY_SET(uint8_t, mem, size, 0, 0, value);
+	}
+}
+
+fpl_common_api void fplMemoryClear(void *mem, const size_t size) {
+	if(mem == fpl_null) {
+		fpl__ArgumentNullError("Memory");
+		return;
+	}
+	if(size == 0) {
+		fpl__ArgumentSizeTooSmallError("Size", size, 1);
+		return;
+	}
+	if(size % 8 == 0) {
+		FPL__MEMORY_SET(uint64_t, mem, size, FPL__MEM_SHIFT_64, FPL__MEM_MASK_64, 0);
+	} else if(size % 4 == 0) {
+		FPL__MEMORY_SET(uint32_t, mem, size, FPL__MEM_SHIFT_32, FPL__MEM_MASK_32, 0);
+	} else if(size % 2 == 0) {
+		FPL__MEMORY_SET(uint16_t, mem, size, FPL__MEM_SHIFT_16, FPL__MEM_MASK_16, 0);
+	} else {
+		FPL__MEMORY_SET(uint8_t, mem, size, 0, 0, 0);
+	}
+}
+
+fpl_common_api void fplMemoryCopy(const void *sourceMem, const size_t sourceSize, void *targetMem) {
+	if(sourceMem == fpl_null) {
+		fpl__ArgumentNullError("Source memory");
+		return;
+	}
+	if(!sourceSize) {
+		fpl__ArgumentZeroError("Source size");
+		return;
+	}
+	if(targetMem == fpl_null) {
+		fpl__ArgumentNullError("Target memory");
+		return;
+	}
+	if(sourceSize % 8 == 0) {
+		FPL__MEMORY_COPY(uint64_t, sourceMem, sourceSize, targetMem, FPL__MEM_SHIFT_64, FPL__MEM_MASK_64);
+	} else if(sourceSize % 4 == 0) {
+		FPL__MEMORY_COPY(uint32_t, sourceMem, sourceSize, targetMem, FPL__MEM_SHIFT_32, FPL__MEM_MASK_32);
+	} else if(sourceSize % 2 == 0) {
+		FPL__MEMORY_COPY(uint16_t, sourceMem, sourceSize, targetMem, FPL__MEM_SHIFT_32, FPL__MEM_MASK_32);
+	} else {
+		FPL__MEMORY_COPY(uint8_t, sourceMem, sourceSize, targetMem, 0, 0);
+	}
+}
+#endif // FPL__COMMON_MEMORY_DEFINED
+
+//
+// Common Atomics
+//
+#if !defined(FPL__COMMON_ATOMICS_DEFINED)
+#define FPL__COMMON_ATOMICS_DEFINED
+
+fpl_common_api void *fplAtomicExchangePtr(volatile void **target, const void *value) {
+	FPL_ASSERT(target != fpl_null);
+#if defined(FPL_ARCH_X64)
+	void *result = (void *)fplAtomicExchangeU64((volatile uint64_t *)target, (uint64_t)value);
+#elif defined(FPL_ARCH_X86)
+	void *result = (void *)fplAtomicExchangeU32((volatile uint32_t *)target, (uint32_t)value);
+#else
+#	error "Unsupported architecture/platform!"
+#endif  // FPL_ARCH
+	return (result);
+}
+
+fpl_common_api void *fplAtomicCompareAndExchangePtr(volatile void **dest, const void *comparand, const void *exchange) {
+	FPL_ASSERT(dest != fpl_null);
+#if defined(FPL_ARCH_X64)
+	void *result = (void *)fplAtomicCompareAndExchangeU64((volatile uint64_t *)dest, (uint64_t)comparand, (uint64_t)exchange);
+#elif defined(FPL_ARCH_X86)
+	void *result = (void *)fplAtomicCompareAndExchangeU32((volatile uint32_t *)dest, (uint32_t)comparand, (uint32_t)exchange);
+#else
+#	error "Unsupported architecture/platform!"
+#endif // FPL_ARCH
+	return (result);
+}
+
+fpl_common_api bool fplIsAtomicCompareAndExchangePtr(volatile void **dest, const void *comparand, const void *exchange) {
+	FPL_ASSERT(dest != fpl_null);
+#if defined(FPL_ARCH_X64)
+	bool result = fplIsAtomicCompareAndExchangeU64((volatile uint64_t *)dest, (uint64_t)comparand, (uint64_t)exchange);
+#elif defined(FPL_ARCH_X86)
+	bool result = fplIsAtomicCompareAndExchangeU32((volatile uint32_t *)dest, (uint32_t)comparand, (uint32_t)exchange);
+#else
+#	error "Unsupported architecture/platform!"
+#endif // FPL_ARCH
+	return (result);
+}
+
+fpl_common_api void *fplAtomicLoadPtr(volatile void **source) {
+#if defined(FPL_ARCH_X64)
+	void *result = (void *)fplAtomicLoadU64((volatile uint64_t *)source);
+#elif defined(FPL_ARCH_X86)
+	void *result = (void *)fplAtomicLoadU32((volatile uint32_t *)source);
+#else
+#	error "Unsupported architecture/platform!"
+#endif  // FPL_ARCH
+	return(result);
+}
+
+fpl_common_api void fplAtomicStorePtr(volatile void **dest, const void *value) {
+#if defined(FPL_ARCH_X64)
+	fplAtomicStoreU64((volatile uint64_t *)dest, (uint64_t)value);
+#elif defined(FPL_ARCH_X86)
+	fplAtomicStoreU32((volatile uint32_t *)dest, (uint32_t)value);
+#else
+#	error "Unsupported architecture/platform!"
+#endif  // FPL_ARCH
+}
+#endif // FPL__COMMON_ATOMICS_DEFINED
+
+//
+// Common Timings
+//
+#if !defined(FPL__COMMON_TIMINGS_DEFINED)
+#define FPL__COMMON_TIMINGS_DEFINED
+
+// Calibration time for the cycle counter frequency in nanoseconds
+#define FPL__CYCLE_COUNTER_CALIBRATION_TIME 20000000ULL
+
+typedef struct fpl__CycleCounterState {
+	volatile uint64_t frequency;
+	volatile uint32_t isDetected;
+	bool hasRdtscp;
+	bool isInvariant;
+} fpl__CycleCounterState;
+
+fpl_globalvar fpl__CycleCounterState fpl__global__CycleCounterState = FPL_ZERO_INIT;
+
+#if defined(FPL_ARCH_X64) || defined(FPL_ARCH_X86)
+fpl_internal void fpl__CPUIDEx(const uint32_t leaf, const uint32_t subLeaf, uint32_t outRegisters[4]) {
+#	if defined(FPL_COMPILER_MSVC)
+	int cpuInfo[4];
+	__cpuidex(cpuInfo, (int)leaf, (int)subLeaf);
+	outRegisters[0] = (uint32_t)cpuInfo[0];
+	outRegisters[1] = (uint32_t)cpuInfo[1];
+	outRegisters[2] = (uint32_t)cpuInfo[2];
+	outRegisters[3] = (uint32_t)cpuInfo[3];
+#	else
+	__asm__ __volatile__("cpuid" : "=a"(outRegisters[0]), "=b"(outRegisters[1]), "=c"(outRegisters[2]), "=d"(outRegisters[3]) : "a"(leaf), "c"(subLeaf));
+#	endif
+}
+fpl_internal void fpl__CPUID(const uint32_t leaf, uint32_t outRegisters[4]) {
+	fpl__CPUIDEx(leaf, 0, outRegisters);
+}
+#endif // FPL_ARCH_X64 || FPL_ARCH_X86
+
+fpl_internal void fpl__DetectCycleCounter() {
+	fpl__CycleCounterState *state = &fpl__global__CycleCounterState;
+	if(fplAtomicLoadU32(&state->isDetected)) {
+		return;
+	}
+#if defined(FPL_ARCH_X64) || defined(FPL_ARCH_X86)
+	uint32_t regs[4];
+	fpl__CPUID(0x80000000, regs);
+	uint32_t maxExtendedLeaf = regs[0];
+	if(maxExtendedLeaf >= 0x80000001) {
+		fpl__CPUID(0x80000001, regs);
+		state->hasRdtscp = (regs[3] & (1 << 27)) != 0;
+	}
+	if(maxExtendedLeaf >= 0x80000007) {
+		fpl__CPUID(0x80000007, regs);
+		state->isInvariant = (regs[3] & (1 << 8)) != 0;
+	}
+#else
+	// @NOTE(final): The fallback is the monotonic clock, which is always invariant
+	state->isInvariant = true;
+#endif
+	fplAtomicStoreU32(&state->isDetected, 1);
+}
+
+fpl_common_api uint64_t fplGetCycleCounter() {
+	fpl__DetectCycleCounter();
+#if defined(FPL_ARCH_X64) || defined(FPL_ARCH_X86)
+	// @NOTE(final): RDTSCP waits for all previous instructions to be executed, so its better for measuring
+#	if defined(FPL_COMPILER_MSVC)
+	if(fpl__global__CycleCounterState.hasRdtscp) {
+		unsigned int aux;
+		return __rdtscp(&aux);
+	}
+	return __rdtsc();
+#	else
+	uint32_t lo, hi;
+	if(fpl__global__CycleCounterState.hasRdtscp) {
+		uint32_t aux;
+		__asm__ __volatile__("rdtscp" : "=a"(lo), "=d"(hi), "=c"(aux));
+	} else {
+		__asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
+	}
+	return ((uint64_t)hi << 32) | (uint64_t)lo;
+#	endif
+#else
+	return fplGetTimeInNanoseconds();
+#endif
+}
+
+fpl_common_api uint64_t fplGetCycleCounterFrequency() {
+	fpl__CycleCounterState *state = &fpl__global__CycleCounterState;
+	uint64_t result = fplAtomicLoadU64(&state->frequency);
+	if(result == 0) {
+#if defined(FPL_ARCH_X64) || defined(FPL_ARCH_X86)
+		// Measure the cycles against the monotonic clock
+		uint64_t startTime = fplGetTimeInNanoseconds();
+		uint64_t startCycles = fplGetCycleCounter();
+		uint64_t elapsedTime;
+		do {
+			elapsedTime = fplGetTimeInNanoseconds() - startTime;
+		} while(elapsedTime < FPL__CYCLE_COUNTER_CALIBRATION_TIME);
+		uint64_t elapsedCycles = fplGetCycleCounter() - startCycles;
+		result = (uint64_t)(((double)elapsedCycles * 1000000000.0) / (double)elapsedTime);
+#else
+		result = 1000000000ULL;
+#endif
+		fplAtomicStoreU64(&state->frequency, result);
+	}
+	return(result);
+}
+
+fpl_common_api bool fplIsCycleCounterInvariant() {
+	fpl__DetectCycleCounter();
+	bool result = fpl__global__CycleCounterState.isInvariant;
+	return(result);
+}
+#endif // FPL__COMMON_TIMINGS_DEFINED
+
+//
+// Common Hardware
+//
+#if !defined(FPL__COMMON_HARDWARE_DEFINED)
+#define FPL__COMMON_HARDWARE_DEFINED
+
+#if defined(FPL_ARCH_X64) || defined(FPL_ARCH_X86)
+fpl_internal uint64_t fpl__XGetBV(const uint32_t index) {
+#	if defined(FPL_COMPILER_MSVC)
+	uint64_t result = _xgetbv(index);
+#	else
+	uint32_t eax, edx;
+	__asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(index));
+	uint64_t result = ((uint64_t)edx << 32) | (uint64_t)eax;
+#	endif
+	return(result);
+}
+
+fpl_internal void fpl__CopyCPUIDRegisterString(char *dest, const uint32_t *regs, const size_t regCount) {
+	for(size_t regIndex = 0; regIndex < regCount; ++regIndex) {
+		for(size_t byteIndex = 0; byteIndex < 4; ++byteIndex) {
+			dest[regIndex * 4 + byteIndex] = (char)((regs[regIndex] >> (byteIndex * 8)) & 0xFF);
+		}
+	}
+}
+
+fpl_internal void fpl__DetectCPUIDCaches(fplCPUInfo *info, const uint32_t maxLeaf, const uint32_t maxExtendedLeaf, const bool isAMD) {
+	uint32_t regs[4];
+
+	// Deterministic cache parameters: Leaf 4 on Intel, leaf 0x8000001D on AMD (TOPOEXT)
+	uint32_t cacheLeaf = 0;
+	if(isAMD) {
+		if(maxExtendedLeaf >= 0x8000001D) {
+			fpl__CPUID(0x80000001, regs);
+			if(regs[2] & (1 << 22)) {
+				cacheLeaf = 0x8000001D;
+			}
+		}
+	} else if(maxLeaf >= 4) {
+		cacheLeaf = 4;
+	}
+	if(cacheLeaf != 0) {
+		for(uint32_t subLeaf = 0; subLeaf < 16; ++subLeaf) {
+			fpl__CPUIDEx(cacheLeaf, subLeaf, regs);
+			uint32_t cacheType = regs[0] & 0x1F;
+			if(cacheType == 0) {
+				break;
+			}
+			uint32_t level = (regs[0] >> 5) & 0x7;
+			uint32_t lineSize = (regs[1] & 0xFFF) + 1;
+			uint32_t partitions = ((regs[1] >> 12) & 0x3FF) + 1;
+			uint32_t ways = ((regs[1] >> 22) & 0x3FF) + 1;
+			uint32_t sets = regs[2] + 1;
+			uint32_t size = ways * partitions * lineSize * sets;
+			if(level == 1 && cacheType == 1) {
+				info->l1DataCacheSize = size;
+			} else if(level == 1 && cacheType == 2) {
+				info->l1InstructionCacheSize = size;
+			} else if(level == 2) {
+				info->l2CacheSize = size;
+			} else if(level == 3) {
+				info->l3CacheSize = size;
+			}
+			if(info->cacheLineSize == 0) {
+				info->cacheLineSize = lineSize;
+			}
+		}
+	} else if(isAMD) {
+		// Legacy AMD cache descriptors
+		if(maxExtendedLeaf >= 0x80000005) {
+			fpl__CPUID(0x80000005, regs);
+			info->l1DataCacheSize = (regs[2] >> 24) * 1024;
+			info->l1InstructionCacheSize = (regs[3] >> 24) * 1024;
+			info->cacheLineSize = regs[2] & 0xFF;
+		}
+		if(maxExtendedLeaf >= 0x80000006) {
+			fpl__CPUID(0x80000006, regs);
+			info->l2CacheSize = (regs[2] >> 16) * 1024;
+			info->l3CacheSize = (regs[3] >> 18) * 512 * 1024;
+		}
+	}
+}
+#endif // FPL_ARCH_X64 || FPL_ARCH_X86
+
+fpl_internal void fpl__DetectCPUInfo(fplCPUInfo *info) {
+	FPL_CLEAR_STRUCT(info);
+#if defined(FPL_ARCH_X64) || defined(FPL_ARCH_X86)
+	uint32_t regs[4];
+	fpl__CPUID(0, regs);
+	uint32_t maxLeaf = regs[0];
+	uint32_t vendorRegs[3] = { regs[1], regs[3], regs[2] };
+	fpl__CopyCPUIDRegisterString(info->vendorName, vendorRegs, FPL_ARRAYCOUNT(vendorRegs));
+	bool isAMD = fplIsStringEqual(info->vendorName, "AuthenticAMD") || fplIsStringEqual(info->vendorName, "HygonGenuine");
+
+	fpl__CPUID(0x80000000, regs);
+	uint32_t maxExtendedLeaf = regs[0];
+	if(maxExtendedLeaf >= 0x80000004) {
+		uint32_t brandRegs[12];
+		for(uint32_t i = 0; i < 3; ++i) {
+			fpl__CPUID(0x80000002 + i, brandRegs + i * 4);
+		}
+		fpl__CopyCPUIDRegisterString(info->brandName, brandRegs, FPL_ARRAYCOUNT(brandRegs));
+		info->brandName[48] = 0;
+		// Some vendors pad the brand string with leading spaces
+		size_t leading = 0;
+		while(info->brandName[leading] == ' ') {
+			++leading;
+		}
+		if(leading > 0) {
+			size_t len = fplGetAnsiStringLength(info->brandName + leading);
+			fplMemoryCopy(info->brandName + leading, len + 1, info->brandName);
+		}
+	}
+
+	fplCPUFeatureFlags features = fplCPUFeatureFlags_None;
+	if(maxLeaf >= 1) {
+		fpl__CPUID(1, regs);
+		uint32_t ecx = regs[2];
+		uint32_t edx = regs[3];
+		if(edx & (1 << 23)) features |= fplCPUFeatureFlags_MMX;
+		if(edx & (1 << 25)) features |= fplCPUFeatureFlags_SSE;
+		if(edx & (1 << 26)) features |= fplCPUFeatureFlags_SSE2;
+		if(ecx & (1 << 0)) features |= fplCPUFeatureFlags_SSE3;
+		if(ecx & (1 << 9)) features |= fplCPUFeatureFlags_SSSE3;
+		if(ecx & (1 << 19)) features |= fplCPUFeatureFlags_SSE4_1;
+		if(ecx & (1 << 20)) features |= fplCPUFeatureFlags_SSE4_2;
+		if(ecx & (1 << 23)) features |= fplCPUFeatureFlags_POPCNT;
+		if(ecx & (1 << 25)) features |= fplCPUFeatureFlags_AES;
+		if(ecx & (1 << 29)) features |= fplCPUFeatureFlags_F16C;
+
+		// @NOTE(final): AVX registers are only usable, when the OS saves them on a context switch (OSXSAVE + XCR0)
+		bool hasAVXState = false;
+		bool hasAVX512State = false;
+		if(ecx & (1 << 27)) {
+			uint64_t xcr0 = fpl__XGetBV(0);
+			hasAVXState = (xcr0 & 0x6) == 0x6;
+			hasAVX512State = (xcr0 & 0xE6) == 0xE6;
+		}
+		if(hasAVXState) {
+			if(ecx & (1 << 28)) features |= fplCPUFeatureFlags_AVX;
+			if(ecx & (1 << 12)) features |= fplCPUFeatureFlags_FMA3;
+		}
+		if(maxLeaf >= 7) {
+			fpl__CPUIDEx(7, 0, regs);
+			uint32_t ebx = regs[1];
+			if(ebx & (1 << 3)) features |= fplCPUFeatureFlags_BMI1;
+			if(ebx & (1 << 8)) features |= fplCPUFeatureFlags_BMI2;
+			if(hasAVXState && (ebx & (1 << 5))) features |= fplCPUFeatureFlags_AVX2;
+			if(hasAVX512State) {
+				if(ebx & (1 << 16)) features |= fplCPUFeatureFlags_AVX512F;
+				if(ebx & (1 << 17)) features |= fplCPUFeatureFlags_AVX512DQ;
+				if(ebx & (1 << 28)) features |= fplCPUFeatureFlags_AVX512CD;
+				if(ebx & (1 << 30)) features |= fplCPUFeatureFlags_AVX512BW;
+				if(ebx & (1u << 31)) features |= fplCPUFeatureFlags_AVX512VL;
+			}
+		}
+	}
+	info->features = features;
+
+	fpl__DetectCPUIDCaches(info, maxLeaf, maxExtendedLeaf, isAMD);
+#elif defined(FPL_ARCH_ARM64) || defined(__ARM_NEON) || defined(__ARM_NEON__)
+	// @NOTE(final): NEON is mandatory on ARM64 and there is no user-mode CPUID on ARM
+	info->features = fplCPUFeatureFlags_NEON;
+#endif
+}
+
+fpl_internal void fpl__FinalizeCPUInfo(fplCPUInfo *info) {
+	if(info->logicalCoreCount == 0) {
+		info->logicalCoreCount = 1;
+	}
+	if(info->physicalCoreCount == 0 || info->physicalCoreCount > info->logicalCoreCount) {
+		info->physicalCoreCount = info->logicalCoreCount;
+	}
+	if(info->packageCount == 0) {
+		info->packageCount = 1;
+	}
+	if(info->numaNodeCount == 0) {
+		info->numaNodeCount = 1;
+	}
+}
+#endif // FPL__COMMON_HARDWARE_DEFINED
+
+//
+// Common Frame Pacer
+//
+#if !defined(FPL__COMMON_FRAMEPACER_DEFINED)
+#define FPL__COMMON_FRAMEPACER_DEFINED
+
+// Frame rate which is used, when the display refresh rate cannot be detected
+#define FPL__DEFAULT_FRAME_RATE 60.0
+
+fpl_common_api void fplFramePacerInit(fplFramePacer *pacer, const double framesPerSecond) {
+	if(pacer == fpl_null) {
+		fpl__ArgumentNullError("Pacer");
+		return;
+	}
+	double rate = framesPerSecond;
+	if(rate <= 0.0) {
+		rate = FPL__DEFAULT_FRAME_RATE;
+#if defined(FPL_PLATFORM_WIN32) && defined(FPL_ENABLE_WINDOW)
+		const fpl__PlatformAppState *appState = fpl__global__AppState;
+		if(appState != fpl_null && appState->window.win32.deviceContext != fpl_null) {
+			int refreshRate = appState->win32.winApi.gdi.GetDeviceCaps(appState->window.win32.deviceContext, VREFRESH);
+			// @NOTE(final): Zero or one means the hardware default, which we dont know
+			if(refreshRate > 1) {
+				rate = (double)refreshRate;
+			}
+		}
+#endif
+	}
+	FPL_CLEAR_STRUCT(pacer);
+	pacer->frameDuration = (uint64_t)(1000000000.0 / rate);
+	pacer->lastFrameTime = fplGetTimeInNanoseconds();
+	pacer->nextFrameTime = pacer->lastFrameTime + pacer->frameDuration;
+}
+
+fpl_common_api bool fplFramePacerWait(fplFramePacer *pacer) {
+	if(pacer == fpl_null) {
+		fpl__ArgumentNullError("Pacer");
+		return false;
+	}
+	bool result = true;
+	uint64_t now = fplGetTimeInNanoseconds();
+	if(now < pacer->nextFrameTime) {
+		fplSleepPrecise(pacer->nextFrameTime - now);
+		now = fplGetTimeInNanoseconds();
+		pacer->nextFrameTime += pacer->frameDuration;
+	} else {
+		// Too late, dont try to catch up with the missed frames
+		result = false;
+		pacer->missedCount++;
+		pacer->nextFrameTime = now + pacer->frameDuration;
+	}
+	pacer->lastFrameDelta = now - pacer->lastFrameTime;
+	pacer->lastFrameTime = now;
+	pacer->frameCount++;
+	return(result);
+}
+#endif // FPL__COMMON_FRAMEPACER_DEFINED
+
+//
+// Common Profiler
+//
+#if defined(FPL_ENABLE_PROFILER)
+#	define FPL__PROFILE_BEGIN(name) fplProfilerBeginZone(name)
+#	define FPL__PROFILE_END() fplProfilerEndZone()
+#else
+#	define FPL__PROFILE_BEGIN(name)
+#	define FPL__PROFILE_END()
+#endif
+
+#if defined(FPL_ENABLE_PROFILER) && !defined(FPL__COMMON_PROFILER_DEFINED)
+#define FPL__COMMON_PROFILER_DEFINED
+
+// Maximum number of threads which can record zones, buffers are not reused when a thread exits
+#define FPL__PROFILER_MAX_THREAD_COUNT 64
+// Maximum number of begin/end events per thread
+#define FPL__PROFILER_MAX_EVENT_COUNT (1 << 16)
+
+typedef struct fpl__ProfilerEvent {
+	// Zone name for begin events, null for end events
+	const char *name;
+	uint64_t cycles;
+} fpl__ProfilerEvent;
+
+typedef struct fpl__ProfilerThreadBuffer {
+	fpl__ProfilerEvent events[FPL__PROFILER_MAX_EVENT_COUNT];
+	volatile uint32_t eventCount;
+	uint32_t threadIndex;
+	uint32_t depth;
+	uint32_t droppedDepth;
+} fpl__ProfilerThreadBuffer;
+
+typedef struct fpl__ProfilerState {
+	fpl__ProfilerThreadBuffer *volatile threadBuffers[FPL__PROFILER_MAX_THREAD_COUNT];
+	volatile uint32_t threadCount;
+	char traceFilePath[1024];
+} fpl__ProfilerState;
+
+fpl_globalvar fpl__ProfilerState fpl__global__ProfilerState = FPL_ZERO_INIT;
+fpl_globalvar fpl__thread_local fpl__ProfilerThreadBuffer *fpl__global__ProfilerThreadBuffer = fpl_null;
+fpl_globalvar fpl__thread_local bool fpl__global__ProfilerThreadFull = false;
+// True while the thread exports the trace, so the instrumented functions used for writing does not record itself
+fpl_globalvar fpl__thread_local bool fpl__global__ProfilerIsExporting = false;
+
+// @NOTE(final): Thread buffers are never freed or handed over to another thread, because the zones of exited threads must still be exported by fplProfilerWriteChromeTrace().
+fpl_internal fpl__ProfilerThreadBuffer *fpl__GetProfilerThreadBuffer() {
+	fpl__ProfilerThreadBuffer *result = fpl__global__ProfilerThreadBuffer;
+	if(result == fpl_null && !fpl__global__ProfilerThreadFull) {
+		fpl__ProfilerState *state = &fpl__global__ProfilerState;
+		uint32_t threadIndex = fplAtomicAddU32(&state->threadCount, 1);
+		if(threadIndex >= FPL__PROFILER_MAX_THREAD_COUNT) {
+			fpl__global__ProfilerThreadFull = true;
+			return fpl_null;
+		}
+		result = (fpl__ProfilerThreadBuffer *)fplMemoryAllocate(sizeof(fpl__ProfilerThreadBuffer));
+		if(result == fpl_null) {
+			fpl__global__ProfilerThreadFull = true;
+			return fpl_null;
+		}
+		result->threadIndex = threadIndex;
+		fplAtomicWriteFence();
+		state->threadBuffers[threadIndex] = result;
+		fpl__global__ProfilerThreadBuffer = result;
+	}
+	return(result);
+}
+
+fpl_internal_inline void fpl__PushProfilerEvent(fpl__ProfilerThreadBuffer *buffer, const char *name, const uint64_t cycles) {
+	// Only the owning thread writes, so we just need to publish the new count after the event
+	uint32_t index = buffer->eventCount;
+	buffer->events[index].name = name;
+	buffer->events[index].cycles = cycles;
+	fplAtomicWriteFence();
+	fplAtomicStoreU32(&buffer->eventCount, index + 1);
+}
+
+fpl_common_api void fplProfilerBeginZone(const char *name) {
+	fpl__ProfilerThreadBuffer *buffer = fpl__GetProfilerThreadBuffer();
+	if(buffer == fpl_null) {
+		return;
+	}
+	// Always keep enough space for ending all open zones, so the trace stays balanced
+	if(fpl__global__ProfilerIsExporting || buffer->droppedDepth > 0 || (buffer->eventCount + buffer->depth + 2) > FPL__PROFILER_MAX_EVENT_COUNT) {
+		buffer->droppedDepth++;
+		return;
+	}
+	buffer->depth++;
+	fpl__PushProfilerEvent(buffer, name != fpl_null ? name : "Unnamed", fplGetCycleCounter());
+}
+
+fpl_common_api void fplProfilerEndZone() {
+	uint64_t cycles = fplGetCycleCounter();
+	fpl__ProfilerThreadBuffer *buffer = fpl__global__ProfilerThreadBuffer;
+	if(buffer == fpl_null) {
+		return;
+	}
+	if(buffer->droppedDepth > 0) {
+		buffer->droppedDepth--;
+		return;
+	}
+	if(buffer->depth == 0) {
+		return;
+	}
+	buffer->depth--;
+	fpl__PushProfilerEvent(buffer, fpl_null, cycles);
+}
+
+fpl_common_api void fplProfilerReset() {
+	fpl__ProfilerState *state = &fpl__global__ProfilerState;
+	uint32_t threadCount = FPL_MIN(fplAtomicLoadU32(&state->threadCount), FPL__PROFILER_MAX_THREAD_COUNT);
+	for(uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+		fpl__ProfilerThreadBuffer *buffer = state->threadBuffers[threadIndex];
+		if(buffer != fpl_null) {
+			fplAtomicStoreU32(&buffer->eventCount, 0);
+			buffer->depth = 0;
+			buffer->droppedDepth = 0;
+		}
+	}
+}
+
+fpl_common_api void fplProfilerSetTraceFilePath(const char *filePath) {
+	fpl__ProfilerState *state = &fpl__global__ProfilerState;
+	if(filePath != fpl_null) {
+		fplCopyAnsiString(filePath, state->traceFilePath, FPL_ARRAYCOUNT(state->traceFilePath));
+	} else {
+		state->traceFilePath[0] = 0;
+	}
+}
+
+// Size of the chunk, the trace is formatted into before it is written to the file
+#define FPL__PROFILER_TRACE_CHUNK_SIZE (64 * 1024)
+
+typedef struct fpl__ProfilerTraceWriter {
+	fplFileHandle file;
+	char *chunk;
+	size_t chunkUsed;
+	bool isFailed;
+} fpl__ProfilerTraceWriter;
+
+fpl_internal void fpl__FlushProfilerTrace(fpl__ProfilerTraceWriter *writer) {
+	if(!writer->isFailed && writer->chunkUsed > 0) {
+		writer->isFailed = fplWriteFileBlock32(&writer->file, writer->chunk, (uint32_t)writer->chunkUsed) != writer->chunkUsed;
+	}
+	writer->chunkUsed = 0;
+}
+
+fpl_internal void fpl__AppendProfilerTrace(fpl__ProfilerTraceWriter *writer, const char *str, const size_t len) {
+	if(writer->chunkUsed + len > FPL__PROFILER_TRACE_CHUNK_SIZE) {
+		fpl__FlushProfilerTrace(writer);
+	}
+	FPL_ASSERT(len <= FPL__PROFILER_TRACE_CHUNK_SIZE);
+	fplMemoryCopy(str, len, writer->chunk + writer->chunkUsed);
+	writer->chunkUsed += len;
+}
+
+// Escapes the given zone name as a JSON string without the quotes, the name is truncated when it does not fit
+fpl_internal void fpl__EscapeProfilerZoneName(const char *name, char *dest, const size_t maxDestLen) {
+	FPL_ASSERT(maxDestLen > 0);
+	const char *hexDigits = "0123456789abcdef";
+	size_t len = 0;
+	for(const char *p = name; *p; ++p) {
+		uint8_t c = (uint8_t)*p;
+		char escaped[6];
+		size_t escapedLen = 0;
+		if(c == '"' || c == '\\') {
+			escaped[escapedLen++] = '\\';
+			escaped[escapedLen++] = (char)c;
+		} else if(c < 0x20) {
+			escaped[escapedLen++] = '\\';
+			escaped[escapedLen++] = 'u';
+			escaped[escapedLen++] = '0';
+			escaped[escapedLen++] = '0';
+			escaped[escapedLen++] = hexDigits[c >> 4];
+			escaped[escapedLen++] = hexDigits[c & 0xF];
+		} else {
+			escaped[escapedLen++] = (char)c;
+		}
+		if(len + escapedLen >= maxDestLen) {
+			break;
+		}
+		fplMemoryCopy(escaped, escapedLen, dest + len);
+		len += escapedLen;
+	}
+	dest[len] = 0;
+}
+
+fpl_common_api bool fplProfilerWriteChromeTrace(const char *filePath) {
+	if(filePath == fpl_null) {
+		fpl__ArgumentNullError("File path");
+		return false;
+	}
+	fpl__ProfilerTraceWriter writer = FPL_ZERO_INIT;
+	writer.chunk = (char *)fplMemoryAllocate(FPL__PROFILER_TRACE_CHUNK_SIZE);
+	if(writer.chunk == fpl_null) {
+		return false;
+	}
+	if(!fplCreateAnsiBinaryFile(filePath, &writer.file)) {
+		fpl__PushError("Failed creating profiler trace file '%s'", filePath);
+		fplMemoryFree(writer.chunk);
+		return false;
+	}
+
+	fpl__ProfilerState *state = &fpl__global__ProfilerState;
+	uint32_t threadCount = FPL_MIN(fplAtomicLoadU32(&state->threadCount), FPL__PROFILER_MAX_THREAD_COUNT);
+	bool wasExporting = fpl__global__ProfilerIsExporting;
+	fpl__global__ProfilerIsExporting = true;
+
+	// Timestamps are relative to the first event of all threads
+	uint64_t baseCycles = UINT64_MAX;
+	for(uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+		const fpl__ProfilerThreadBuffer *buffer = state->threadBuffers[threadIndex];
+		if(buffer != fpl_null && fplAtomicLoadU32((volatile uint32_t *)&buffer->eventCount) > 0) {
+			baseCycles = FPL_MIN(baseCycles, buffer->events[0].cycles);
+		}
+	}
+	double microsecondsPerCycle = 1000000.0 / (double)fplGetCycleCounterFrequency();
+
+	const char *header = "{\"traceEvents\":[\n";
+	fpl__AppendProfilerTrace(&writer, header, fplGetAnsiStringLength(header));
+	bool isFirst = true;
+	char name[256];
+	char line[512];
+	for(uint32_t threadIndex = 0; threadIndex < threadCount && !writer.isFailed; ++threadIndex) {
+		const fpl__ProfilerThreadBuffer *buffer = state->threadBuffers[threadIndex];
+		if(buffer == fpl_null) {
+			continue;
+		}
+		uint32_t eventCount = fplAtomicLoadU32((volatile uint32_t *)&buffer->eventCount);
+		fplAtomicReadFence();
+		for(uint32_t eventIndex = 0; eventIndex < eventCount && !writer.isFailed; ++eventIndex) {
+			const fpl__ProfilerEvent *ev = &buffer->events[eventIndex];
+			double ts = (double)(ev->cycles - baseCycles) * microsecondsPerCycle;
+			const char *separator = isFirst ? "" : ",\n";
+			size_t lineLen;
+			if(ev->name != fpl_null) {
+				fpl__EscapeProfilerZoneName(ev->name, name, FPL_ARRAYCOUNT(name));
+				lineLen = fpl__FormatAnsiStringQuiet(line, FPL_ARRAYCOUNT(line), "%s{\"name\":\"%s\",\"ph\":\"B\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", separator, name, ts, buffer->threadIndex + 1);
+			} else {
+				lineLen = fpl__FormatAnsiStringQuiet(line, FPL_ARRAYCOUNT(line), "%s{\"ph\":\"E\",\"ts\":%.3f,\"pid\":1,\"tid\":%u}", separator, ts, buffer->threadIndex + 1);
+			}
+			fpl__AppendProfilerTrace(&writer, line, lineLen);
+			isFirst = false;
+		}
+	}
+	const char *footer = "\n],\"displayTimeUnit\":\"ms\"}\n";
+	fpl__AppendProfilerTrace(&writer, footer, fplGetAnsiStringLength(footer));
+	fpl__FlushProfilerTrace(&writer);
+	fplCloseFile(&writer.file);
+	fplMemoryFree(writer.chunk);
+	fpl__global__ProfilerIsExporting = wasExporting;
+	bool result = !writer.isFailed;
+	return(result);
+}
+#endif // FPL_ENABLE_PROFILER && !FPL__COMMON_PROFILER_DEFINED
+
+//
+// Common Logging
+//
+#if defined(FPL_ENABLE_LOGGING) && !defined(FPL__COMMON_LOGGING_DEFINED)
+#define FPL__COMMON_LOGGING_DEFINED
+
+// Maximum number of concurrently running threads which gets its own log ring, rings of exited threads are reused
+#define FPL__LOG_MAX_THREAD_COUNT 64
+// Minimum capacity of the log ring for each thread in bytes
+#define FPL__LOG_THREAD_RING_CAPACITY (64 * 1024)
+// Maximum size of a single binary log record in bytes
+#define FPL__LOG_MAX_RECORD_SIZE 1024
+// Maximum length of a formatted log message
+#define FPL__LOG_MAX_MESSAGE_LENGTH 2048
+// Time in milliseconds the log writer thread sleeps between two drains
+#define FPL__LOG_WRITER_INTERVAL 10
+
+// @NOTE(final): A record is the header followed by the arguments in the order of the format string.
+// Every argument uses 8 bytes, strings are stored as 8 bytes length (Including the null terminator) followed by the characters padded to 8 bytes.
+typedef struct fpl__LogRecordHeader {
+	uint64_t time;
+	const char *category;
+	const char *format;
+	// Total size including the header, always a multiple of 8
+	uint32_t size;
+	uint32_t argsSize;
+	uint32_t threadIndex;
+	uint32_t level;
+} fpl__LogRecordHeader;
+
+typedef enum fpl__LogArgType {
+	fpl__LogArgType_None = 0,
+	fpl__LogArgType_Signed,
+	fpl__LogArgType_Unsigned,
+	fpl__LogArgType_Char,
+	fpl__LogArgType_Double,
+	fpl__LogArgType_String,
+	fpl__LogArgType_WideString,
+	fpl__LogArgType_Pointer,
+	fpl__LogArgType_Count,
+} fpl__LogArgType;
+
+typedef enum fpl__LogArgLength {
+	fpl__LogArgLength_Default = 0,
+	fpl__LogArgLength_Char,
+	fpl__LogArgLength_Short,
+	fpl__LogArgLength_Long,
+	fpl__LogArgLength_LongLong,
+	fpl__LogArgLength_IntMax,
+	fpl__LogArgLength_Size,
+	fpl__LogArgLength_PtrDiff,
+	fpl__LogArgLength_LongDouble,
+} fpl__LogArgLength;
+
+typedef struct fpl__LogFormatSpec {
+	// Flags, width and precision without the leading percent sign
+	const char *flags;
+	size_t flagsLen;
+	fpl__LogArgType type;
+	fpl__LogArgLength length;
+	uint32_t starCount;
+	char conversion;
+	bool isValid;
+} fpl__LogFormatSpec;
+
+typedef struct fpl__LogState {
+	fplRingBuffer rings[FPL__LOG_MAX_THREAD_COUNT];
+	fplRingBuffer *volatile activeRings[FPL__LOG_MAX_THREAD_COUNT];
+	// One when a thread owns the ring, zero when the ring can be reused
+	volatile uint32_t ringOwners[FPL__LOG_MAX_THREAD_COUNT];
+	fplFileHandle file;
+	fplThreadHandle *writerThread;
+	volatile uint32_t threadCount;
+	volatile uint32_t droppedCount;
+	volatile uint32_t consumerLock;
+	volatile uint32_t isWriterRunning;
+	volatile uint32_t stopWriter;
+	volatile uint32_t hasSettings;
+	bool isFileOpen;
+} fpl__LogState;
+
+fpl_globalvar fpl__LogState fpl__global__LogState = FPL_ZERO_INIT;
+fpl_globalvar fplLogSettings fpl__global__LogSettings = FPL_ZERO_INIT;
+fpl_globalvar fpl__thread_local fplRingBuffer *fpl__global__LogThreadRing = fpl_null;
+fpl_globalvar fpl__thread_local uint32_t fpl__global__LogThreadIndex = 0;
+fpl_globalvar fpl__thread_local bool fpl__global__LogThreadFull = false;
+
+fpl_internal const char *fpl__ParseLogFormatSpec(const char *p, fpl__LogFormatSpec *spec) {
+	// p points to the first character after the percent sign
+	FPL_CLEAR_STRUCT(spec);
+	spec->flags = p;
+	while(*p == '-' || *p == '+' || *p == ' ' || *p == '#' || *p == '0') {
+		++p;
+	}
+	if(*p == '*') {
+		spec->starCount++;
+		++p;
+	} else {
+		while(*p >= '0' && *p <= '9') {
+			++p;
+		}
+	}
+	if(*p == '.') {
+		++p;
+		if(*p == '*') {
+			spec->starCount++;
+			++p;
+		} else {
+			while(*p >= '0' && *p <= '9') {
+				++p;
+			}
+		}
+	}
+	spec->flagsLen = (size_t)(p - spec->flags);
+	switch(*p) {
+		case 'h':
+			++p;
+			if(*p == 'h') {
+				++p;
+				spec->length = fpl__LogArgLength_Char;
+			} else {
+				spec->length = fpl__LogArgLength_Short;
+			}
+			break;
+		case 'l':
+			++p;
+			if(*p == 'l') {
+				++p;
+				spec->length = fpl__LogArgLength_LongLong;
+			} else {
+				spec->length = fpl__LogArgLength_Long;
+			}
+			break;
+		case 'q':
+			++p;
+			spec->length = fpl__LogArgLength_LongLong;
+			break;
+		case 'j':
+			++p;
+			spec->length = fpl__LogArgLength_IntMax;
+			break;
+		case 'z':
+			++p;
+			spec->length = fpl__LogArgLength_Size;
+			break;
+		case 't':
+			++p;
+			spec->length = fpl__LogArgLength_PtrDiff;
+			break;
+		case 'L':
+			++p;
+			spec->length = fpl__LogArgLength_LongDouble;
+			break;
+		default:
+			break;
+	}
+	spec->conversion = *p;
+	spec->isValid = true;
+	switch(*p) {
+		case 'd':
+		case 'i':
+			spec->type = fpl__LogArgType_Signed;
+			break;
+		case 'u':
+		case 'o':
+		case 'x':
+		case 'X':
+			spec->type = fpl__LogArgType_Unsigned;
+			break;
+		case 'c':
+			spec->type = fpl__LogArgType_Char;
+			break;
+		case 'f':
+		case 'F':
+		case 'e':
+		case 'E':
+		case 'g':
+		case 'G':
+		case 'a':
+		case 'A':
+			spec->type = fpl__LogArgType_Double;
+			break;
+		case 's':
+			spec->type = spec->length == fpl__LogArgLength_Long ? fpl__LogArgType_WideString : fpl__LogArgType_String;
+			break;
+		case 'p':
+			spec->type = fpl__LogArgType_Pointer;
+			break;
+		case 'n':
+			spec->type = fpl__LogArgType_Count;
+			break;
+		case '%':
+			spec->type = fpl__LogArgType_None;
+			break;
+		default:
+			spec->isValid = false;
+			return(p);
+	}
+	++p;
+	return(p);
+}
+
+fpl_internal size_t fpl__EncodeLogRecord(uint8_t *buffer, const size_t maxSize, const fplLogLevel level, const char *category, const char *format, va_list argList) {
+	FPL_ASSERT((maxSize % 8) == 0 && maxSize >= sizeof(fpl__LogRecordHeader));
+	fpl__LogRecordHeader *header = (fpl__LogRecordHeader *)buffer;
+	size_t offset = sizeof(fpl__LogRecordHeader);
 
-	// Ensure alignment
-	FPL_ASSERT(FPL_IS_ALIGNED(alignedPtr, alignment));
+	// @NOTE(final): All va_arg() calls must happen in this function, because a va_list cannot be continued after passing it to another function
+#	define FPL__LOG_PUSH_ARG(value) \
+		if(offset + sizeof(uint64_t) > maxSize) { \
+			isTruncated = true; \
+			break; \
+		} \
+		*(uint64_t *)(buffer + offset) = (uint64_t)(value); \
+		offset += sizeof(uint64_t);
 
-	return(alignedPtr);
+	bool isTruncated = false;
+	const char *p = format;
+	while(*p && !isTruncated) {
+		if(*p++ != '%') {
+			continue;
+		}
+		fpl__LogFormatSpec spec;
+		p = fpl__ParseLogFormatSpec(p, &spec);
+		if(!spec.isValid) {
+			break;
+		}
+		for(uint32_t starIndex = 0; starIndex < spec.starCount; ++starIndex) {
+			int star = va_arg(argList, int);
+			FPL__LOG_PUSH_ARG((int64_t)star);
+		}
+		if(isTruncated) {
+			break;
+		}
+		switch(spec.type) {
+			case fpl__LogArgType_Signed:
+			{
+				int64_t value;
+				switch(spec.length) {
+					case fpl__LogArgLength_Long:
+						value = (int64_t)va_arg(argList, long);
+						break;
+					case fpl__LogArgLength_LongLong:
+						value = (int64_t)va_arg(argList, long long);
+						break;
+					case fpl__LogArgLength_IntMax:
+						value = (int64_t)va_arg(argList, intmax_t);
+						break;
+					case fpl__LogArgLength_Size:
+						value = (int64_t)va_arg(argList, size_t);
+						break;
+					case fpl__LogArgLength_PtrDiff:
+						value = (int64_t)va_arg(argList, ptrdiff_t);
+						break;
+					default:
+						value = (int64_t)va_arg(argList, int);
+						break;
+				}
+				FPL__LOG_PUSH_ARG(value);
+			} break;
+
+			case fpl__LogArgType_Unsigned:
+			{
+				uint64_t value;
+				switch(spec.length) {
+					case fpl__LogArgLength_Long:
+						value = (uint64_t)va_arg(argList, unsigned long);
+						break;
+					case fpl__LogArgLength_LongLong:
+						value = (uint64_t)va_arg(argList, unsigned long long);
+						break;
+					case fpl__LogArgLength_IntMax:
+						value = (uint64_t)va_arg(argList, uintmax_t);
+						break;
+					case fpl__LogArgLength_Size:
+						value = (uint64_t)va_arg(argList, size_t);
+						break;
+					case fpl__LogArgLength_PtrDiff:
+						value = (uint64_t)va_arg(argList, ptrdiff_t);
+						break;
+					default:
+						value = (uint64_t)va_arg(argList, unsigned int);
+						break;
+				}
+				FPL__LOG_PUSH_ARG(value);
+			} break;
+
+			case fpl__LogArgType_Char:
+			{
+				int value = va_arg(argList, int);
+				FPL__LOG_PUSH_ARG(value);
+			} break;
+
+			case fpl__LogArgType_Double:
+			{
+				double value;
+				if(spec.length == fpl__LogArgLength_LongDouble) {
+					value = (double)va_arg(argList, long double);
+				} else {
+					value = va_arg(argList, double);
+				}
+				if(offset + sizeof(double) > maxSize) {
+					isTruncated = true;
+					break;
+				}
+				fplMemoryCopy(&value, sizeof(double), buffer + offset);
+				offset += sizeof(double);
+			} break;
+
+			case fpl__LogArgType_String:
+			{
+				// Strings are copied, because they may not outlive the record
+				const char *str = va_arg(argList, const char *);
+				if(str == fpl_null) {
+					str = "(null)";
+				}
+				if(offset + sizeof(uint64_t) * 2 > maxSize) {
+					isTruncated = true;
+					break;
+				}
+				size_t maxLen = maxSize - offset - sizeof(uint64_t) - 1;
+				size_t len = 0;
+				while(len < maxLen && str[len]) {
+					++len;
+				}
+				FPL__LOG_PUSH_ARG(len + 1);
+				if(len > 0) {
+					fplMemoryCopy(str, len, buffer + offset);
+				}
+				buffer[offset + len] = 0;
+				offset += FPL_ALIGNED_SIZE(len + 1, 8);
+			} break;
+
+			case fpl__LogArgType_WideString:
+			case fpl__LogArgType_Pointer:
+			case fpl__LogArgType_Count:
+			{
+				void *value = va_arg(argList, void *);
+				FPL__LOG_PUSH_ARG((uintptr_t)value);
+			} break;
+
+			default:
+				break;
+		}
+	}
+#	undef FPL__LOG_PUSH_ARG
+
+	FPL_ASSERT((offset % 8) == 0);
+	header->category = category;
+	header->format = format;
+	header->level = (uint32_t)level;
+	header->threadIndex = fpl__global__LogThreadIndex;
+	header->argsSize = (uint32_t)(offset - sizeof(fpl__LogRecordHeader));
+	header->size = (uint32_t)offset;
+#if defined(FPL_PLATFORM_WIN32)
+	// @NOTE(final): The performance frequency is not known before the platform is initialized
+	header->time = fpl__global__InitState.win32.performanceFrequency.QuadPart > 0 ? fplGetTimeInNanoseconds() : 0;
+#else
+	header->time = fplGetTimeInNanoseconds();
+#endif
+	return(offset);
 }
 
-fpl_common_api void fplMemoryAlignedFree(void *ptr) {
-	if(ptr == fpl_null) {
-		fpl__ArgumentNullError("Pointer");
-		return;
+fpl_internal bool fpl__ReadLogArg(const fpl__LogRecordHeader *header, size_t *offset, uint64_t *outValue) {
+	if(*offset + sizeof(uint64_t) > header->argsSize) {
+		return false;
 	}
+	const uint8_t *args = (const uint8_t *)(header + 1);
+	fplMemoryCopy(args + *offset, sizeof(uint64_t), outValue);
+	*offset += sizeof(uint64_t);
+	return true;
+}
 
-	// Free the base pointer which is stored to the left from the given pointer
-	void *basePtr = *(void **)((void *)((uint8_t *)ptr - sizeof(void *)));
-	FPL_ASSERT(basePtr != fpl_null);
-	fplMemoryFree(basePtr);
+fpl_internal size_t fpl__FormatLogRecord(const fpl__LogRecordHeader *header, char *buffer, const size_t maxBufferLen) {
+	FPL_ASSERT(maxBufferLen > 0);
+	const uint8_t *args = (const uint8_t *)(header + 1);
+	size_t argOffset = 0;
+	size_t len = 0;
+	const char *p = header->format;
+	while(*p && (len + 1) < maxBufferLen) {
+		if(*p != '%') {
+			buffer[len++] = *p++;
+			continue;
+		}
+		++p;
+		fpl__LogFormatSpec spec;
+		p = fpl__ParseLogFormatSpec(p, &spec);
+		if(!spec.isValid) {
+			break;
+		}
+		if(spec.type == fpl__LogArgType_None) {
+			buffer[len++] = '%';
+			continue;
+		}
+
+		// Rebuild the format spec with resolved stars and normalized length modifiers
+		char specFormat[64];
+		size_t specLen = 0;
+		bool hasArgs = true;
+		specFormat[specLen++] = '%';
+		for(size_t flagIndex = 0; flagIndex < spec.flagsLen && hasArgs; ++flagIndex) {
+			char c = spec.flags[flagIndex];
+			if(c == '*') {
+				uint64_t star;
+				hasArgs = fpl__ReadLogArg(header, &argOffset, &star);
+				if(hasArgs) {
+					specLen += fpl__FormatAnsiStringQuiet(specFormat + specLen, 16, "%d", (int)(int64_t)star);
+				}
+			} else if(specLen < (FPL_ARRAYCOUNT(specFormat) - 8)) {
+				specFormat[specLen++] = c;
+			}
+		}
+		uint64_t value = 0;
+		if(hasArgs) {
+			hasArgs = fpl__ReadLogArg(header, &argOffset, &value);
+		}
+		if(!hasArgs) {
+			len += fpl__FormatAnsiStringQuiet(buffer + len, maxBufferLen - len, "%s", "<?>");
+			break;
+		}
+		switch(spec.type) {
+			case fpl__LogArgType_Signed:
+			case fpl__LogArgType_Unsigned:
+				specFormat[specLen++] = 'l';
+				specFormat[specLen++] = 'l';
+				specFormat[specLen++] = spec.conversion;
+				specFormat[specLen] = 0;
+				if(spec.type == fpl__LogArgType_Signed) {
+					len += fpl__FormatAnsiStringQuiet(buffer + len, maxBufferLen - len, specFormat, (long long)(int64_t)value);
+				} else {
+					len += fpl__FormatAnsiStringQuiet(buffer + len, maxBufferLen - len, specFormat, (unsigned long long)value);
+				}
+				break;
+			case fpl__LogArgType_Char:
+				specFormat[specLen++] = 'c';
+				specFormat[specLen] = 0;
+				len += fpl__FormatAnsiStringQuiet(buffer + len, maxBufferLen - len, specFormat, (int)value);
+				break;
+			case fpl__LogArgType_Double:
+			{
+				double d;
+				fplMemoryCopy(&value, sizeof(double), &d);
+				specFormat[specLen++] = spec.conversion;
+				specFormat[specLen] = 0;
+				len += fpl__FormatAnsiStringQuiet(buffer + len, maxBufferLen - len, specFormat, d);
+			} break;
+			case fpl__LogArgType_String:
+			{
+				const char *str = (const char *)(args + argOffset);
+				argOffset += FPL_ALIGNED_SIZE((size_t)value, 8);
+				specFormat[specLen++] = 's';
+				specFormat[specLen] = 0;
+				len += fpl__FormatAnsiStringQuiet(buffer + len, maxBufferLen - len, specFormat, str);
+			} break;
+			case fpl__LogArgType_WideString:
+				len += fpl__FormatAnsiStringQuiet(buffer + len, maxBufferLen - len, "%s", "(wide string)");
+				break;
+			case fpl__LogArgType_Pointer:
+				specFormat[specLen++] = 'p';
+				specFormat[specLen] = 0;
+				len += fpl__FormatAnsiStringQuiet(buffer + len, maxBufferLen - len, specFormat, (void *)(uintptr_t)value);
+				break;
+			default:
+				break;
+		}
+	}
+	buffer[len] = 0;
+	return(len);
+}
+
+fpl_internal void fpl__WriteLogRecord(fpl__LogState *state, const fpl__LogRecordHeader *header) {
+	const fplLogSettings *settings = &fpl__global__LogSettings;
+	char message[FPL__LOG_MAX_MESSAGE_LENGTH];
+	fpl__FormatLogRecord(header, message, FPL_ARRAYCOUNT(message));
+	fplLogLevel level = (fplLogLevel)header->level;
+	const char *category = header->category != fpl_null ? header->category : "";
+	char line[FPL__LOG_MAX_MESSAGE_LENGTH + 256];
+	if(settings->sinks & fplLogSinkFlags_Console) {
+		fpl__FormatAnsiStringQuiet(line, FPL_ARRAYCOUNT(line), "[%s] %s\n", category, message);
+		if(level <= fplLogLevel_Error) {
+			fplConsoleError(line);
+		} else {
+			fplConsoleOut(line);
+		}
+	}
+	if((settings->sinks & fplLogSinkFlags_File) && state->isFileOpen) {
+		size_t lineLen = fpl__FormatAnsiStringQuiet(line, FPL_ARRAYCOUNT(line), "%.6f %-8s #%u [%s] %s\n", (double)header->time / 1000000000.0, fplGetLogLevelString(level), header->threadIndex, category, message);
+		fplWriteFileBlock32(&state->file, line, (uint32_t)lineLen);
+	}
+	if((settings->sinks & fplLogSinkFlags_Custom) && settings->callback != fpl_null) {
+		fplLogEntry entry = FPL_ZERO_INIT;
+		entry.time = header->time;
+		entry.category = category;
+		entry.message = message;
+		entry.level = level;
+		entry.threadIndex = header->threadIndex;
+		settings->callback(&entry, settings->userData);
+	}
 }
 
-#define FPL__MEM_SHIFT_64 3
-#define FPL__MEM_MASK_64 0x00000007
-#define FPL__MEM_SHIFT_32 2
-#define FPL__MEM_MASK_32 0x00000003
-#define FPL__MEM_SHIFT_16 1
-#define FPL__MEM_MASK_16 0x0000000
+fpl_internal void fpl__LockLogConsumer(fpl__LogState *state) {
+	// @NOTE(final): Spin lock, because this must work before the platform is initialized as well
+	while(fplAtomicCompareAndExchangeU32(&state->consumerLock, 0, 1) != 0) {
+		fplThreadSleep(0);
+	}
+}
 
-fpl_common_api void fplMemorySet(void *mem, const uint8_t value, const size_t size) {
-	if(mem == fpl_null) {
-		fpl__ArgumentNullError("Memory");
-		return;
+fpl_internal void fpl__UnlockLogConsumer(fpl__LogState *state) {
+	fplAtomicStoreU32(&state->consumerLock, 0);
+}
+
+fpl_internal bool fpl__PeekLogRecordHeader(fplRingBuffer *ring, fpl__LogRecordHeader *outHeader) {
+	// Only the consumer changes the read index, so we can read it directly
+	uint64_t readIndex = ring->readIndex;
+	uint64_t writeIndex = fplAtomicLoadU64(&ring->writeIndex);
+	size_t available = (size_t)(writeIndex - readIndex);
+	if(available < sizeof(fpl__LogRecordHeader)) {
+		return false;
 	}
-	if(size == 0) {
-		fpl__ArgumentSizeTooSmallError("Size", size, 1);
-		return;
+	fplAtomicReadFence();
+	// The header may wrap around, when the ring is not mirrored
+	size_t offset = (size_t)readIndex & ring->mask;
+	size_t firstSize = ring->capacity - offset;
+	if(firstSize > sizeof(fpl__LogRecordHeader)) {
+		firstSize = sizeof(fpl__LogRecordHeader);
 	}
-	if(size % 8 == 0) {
-		FPL__MEMORY_SET(uint64_t, mem, size, FPL__MEM_SHIFT_64, FPL__MEM_MASK_64, value);
-	} else if(size % 4 == 0) {
-		FPL__MEMORY_SET(uint32_t, mem, size, FPL__MEM_SHIFT_32, FPL__MEM_MASK_32, value);
-	} else if(size % 2 == 0) {
-		FPL__MEMORY_SET(uint16_t, mem, size, FPL__MEM_SHIFT_16, FPL__MEM_MASK_16, value);
-	} else {
-		FPL__MEMORY_SET(uint8_t, mem, size, 0, 0, value);
+	fplMemoryCopy(ring->data + offset, firstSize, outHeader);
+	if(firstSize < sizeof(fpl__LogRecordHeader)) {
+		fplMemoryCopy(ring->data, sizeof(fpl__LogRecordHeader) - firstSize, (uint8_t *)outHeader + firstSize);
 	}
+	bool result = available >= outHeader->size;
+	return(result);
 }
 
-fpl_common_api void fplMemoryClear(void *mem, const size_t size) {
-	if(mem == fpl_null) {
-		fpl__ArgumentNullError("Memory");
+// Writes all pending records from all threads ordered by time, the consumer lock must be held
+fpl_internal void fpl__DrainLogRecords(fpl__LogState *state) {
+	uint32_t threadCount = FPL_MIN(fplAtomicLoadU32(&state->threadCount), FPL__LOG_MAX_THREAD_COUNT);
+	uint64_t record[FPL__LOG_MAX_RECORD_SIZE / sizeof(uint64_t)];
+	for(;;) {
+		fplRingBuffer *bestRing = fpl_null;
+		fpl__LogRecordHeader bestHeader;
+		for(uint32_t threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+			fplRingBuffer *ring = state->activeRings[threadIndex];
+			fpl__LogRecordHeader header;
+			if(ring != fpl_null && fpl__PeekLogRecordHeader(ring, &header)) {
+				if(bestRing == fpl_null || header.time < bestHeader.time) {
+					bestRing = ring;
+					bestHeader = header;
+				}
+			}
+		}
+		if(bestRing == fpl_null) {
+			break;
+		}
+		FPL_ASSERT(bestHeader.size <= sizeof(record));
+		fplRingBufferRead(bestRing, record, bestHeader.size);
+		fpl__WriteLogRecord(state, (const fpl__LogRecordHeader *)record);
+	}
+}
+
+// @NOTE(final): Rings are never freed, because the consumer may still drain it.
+// Instead a ring is handed over to the next thread, when its owning thread has exited, see fpl__ReleaseLogThreadRing().
+fpl_internal fplRingBuffer *fpl__GetLogThreadRing(fpl__LogState *state) {
+	fplRingBuffer *result = fpl__global__LogThreadRing;
+	if(result == fpl_null && !fpl__global__LogThreadFull) {
+		// Reuse a released ring first, which is already mapped
+		uint32_t threadIndex;
+		uint32_t threadCount = FPL_MIN(fplAtomicLoadU32(&state->threadCount), FPL__LOG_MAX_THREAD_COUNT);
+		for(threadIndex = 0; threadIndex < threadCount; ++threadIndex) {
+			if(state->activeRings[threadIndex] != fpl_null && fplAtomicCompareAndExchangeU32(&state->ringOwners[threadIndex], 0, 1) == 0) {
+				result = state->activeRings[threadIndex];
+				break;
+			}
+		}
+		if(result == fpl_null) {
+			threadIndex = fplAtomicAddU32(&state->threadCount, 1);
+			if(threadIndex >= FPL__LOG_MAX_THREAD_COUNT) {
+				fpl__global__LogThreadFull = true;
+				return fpl_null;
+			}
+			result = &state->rings[threadIndex];
+			if(!fplRingBufferInit(result, FPL__LOG_THREAD_RING_CAPACITY)) {
+				fpl__global__LogThreadFull = true;
+				return fpl_null;
+			}
+			fplAtomicStoreU32(&state->ringOwners[threadIndex], 1);
+			fplAtomicWriteFence();
+			state->activeRings[threadIndex] = result;
+		}
+		fpl__global__LogThreadRing = result;
+		fpl__global__LogThreadIndex = threadIndex + 1;
+	}
+	return(result);
+}
+
+// Called when a thread created by fplThreadCreate() exits, pending records in the ring are still written by the consumer
+fpl_internal void fpl__ReleaseLogThreadRing(fpl__LogState *state) {
+	if(fpl__global__LogThreadRing != fpl_null) {
+		uint32_t threadIndex = fpl__global__LogThreadIndex - 1;
+		FPL_ASSERT(threadIndex < FPL__LOG_MAX_THREAD_COUNT && state->activeRings[threadIndex] == fpl__global__LogThreadRing);
+		fpl__global__LogThreadRing = fpl_null;
+		fpl__global__LogThreadIndex = 0;
+		fplAtomicStoreU32(&state->ringOwners[threadIndex], 0);
+	}
+	fpl__global__LogThreadFull = false;
+}
+
+fpl_common_api void fplSetDefaultLogSettings(fplLogSettings *settings) {
+	if(settings == fpl_null) {
+		fpl__ArgumentNullError("Settings");
 		return;
 	}
-	if(size == 0) {
-		fpl__ArgumentSizeTooSmallError("Size", size, 1);
+	FPL_CLEAR_STRUCT(settings);
+	settings->sinks = fplLogSinkFlags_Console;
+	settings->maxLevel = fplLogLevel_Debug;
+}
+
+// @NOTE(final): Logging works before the platform is initialized, so the default settings are applied on the first use
+fpl_internal void fpl__EnsureLogSettings(fpl__LogState *state) {
+	if(fplAtomicLoadU32(&state->hasSettings) == 0) {
+		fpl__LockLogConsumer(state);
+		if(state->hasSettings == 0) {
+			fplSetDefaultLogSettings(&fpl__global__LogSettings);
+			fplAtomicStoreU32(&state->hasSettings, 1);
+		}
+		fpl__UnlockLogConsumer(state);
+	}
+}
+
+fpl_common_api void fplSetLogSettings(const fplLogSettings *settings) {
+	if(settings == fpl_null) {
+		fpl__ArgumentNullError("Settings");
 		return;
 	}
-	if(size % 8 == 0) {
-		FPL__MEMORY_SET(uint64_t, mem, size, FPL__MEM_SHIFT_64, FPL__MEM_MASK_64, 0);
-	} else if(size % 4 == 0) {
-		FPL__MEMORY_SET(uint32_t, mem, size, FPL__MEM_SHIFT_32, FPL__MEM_MASK_32, 0);
-	} else if(size % 2 == 0) {
-		FPL__MEMORY_SET(uint16_t, mem, size, FPL__MEM_SHIFT_16, FPL__MEM_MASK_16, 0);
-	} else {
-		FPL__MEMORY_SET(uint8_t, mem, size, 0, 0, 0);
+	fpl__LogState *state = &fpl__global__LogState;
+	fpl__LockLogConsumer(state);
+	fpl__DrainLogRecords(state);
+	if(state->isFileOpen) {
+		fplCloseFile(&state->file);
+		state->isFileOpen = false;
+	}
+	fpl__global__LogSettings = *settings;
+	fplAtomicStoreU32(&state->hasSettings, 1);
+	if((settings->sinks & fplLogSinkFlags_File) && fplGetAnsiStringLength(settings->filePath) > 0) {
+		state->isFileOpen = fplCreateAnsiBinaryFile(settings->filePath, &state->file);
+		if(!state->isFileOpen) {
+			fpl__PushError("Failed creating log file '%s'", settings->filePath);
+		}
 	}
+	fpl__UnlockLogConsumer(state);
 }
 
-fpl_common_api void fplMemoryCopy(const void *sourceMem, const size_t sourceSize, void *targetMem) {
-	if(sourceMem == fpl_null) {
-		fpl__ArgumentNullError("Source memory");
+fpl_common_api void fplLogFlush() {
+	fpl__LogState *state = &fpl__global__LogState;
+	fpl__LockLogConsumer(state);
+	fpl__DrainLogRecords(state);
+	fpl__UnlockLogConsumer(state);
+}
+
+fpl_common_api uint32_t fplGetLogDroppedCount() {
+	uint32_t result = fplAtomicLoadU32(&fpl__global__LogState.droppedCount);
+	return(result);
+}
+
+fpl_common_api void fplLogWrite(const fplLogLevel level, const char *category, const char *format, ...) {
+	if(format == fpl_null) {
 		return;
 	}
-	if(!sourceSize) {
-		fpl__ArgumentZeroError("Source size");
+	fpl__LogState *state = &fpl__global__LogState;
+	fpl__EnsureLogSettings(state);
+	if((uint32_t)level > fplAtomicLoadU32((volatile uint32_t *)&fpl__global__LogSettings.maxLevel)) {
 		return;
 	}
-	if(targetMem == fpl_null) {
-		fpl__ArgumentNullError("Target memory");
+	fplRingBuffer *ring = fpl__GetLogThreadRing(state);
+
+	uint64_t record[FPL__LOG_MAX_RECORD_SIZE / sizeof(uint64_t)];
+	va_list argList;
+	va_start(argList, format);
+	size_t recordSize = fpl__EncodeLogRecord((uint8_t *)record, sizeof(record), level, category, format, argList);
+	va_end(argList);
+
+	if(ring == fpl_null) {
+		// No ring for this thread, so we write it directly
+		fpl__LockLogConsumer(state);
+		fpl__WriteLogRecord(state, (const fpl__LogRecordHeader *)record);
+		fpl__UnlockLogConsumer(state);
 		return;
 	}
-	if(sourceSize % 8 == 0) {
-		FPL__MEMORY_COPY(uint64_t, sourceMem, sourceSize, targetMem, FPL__MEM_SHIFT_64, FPL__MEM_MASK_64);
-	} else if(sourceSize % 4 == 0) {
-		FPL__MEMORY_COPY(uint32_t, sourceMem, sourceSize, targetMem, FPL__MEM_SHIFT_32, FPL__MEM_MASK_32);
-	} else if(sourceSize % 2 == 0) {
-		FPL__MEMORY_COPY(uint16_t, sourceMem, sourceSize, targetMem, FPL__MEM_SHIFT_32, FPL__MEM_MASK_32);
+
+	bool isWriterRunning = fplAtomicLoadU32(&state->isWriterRunning) != 0;
+	if(!isWriterRunning && fplRingBufferGetWriteAvailable(ring) < recordSize) {
+		fplLogFlush();
+	}
+	if(fplRingBufferGetWriteAvailable(ring) >= recordSize) {
+		fplRingBufferWrite(ring, record, recordSize);
 	} else {
-		FPL__MEMORY_COPY(uint8_t, sourceMem, sourceSize, targetMem, 0, 0);
+		fplAtomicAddU32(&state->droppedCount, 1);
+	}
+
+	// Without a writer thread, the log is written immediately
+	if(!isWriterRunning) {
+		fplLogFlush();
+	}
+}
+
+fpl_internal void fpl__LogWriterThreadProc(const fplThreadHandle *thread, void *data) {
+	(void)thread;
+	fpl__LogState *state = (fpl__LogState *)data;
+	while(!fplAtomicLoadU32(&state->stopWriter)) {
+		fplLogFlush();
+		fplThreadSleep(FPL__LOG_WRITER_INTERVAL);
+	}
+}
+
+fpl_internal void fpl__StartLogWriter() {
+	fpl__LogState *state = &fpl__global__LogState;
+	FPL_ASSERT(state->writerThread == fpl_null);
+	fplAtomicStoreU32(&state->stopWriter, 0);
+	state->writerThread = fplThreadCreate(fpl__LogWriterThreadProc, state);
+	if(state->writerThread != fpl_null) {
+		fplAtomicStoreU32(&state->isWriterRunning, 1);
+	}
+}
+
+fpl_internal void fpl__StopLogWriter() {
+	fpl__LogState *state = &fpl__global__LogState;
+	if(state->writerThread != fpl_null) {
+		fplAtomicStoreU32(&state->isWriterRunning, 0);
+		fplAtomicStoreU32(&state->stopWriter, 1);
+		fplThreadWaitForOne(state->writerThread, FPL_TIMEOUT_INFINITE);
+		fplThreadTerminate(state->writerThread);
+		state->writerThread = fpl_null;
+	}
+	fplLogFlush();
+}
+#endif // FPL_ENABLE_LOGGING && !FPL__COMMON_LOGGING_DEFINED
+
+//
+// Common Ring Buffer
+//
+#if !defined(FPL__COMMON_RINGBUFFER_DEFINED)
+#define FPL__COMMON_RINGBUFFER_DEFINED
+
+fpl_internal size_t fpl__ComputeRingBufferCapacity(const size_t minCapacity, const size_t granularity) {
+	// @NOTE(final): The capacity must be a power of two, so positions can be wrapped with a simple mask.
+	// Granularity is the page size or the allocation granularity, which is always a power of two as well.
+	size_t result = granularity > 0 ? granularity : 1;
+	while(result < minCapacity) {
+		if(result > (SIZE_MAX >> 2)) {
+			return 0;
+		}
+		result <<= 1;
+	}
+	return(result);
+}
+
+fpl_common_api size_t fplRingBufferGetReadAvailable(fplRingBuffer *ringBuffer) {
+	if(ringBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ring buffer");
+		return 0;
+	}
+	uint64_t writeIndex = fplAtomicLoadU64(&ringBuffer->writeIndex);
+	uint64_t readIndex = fplAtomicLoadU64(&ringBuffer->readIndex);
+	size_t result = (size_t)(writeIndex - readIndex);
+	return(result);
+}
+
+fpl_common_api size_t fplRingBufferGetWriteAvailable(fplRingBuffer *ringBuffer) {
+	if(ringBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ring buffer");
+		return 0;
+	}
+	uint64_t writeIndex = fplAtomicLoadU64(&ringBuffer->writeIndex);
+	uint64_t readIndex = fplAtomicLoadU64(&ringBuffer->readIndex);
+	size_t result = ringBuffer->capacity - (size_t)(writeIndex - readIndex);
+	return(result);
+}
+
+fpl_common_api uint8_t *fplRingBufferBeginWrite(fplRingBuffer *ringBuffer, size_t *outSize) {
+	if(ringBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ring buffer");
+		return fpl_null;
+	}
+	if(outSize == fpl_null) {
+		fpl__ArgumentNullError("Out size");
+		return fpl_null;
+	}
+	FPL_ASSERT(ringBuffer->data != fpl_null);
+
+	// @NOTE(final): Only the producer changes the write index, so we can read it directly.
+	uint64_t writeIndex = ringBuffer->writeIndex;
+	uint64_t readIndex = fplAtomicLoadU64(&ringBuffer->readIndex);
+	size_t available = ringBuffer->capacity - (size_t)(writeIndex - readIndex);
+	size_t offset = (size_t)writeIndex & ringBuffer->mask;
+	if(!ringBuffer->isMirrored) {
+		size_t contiguous = ringBuffer->capacity - offset;
+		if(available > contiguous) {
+			available = contiguous;
+		}
+	}
+	*outSize = available;
+	uint8_t *result = available > 0 ? ringBuffer->data + offset : fpl_null;
+	return(result);
+}
+
+fpl_common_api void fplRingBufferEndWrite(fplRingBuffer *ringBuffer, const size_t size) {
+	if(ringBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ring buffer");
+		return;
 	}
+	FPL_ASSERT(size <= fplRingBufferGetWriteAvailable(ringBuffer));
+
+	// Make sure the written data is visible before the consumer sees the new write index
+	fplAtomicWriteFence();
+	fplAtomicStoreU64(&ringBuffer->writeIndex, ringBuffer->writeIndex + size);
 }
-#endif // FPL__COMMON_MEMORY_DEFINED
 
-//
-// Common Atomics
-//
-#if !defined(FPL__COMMON_ATOMICS_DEFINED)
-#define FPL__COMMON_ATOMICS_DEFINED
+fpl_common_api const uint8_t *fplRingBufferBeginRead(fplRingBuffer *ringBuffer, size_t *outSize) {
+	if(ringBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ring buffer");
+		return fpl_null;
+	}
+	if(outSize == fpl_null) {
+		fpl__ArgumentNullError("Out size");
+		return fpl_null;
+	}
+	FPL_ASSERT(ringBuffer->data != fpl_null);
 
-fpl_common_api void *fplAtomicExchangePtr(volatile void **target, const void *value) {
-	FPL_ASSERT(target != fpl_null);
-#if defined(FPL_ARCH_X64)
-	void *result = (void *)fplAtomicExchangeU64((volatile uint64_t *)target, (uint64_t)value);
-#elif defined(FPL_ARCH_X86)
-	void *result = (void *)fplAtomicExchangeU32((volatile uint32_t *)target, (uint32_t)value);
-#else
-#	error "Unsupported architecture/platform!"
-#endif  // FPL_ARCH
-	return (result);
-}
+	// @NOTE(final): Only the consumer changes the read index, so we can read it directly.
+	uint64_t readIndex = ringBuffer->readIndex;
+	uint64_t writeIndex = fplAtomicLoadU64(&ringBuffer->writeIndex);
 
-fpl_common_api void *fplAtomicCompareAndExchangePtr(volatile void **dest, const void *comparand, const void *exchange) {
-	FPL_ASSERT(dest != fpl_null);
-#if defined(FPL_ARCH_X64)
-	void *result = (void *)fplAtomicCompareAndExchangeU64((volatile uint64_t *)dest, (uint64_t)comparand, (uint64_t)exchange);
-#elif defined(FPL_ARCH_X86)
-	void *result = (void *)fplAtomicCompareAndExchangeU32((volatile uint32_t *)dest, (uint32_t)comparand, (uint32_t)exchange);
-#else
-#	error "Unsupported architecture/platform!"
-#endif // FPL_ARCH
-	return (result);
+	// Make sure we dont read any data before the write index is loaded
+	fplAtomicReadFence();
+
+	size_t available = (size_t)(writeIndex - readIndex);
+	size_t offset = (size_t)readIndex & ringBuffer->mask;
+	if(!ringBuffer->isMirrored) {
+		size_t contiguous = ringBuffer->capacity - offset;
+		if(available > contiguous) {
+			available = contiguous;
+		}
+	}
+	*outSize = available;
+	const uint8_t *result = available > 0 ? ringBuffer->data + offset : fpl_null;
+	return(result);
 }
 
-fpl_common_api bool fplIsAtomicCompareAndExchangePtr(volatile void **dest, const void *comparand, const void *exchange) {
-	FPL_ASSERT(dest != fpl_null);
-#if defined(FPL_ARCH_X64)
-	bool result = fplIsAtomicCompareAndExchangeU64((volatile uint64_t *)dest, (uint64_t)comparand, (uint64_t)exchange);
-#elif defined(FPL_ARCH_X86)
-	bool result = fplIsAtomicCompareAndExchangeU32((volatile uint32_t *)dest, (uint32_t)comparand, (uint32_t)exchange);
-#else
-#	error "Unsupported architecture/platform!"
-#endif // FPL_ARCH
-	return (result);
+fpl_common_api void fplRingBufferEndRead(fplRingBuffer *ringBuffer, const size_t size) {
+	if(ringBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ring buffer");
+		return;
+	}
+	FPL_ASSERT(size <= fplRingBufferGetReadAvailable(ringBuffer));
+
+	// Make sure we are done reading the data before the producer sees the new read index
+	fplAtomicReadWriteFence();
+	fplAtomicStoreU64(&ringBuffer->readIndex, ringBuffer->readIndex + size);
 }
 
-fpl_common_api void *fplAtomicLoadPtr(volatile void **source) {
-#if defined(FPL_ARCH_X64)
-	void *result = (void *)fplAtomicLoadU64((volatile uint64_t *)source);
-#elif defined(FPL_ARCH_X86)
-	void *result = (void *)fplAtomicLoadU32((volatile uint32_t *)source);
-#else
-#	error "Unsupported architecture/platform!"
-#endif  // FPL_ARCH
+fpl_common_api size_t fplRingBufferWrite(fplRingBuffer *ringBuffer, const void *sourceMem, const size_t sourceSize) {
+	if(sourceMem == fpl_null) {
+		fpl__ArgumentNullError("Source memory");
+		return 0;
+	}
+	size_t result = 0;
+	while(result < sourceSize) {
+		size_t regionSize;
+		uint8_t *region = fplRingBufferBeginWrite(ringBuffer, &regionSize);
+		if(region == fpl_null) {
+			break;
+		}
+		size_t bytesToCopy = FPL_MIN(regionSize, sourceSize - result);
+		fplMemoryCopy((const uint8_t *)sourceMem + result, bytesToCopy, region);
+		fplRingBufferEndWrite(ringBuffer, bytesToCopy);
+		result += bytesToCopy;
+	}
 	return(result);
 }
 
-fpl_common_api void fplAtomicStorePtr(volatile void **dest, const void *value) {
-#if defined(FPL_ARCH_X64)
-	fplAtomicStoreU64((volatile uint64_t *)dest, (uint64_t)value);
-#elif defined(FPL_ARCH_X86)
-	fplAtomicStoreU32((volatile uint32_t *)dest, (uint32_t)value);
-#else
-#	error "Unsupported architecture/platform!"
-#endif  // FPL_ARCH
+fpl_common_api size_t fplRingBufferRead(fplRingBuffer *ringBuffer, void *targetMem, const size_t targetSize) {
+	if(targetMem == fpl_null) {
+		fpl__ArgumentNullError("Target memory");
+		return 0;
+	}
+	size_t result = 0;
+	while(result < targetSize) {
+		size_t regionSize;
+		const uint8_t *region = fplRingBufferBeginRead(ringBuffer, &regionSize);
+		if(region == fpl_null) {
+			break;
+		}
+		size_t bytesToCopy = FPL_MIN(regionSize, targetSize - result);
+		fplMemoryCopy(region, bytesToCopy, (uint8_t *)targetMem + result);
+		fplRingBufferEndRead(ringBuffer, bytesToCopy);
+		result += bytesToCopy;
+	}
+	return(result);
 }
-#endif // FPL__COMMON_ATOMICS_DEFINED
+#endif // FPL__COMMON_RINGBUFFER_DEFINED
 
 //
 // Common Paths
@@ -5698,14 +8870,8 @@ fpl_common_api char *fplExtractFilePath(const char *sourcePath, char *destPath,
 
 	char *result = fpl_null;
 	if(sourcePath) {
-		int copyLen = 0;
-		char *chPtr = (char *)sourcePath;
-		while(*chPtr) {
-			if(*chPtr == FPL__PATH_SEPARATOR) {
-				copyLen = (int)(chPtr - sourcePath);
-			}
-			++chPtr;
-		}
+		const char *lastPathSeparatorPtr = fplFindLastChar(sourcePath, FPL__PATH_SEPARATOR);
+		size_t copyLen = lastPathSeparatorPtr != fpl_null ? (size_t)(lastPathSeparatorPtr - sourcePath) : 0;
 		if(copyLen) {
 			result = fplCopyAnsiStringLen(sourcePath, copyLen, destPath, maxDestLen);
 		}
@@ -5718,14 +8884,7 @@ fpl_common_api const char *fplExtractFileExtension(const char *sourcePath) {
 	if(sourcePath != fpl_null) {
 		const char *filename = fplExtractFileName(sourcePath);
 		if(filename) {
-			const char *chPtr = filename;
-			while(*chPtr) {
-				if(*chPtr == FPL__FILE_EXT_SEPARATOR) {
-					result = chPtr;
-					break;
-				}
-				++chPtr;
-			}
+			result = fplFindChar(filename, FPL__FILE_EXT_SEPARATOR);
 		}
 	}
 	return(result);
@@ -5734,14 +8893,8 @@ fpl_common_api const char *fplExtractFileExtension(const char *sourcePath) {
 fpl_common_api const char *fplExtractFileName(const char *sourcePath) {
 	const char *result = fpl_null;
 	if(sourcePath) {
-		result = sourcePath;
-		const char *chPtr = sourcePath;
-		while(*chPtr) {
-			if(*chPtr == FPL__PATH_SEPARATOR) {
-				result = chPtr + 1;
-			}
-			++chPtr;
-		}
+		const char *lastPathSeparatorPtr = fplFindLastChar(sourcePath, FPL__PATH_SEPARATOR);
+		result = lastPathSeparatorPtr != fpl_null ? lastPathSeparatorPtr + 1 : sourcePath;
 	}
 	return(result);
 }
@@ -5775,28 +8928,11 @@ fpl_common_api char *fplChangeFileExtension(const char *filePath, const char *ne
 	char *result = fpl_null;
 	if(filePath != fpl_null) {
 		// Find last path
-		char *chPtr = (char *)filePath;
-		char *lastPathSeparatorPtr = fpl_null;
-		while(*chPtr) {
-			if(*chPtr == FPL__PATH_SEPARATOR) {
-				lastPathSeparatorPtr = chPtr;
-			}
-			++chPtr;
-		}
+		const char *lastPathSeparatorPtr = fplFindLastChar(filePath, FPL__PATH_SEPARATOR);
 
 		// Find last ext separator
-		if(lastPathSeparatorPtr != fpl_null) {
-			chPtr = lastPathSeparatorPtr + 1;
-		} else {
-			chPtr = (char *)filePath;
-		}
-		char *lastExtSeparatorPtr = fpl_null;
-		while(*chPtr) {
-			if(*chPtr == FPL__FILE_EXT_SEPARATOR) {
-				lastExtSeparatorPtr = chPtr;
-			}
-			++chPtr;
-		}
+		const char *fileNamePtr = lastPathSeparatorPtr != fpl_null ? lastPathSeparatorPtr + 1 : filePath;
+		const char *lastExtSeparatorPtr = fplFindLastChar(fileNamePtr, FPL__FILE_EXT_SEPARATOR);
 
 		size_t copyLen;
 		if(lastExtSeparatorPtr != fpl_null) {
@@ -5856,9 +8992,16 @@ fpl_common_api char *fplPathCombine(char *destPath, const size_t maxDestPathLen,
 #if !defined(FPL__COMMON_WINDOW_DEFINED)
 #define FPL__COMMON_WINDOW_DEFINED
 
+#if defined(FPL_ENABLE_AUDIO)
+fpl_internal void fpl__PushPendingAudioEvents();
+#endif
+
 fpl_common_api bool fplPollEvent(fplEvent *ev) {
 	fpl__PlatformAppState *appState = fpl__global__AppState;
 	FPL_ASSERT(appState != fpl_null);
+#if defined(FPL_ENABLE_AUDIO)
+	fpl__PushPendingAudioEvents();
+#endif
 	fpl__EventQueue *eventQueue = &appState->window.eventQueue;
 	bool result = false;
 	if(eventQueue->pushCount > 0 && (eventQueue->pollIndex < eventQueue->pushCount)) {
@@ -5886,29 +9029,37 @@ fpl_common_api void fplClearEvents() {
 fpl_common_api const char *fplGetPlatformError() {
 	const char *result = "";
 	const fpl__ErrorState *errorState = &fpl__global__LastErrorState;
-#	if defined(FPL_ENABLE_MULTIPLE_ERRORSTATES)
 	if(errorState->count > 0) {
-		size_t index = errorState->count - 1;
-		result = fplGetPlatformErrorFromIndex(index);
+		result = fpl__GetErrorMessage(fpl__GetErrorEntry(errorState->count - 1));
 	}
-#	else
-	result = errorState.errors[0];
-#	endif // FPL_ENABLE_MULTIPLE_ERRORSTATES
 	return (result);
 }
 
 fpl_common_api const char *fplGetPlatformErrorFromIndex(const size_t index) {
 	const char *result = "";
 	const fpl__ErrorState *errorState = &fpl__global__LastErrorState;
-#if defined(FPL_ENABLE_MULTIPLE_ERRORSTATES)
+	if(errorState->count > 0) {
+		size_t actualIndex = index < errorState->count ? index : errorState->count - 1;
+		result = fpl__GetErrorMessage(fpl__GetErrorEntry(actualIndex));
+	}
+	return (result);
+}
+
+fpl_common_api fplPlatformErrorType fplGetPlatformErrorType() {
+	fplPlatformErrorType result = fplPlatformErrorType_None;
+	const fpl__ErrorState *errorState = &fpl__global__LastErrorState;
+	if(errorState->count > 0) {
+		result = fpl__GetErrorEntry(errorState->count - 1)->type;
+	}
+	return (result);
+}
+
+fpl_common_api fplPlatformErrorType fplGetPlatformErrorTypeFromIndex(const size_t index) {
+	fplPlatformErrorType result = fplPlatformErrorType_None;
+	const fpl__ErrorState *errorState = &fpl__global__LastErrorState;
 	if(index < errorState->count) {
-		result = errorState->errors[index];
-	} else {
-		result = errorState->errors[errorState->count - 1];
+		result = fpl__GetErrorEntry(index)->type;
 	}
-#else
-	result = errorState->errors[0];
-#endif // FPL_ENABLE_MULTIPLE_ERRORSTATES
 	return (result);
 }
 
@@ -5921,7 +9072,8 @@ fpl_common_api size_t fplGetPlatformErrorCount() {
 
 fpl_common_api void fplClearPlatformErrors() {
 	fpl__ErrorState *errorState = &fpl__global__LastErrorState;
-	FPL_CLEAR_STRUCT(errorState);
+	errorState->writeIndex = 0;
+	errorState->count = 0;
 }
 
 fpl_common_api const fplSettings *fplGetCurrentSettings() {
@@ -7584,9 +10736,76 @@ fpl_platform_api char *fplGetProcessorName(char *destBuffer, const size_t maxDes
 	return(destBuffer);
 }
 
+fpl_platform_api bool fplGetCPUInfo(fplCPUInfo *outInfo) {
+	if(outInfo == fpl_null) {
+		fpl__ArgumentNullError("Out info");
+		return false;
+	}
+	fpl__DetectCPUInfo(outInfo);
+
+	DWORD bufferSize = 0;
+	GetLogicalProcessorInformation(fpl_null, &bufferSize);
+	SYSTEM_LOGICAL_PROCESSOR_INFORMATION *procInfos = fpl_null;
+	if(bufferSize > 0) {
+		procInfos = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION *)fplMemoryAllocate(bufferSize);
+	}
+	if(procInfos != fpl_null && GetLogicalProcessorInformation(procInfos, &bufferSize)) {
+		size_t count = bufferSize / sizeof(SYSTEM_LOGICAL_PROCESSOR_INFORMATION);
+		for(size_t i = 0; i < count; ++i) {
+			const SYSTEM_LOGICAL_PROCESSOR_INFORMATION *procInfo = &procInfos[i];
+			switch(procInfo->Relationship) {
+				case RelationProcessorCore:
+				{
+					++outInfo->physicalCoreCount;
+					ULONG_PTR mask = procInfo->ProcessorMask;
+					while(mask) {
+						outInfo->logicalCoreCount += (uint32_t)(mask & 1);
+						mask >>= 1;
+					}
+				} break;
+				case RelationNumaNode:
+					++outInfo->numaNodeCount;
+					break;
+				case RelationProcessorPackage:
+					++outInfo->packageCount;
+					break;
+				case RelationCache:
+				{
+					const CACHE_DESCRIPTOR *cache = &procInfo->Cache;
+					if(cache->Level == 1 && cache->Type == CacheData) {
+						outInfo->l1DataCacheSize = cache->Size;
+					} else if(cache->Level == 1 && cache->Type == CacheInstruction) {
+						outInfo->l1InstructionCacheSize = cache->Size;
+					} else if(cache->Level == 2) {
+						outInfo->l2CacheSize = cache->Size;
+					} else if(cache->Level == 3) {
+						outInfo->l3CacheSize = cache->Size;
+					}
+					if(cache->LineSize > 0) {
+						outInfo->cacheLineSize = cache->LineSize;
+					}
+				} break;
+				default:
+					break;
+			}
+		}
+	} else {
+		outInfo->logicalCoreCount = (uint32_t)fplGetProcessorCoreCount();
+	}
+	if(procInfos != fpl_null) {
+		fplMemoryFree(procInfos);
+	}
+
+	fpl__FinalizeCPUInfo(outInfo);
+	return true;
+}
+
 //
 // Win32 Threading
 //
+// Time in nanoseconds which fplSleepPrecise() spins, because Sleep() is not that precise
+#define FPL__WIN32_SLEEP_PRECISE_SPIN_TIME 2000000ULL
+
 fpl_internal DWORD WINAPI fpl__Win32ThreadProc(void *data) {
 	fplThreadHandle *thread = (fplThreadHandle *)data;
 	FPL_ASSERT(thread != fpl_null);
@@ -7594,6 +10813,9 @@ fpl_internal DWORD WINAPI fpl__Win32ThreadProc(void *data) {
 	if(thread->runFunc != fpl_null) {
 		thread->runFunc(thread, thread->data);
 	}
+#if defined(FPL_ENABLE_LOGGING)
+	fpl__ReleaseLogThreadRing(&fpl__global__LogState);
+#endif
 	HANDLE handle = thread->internalHandle.win32ThreadHandle;
 	CloseHandle(handle);
 	thread->internalHandle.win32ThreadHandle = fpl_null;
@@ -7630,6 +10852,24 @@ fpl_platform_api void fplThreadSleep(const uint32_t milliseconds) {
 	Sleep((DWORD)milliseconds);
 }
 
+fpl_platform_api void fplSleepPrecise(const uint64_t nanoseconds) {
+	uint64_t deadline = fplGetTimeInNanoseconds() + nanoseconds;
+	// @NOTE(final): Sleep() may overshoot up to a full scheduler quantum, so we keep this amount for spinning
+	const uint64_t spinTime = FPL__WIN32_SLEEP_PRECISE_SPIN_TIME;
+	for(;;) {
+		uint64_t now = fplGetTimeInNanoseconds();
+		if(now >= deadline) {
+			break;
+		}
+		uint64_t remaining = deadline - now;
+		if(remaining > spinTime) {
+			Sleep((DWORD)((remaining - spinTime) / 1000000ULL));
+		} else {
+			YieldProcessor();
+		}
+	}
+}
+
 fpl_platform_api bool fplThreadTerminate(fplThreadHandle *thread) {
 	if(thread == fpl_null) {
 		fpl__ArgumentNullError("Thread");
@@ -7938,6 +11178,95 @@ fpl_platform_api void fplMemoryFree(void *ptr) {
 	VirtualFree(ptr, 0, MEM_FREE);
 }
 
+//
+// Win32 Ring Buffer
+//
+fpl_platform_api bool fplRingBufferInit(fplRingBuffer *ringBuffer, const size_t minCapacity) {
+	if(ringBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ring buffer");
+		return false;
+	}
+	if(minCapacity == 0) {
+		fpl__ArgumentZeroError("Min capacity");
+		return false;
+	}
+	FPL_CLEAR_STRUCT(ringBuffer);
+
+	SYSTEM_INFO sysInfo;
+	GetSystemInfo(&sysInfo);
+	size_t capacity = fpl__ComputeRingBufferCapacity(minCapacity, sysInfo.dwAllocationGranularity);
+	if(capacity == 0) {
+		fpl__ArgumentSizeTooBigError("Min capacity", minCapacity, SIZE_MAX >> 2);
+		return false;
+	}
+
+	// Map the same pagefile section twice in a row, so reads and writes never wrap
+	// @NOTE(final): There is no way to map a view into a reserved region without VirtualAlloc2 (Win10+),
+	// so we look for a free address range and try to map both views there. Another thread may steal the range in between, so we retry.
+	uint8_t *data = fpl_null;
+	HANDLE mappingHandle = CreateFileMappingW(INVALID_HANDLE_VALUE, fpl_null, PAGE_READWRITE, (DWORD)((uint64_t)capacity >> 32), (DWORD)(capacity & 0xFFFFFFFF), fpl_null);
+	if(mappingHandle != fpl_null) {
+		for(int attempt = 0; attempt < 16; ++attempt) {
+			uint8_t *address = (uint8_t *)VirtualAlloc(fpl_null, capacity * 2, MEM_RESERVE, PAGE_NOACCESS);
+			if(address == fpl_null) {
+				break;
+			}
+			VirtualFree(address, 0, MEM_RELEASE);
+			void *firstView = MapViewOfFileEx(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, capacity, address);
+			void *secondView = fpl_null;
+			if(firstView == address) {
+				secondView = MapViewOfFileEx(mappingHandle, FILE_MAP_ALL_ACCESS, 0, 0, capacity, address + capacity);
+				if(secondView == address + capacity) {
+					data = address;
+					break;
+				}
+			}
+			if(secondView != fpl_null) {
+				UnmapViewOfFile(secondView);
+			}
+			if(firstView != fpl_null) {
+				UnmapViewOfFile(firstView);
+			}
+		}
+		if(data != fpl_null) {
+			ringBuffer->internalHandle.win32MappingHandle = mappingHandle;
+			ringBuffer->isMirrored = true;
+		} else {
+			CloseHandle(mappingHandle);
+		}
+	}
+
+	// Fallback to a single allocation, reads and writes will wrap
+	if(data == fpl_null) {
+		data = (uint8_t *)fplMemoryAllocate(capacity);
+		if(data == fpl_null) {
+			return false;
+		}
+	}
+
+	ringBuffer->data = data;
+	ringBuffer->capacity = capacity;
+	ringBuffer->mask = capacity - 1;
+	return true;
+}
+
+fpl_platform_api void fplRingBufferRelease(fplRingBuffer *ringBuffer) {
+	if(ringBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ring buffer");
+		return;
+	}
+	if(ringBuffer->data != fpl_null) {
+		if(ringBuffer->isMirrored) {
+			UnmapViewOfFile(ringBuffer->data + ringBuffer->capacity);
+			UnmapViewOfFile(ringBuffer->data);
+			CloseHandle(ringBuffer->internalHandle.win32MappingHandle);
+		} else {
+			fplMemoryFree(ringBuffer->data);
+		}
+	}
+	FPL_CLEAR_STRUCT(ringBuffer);
+}
+
 //
 // Win32 Files
 //
@@ -8022,9 +11351,11 @@ fpl_platform_api uint32_t fplReadFileBlock32(const fplFileHandle *fileHandle, co
 	uint32_t result = 0;
 	HANDLE win32FileHandle = (HANDLE)fileHandle->internalHandle.win32FileHandle;
 	DWORD bytesRead = 0;
+	FPL__PROFILE_BEGIN("fplReadFileBlock32");
 	if(ReadFile(win32FileHandle, targetBuffer, (DWORD)sizeToRead, &bytesRead, fpl_null) == TRUE) {
 		result = bytesRead;
 	}
+	FPL__PROFILE_END();
 	return(result);
 }
 
@@ -8048,9 +11379,11 @@ fpl_platform_api uint32_t fplWriteFileBlock32(const fplFileHandle *fileHandle, v
 	uint32_t result = 0;
 	HANDLE win32FileHandle = (HANDLE)fileHandle->internalHandle.win32FileHandle;
 	DWORD bytesWritten = 0;
+	FPL__PROFILE_BEGIN("fplWriteFileBlock32");
 	if(WriteFile(win32FileHandle, sourceBuffer, (DWORD)sourceSize, &bytesWritten, fpl_null) == TRUE) {
 		result = bytesWritten;
 	}
+	FPL__PROFILE_END();
 	return(result);
 }
 
@@ -8387,7 +11720,7 @@ fpl_platform_api double fplGetTimeInMillisecondsHP() {
 	const fpl__Win32InitState *initState = &fpl__global__InitState.win32;
 	LARGE_INTEGER time;
 	QueryPerformanceCounter(&time);
-	double result = (double)(time.QuadPart / initState->performanceFrequency.QuadPart) * 1000.0;
+	double result = (time.QuadPart / (double)initState->performanceFrequency.QuadPart) * 1000.0;
 	return(result);
 }
 
@@ -8401,6 +11734,17 @@ fpl_platform_api uint64_t fplGetTimeInMilliseconds() {
 	return(result);
 }
 
+fpl_platform_api uint64_t fplGetTimeInNanoseconds() {
+	const fpl__Win32InitState *initState = &fpl__global__InitState.win32;
+	LARGE_INTEGER time;
+	QueryPerformanceCounter(&time);
+	// Split into seconds and remainder, so the multiplication cannot overflow
+	uint64_t frequency = (uint64_t)initState->performanceFrequency.QuadPart;
+	uint64_t counter = (uint64_t)time.QuadPart;
+	uint64_t result = (counter / frequency) * 1000000000ULL + ((counter % frequency) * 1000000000ULL) / frequency;
+	return(result);
+}
+
 //
 // Win32 Strings
 //
@@ -8424,23 +11768,8 @@ fpl_platform_api char *fplWideStringToAnsiString(const wchar_t *wideSource, cons
 	return(ansiDest);
 }
 fpl_platform_api char *fplWideStringToUTF8String(const wchar_t *wideSource, const size_t maxWideSourceLen, char *utf8Dest, const size_t maxUtf8DestLen) {
-	if(wideSource == fpl_null) {
-		fpl__ArgumentNullError("Wide source");
-		return fpl_null;
-	}
-	if(utf8Dest == fpl_null) {
-		fpl__ArgumentNullError("UTF8 dest");
-		return fpl_null;
-	}
-	int requiredLen = WideCharToMultiByte(CP_UTF8, 0, wideSource, (int)maxWideSourceLen, fpl_null, 0, fpl_null, fpl_null);
-	size_t minRequiredLen = requiredLen + 1;
-	if(maxUtf8DestLen < minRequiredLen) {
-		fpl__ArgumentSizeTooSmallError("Max utf8 dest len", maxUtf8DestLen, minRequiredLen);
-		return fpl_null;
-	}
-	WideCharToMultiByte(CP_UTF8, 0, wideSource, (int)maxWideSourceLen, utf8Dest, (int)maxUtf8DestLen, fpl_null, fpl_null);
-	utf8Dest[requiredLen] = 0;
-	return(utf8Dest);
+	char *result = fpl__WideStringToUTF8(wideSource, maxWideSourceLen, utf8Dest, maxUtf8DestLen);
+	return(result);
 }
 fpl_platform_api wchar_t *fplAnsiStringToWideString(const char *ansiSource, const size_t ansiSourceLen, wchar_t *wideDest, const size_t maxWideDestLen) {
 	if(ansiSource == fpl_null) {
@@ -8462,23 +11791,8 @@ fpl_platform_api wchar_t *fplAnsiStringToWideString(const char *ansiSource, cons
 	return(wideDest);
 }
 fpl_platform_api wchar_t *fplUTF8StringToWideString(const char *utf8Source, const size_t utf8SourceLen, wchar_t *wideDest, const size_t maxWideDestLen) {
-	if(utf8Source == fpl_null) {
-		fpl__ArgumentNullError("UTF8 source");
-		return fpl_null;
-	}
-	if(wideDest == fpl_null) {
-		fpl__ArgumentNullError("Wide dest");
-		return fpl_null;
-	}
-	int requiredLen = MultiByteToWideChar(CP_UTF8, 0, utf8Source, (int)utf8SourceLen, fpl_null, 0);
-	size_t minRequiredLen = requiredLen + 1;
-	if(maxWideDestLen < minRequiredLen) {
-		fpl__ArgumentSizeTooSmallError("Max wide dest len", maxWideDestLen, minRequiredLen);
-		return fpl_null;
-	}
-	MultiByteToWideChar(CP_UTF8, 0, utf8Source, (int)utf8SourceLen, wideDest, (int)maxWideDestLen);
-	wideDest[requiredLen] = 0;
-	return(wideDest);
+	wchar_t *result = fpl__UTF8ToWideString(utf8Source, utf8SourceLen, wideDest, maxWideDestLen);
+	return(result);
 }
 
 //
@@ -8768,6 +12082,8 @@ fpl_platform_api bool fplWindowUpdate() {
 
 	bool result = false;
 
+	FPL__PROFILE_BEGIN("fplWindowUpdate");
+
 	// Poll gamepad controller states
 	fpl__Win32PollControllers(&appState->currentSettings, win32InitState, &win32AppState->xinput);
 
@@ -8781,6 +12097,8 @@ fpl_platform_api bool fplWindowUpdate() {
 		result = appState->window.isRunning;
 	}
 
+	FPL__PROFILE_END();
+
 	return(result);
 }
 
@@ -8911,16 +12229,36 @@ int WINAPI WinMain(HINSTANCE appInstance, HINSTANCE prevInstance, LPSTR cmdLine,
 #if defined(FPL_SUBPLATFORM_POSIX)
 fpl_internal void fpl__PosixReleaseSubplatform(fpl__PosixAppState *appState) {
 	fpl__PThreadUnloadApi(&appState->pthreadApi);
+	fplAtomicStoreU32(&appState->pthreadApiState, FPL__POSIX_LAZYAPI_UNLOADED);
 }
 
 fpl_internal bool fpl__PosixInitSubplatform(const fplInitFlags initFlags, const fplSettings *initSettings, fpl__PosixInitState *initState, fpl__PosixAppState *appState) {
-	if(!fpl__PThreadLoadApi(&appState->pthreadApi)) {
-		fpl__PushError("Failed initializing PThread API");
-		return false;
-	}
+	// @NOTE(final): The pthread api is loaded on its first use, see fpl__PosixGetPThreadApi()
+	fplAtomicStoreU32(&appState->pthreadApiState, FPL__POSIX_LAZYAPI_UNLOADED);
 	return true;
 }
 
+// Returns the pthread api and loads it on the first call
+fpl_internal const fpl__PThreadApi *fpl__PosixGetPThreadApi() {
+	fpl__PlatformAppState *appState = fpl__global__AppState;
+	if(appState == fpl_null) {
+		fpl__PushError("Platform is not initialized");
+		return fpl_null;
+	}
+	fpl__PosixAppState *posixState = &appState->posix;
+	if(fpl__PosixBeginLazyLoad(&posixState->pthreadApiState)) {
+		bool loaded = fpl__PThreadLoadApi(&posixState->pthreadApi);
+		if(loaded) {
+			FPL_LOG("POSIX", "Loaded PThread api in %.3f ms", (double)fpl__global__PThreadLibraryProbe.loadTime / 1000000.0);
+		} else {
+			fpl__PushError("Failed loading PThread API");
+		}
+		fpl__PosixEndLazyLoad(&posixState->pthreadApiState, loaded);
+	}
+	const fpl__PThreadApi *result = fpl__PosixIsLazyLoaded(&posixState->pthreadApiState) ? &posixState->pthreadApi : fpl_null;
+	return(result);
+}
+
 void *fpl__PosixThreadProc(void *data) {
 	FPL_ASSERT(fpl__global__AppState != fpl_null);
 	const fpl__PThreadApi *pthreadApi = &fpl__global__AppState->posix.pthreadApi;
@@ -8930,6 +12268,9 @@ void *fpl__PosixThreadProc(void *data) {
 	if(thread->runFunc != fpl_null) {
 		thread->runFunc(thread, thread->data);
 	}
+#if defined(FPL_ENABLE_LOGGING)
+	fpl__ReleaseLogThreadRing(&fpl__global__LogState);
+#endif
 	fplAtomicStoreU32((volatile uint32_t *)&thread->currentState, (uint32_t)fplThreadState_Stopped);
 	pthreadApi->pthread_exit(data);
 	return 0;
@@ -9183,9 +12524,7 @@ fpl_platform_api uint64_t fplGetTimeInSecondsLP() {
 }
 
 fpl_platform_api double fplGetTimeInSeconds() {
-	struct timeval  tv;
-	gettimeofday(&tv, fpl_null);
-	double result = (double)tv.tv_sec + ((double)tv.tv_usec * 1e-6);
+	double result = fplGetTimeInSecondsHP();
 	return(result);
 }
 
@@ -9202,25 +12541,37 @@ fpl_platform_api uint64_t fplGetTimeInMillisecondsLP() {
 }
 
 fpl_platform_api uint64_t fplGetTimeInMilliseconds() {
-	struct timeval  tv;
-	gettimeofday(&tv, fpl_null);
-	uint64_t result = tv.tv_sec * 1000 + ((uint64_t)tv.tv_usec / 1000);
+	// @NOTE(final): gettimeofday() is not monotonic, it jumps when the system time changes
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	uint64_t result = (uint64_t)t.tv_sec * 1000ULL + ((uint64_t)t.tv_nsec / 1000000ULL);
+	return(result);
+}
+
+// @NOTE(final): clock_nanosleep() does not accept CLOCK_MONOTONIC_RAW, so fplGetTimeInNanoseconds() and fplSleepPrecise() both use CLOCK_MONOTONIC to share the same deadlines
+#define FPL__POSIX_PRECISE_CLOCK CLOCK_MONOTONIC
+
+fpl_platform_api uint64_t fplGetTimeInNanoseconds() {
+	struct timespec t;
+	clock_gettime(FPL__POSIX_PRECISE_CLOCK, &t);
+	uint64_t result = (uint64_t)t.tv_sec * 1000000000ULL + (uint64_t)t.tv_nsec;
 	return(result);
 }
 
 //
 // POSIX Threading
 //
+// Time in nanoseconds which fplSleepPrecise() spins after waking up
+#define FPL__POSIX_SLEEP_PRECISE_SPIN_TIME 100000ULL
+
 fpl_platform_api bool fplThreadTerminate(fplThreadHandle *thread) {
 	if(thread == fpl_null) {
 		fpl__ArgumentNullError("Thread");
 		return false;
 	}
 	FPL_ASSERT(fpl__global__AppState != fpl_null);
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return false;
 	}
 	if(thread->isValid && (fplGetThreadState(thread) != fplThreadState_Stopped)) {
@@ -9238,10 +12589,8 @@ fpl_platform_api bool fplThreadTerminate(fplThreadHandle *thread) {
 
 fpl_platform_api fplThreadHandle *fplThreadCreate(fpl_run_thread_function *runFunc, void *data) {
 	FPL_ASSERT(fpl__global__AppState != fpl_null);
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return fpl_null;
 	}
 	fplThreadHandle *result = fpl_null;
@@ -9277,10 +12626,8 @@ fpl_platform_api fplThreadHandle *fplThreadCreate(fpl_run_thread_function *runFu
 }
 
 fpl_platform_api bool fplThreadWaitForOne(fplThreadHandle *thread, const fplTimeoutValue timeout) {
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return false;
 	}
 	bool result = false;
@@ -9306,6 +12653,28 @@ fpl_platform_api bool fplThreadWaitForAny(fplThreadHandle *threads[], const size
 	return(result);
 }
 
+fpl_platform_api void fplSleepPrecise(const uint64_t nanoseconds) {
+	// @NOTE(final): Using an absolute deadline, so interrupted sleeps does not drift
+	struct timespec deadline;
+	clock_gettime(FPL__POSIX_PRECISE_CLOCK, &deadline);
+	uint64_t target = (uint64_t)deadline.tv_sec * 1000000000ULL + (uint64_t)deadline.tv_nsec + nanoseconds;
+	if(nanoseconds > FPL__POSIX_SLEEP_PRECISE_SPIN_TIME) {
+		uint64_t wakeup = target - FPL__POSIX_SLEEP_PRECISE_SPIN_TIME;
+		deadline.tv_sec = (time_t)(wakeup / 1000000000ULL);
+		deadline.tv_nsec = (long)(wakeup % 1000000000ULL);
+		while(clock_nanosleep(FPL__POSIX_PRECISE_CLOCK, TIMER_ABSTIME, &deadline, fpl_null) == EINTR) {
+		}
+	}
+	// Spin the remaining time
+	for(;;) {
+		struct timespec now;
+		clock_gettime(FPL__POSIX_PRECISE_CLOCK, &now);
+		if(((uint64_t)now.tv_sec * 1000000000ULL + (uint64_t)now.tv_nsec) >= target) {
+			break;
+		}
+	}
+}
+
 fpl_platform_api void fplThreadSleep(const uint32_t milliseconds) {
 	uint32_t ms;
 	uint32_t s;
@@ -9331,10 +12700,8 @@ fpl_platform_api bool fplMutexInit(fplMutexHandle *mutex) {
 		fpl__PushError("Mutex '%p' is already initialized!", mutex);
 		return false;
 	}
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return false;
 	}
 	FPL_CLEAR_STRUCT(mutex);
@@ -9348,10 +12715,8 @@ fpl_platform_api bool fplMutexInit(fplMutexHandle *mutex) {
 }
 
 fpl_platform_api void fplMutexDestroy(fplMutexHandle *mutex) {
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return;
 	}
 	if(mutex != fpl_null) {
@@ -9368,10 +12733,8 @@ fpl_platform_api bool fplMutexLock(fplMutexHandle *mutex) {
 		fpl__ArgumentNullError("Mutex");
 		return false;
 	}
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return false;
 	}
 	bool result = false;
@@ -9387,10 +12750,8 @@ fpl_platform_api bool fplMutexUnlock(fplMutexHandle *mutex) {
 		fpl__ArgumentNullError("Mutex");
 		return false;
 	}
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return false;
 	}
 	bool result = false;
@@ -9406,10 +12767,8 @@ fpl_platform_api bool fplConditionInit(fplConditionVariable *condition) {
 		fpl__ArgumentNullError("Condition");
 		return false;
 	}
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return false;
 	}
 	FPL_CLEAR_STRUCT(condition);
@@ -9431,10 +12790,8 @@ fpl_platform_api void fplConditionDestroy(fplConditionVariable *condition) {
 		fpl__ArgumentNullError("Condition");
 		return;
 	}
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return;
 	}
 	if(condition->isValid) {
@@ -9461,10 +12818,8 @@ fpl_platform_api bool fplConditionWait(fplConditionVariable *condition, fplMutex
 		fpl__PushError("Mutex is not valid!");
 		return false;
 	}
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return false;
 	}
 	pthread_cond_t *cond = &condition->internalHandle.posixCondition;
@@ -9489,10 +12844,8 @@ fpl_platform_api bool fplConditionSignal(fplConditionVariable *condition) {
 		fpl__PushError("Condition is not valid!");
 		return false;
 	}
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return false;
 	}
 	pthread_cond_t *handle = &condition->internalHandle.posixCondition;
@@ -9509,10 +12862,8 @@ fpl_platform_api bool fplConditionBroadcast(fplConditionVariable *condition) {
 		fpl__PushError("Condition is not valid!");
 		return false;
 	}
-	const fpl__PlatformAppState *appState = fpl__global__AppState;
-	const fpl__PThreadApi *pthreadApi = &appState->posix.pthreadApi;
-	if(pthreadApi->libHandle == fpl_null) {
-		fpl__PushError("PThread api not loaded");
+	const fpl__PThreadApi *pthreadApi = fpl__PosixGetPThreadApi();
+	if(pthreadApi == fpl_null) {
 		return false;
 	}
 	pthread_cond_t *handle = &condition->internalHandle.posixCondition;
@@ -9587,10 +12938,83 @@ fpl_platform_api void fplMemoryFree(void *ptr) {
 	munmap(basePtr, storedSize);
 }
 
+//
+// POSIX Ring Buffer
+//
+fpl_platform_api bool fplRingBufferInit(fplRingBuffer *ringBuffer, const size_t minCapacity) {
+	if(ringBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ring buffer");
+		return false;
+	}
+	if(minCapacity == 0) {
+		fpl__ArgumentZeroError("Min capacity");
+		return false;
+	}
+	FPL_CLEAR_STRUCT(ringBuffer);
+
+	long pageSize = sysconf(_SC_PAGESIZE);
+	size_t capacity = fpl__ComputeRingBufferCapacity(minCapacity, pageSize > 0 ? (size_t)pageSize : 4096);
+	if(capacity == 0) {
+		fpl__ArgumentSizeTooBigError("Min capacity", minCapacity, SIZE_MAX >> 2);
+		return false;
+	}
+
+	uint8_t *data = fpl_null;
+#if defined(FPL_PLATFORM_LINUX) && defined(SYS_memfd_create)
+	// Map an anonymous file twice in a row into a reserved address range, so reads and writes never wrap
+	int fd = (int)syscall(SYS_memfd_create, "fpl_ringbuffer", 0);
+	if(fd != -1) {
+		if(ftruncate(fd, (off_t)capacity) == 0) {
+			uint8_t *address = (uint8_t *)mmap(fpl_null, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if(address != MAP_FAILED) {
+				void *firstView = mmap(address, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+				void *secondView = mmap(address + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0);
+				if(firstView == address && secondView == address + capacity) {
+					data = address;
+					ringBuffer->isMirrored = true;
+				} else {
+					munmap(address, capacity * 2);
+				}
+			}
+		}
+		// @NOTE(final): The mappings keep the memory alive, so we dont need the file descriptor anymore
+		close(fd);
+	}
+#endif
+
+	// Fallback to a single allocation, reads and writes will wrap
+	if(data == fpl_null) {
+		data = (uint8_t *)fplMemoryAllocate(capacity);
+		if(data == fpl_null) {
+			return false;
+		}
+	}
+
+	ringBuffer->data = data;
+	ringBuffer->capacity = capacity;
+	ringBuffer->mask = capacity - 1;
+	return true;
+}
+
+fpl_platform_api void fplRingBufferRelease(fplRingBuffer *ringBuffer) {
+	if(ringBuffer == fpl_null) {
+		fpl__ArgumentNullError("Ring buffer");
+		return;
+	}
+	if(ringBuffer->data != fpl_null) {
+		if(ringBuffer->isMirrored) {
+			munmap(ringBuffer->data, ringBuffer->capacity * 2);
+		} else {
+			fplMemoryFree(ringBuffer->data);
+		}
+	}
+	FPL_CLEAR_STRUCT(ringBuffer);
+}
+
 //
 // POSIX Files
 //
-fpl_platform_api bool fplOpenBinaryAnsiFile(const char *filePath, fplFileHandle *outHandle) {
+fpl_platform_api bool fplOpenAnsiBinaryFile(const char *filePath, fplFileHandle *outHandle) {
 	if(filePath != fpl_null && outHandle != fpl_null) {
 		FPL_CLEAR_STRUCT(outHandle);
 		int posixFileHandle;
@@ -9605,17 +13029,42 @@ fpl_platform_api bool fplOpenBinaryAnsiFile(const char *filePath, fplFileHandle
 	}
 	return false;
 }
-fpl_platform_api bool fplOpenBinaryWideFile(const wchar_t *filePath, fplFileHandle *outHandle) {
+// Converts the given wide string into UTF-8, using the given stack buffer when it fits or allocating memory otherwise
+fpl_internal char *fpl__PosixWideToUTF8(const wchar_t *wideSource, char *stackBuffer, const size_t stackBufferLen) {
+	size_t wideLen = fplGetWideStringLength(wideSource);
+	size_t utf8Len;
+	if(!fpl__ConvertUTF(wideSource, wideLen, FPL__WIDE_UTF_TYPE, fpl_null, 0, fpl__UTFType_8, &utf8Len)) {
+		return fpl_null;
+	}
+	char *result = stackBuffer;
+	if((utf8Len + 1) > stackBufferLen) {
+		result = (char *)fplMemoryAllocate(utf8Len + 1);
+		if(result == fpl_null) {
+			return fpl_null;
+		}
+	}
+	fpl__ConvertUTF(wideSource, wideLen, FPL__WIDE_UTF_TYPE, result, utf8Len + 1, fpl__UTFType_8, &utf8Len);
+	return(result);
+}
+
+fpl_internal void fpl__PosixReleaseWideToUTF8(char *utf8String, char *stackBuffer) {
+	if(utf8String != fpl_null && utf8String != stackBuffer) {
+		fplMemoryFree(utf8String);
+	}
+}
+
+fpl_platform_api bool fplOpenWideBinaryFile(const wchar_t *filePath, fplFileHandle *outHandle) {
 	if(filePath != fpl_null && outHandle != fpl_null) {
-		char utf8FilePath[1024] = FPL_ZERO_INIT;
-		fplWideStringToAnsiString(filePath, fplGetWideStringLength(filePath), utf8FilePath, FPL_ARRAYCOUNT(utf8FilePath));
-		bool result = fplOpenBinaryAnsiFile(utf8FilePath, outHandle);
+		char stackBuffer[256];
+		char *utf8FilePath = fpl__PosixWideToUTF8(filePath, stackBuffer, FPL_ARRAYCOUNT(stackBuffer));
+		bool result = utf8FilePath != fpl_null && fplOpenAnsiBinaryFile(utf8FilePath, outHandle);
+		fpl__PosixReleaseWideToUTF8(utf8FilePath, stackBuffer);
 		return(result);
 	}
 	return false;
 }
 
-fpl_platform_api bool fplCreateBinaryAnsiFile(const char *filePath, fplFileHandle *outHandle) {
+fpl_platform_api bool fplCreateAnsiBinaryFile(const char *filePath, fplFileHandle *outHandle) {
 	if(filePath != fpl_null) {
 		int posixFileHandle;
 		do {
@@ -9629,11 +13078,12 @@ fpl_platform_api bool fplCreateBinaryAnsiFile(const char *filePath, fplFileHandl
 	}
 	return false;
 }
-fpl_platform_api bool fplCreateBinaryWideFile(const wchar_t *filePath, fplFileHandle *outHandle) {
+fpl_platform_api bool fplCreateWideBinaryFile(const wchar_t *filePath, fplFileHandle *outHandle) {
 	if(filePath != fpl_null && outHandle != fpl_null) {
-		char utf8FilePath[1024] = FPL_ZERO_INIT;
-		fplWideStringToAnsiString(filePath, fplGetWideStringLength(filePath), utf8FilePath, FPL_ARRAYCOUNT(utf8FilePath));
-		bool result = fplCreateBinaryAnsiFile(utf8FilePath, outHandle);
+		char stackBuffer[256];
+		char *utf8FilePath = fpl__PosixWideToUTF8(filePath, stackBuffer, FPL_ARRAYCOUNT(stackBuffer));
+		bool result = utf8FilePath != fpl_null && fplCreateAnsiBinaryFile(utf8FilePath, outHandle);
+		fpl__PosixReleaseWideToUTF8(utf8FilePath, stackBuffer);
 		return(result);
 	}
 	return false;
@@ -9658,9 +13108,11 @@ fpl_platform_api uint32_t fplReadFileBlock32(const fplFileHandle *fileHandle, co
 	int posixFileHandle = fileHandle->internalHandle.posixFileHandle;
 
 	ssize_t res;
+	FPL__PROFILE_BEGIN("fplReadFileBlock32");
 	do {
 		res = read(posixFileHandle, targetBuffer, sizeToRead);
 	} while(res == -1 && errno == EINTR);
+	FPL__PROFILE_END();
 
 	uint32_t result = 0;
 	if(res != -1) {
@@ -9689,9 +13141,11 @@ fpl_platform_api uint32_t fplWriteFileBlock32(const fplFileHandle *fileHandle, v
 	int posixFileHandle = fileHandle->internalHandle.posixFileHandle;
 
 	ssize_t res;
+	FPL__PROFILE_BEGIN("fplWriteFileBlock32");
 	do {
 		res = write(posixFileHandle, sourceBuffer, sourceSize);
 	} while(res == -1 && errno == EINTR);
+	FPL__PROFILE_END();
 
 	uint32_t result = 0;
 	if(res != -1) {
@@ -9909,88 +13363,26 @@ fpl_platform_api void fplListFilesEnd(fplFileEntry *lastEntry) {
 //
 // > STD_STRINGS_SUBPLATFORM
 //
-// Strings Implementation using C Standard Library
+// Strings Implementation for platforms where ansi strings are UTF-8 and wchar_t is UTF-32
 //
 // ############################################################################
 #if defined(FPL_SUBPLATFORM_STD_STRINGS)
-// @NOTE(final): stdio.h is already included
+// @NOTE(final): The conversions does not use wcstombs/mbstowcs anymore, so they dont depend on setlocale() and work without the C-Runtime
 fpl_platform_api char *fplWideStringToAnsiString(const wchar_t *wideSource, const size_t maxWideSourceLen, char *ansiDest, const size_t maxAnsiDestLen) {
-	if(wideSource == fpl_null) {
-		fpl__ArgumentNullError("Wide source");
-		return fpl_null;
-	}
-	if(ansiDest == fpl_null) {
-		fpl__ArgumentNullError("Ansi dest");
-		return fpl_null;
-	}
-	size_t requiredLen = wcstombs(fpl_null, wideSource, maxWideSourceLen);
-	size_t minRequiredLen = requiredLen + 1;
-	if(maxAnsiDestLen < minRequiredLen) {
-		fpl__ArgumentSizeTooSmallError("Max ansi dest len", maxAnsiDestLen, minRequiredLen);
-		return fpl_null;
-	}
-	wcstombs(ansiDest, wideSource, maxWideSourceLen);
-	ansiDest[requiredLen] = 0;
-	return(ansiDest);
+	char *result = fpl__WideStringToUTF8(wideSource, maxWideSourceLen, ansiDest, maxAnsiDestLen);
+	return(result);
 }
 fpl_platform_api char *fplWideStringToUTF8String(const wchar_t *wideSource, const size_t maxWideSourceLen, char *utf8Dest, const size_t maxUtf8DestLen) {
-	if(wideSource == fpl_null) {
-		fpl__ArgumentNullError("Wide source");
-		return fpl_null;
-	}
-	if(utf8Dest == fpl_null) {
-		fpl__ArgumentNullError("UTF8 dest");
-		return fpl_null;
-	}
-	// @TODO(final): UTF-8!
-	size_t requiredLen = wcstombs(fpl_null, wideSource, maxWideSourceLen);
-	size_t minRequiredLen = requiredLen + 1;
-	if(maxUtf8DestLen < minRequiredLen) {
-		fpl__ArgumentSizeTooSmallError("Max utf8 dest len", maxUtf8DestLen, minRequiredLen);
-		return fpl_null;
-	}
-	wcstombs(utf8Dest, wideSource, maxWideSourceLen);
-	utf8Dest[requiredLen] = 0;
-	return(utf8Dest);
+	char *result = fpl__WideStringToUTF8(wideSource, maxWideSourceLen, utf8Dest, maxUtf8DestLen);
+	return(result);
 }
 fpl_platform_api wchar_t *fplAnsiStringToWideString(const char *ansiSource, const size_t ansiSourceLen, wchar_t *wideDest, const size_t maxWideDestLen) {
-	if(ansiSource == fpl_null) {
-		fpl__ArgumentNullError("Ansi source");
-		return fpl_null;
-	}
-	if(wideDest == fpl_null) {
-		fpl__ArgumentNullError("Wide dest");
-		return fpl_null;
-	}
-	size_t requiredLen = mbstowcs(fpl_null, ansiSource, ansiSourceLen);
-	size_t minRequiredLen = requiredLen + 1;
-	if(maxWideDestLen < minRequiredLen) {
-		fpl__ArgumentSizeTooSmallError("Max wide dest len", maxWideDestLen, minRequiredLen);
-		return fpl_null;
-	}
-	mbstowcs(wideDest, ansiSource, ansiSourceLen);
-	wideDest[requiredLen] = 0;
-	return(wideDest);
+	wchar_t *result = fpl__UTF8ToWideString(ansiSource, ansiSourceLen, wideDest, maxWideDestLen);
+	return(result);
 }
 fpl_platform_api wchar_t *fplUTF8StringToWideString(const char *utf8Source, const size_t utf8SourceLen, wchar_t *wideDest, const size_t maxWideDestLen) {
-	if(utf8Source == fpl_null) {
-		fpl__ArgumentNullError("UTF8 source");
-		return fpl_null;
-	}
-	if(wideDest == fpl_null) {
-		fpl__ArgumentNullError("Wide dest");
-		return fpl_null;
-	}
-	// @TODO(final): UTF-8!
-	size_t requiredLen = mbstowcs(fpl_null, utf8Source, utf8SourceLen);
-	size_t minRequiredLen = requiredLen + 1;
-	if(maxWideDestLen < minRequiredLen) {
-		fpl__ArgumentSizeTooSmallError("Max wide dest len", maxWideDestLen, minRequiredLen);
-		return fpl_null;
-	}
-	mbstowcs(wideDest, utf8Source, utf8SourceLen);
-	wideDest[requiredLen] = 0;
-	return(wideDest);
+	wchar_t *result = fpl__UTF8ToWideString(utf8Source, utf8SourceLen, wideDest, maxWideDestLen);
+	return(result);
 }
 #endif // FPL_SUBPLATFORM_STD_STRINGS
 
@@ -10028,16 +13420,30 @@ fpl_platform_api char fplConsoleWaitForCharInput() {
 #if defined(FPL_SUBPLATFORM_X11)
 fpl_internal void fpl__X11ReleaseSubplatform(fpl__X11SubplatformState *subplatform) {
 	fpl__UnloadX11Api(&subplatform->api);
+	fplAtomicStoreU32(&subplatform->apiState, FPL__POSIX_LAZYAPI_UNLOADED);
 }
 
 fpl_internal bool fpl__X11InitSubplatform(fpl__X11SubplatformState *subplatform) {
-	if(!fpl__LoadX11Api(&subplatform->api)) {
-		fpl__PushError("Failed loading x11 api!");
-		return false;
-	}
+	// @NOTE(final): The x11 api is loaded when the window is created, so console applications never touches libX11
+	fplAtomicStoreU32(&subplatform->apiState, FPL__POSIX_LAZYAPI_UNLOADED);
 	return true;
 }
 
+// Returns the x11 api and loads it on the first call
+fpl_internal const fpl__X11Api *fpl__X11GetApi(fpl__X11SubplatformState *subplatform) {
+	if(fpl__PosixBeginLazyLoad(&subplatform->apiState)) {
+		bool loaded = fpl__LoadX11Api(&subplatform->api);
+		if(loaded) {
+			FPL_LOG("X11", "Loaded X11 api in %.3f ms", (double)fpl__global__X11LibraryProbe.loadTime / 1000000.0);
+		} else {
+			fpl__PushError("Failed loading x11 api!");
+		}
+		fpl__PosixEndLazyLoad(&subplatform->apiState, loaded);
+	}
+	const fpl__X11Api *result = fpl__PosixIsLazyLoaded(&subplatform->apiState) ? &subplatform->api : fpl_null;
+	return(result);
+}
+
 fpl_internal void fpl__X11ReleaseWindow(const fpl__X11SubplatformState *subplatform, fpl__X11WindowState *windowState) {
 	const fpl__X11Api *x11Api = &subplatform->api;
 	if(windowState->window) {
@@ -10283,7 +13689,10 @@ fpl_internal fplKey fpl__X11TranslateKeySymbol(const KeySym keySym) {
 }
 
 fpl_internal bool fpl__X11InitWindow(const fplSettings *initSettings, fplWindowSettings *currentWindowSettings, fpl__PlatformAppState *appState, fpl__X11SubplatformState *subplatform, fpl__X11WindowState *windowState, const fpl__SetupWindowCallbacks *setupCallbacks) {
-	const fpl__X11Api *x11Api = &subplatform->api;
+	const fpl__X11Api *x11Api = fpl__X11GetApi(subplatform);
+	if(x11Api == fpl_null) {
+		return false;
+	}
 
 	FPL_LOG("X11", "Open default Display");
 	windowState->display = x11Api->XOpenDisplay(fpl_null);
@@ -10553,6 +13962,7 @@ fpl_platform_api bool fplWindowUpdate() {
 	const fpl__X11Api *x11Api = &subplatform->api;
 	const fpl__X11WindowState *windowState = &appState->window.x11;
 	bool result = false;
+	FPL__PROFILE_BEGIN("fplWindowUpdate");
 	int pendingCount = x11Api->XPending(windowState->display);
 	while(pendingCount--) {
 		XEvent ev;
@@ -10561,6 +13971,7 @@ fpl_platform_api bool fplWindowUpdate() {
 	}
 	x11Api->XFlush(windowState->display);
 	result = appState->window.isRunning;
+	FPL__PROFILE_END();
 	return(result);
 }
 
@@ -10677,7 +14088,12 @@ fpl_platform_api void fplSetWindowAnsiTitle(const char *ansiTitle) {
 }
 
 fpl_platform_api void fplSetWindowWideTitle(const wchar_t *wideTitle) {
-	// @IMPLEMENT(final): X11 fplSetWindowWideTitle
+	char stackBuffer[256];
+	char *utf8Title = fpl__PosixWideToUTF8(wideTitle, stackBuffer, FPL_ARRAYCOUNT(stackBuffer));
+	if(utf8Title != fpl_null) {
+		fplSetWindowAnsiTitle(utf8Title);
+		fpl__PosixReleaseWideToUTF8(utf8Title, stackBuffer);
+	}
 }
 
 fpl_platform_api char *fplGetClipboardAnsiText(char *dest, const uint32_t maxDestLen) {
@@ -10988,6 +14404,162 @@ fpl_platform_api fplArchType fplGetRunningArchitecture() {
 	return(fplArchType_Unknown);
 }
 
+fpl_internal size_t fpl__LinuxReadSysFile(const char *filePath, char *buffer, const size_t maxBufferLen) {
+	size_t result = 0;
+	int fd = open(filePath, O_RDONLY);
+	if(fd >= 0) {
+		ssize_t bytesRead = read(fd, buffer, maxBufferLen - 1);
+		if(bytesRead > 0) {
+			result = (size_t)bytesRead;
+		}
+		close(fd);
+	}
+	buffer[result] = 0;
+	return(result);
+}
+
+fpl_internal const char *fpl__LinuxParseSysNumber(const char *p, uint32_t *outValue) {
+	uint32_t value = 0;
+	while(*p >= '0' && *p <= '9') {
+		value = value * 10 + (uint32_t)(*p - '0');
+		++p;
+	}
+	*outValue = value;
+	return(p);
+}
+
+fpl_internal bool fpl__LinuxReadSysNumber(const char *filePath, uint32_t *outValue) {
+	char buffer[32];
+	if(fpl__LinuxReadSysFile(filePath, buffer, FPL_ARRAYCOUNT(buffer)) == 0 || !(buffer[0] >= '0' && buffer[0] <= '9')) {
+		return false;
+	}
+	const char *p = fpl__LinuxParseSysNumber(buffer, outValue);
+	// Cache sizes are written with a unit suffix (32K, 8M)
+	if(*p == 'K') {
+		*outValue *= 1024;
+	} else if(*p == 'M') {
+		*outValue *= 1024 * 1024;
+	}
+	return true;
+}
+
+fpl_internal uint32_t fpl__LinuxCountSysCPUList(const char *filePath) {
+	// Counts the entries of a list like "0-3,8,10-11"
+	char buffer[256];
+	if(fpl__LinuxReadSysFile(filePath, buffer, FPL_ARRAYCOUNT(buffer)) == 0) {
+		return 0;
+	}
+	uint32_t result = 0;
+	const char *p = buffer;
+	while(*p >= '0' && *p <= '9') {
+		uint32_t first, last;
+		p = fpl__LinuxParseSysNumber(p, &first);
+		last = first;
+		if(*p == '-') {
+			p = fpl__LinuxParseSysNumber(p + 1, &last);
+		}
+		if(last >= first) {
+			result += last - first + 1;
+		}
+		if(*p != ',') {
+			break;
+		}
+		++p;
+	}
+	return(result);
+}
+
+fpl_internal void fpl__LinuxDetectCPUTopology(fplCPUInfo *info) {
+	long configuredCount = sysconf(_SC_NPROCESSORS_CONF);
+	if(configuredCount <= 0) {
+		return;
+	}
+	// Unique core identifiers are (package << 32 | core), packages are stored in a second array
+	uint64_t *coreIds = (uint64_t *)fplMemoryAllocate(sizeof(uint64_t) * configuredCount * 2);
+	if(coreIds == fpl_null) {
+		return;
+	}
+	uint64_t *packageIds = coreIds + configuredCount;
+	char path[128];
+	for(long cpuIndex = 0; cpuIndex < configuredCount; ++cpuIndex) {
+		uint32_t packageId, coreId;
+		fplFormatAnsiString(path, FPL_ARRAYCOUNT(path), "/sys/devices/system/cpu/cpu%d/topology/physical_package_id", (int)cpuIndex);
+		if(!fpl__LinuxReadSysNumber(path, &packageId)) {
+			// Offline processors have no topology
+			continue;
+		}
+		fplFormatAnsiString(path, FPL_ARRAYCOUNT(path), "/sys/devices/system/cpu/cpu%d/topology/core_id", (int)cpuIndex);
+		if(!fpl__LinuxReadSysNumber(path, &coreId)) {
+			continue;
+		}
+		++info->logicalCoreCount;
+		uint64_t uniqueCoreId = ((uint64_t)packageId << 32) | (uint64_t)coreId;
+		uint32_t index;
+		for(index = 0; index < info->physicalCoreCount; ++index) {
+			if(coreIds[index] == uniqueCoreId) break;
+		}
+		if(index == info->physicalCoreCount) {
+			coreIds[info->physicalCoreCount++] = uniqueCoreId;
+		}
+		for(index = 0; index < info->packageCount; ++index) {
+			if(packageIds[index] == packageId) break;
+		}
+		if(index == info->packageCount) {
+			packageIds[info->packageCount++] = packageId;
+		}
+	}
+	fplMemoryFree(coreIds);
+}
+
+fpl_internal void fpl__LinuxDetectCPUCaches(fplCPUInfo *info) {
+	char path[128];
+	char type[32];
+	for(int cacheIndex = 0; cacheIndex < 16; ++cacheIndex) {
+		uint32_t level, size;
+		fplFormatAnsiString(path, FPL_ARRAYCOUNT(path), "/sys/devices/system/cpu/cpu0/cache/index%d/level", cacheIndex);
+		if(!fpl__LinuxReadSysNumber(path, &level)) {
+			break;
+		}
+		fplFormatAnsiString(path, FPL_ARRAYCOUNT(path), "/sys/devices/system/cpu/cpu0/cache/index%d/size", cacheIndex);
+		if(!fpl__LinuxReadSysNumber(path, &size)) {
+			continue;
+		}
+		fplFormatAnsiString(path, FPL_ARRAYCOUNT(path), "/sys/devices/system/cpu/cpu0/cache/index%d/type", cacheIndex);
+		fpl__LinuxReadSysFile(path, type, FPL_ARRAYCOUNT(type));
+		if(level == 1 && fplIsStringEqualLen(type, 4, "Data", 4)) {
+			info->l1DataCacheSize = size;
+		} else if(level == 1 && fplIsStringEqualLen(type, 11, "Instruction", 11)) {
+			info->l1InstructionCacheSize = size;
+		} else if(level == 2) {
+			info->l2CacheSize = size;
+		} else if(level == 3) {
+			info->l3CacheSize = size;
+		}
+		uint32_t lineSize;
+		fplFormatAnsiString(path, FPL_ARRAYCOUNT(path), "/sys/devices/system/cpu/cpu0/cache/index%d/coherency_line_size", cacheIndex);
+		if(fpl__LinuxReadSysNumber(path, &lineSize) && lineSize > 0) {
+			info->cacheLineSize = lineSize;
+		}
+	}
+}
+
+fpl_platform_api bool fplGetCPUInfo(fplCPUInfo *outInfo) {
+	if(outInfo == fpl_null) {
+		fpl__ArgumentNullError("Out info");
+		return false;
+	}
+	// CPUID first, sysfs overrides what the kernel knows better (Caches are reported by the kernel on all architectures)
+	fpl__DetectCPUInfo(outInfo);
+	fpl__LinuxDetectCPUTopology(outInfo);
+	fpl__LinuxDetectCPUCaches(outInfo);
+	outInfo->numaNodeCount = fpl__LinuxCountSysCPUList("/sys/devices/system/node/online");
+	if(outInfo->logicalCoreCount == 0) {
+		outInfo->logicalCoreCount = (uint32_t)fplGetProcessorCoreCount();
+	}
+	fpl__FinalizeCPUInfo(outInfo);
+	return true;
+}
+
 //
 // Linux Paths
 //
@@ -11093,6 +14665,18 @@ fpl_platform_api fplArchType fplGetRunningArchitecture() {
 	return(fplArchType_Unknown);
 }
 
+fpl_platform_api bool fplGetCPUInfo(fplCPUInfo *outInfo) {
+	if(outInfo == fpl_null) {
+		fpl__ArgumentNullError("Out info");
+		return false;
+	}
+	fpl__DetectCPUInfo(outInfo);
+	// @NOTE(final): There is no portable topology query for generic Unix, so physical cores, packages and NUMA nodes fallback to the logical cores
+	outInfo->logicalCoreCount = (uint32_t)fplGetProcessorCoreCount();
+	fpl__FinalizeCPUInfo(outInfo);
+	return true;
+}
+
 //
 // Unix Paths
 //
@@ -11850,21 +15434,156 @@ typedef enum fpl__AudioDeviceState {
 	fpl__AudioDeviceState_Stopping,
 } fpl__AudioDeviceState;
 
+// Maximum number of period records, which can be queued for fplReadAudioPeriodRecords()
+#define FPL__AUDIO_MAX_PERIOD_RECORDS 256
+
 typedef struct fpl__CommonAudioState {
 	fplAudioDeviceFormat internalFormat;
 	fpl_audio_client_read_callback *clientReadCallback;
 	void *clientUserData;
+	fpl_audio_client_capture_callback *clientCaptureCallback;
+	void *clientCaptureUserData;
+	fplAudioDeviceType deviceType;
+	fplRingBuffer pendingEvents;
+	fplRingBuffer periodRecords;
+	fplAudioStats stats;
+	volatile uint32_t statsSequence;
+	double lastCallbackStart;
+	uint32_t lastFramesRequested;
+	volatile uint32_t underrunCount;
+	volatile uint32_t overrunCount;
+	volatile uint32_t deviceLostCount;
+	volatile uint32_t reopenCount;
 	volatile fpl__AudioDeviceState state;
 } fpl__CommonAudioState;
 
-fpl_internal_inline uint32_t fpl__ReadAudioFramesFromClient(const fpl__CommonAudioState *commonAudio, uint32_t frameCount, void *pSamples) {
+fpl_internal_inline void fpl__AddAudioTimingSample(fplAudioTimingHistogram *histogram, const uint64_t microseconds) {
+	uint32_t bucketIndex = 0;
+	uint64_t value = microseconds;
+	while(value > 1 && bucketIndex < (FPL_AUDIO_TIMING_BUCKET_COUNT - 1)) {
+		value >>= 1;
+		++bucketIndex;
+	}
+	histogram->buckets[bucketIndex]++;
+	if(histogram->sampleCount == 0 || microseconds < histogram->minMicroseconds) {
+		histogram->minMicroseconds = microseconds;
+	}
+	if(microseconds > histogram->maxMicroseconds) {
+		histogram->maxMicroseconds = microseconds;
+	}
+	histogram->totalMicroseconds += microseconds;
+	histogram->sampleCount++;
+}
+
+// @NOTE(final): The statistics are owned by the audio thread and published with a sequence counter, so the audio thread never blocks.
+// The sequence is odd while the single writer updates the statistics, readers retry until they copied an unchanged even sequence.
+fpl_internal_inline void fpl__BeginAudioStatsWrite(volatile uint32_t *sequence) {
+	fplAtomicAddU32(sequence, 1);
+}
+
+fpl_internal_inline void fpl__EndAudioStatsWrite(volatile uint32_t *sequence) {
+	fplAtomicAddU32(sequence, 1);
+}
+
+fpl_internal void fpl__ReadAudioStats(volatile uint32_t *sequence, const void *stats, const size_t statsSize, void *outStats) {
+	for(;;) {
+		uint32_t sequenceBefore = fplAtomicLoadU32(sequence);
+		if((sequenceBefore & 1) == 0) {
+			fplMemoryCopy(stats, statsSize, outStats);
+			fplAtomicReadFence();
+			if(fplAtomicLoadU32(sequence) == sequenceBefore) {
+				break;
+			}
+		}
+	}
+}
+
+// @NOTE(final): Called from the audio thread only, the records are consumed by fplReadAudioPeriodRecords()
+fpl_internal void fpl__RecordAudioPeriod(fpl__CommonAudioState *commonAudio, const double startTime, const double endTime, const uint32_t framesRequested, const uint32_t framesDelivered, const uint32_t deviceDelayInFrames) {
+	fplAudioPeriodRecord record;
+	record.startTime = startTime;
+	record.durationInMicroseconds = (uint32_t)((endTime - startTime) * 1000.0);
+	record.framesRequested = framesRequested;
+	record.framesDelivered = framesDelivered;
+	record.deviceDelayInFrames = deviceDelayInFrames;
+
+	bool isDropped = true;
+	if(commonAudio->periodRecords.data != fpl_null && fplRingBufferGetWriteAvailable(&commonAudio->periodRecords) >= sizeof(record)) {
+		fplRingBufferWrite(&commonAudio->periodRecords, &record, sizeof(record));
+		isDropped = false;
+	}
+
+	// The jitter is the difference between the actual and the expected time since the last callback
+	bool hasJitter = commonAudio->lastFramesRequested > 0 && commonAudio->internalFormat.sampleRate > 0;
+	uint64_t jitterInMicroseconds = 0;
+	if(hasJitter) {
+		double expected = ((double)commonAudio->lastFramesRequested * 1000.0) / (double)commonAudio->internalFormat.sampleRate;
+		double actual = startTime - commonAudio->lastCallbackStart;
+		double difference = actual > expected ? actual - expected : expected - actual;
+		jitterInMicroseconds = (uint64_t)(difference * 1000.0);
+	}
+	commonAudio->lastCallbackStart = startTime;
+	commonAudio->lastFramesRequested = framesRequested;
+
+	fpl__BeginAudioStatsWrite(&commonAudio->statsSequence);
+	fplAudioStats *stats = &commonAudio->stats;
+	fpl__AddAudioTimingSample(&stats->callbackDuration, record.durationInMicroseconds);
+	if(hasJitter) {
+		fpl__AddAudioTimingSample(&stats->callbackJitter, jitterInMicroseconds);
+	}
+	stats->periodCount++;
+	stats->framesRequested += framesRequested;
+	stats->framesDelivered += framesDelivered;
+	if(isDropped) {
+		stats->droppedRecordCount++;
+	}
+	fpl__EndAudioStatsWrite(&commonAudio->statsSequence);
+}
+
+// @NOTE(final): Called before the first period after (re)starting the device, so the pause is not recorded as jitter
+fpl_internal_inline void fpl__ResetAudioJitter(fpl__CommonAudioState *commonAudio) {
+	commonAudio->lastCallbackStart = 0.0;
+	commonAudio->lastFramesRequested = 0;
+}
+
+fpl_internal_inline uint32_t fpl__ReadAudioFramesFromClient(fpl__CommonAudioState *commonAudio, uint32_t frameCount, void *pSamples, uint32_t deviceDelayInFrames) {
 	uint32_t outputSamplesWritten = 0;
 	if(commonAudio->clientReadCallback != fpl_null) {
+		FPL__PROFILE_BEGIN("AudioClientRead");
+		double startTime = fplGetTimeInMillisecondsHP();
 		outputSamplesWritten = commonAudio->clientReadCallback(&commonAudio->internalFormat, frameCount, pSamples, commonAudio->clientUserData);
+		FPL__PROFILE_END();
+		fpl__RecordAudioPeriod(commonAudio, startTime, fplGetTimeInMillisecondsHP(), frameCount, outputSamplesWritten, deviceDelayInFrames);
 	}
 	return outputSamplesWritten;
 }
 
+fpl_internal_inline void fpl__WriteAudioFramesToClient(fpl__CommonAudioState *commonAudio, uint32_t frameCount, const void *pSamples, uint32_t deviceDelayInFrames) {
+	if(commonAudio->clientCaptureCallback != fpl_null) {
+		FPL__PROFILE_BEGIN("AudioClientCapture");
+		double startTime = fplGetTimeInMillisecondsHP();
+		commonAudio->clientCaptureCallback(&commonAudio->internalFormat, frameCount, pSamples, commonAudio->clientCaptureUserData);
+		FPL__PROFILE_END();
+		// @NOTE(final): In full-duplex mode only the playback callback is recorded, so we get one record per period
+		if(commonAudio->deviceType == fplAudioDeviceType_Capture) {
+			fpl__RecordAudioPeriod(commonAudio, startTime, fplGetTimeInMillisecondsHP(), frameCount, frameCount, deviceDelayInFrames);
+		}
+	}
+}
+
+// @NOTE(final): The event queue is owned by the thread polling the events, so the audio thread only
+// writes into a ring buffer which gets flushed into the event queue from fplPollEvent().
+fpl_internal_inline void fpl__PushAudioEvent(fpl__CommonAudioState *commonAudio, fplAudioEventType type) {
+	if(commonAudio->pendingEvents.data == fpl_null) {
+		return;
+	}
+	fplAudioEvent audioEvent = FPL_ZERO_INIT;
+	audioEvent.type = type;
+	if(fplRingBufferGetWriteAvailable(&commonAudio->pendingEvents) >= sizeof(audioEvent)) {
+		fplRingBufferWrite(&commonAudio->pendingEvents, &audioEvent, sizeof(audioEvent));
+	}
+}
+
 // Global Audio GUIDs
 #if defined(FPL_PLATFORM_WIN32)
 static GUID FPL__GUID_KSDATAFORMAT_SUBTYPE_PCM = { 0x00000001, 0x0000, 0x0010, {0x80, 0x00, 0x00, 0xaa, 0x00, 0x38, 0x9b, 0x71} };
@@ -12016,6 +15735,12 @@ fpl_internal fplAudioResult fpl__AudioInitDirectSound(const fplAudioSettings *au
 	fpl__Win32AppState *win32AppState = &appState->win32;
 	const fpl__Win32Api *apiFuncs = &win32AppState->winApi;
 
+	// @TODO(final): Support for capture devices on DirectSound (IDirectSoundCapture)
+	if(audioSettings->deviceType != fplAudioDeviceType_Playback) {
+		fpl__AudioReleaseDirectSound(commonAudio, dsoundState);
+		return fplAudioResult_Failed;
+	}
+
 	// Load direct sound library
 	fpl__DirectSoundApi *dsoundApi = &dsoundState->api;
 	if(!fpl__LoadDirectSoundApi(dsoundApi)) {
@@ -12263,7 +15988,7 @@ fpl_internal bool fpl__AudioStopDirectSound(fpl__DirectSoundAudioState *dsoundSt
 	return true;
 }
 
-fpl_internal fplAudioResult fpl__AudioStartDirectSound(const fpl__CommonAudioState *commonAudio, fpl__DirectSoundAudioState *dsoundState) {
+fpl_internal fplAudioResult fpl__AudioStartDirectSound(fpl__CommonAudioState *commonAudio, fpl__DirectSoundAudioState *dsoundState) {
 	FPL_ASSERT(commonAudio->internalFormat.channels > 0);
 	FPL_ASSERT(commonAudio->internalFormat.periods > 0);
 	uint32_t audioSampleSizeBytes = fplGetAudioSampleSizeInBytes(commonAudio->internalFormat.type);
@@ -12280,7 +16005,7 @@ fpl_internal fplAudioResult fpl__AudioStartDirectSound(const fpl__CommonAudioSta
 
 	if(SUCCEEDED(IDirectSoundBuffer_Lock(dsoundState->secondaryBuffer, 0, desiredLockSize, &pLockPtr, &actualLockSize, &pLockPtr2, &actualLockSize2, 0))) {
 		framesToRead = actualLockSize / audioSampleSizeBytes / commonAudio->internalFormat.channels;
-		fpl__ReadAudioFramesFromClient(commonAudio, framesToRead, pLockPtr);
+		fpl__ReadAudioFramesFromClient(commonAudio, framesToRead, pLockPtr, 0);
 		IDirectSoundBuffer_Unlock(dsoundState->secondaryBuffer, pLockPtr, actualLockSize, pLockPtr2, actualLockSize2);
 		dsoundState->lastProcessedFrame = framesToRead;
 		if(FAILED(IDirectSoundBuffer_Play(dsoundState->secondaryBuffer, 0, 0, DSBPLAY_LOOPING))) {
@@ -12292,7 +16017,7 @@ fpl_internal fplAudioResult fpl__AudioStartDirectSound(const fpl__CommonAudioSta
 	return fplAudioResult_Success;
 }
 
-fpl_internal void fpl__AudioRunMainLoopDirectSound(const fpl__CommonAudioState *commonAudio, fpl__DirectSoundAudioState *dsoundState) {
+fpl_internal void fpl__AudioRunMainLoopDirectSound(fpl__CommonAudioState *commonAudio, fpl__DirectSoundAudioState *dsoundState) {
 	FPL_ASSERT(commonAudio->internalFormat.channels > 0);
 	uint32_t audioSampleSizeBytes = fplGetAudioSampleSizeInBytes(commonAudio->internalFormat.type);
 	FPL_ASSERT(audioSampleSizeBytes > 0);
@@ -12329,7 +16054,8 @@ fpl_internal void fpl__AudioRunMainLoopDirectSound(const fpl__CommonAudioState *
 
 			// Read actual frames from user
 			uint32_t frameCount = actualLockSize / audioSampleSizeBytes / commonAudio->internalFormat.channels;
-			fpl__ReadAudioFramesFromClient(commonAudio, frameCount, pLockPtr);
+			uint32_t deviceDelayInFrames = commonAudio->internalFormat.bufferSizeInFrames - framesAvailable;
+			fpl__ReadAudioFramesFromClient(commonAudio, frameCount, pLockPtr, deviceDelayInFrames);
 			dsoundState->lastProcessedFrame = (dsoundState->lastProcessedFrame + frameCount) % commonAudio->internalFormat.bufferSizeInFrames;
 
 			// Unlock playback buffer
@@ -12435,6 +16161,12 @@ typedef FPL__ALSA_FUNC_snd_pcm_avail(fpl__alsa_func_snd_pcm_avail);
 typedef FPL__ALSA_FUNC_snd_pcm_avail_update(fpl__alsa_func_snd_pcm_avail_update);
 #define FPL__ALSA_FUNC_snd_pcm_wait(name) int name(snd_pcm_t *pcm, int timeout)
 typedef FPL__ALSA_FUNC_snd_pcm_wait(fpl__alsa_func_snd_pcm_wait);
+#define FPL__ALSA_FUNC_snd_pcm_readi(name) snd_pcm_sframes_t name(snd_pcm_t *pcm, void *buffer, snd_pcm_uframes_t size)
+typedef FPL__ALSA_FUNC_snd_pcm_readi(fpl__alsa_func_snd_pcm_readi);
+#define FPL__ALSA_FUNC_snd_pcm_link(name) int name(snd_pcm_t *pcm1, snd_pcm_t *pcm2)
+typedef FPL__ALSA_FUNC_snd_pcm_link(fpl__alsa_func_snd_pcm_link);
+#define FPL__ALSA_FUNC_snd_pcm_unlink(name) int name(snd_pcm_t *pcm)
+typedef FPL__ALSA_FUNC_snd_pcm_unlink(fpl__alsa_func_snd_pcm_unlink);
 
 typedef struct fpl__AlsaAudioApi {
 	void *libHandle;
@@ -12481,13 +16213,32 @@ typedef struct fpl__AlsaAudioApi {
 	fpl__alsa_func_snd_pcm_avail *snd_pcm_avail;
 	fpl__alsa_func_snd_pcm_avail_update *snd_pcm_avail_update;
 	fpl__alsa_func_snd_pcm_wait *snd_pcm_wait;
+	fpl__alsa_func_snd_pcm_readi *snd_pcm_readi;
+	fpl__alsa_func_snd_pcm_link *snd_pcm_link;
+	fpl__alsa_func_snd_pcm_unlink *snd_pcm_unlink;
 } fpl__AlsaAudioApi;
 
-typedef struct fpl__AlsaAudioState {
-	fpl__AlsaAudioApi api;
+// Number of xruns in a row, before a device is considered lost
+#define FPL__ALSA_MAX_CONSECUTIVE_XRUNS 32
+// Min/Max wait time in milliseconds between reopening a lost device
+#define FPL__ALSA_REOPEN_MIN_BACKOFF 10
+#define FPL__ALSA_REOPEN_MAX_BACKOFF 2000
+
+typedef struct fpl__AlsaPcmStream {
+	char deviceName[256];
 	snd_pcm_t* pcmDevice;
 	void *intermediaryBuffer;
 	bool isUsingMMap;
+} fpl__AlsaPcmStream;
+
+typedef struct fpl__AlsaAudioState {
+	fplAudioSettings audioSettings;
+	fpl__AlsaAudioApi api;
+	fpl__AlsaPcmStream playback;
+	fpl__AlsaPcmStream capture;
+	uint32_t consecutiveXRuns;
+	bool hasRecoveredXRun;
+	bool isLinked;
 	bool breakMainLoop;
 } fpl__AlsaAudioState;
 
@@ -12499,13 +16250,23 @@ fpl_internal void fpl__UnloadAlsaApi(fpl__AlsaAudioApi *alsaApi) {
 	FPL_CLEAR_STRUCT(alsaApi);
 }
 
+fpl_globalvar fpl__PosixLibraryProbe fpl__global__AlsaLibraryProbe = FPL_ZERO_INIT;
+
 fpl_internal bool fpl__LoadAlsaApi(fpl__AlsaAudioApi *alsaApi) {
 	FPL_ASSERT(alsaApi != fpl_null);
+	fpl__PosixLibraryProbe *probe = &fpl__global__AlsaLibraryProbe;
+	if(probe->isUnavailable) {
+		return false;
+	}
 	const char* libraryNames[] = {
+		"libasound.so.2",
 		"libasound.so",
 	};
+	uint64_t startTime = fplGetTimeInNanoseconds();
+	uint32_t libCount = FPL_ARRAYCOUNT(libraryNames);
 	bool result = false;
-	for(uint32_t index = 0; index < FPL_ARRAYCOUNT(libraryNames); ++index) {
+	for(uint32_t iteration = 0; iteration < libCount; ++iteration) {
+		uint32_t index = fpl__PosixGetProbeIndex(probe, iteration, libCount);
 		const char * libName = libraryNames[index];
 		void *libHandle = alsaApi->libHandle = dlopen(libName, FPL__POSIX_DL_LOADTYPE);
 		if(libHandle != fpl_null) {
@@ -12553,75 +16314,112 @@ fpl_internal bool fpl__LoadAlsaApi(fpl__AlsaAudioApi *alsaApi) {
 				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, alsaApi->snd_pcm_avail, fpl__alsa_func_snd_pcm_avail, "snd_pcm_avail");
 				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, alsaApi->snd_pcm_avail_update, fpl__alsa_func_snd_pcm_avail_update, "snd_pcm_avail_update");
 				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, alsaApi->snd_pcm_wait, fpl__alsa_func_snd_pcm_wait, "snd_pcm_wait");
+				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, alsaApi->snd_pcm_readi, fpl__alsa_func_snd_pcm_readi, "snd_pcm_readi");
+				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, alsaApi->snd_pcm_link, fpl__alsa_func_snd_pcm_link, "snd_pcm_link");
+				FPL__POSIX_GET_FUNCTION_ADDRESS_BREAK(libHandle, libName, alsaApi->snd_pcm_unlink, fpl__alsa_func_snd_pcm_unlink, "snd_pcm_unlink");
 				result = true;
 			} while(0);
 			if(result) {
+				probe->lastIndex = index;
 				break;
 			}
 		}
 		fpl__UnloadAlsaApi(alsaApi);
 	}
+	probe->isUnavailable = !result;
+	probe->loadTime = fplGetTimeInNanoseconds() - startTime;
+	return(result);
+}
+
+fpl_internal bool fpl__AlsaRecoverXRun(fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState, fpl__AlsaPcmStream *stream, int errorCode) {
+	FPL_ASSERT(commonAudio != fpl_null && alsaState != fpl_null && stream != fpl_null);
+	const fpl__AlsaAudioApi *alsaApi = &alsaState->api;
+	if(errorCode == -EPIPE) {
+		if(stream == &alsaState->capture) {
+			fplAtomicAddU32(&commonAudio->overrunCount, 1);
+		} else {
+			fplAtomicAddU32(&commonAudio->underrunCount, 1);
+		}
+		alsaState->hasRecoveredXRun = true;
+		// A device which does nothing but xruns is most likely gone, so we let the caller reopen it
+		if(++alsaState->consecutiveXRuns > FPL__ALSA_MAX_CONSECUTIVE_XRUNS) {
+			FPL_LOG("ALSA", "Too many xruns in a row on device '%s'!", stream->deviceName);
+			return false;
+		}
+	}
+	bool result = alsaApi->snd_pcm_recover(stream->pcmDevice, errorCode, 1) >= 0;
 	return(result);
 }
 
-fpl_internal uint32_t fpl__AudioWaitForFramesAlsa(const fplAudioDeviceFormat *deviceFormat, fpl__AlsaAudioState *alsaState, bool *requiresRestart) {
-	FPL_ASSERT(commonAudio != fpl_null && deviceFormat != fpl_null);
+// Waits for up to one period of frames, returns false when the device is lost or could not be recovered.
+// The frame count is zero, when nothing is available yet or the main loop is stopping.
+// The device delay is the number of frames queued in the device, computed from the unclamped number of available frames.
+fpl_internal bool fpl__AudioWaitForFramesAlsa(fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState, fpl__AlsaPcmStream *stream, uint32_t *outFrameCount, uint32_t *outDeviceDelayInFrames, bool *requiresRestart) {
+	FPL_ASSERT(commonAudio != fpl_null && alsaState != fpl_null && stream != fpl_null && outFrameCount != fpl_null && outDeviceDelayInFrames != fpl_null);
+	*outFrameCount = 0;
+	*outDeviceDelayInFrames = 0;
 	if(requiresRestart != fpl_null) {
 		*requiresRestart = false;
 	}
 	const fpl__AlsaAudioApi *alsaApi = &alsaState->api;
+	const fplAudioDeviceFormat *deviceFormat = &commonAudio->internalFormat;
+	snd_pcm_t *pcmDevice = stream->pcmDevice;
 	uint32_t periodSizeInFrames = deviceFormat->bufferSizeInFrames / deviceFormat->periods;
-	while(!alsaState->breakMainLoop) {
-		const int timeoutInMilliseconds = 10;
-		int waitResult = alsaApi->snd_pcm_wait(alsaState->pcmDevice, timeoutInMilliseconds);
-		if(waitResult < 0) {
-			if(waitResult == -EPIPE) {
-				if(alsaApi->snd_pcm_recover(alsaState->pcmDevice, waitResult, 1) < 0) {
-					return 0;
-				}
-				if(requiresRestart != fpl_null) {
-					*requiresRestart = true;
-				}
-			}
-		}
 
-		if(alsaState->breakMainLoop) {
-			return 0;
+	const int timeoutInMilliseconds = 10;
+	int waitResult = alsaApi->snd_pcm_wait(pcmDevice, timeoutInMilliseconds);
+	if(waitResult < 0 && waitResult != -EAGAIN) {
+		if(waitResult != -EPIPE) {
+			FPL_LOG("ALSA", "Failed waiting for device '%s', error code: %d!", stream->deviceName, waitResult);
+			return false;
+		}
+		if(!fpl__AlsaRecoverXRun(commonAudio, alsaState, stream, waitResult)) {
+			return false;
+		}
+		if(requiresRestart != fpl_null) {
+			*requiresRestart = true;
 		}
+	}
 
-		snd_pcm_sframes_t framesAvailable = alsaApi->snd_pcm_avail_update(alsaState->pcmDevice);
-		if(framesAvailable < 0) {
-			if(framesAvailable == -EPIPE) {
-				if(alsaApi->snd_pcm_recover(alsaState->pcmDevice, framesAvailable, 1) < 0) {
-					return 0;
-				}
-				if(requiresRestart != fpl_null) {
-					*requiresRestart = true;
-				}
-				framesAvailable = alsaApi->snd_pcm_avail_update(alsaState->pcmDevice);
-				if(framesAvailable < 0) {
-					return 0;
-				}
-			}
-		}
+	if(alsaState->breakMainLoop) {
+		return true;
+	}
 
-		// Keep the returned number of samples consistent and based on the period size.
-		if(framesAvailable >= periodSizeInFrames) {
-			return periodSizeInFrames;
+	snd_pcm_sframes_t framesAvailable = alsaApi->snd_pcm_avail_update(pcmDevice);
+	if(framesAvailable == -EPIPE) {
+		if(!fpl__AlsaRecoverXRun(commonAudio, alsaState, stream, (int)framesAvailable)) {
+			return false;
 		}
-
-		// We'll get here if the loop was terminated. Just return whatever's available.
-		framesAvailable = alsaApi->snd_pcm_avail_update(alsaState->pcmDevice);
-		if(framesAvailable < 0) {
-			return 0;
+		if(requiresRestart != fpl_null) {
+			*requiresRestart = true;
 		}
-		return framesAvailable;
+		framesAvailable = alsaApi->snd_pcm_avail_update(pcmDevice);
+	}
+	if(framesAvailable < 0) {
+		if(framesAvailable == -EAGAIN) {
+			return true;
+		}
+		FPL_LOG("ALSA", "Failed getting the available frames for device '%s', error code: %d!", stream->deviceName, (int)framesAvailable);
+		return false;
 	}
+
+	// Playback has the frames queued which are not available for writing, capture has the available frames queued
+	uint32_t bufferFramesAvailable = (uint32_t)FPL_MIN((snd_pcm_uframes_t)framesAvailable, (snd_pcm_uframes_t)deviceFormat->bufferSizeInFrames);
+	if(stream == &alsaState->capture) {
+		*outDeviceDelayInFrames = bufferFramesAvailable;
+	} else {
+		*outDeviceDelayInFrames = deviceFormat->bufferSizeInFrames - bufferFramesAvailable;
+	}
+
+	// Keep the returned number of frames consistent and based on the period size
+	*outFrameCount = FPL_MIN(bufferFramesAvailable, periodSizeInFrames);
+	return true;
 }
 
 fpl_internal bool fpl__GetAudioFramesFromClientAlsa(fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState) {
 	FPL_ASSERT(commonAudio != fpl_null && alsaState != fpl_null);
 	const fpl__AlsaAudioApi *alsaApi = &alsaState->api;
+	fpl__AlsaPcmStream *stream = &alsaState->playback;
 
 	if(!fpl__IsAudioDeviceStarted(commonAudio) && fpl__AudioGetDeviceState(commonAudio) != fpl__AudioDeviceState_Starting) {
 		return false;
@@ -12630,64 +16428,80 @@ fpl_internal bool fpl__GetAudioFramesFromClientAlsa(fpl__CommonAudioState *commo
 		return false;
 	}
 
-	if(alsaState->isUsingMMap) {
+	if(stream->isUsingMMap) {
 		// mmap path
 		bool requiresRestart;
-		uint32_t framesAvailable = fpl__AudioWaitForFramesAlsa(&commonAudio->internalFormat, alsaState, &requiresRestart);
-		if(framesAvailable == 0) {
+		uint32_t framesAvailable;
+		uint32_t deviceDelayInFrames;
+		if(!fpl__AudioWaitForFramesAlsa(commonAudio, alsaState, stream, &framesAvailable, &deviceDelayInFrames, &requiresRestart)) {
 			return false;
 		}
-		if(alsaState->breakMainLoop) {
-			return false;
+		if(framesAvailable == 0 || alsaState->breakMainLoop) {
+			// Nothing to write yet, try again in the next iteration
+			return !alsaState->breakMainLoop;
 		}
 
 		const snd_pcm_channel_area_t* channelAreas;
 		snd_pcm_uframes_t mappedOffset;
-		snd_pcm_uframes_t mappedFrames = framesAvailable;
 		while(framesAvailable > 0) {
-			int result = alsaApi->snd_pcm_mmap_begin(alsaState->pcmDevice, &channelAreas, &mappedOffset, &mappedFrames);
+			snd_pcm_uframes_t mappedFrames = framesAvailable;
+			int result = alsaApi->snd_pcm_mmap_begin(stream->pcmDevice, &channelAreas, &mappedOffset, &mappedFrames);
 			if(result < 0) {
-				return false;
+				if(result != -EPIPE || !fpl__AlsaRecoverXRun(commonAudio, alsaState, stream, result)) {
+					return false;
+				}
+				// Recovered mmap devices are not started automatically
+				return alsaApi->snd_pcm_start(stream->pcmDevice) >= 0;
 			}
 			if(mappedFrames > 0) {
 				void *bufferPtr = (uint8_t *)channelAreas[0].addr + ((channelAreas[0].first + (mappedOffset * channelAreas[0].step)) / 8);
-				fpl__ReadAudioFramesFromClient(commonAudio, mappedFrames, bufferPtr);
+				fpl__ReadAudioFramesFromClient(commonAudio, (uint32_t)mappedFrames, bufferPtr, deviceDelayInFrames);
 			}
-			result = alsaApi->snd_pcm_mmap_commit(alsaState->pcmDevice, mappedOffset, mappedFrames);
+			result = alsaApi->snd_pcm_mmap_commit(stream->pcmDevice, mappedOffset, mappedFrames);
 			if(result < 0 || (snd_pcm_uframes_t)result != mappedFrames) {
-				alsaApi->snd_pcm_recover(alsaState->pcmDevice, result, 1);
-				return false;
+				if(!fpl__AlsaRecoverXRun(commonAudio, alsaState, stream, result < 0 ? result : -EPIPE)) {
+					return false;
+				}
+				// Recovered mmap devices are not started automatically
+				return alsaApi->snd_pcm_start(stream->pcmDevice) >= 0;
 			}
 			framesAvailable -= mappedFrames;
 			if(requiresRestart) {
-				if(alsaApi->snd_pcm_start(alsaState->pcmDevice) < 0) {
+				// Start the recovered device once, after the first frames are written
+				if(alsaApi->snd_pcm_start(stream->pcmDevice) < 0) {
 					return false;
 				}
+				requiresRestart = false;
 			}
 		}
 	} else {
 		// readi/writei path
 		while(!alsaState->breakMainLoop) {
-			uint32_t framesAvailable = fpl__AudioWaitForFramesAlsa(&commonAudio->internalFormat, alsaState, fpl_null);
+			uint32_t framesAvailable;
+			uint32_t deviceDelayInFrames;
+			if(!fpl__AudioWaitForFramesAlsa(commonAudio, alsaState, stream, &framesAvailable, &deviceDelayInFrames, fpl_null)) {
+				return false;
+			}
 			if(framesAvailable == 0) {
+				// snd_pcm_wait() has blocked until the timeout, so this does not spin
 				continue;
 			}
 			if(alsaState->breakMainLoop) {
 				return false;
 			}
-			fpl__ReadAudioFramesFromClient(commonAudio, framesAvailable, alsaState->intermediaryBuffer);
-			snd_pcm_sframes_t framesWritten = alsaApi->snd_pcm_writei(alsaState->pcmDevice, alsaState->intermediaryBuffer, framesAvailable);
+			fpl__ReadAudioFramesFromClient(commonAudio, framesAvailable, stream->intermediaryBuffer, deviceDelayInFrames);
+			snd_pcm_sframes_t framesWritten = alsaApi->snd_pcm_writei(stream->pcmDevice, stream->intermediaryBuffer, framesAvailable);
 			if(framesWritten < 0) {
 				if(framesWritten == -EAGAIN) {
 					// Keep trying
 					continue;
 				} else if(framesWritten == -EPIPE) {
 					// Underrun -> Recover and try again
-					if(alsaApi->snd_pcm_recover(alsaState->pcmDevice, framesWritten, 1) < 0) {
+					if(!fpl__AlsaRecoverXRun(commonAudio, alsaState, stream, (int)framesWritten)) {
 						FPL_LOG("ALSA", "Failed to recover device after underrun!");
 						return false;
 					}
-					framesWritten = alsaApi->snd_pcm_writei(alsaState->pcmDevice, alsaState->intermediaryBuffer, framesAvailable);
+					framesWritten = alsaApi->snd_pcm_writei(stream->pcmDevice, stream->intermediaryBuffer, framesAvailable);
 					if(framesWritten < 0) {
 						FPL_LOG("ALSA", "Failed to write data to the PCM device!");
 						return false;
@@ -12707,22 +16521,131 @@ fpl_internal bool fpl__GetAudioFramesFromClientAlsa(fpl__CommonAudioState *commo
 	return true;
 }
 
+fpl_internal bool fpl__SendAudioFramesToClientAlsa(fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState) {
+	FPL_ASSERT(commonAudio != fpl_null && alsaState != fpl_null);
+	const fpl__AlsaAudioApi *alsaApi = &alsaState->api;
+	fpl__AlsaPcmStream *stream = &alsaState->capture;
+
+	if(!fpl__IsAudioDeviceStarted(commonAudio)) {
+		return false;
+	}
+	if(alsaState->breakMainLoop) {
+		return false;
+	}
+
+	// @NOTE(final): Unlike playback, having no captured frames available is not an error, we just try again in the next iteration.
+	if(stream->isUsingMMap) {
+		// mmap path
+		bool requiresRestart;
+		uint32_t framesAvailable;
+		uint32_t deviceDelayInFrames;
+		if(!fpl__AudioWaitForFramesAlsa(commonAudio, alsaState, stream, &framesAvailable, &deviceDelayInFrames, &requiresRestart)) {
+			return false;
+		}
+		if(requiresRestart) {
+			// Capture devices stay in the prepared state after an overrun was recovered
+			if(alsaApi->snd_pcm_start(stream->pcmDevice) < 0) {
+				return false;
+			}
+		}
+
+		const snd_pcm_channel_area_t* channelAreas;
+		snd_pcm_uframes_t mappedOffset;
+		while(framesAvailable > 0 && !alsaState->breakMainLoop) {
+			snd_pcm_uframes_t mappedFrames = framesAvailable;
+			int result = alsaApi->snd_pcm_mmap_begin(stream->pcmDevice, &channelAreas, &mappedOffset, &mappedFrames);
+			if(result < 0) {
+				if(result != -EPIPE || !fpl__AlsaRecoverXRun(commonAudio, alsaState, stream, result)) {
+					return false;
+				}
+				// Recovered capture devices are not started automatically
+				return alsaApi->snd_pcm_start(stream->pcmDevice) >= 0;
+			}
+			if(mappedFrames > 0) {
+				const void *bufferPtr = (const uint8_t *)channelAreas[0].addr + ((channelAreas[0].first + (mappedOffset * channelAreas[0].step)) / 8);
+				fpl__WriteAudioFramesToClient(commonAudio, (uint32_t)mappedFrames, bufferPtr, deviceDelayInFrames);
+			}
+			result = alsaApi->snd_pcm_mmap_commit(stream->pcmDevice, mappedOffset, mappedFrames);
+			if(result < 0 || (snd_pcm_uframes_t)result != mappedFrames) {
+				if(!fpl__AlsaRecoverXRun(commonAudio, alsaState, stream, result < 0 ? result : -EPIPE)) {
+					return false;
+				}
+				// Recovered capture devices are not started automatically
+				return alsaApi->snd_pcm_start(stream->pcmDevice) >= 0;
+			}
+			framesAvailable -= mappedFrames;
+		}
+	} else {
+		// readi/writei path
+		uint32_t framesAvailable;
+		uint32_t deviceDelayInFrames;
+		if(!fpl__AudioWaitForFramesAlsa(commonAudio, alsaState, stream, &framesAvailable, &deviceDelayInFrames, fpl_null)) {
+			return false;
+		}
+		if(framesAvailable == 0 || alsaState->breakMainLoop) {
+			return !alsaState->breakMainLoop;
+		}
+		snd_pcm_sframes_t framesRead = alsaApi->snd_pcm_readi(stream->pcmDevice, stream->intermediaryBuffer, framesAvailable);
+		if(framesRead < 0) {
+			if(framesRead == -EAGAIN) {
+				// Try again in the next iteration
+				return true;
+			} else if(framesRead == -EPIPE) {
+				// Overrun -> Recover and try again
+				if(!fpl__AlsaRecoverXRun(commonAudio, alsaState, stream, (int)framesRead)) {
+					FPL_LOG("ALSA", "Failed to recover capture device after overrun!");
+					return false;
+				}
+				framesRead = alsaApi->snd_pcm_readi(stream->pcmDevice, stream->intermediaryBuffer, framesAvailable);
+				if(framesRead < 0) {
+					FPL_LOG("ALSA", "Failed to read data from the PCM capture device!");
+					return false;
+				}
+			} else {
+				FPL_LOG("ALSA", "Failed to read audio frames for client, error code: %d!", framesRead);
+				return false;
+			}
+		}
+		if(framesRead > 0) {
+			fpl__WriteAudioFramesToClient(commonAudio, (uint32_t)framesRead, stream->intermediaryBuffer, deviceDelayInFrames);
+		}
+	}
+	return true;
+}
+
 fpl_internal_inline void fpl__AudioStopMainLoopAlsa(fpl__AlsaAudioState *alsaState) {
 	FPL_ASSERT(alsaState != fpl_null);
 	alsaState->breakMainLoop = true;
 }
 
+fpl_internal void fpl__AlsaReleasePcmStream(const fpl__AlsaAudioApi *alsaApi, fpl__AlsaPcmStream *stream) {
+	FPL_ASSERT(alsaApi != fpl_null && stream != fpl_null);
+	if(stream->pcmDevice != fpl_null) {
+		alsaApi->snd_pcm_close(stream->pcmDevice);
+		stream->pcmDevice = fpl_null;
+	}
+	if(stream->intermediaryBuffer != fpl_null) {
+		fplMemoryFree(stream->intermediaryBuffer);
+		stream->intermediaryBuffer = fpl_null;
+	}
+	FPL_CLEAR_STRUCT(stream);
+}
+
+fpl_internal void fpl__AlsaReleasePcmStreams(fpl__AlsaAudioState *alsaState) {
+	FPL_ASSERT(alsaState != fpl_null);
+	const fpl__AlsaAudioApi *alsaApi = &alsaState->api;
+	if(alsaState->isLinked) {
+		alsaApi->snd_pcm_unlink(alsaState->capture.pcmDevice);
+		alsaState->isLinked = false;
+	}
+	fpl__AlsaReleasePcmStream(alsaApi, &alsaState->capture);
+	fpl__AlsaReleasePcmStream(alsaApi, &alsaState->playback);
+}
+
 fpl_internal bool fpl__AudioReleaseAlsa(const fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState) {
 	FPL_ASSERT(commonAudio != fpl_null && alsaState != fpl_null);
 	fpl__AlsaAudioApi *alsaApi = &alsaState->api;
-	if(alsaState->pcmDevice != fpl_null) {
-		alsaApi->snd_pcm_close(alsaState->pcmDevice);
-		alsaState->pcmDevice = fpl_null;
-		if(alsaState->intermediaryBuffer != fpl_null) {
-			fplMemoryFree(alsaState->intermediaryBuffer);
-			alsaState->intermediaryBuffer = fpl_null;
-		}
-	}
+	fpl__AlsaReleasePcmStreams(alsaState);
 	fpl__UnloadAlsaApi(alsaApi);
 	FPL_CLEAR_STRUCT(alsaState);
 	return true;
@@ -12731,22 +16654,43 @@ fpl_internal bool fpl__AudioReleaseAlsa(const fpl__CommonAudioState *commonAudio
 fpl_internal fplAudioResult fpl__AudioStartAlsa(fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState) {
 	FPL_ASSERT(commonAudio != fpl_null && alsaState != fpl_null);
 	const fpl__AlsaAudioApi *alsaApi = &alsaState->api;
+	fpl__AlsaPcmStream *playback = &alsaState->playback;
+	fpl__AlsaPcmStream *capture = &alsaState->capture;
 
-	// Prepare the device
-	if(alsaApi->snd_pcm_prepare(alsaState->pcmDevice) < 0) {
-		FPL_LOG("ALSA", "Failed to prepare PCM device '%p'!", alsaState->pcmDevice);
-		return fplAudioResult_Failed;
+	// Prepare the devices (Linked devices are prepared together)
+	if(playback->pcmDevice != fpl_null) {
+		if(alsaApi->snd_pcm_prepare(playback->pcmDevice) < 0) {
+			FPL_LOG("ALSA", "Failed to prepare PCM device '%p'!", playback->pcmDevice);
+			return fplAudioResult_Failed;
+		}
+	}
+	if(capture->pcmDevice != fpl_null && !alsaState->isLinked) {
+		if(alsaApi->snd_pcm_prepare(capture->pcmDevice) < 0) {
+			FPL_LOG("ALSA", "Failed to prepare PCM capture device '%p'!", capture->pcmDevice);
+			return fplAudioResult_Failed;
+		}
 	}
 
-	// Get initial frames to fill from the client
-	if(!fpl__GetAudioFramesFromClientAlsa(commonAudio, alsaState)) {
-		FPL_LOG("ALSA", "Failed to get initial audio frames from client!");
-		return fplAudioResult_Failed;
+	if(playback->pcmDevice != fpl_null) {
+		// Get initial frames to fill from the client
+		if(!fpl__GetAudioFramesFromClientAlsa(commonAudio, alsaState)) {
+			FPL_LOG("ALSA", "Failed to get initial audio frames from client!");
+			return fplAudioResult_Failed;
+		}
+
+		// Starting the playback device starts the linked capture device as well
+		if(playback->isUsingMMap) {
+			if(alsaApi->snd_pcm_start(playback->pcmDevice) < 0) {
+				FPL_LOG("ALSA", "Failed to start PCM device '%p'!", playback->pcmDevice);
+				return fplAudioResult_Failed;
+			}
+		}
 	}
 
-	if(alsaState->isUsingMMap) {
-		if(alsaApi->snd_pcm_start(alsaState->pcmDevice) < 0) {
-			FPL_LOG("ALSA", "Failed to start PCM device '%p'!", alsaState->pcmDevice);
+	// Capture devices are not started by writing frames, so we start it when it is not linked
+	if(capture->pcmDevice != fpl_null && !alsaState->isLinked) {
+		if(alsaApi->snd_pcm_start(capture->pcmDevice) < 0) {
+			FPL_LOG("ALSA", "Failed to start PCM capture device '%p'!", capture->pcmDevice);
 			return fplAudioResult_Failed;
 		}
 	}
@@ -12757,11 +16701,20 @@ fpl_internal fplAudioResult fpl__AudioStartAlsa(fpl__CommonAudioState *commonAud
 fpl_internal bool fpl__AudioStopAlsa(fpl__AlsaAudioState *alsaState) {
 	FPL_ASSERT(alsaState != fpl_null);
 	const fpl__AlsaAudioApi *alsaApi = &alsaState->api;
-	if(alsaApi->snd_pcm_drop(alsaState->pcmDevice)) {
-		FPL_LOG("ALSA", "Failed to drop the PCM device '%p'!", alsaState->pcmDevice);
-		return false;
+	bool result = true;
+	if(alsaState->playback.pcmDevice != fpl_null) {
+		if(alsaApi->snd_pcm_drop(alsaState->playback.pcmDevice)) {
+			FPL_LOG("ALSA", "Failed to drop the PCM device '%p'!", alsaState->playback.pcmDevice);
+			result = false;
+		}
 	}
-	return true;
+	if(alsaState->capture.pcmDevice != fpl_null && !alsaState->isLinked) {
+		if(alsaApi->snd_pcm_drop(alsaState->capture.pcmDevice)) {
+			FPL_LOG("ALSA", "Failed to drop the PCM capture device '%p'!", alsaState->capture.pcmDevice);
+			result = false;
+		}
+	}
+	return(result);
 }
 
 fpl_internal_inline snd_pcm_format_t fpl__MapAudioFormatToAlsaFormat(fplAudioFormatType format) {
@@ -12781,13 +16734,6 @@ fpl_internal_inline snd_pcm_format_t fpl__MapAudioFormatToAlsaFormat(fplAudioFor
 	}
 }
 
-fpl_internal void fpl__AudioRunMainLoopAlsa(fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState) {
-	FPL_ASSERT(alsaState != fpl_null);
-	alsaState->breakMainLoop = false;
-	while(!alsaState->breakMainLoop && fpl__GetAudioFramesFromClientAlsa(commonAudio, alsaState)) {
-	}
-}
-
 fpl_internal_inline fplAudioFormatType fpl__MapAlsaFormatToAudioFormat(snd_pcm_format_t format) {
 	switch(format) {
 		case SND_PCM_FORMAT_U8:
@@ -12805,35 +16751,45 @@ fpl_internal_inline fplAudioFormatType fpl__MapAlsaFormatToAudioFormat(snd_pcm_f
 	}
 }
 
-fpl_internal fplAudioResult fpl__AudioInitAlsa(const fplAudioSettings *audioSettings, fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState) {
+fpl_internal fplAudioResult fpl__AlsaInitPcmStream(const fplAudioSettings *audioSettings, const fplAudioDeviceFormat *requestedFormat, const char *forcedDeviceName, const fpl__AlsaAudioApi *alsaApi, snd_pcm_stream_t stream, fpl__AlsaPcmStream *pcmStream, fplAudioDeviceFormat *outFormat) {
 #	define FPL__ALSA_INIT_ERROR(ret, format, ...) do { \
 		FPL_LOG("ALSA", format, __VA_ARGS__); \
-		fpl__AudioReleaseAlsa(commonAudio, alsaState); \
-		return fplAudioResult_Failed; \
+		return ret; \
 	} while (0)
 
-	// Load ALSA library
-	fpl__AlsaAudioApi *alsaApi = &alsaState->api;
-	if(!fpl__LoadAlsaApi(alsaApi)) {
-		FPL__ALSA_INIT_ERROR(fplAudioResult_ApiFailed, "Failed loading ALSA api!");
-	}
+	// Only used for logging
+	const char *streamName = stream == SND_PCM_STREAM_CAPTURE ? "capture" : "playback";
+	(void)streamName;
 
 	//
 	// Open PCM Device
 	//
-	char deviceName[256] = FPL_ZERO_INIT;
-	snd_pcm_stream_t stream = SND_PCM_STREAM_PLAYBACK;
-	if(fplGetAnsiStringLength(audioSettings->deviceInfo.name) > 0) {
+	char *deviceName = pcmStream->deviceName;
+	if(forcedDeviceName != fpl_null) {
+		// @NOTE(final): Used for reopening a lost device only
+		FPL_LOG("ALSA", "Opening PCM %s device '%s'", streamName, forcedDeviceName);
+		if(alsaApi->snd_pcm_open(&pcmStream->pcmDevice, forcedDeviceName, stream, 0) != 0) {
+			FPL__ALSA_INIT_ERROR(fplAudioResult_NoDeviceFound, "Failed opening PCM %s device '%s'!", streamName, forcedDeviceName);
+		}
+		fplCopyAnsiString(forcedDeviceName, deviceName, FPL_ARRAYCOUNT(pcmStream->deviceName));
+	} else if(fplGetAnsiStringLength(audioSettings->deviceInfo.name) > 0) {
 		// @TODO(final): Support for forced audio device ALSA
-		FPL__ALSA_INIT_ERROR(fplAudioResult_NoDeviceFound, "Forced audio device on ALSA is not supported yet!");
+		FPL__ALSA_INIT_ERROR(fplAudioResult_NoDeviceFound, "Forced %s audio device on ALSA is not supported yet!", streamName);
 	} else {
 		const char *defaultDeviceNames[16];
 		int defaultDeviceCount = 0;
 		defaultDeviceNames[defaultDeviceCount++] = "default";
 		if(!audioSettings->preferExclusiveMode) {
-			defaultDeviceNames[defaultDeviceCount++] = "dmix";
-			defaultDeviceNames[defaultDeviceCount++] = "dmix:0";
-			defaultDeviceNames[defaultDeviceCount++] = "dmix:0,0";
+			// @NOTE(final): Software mixing is "dmix" for playback and "dsnoop" for capture
+			if(stream == SND_PCM_STREAM_CAPTURE) {
+				defaultDeviceNames[defaultDeviceCount++] = "dsnoop";
+				defaultDeviceNames[defaultDeviceCount++] = "dsnoop:0";
+				defaultDeviceNames[defaultDeviceCount++] = "dsnoop:0,0";
+			} else {
+				defaultDeviceNames[defaultDeviceCount++] = "dmix";
+				defaultDeviceNames[defaultDeviceCount++] = "dmix:0";
+				defaultDeviceNames[defaultDeviceCount++] = "dmix:0,0";
+			}
 		}
 		defaultDeviceNames[defaultDeviceCount++] = "hw";
 		defaultDeviceNames[defaultDeviceCount++] = "hw:0";
@@ -12842,32 +16798,32 @@ fpl_internal fplAudioResult fpl__AudioInitAlsa(const fplAudioSettings *audioSett
 		bool isDeviceOpen = false;
 		for(size_t defaultDeviceIndex = 0; defaultDeviceIndex < defaultDeviceCount; ++defaultDeviceIndex) {
 			const char *defaultDeviceName = defaultDeviceNames[defaultDeviceIndex];
-			FPL_LOG("ALSA", "Opening PCM audio device '%s'", defaultDeviceName);
-			if(alsaApi->snd_pcm_open(&alsaState->pcmDevice, defaultDeviceName, stream, 0) == 0) {
-				FPL_LOG("ALSA", "Successfully opened PCM audio device '%s'", defaultDeviceName);
+			FPL_LOG("ALSA", "Opening PCM %s device '%s'", streamName, defaultDeviceName);
+			if(alsaApi->snd_pcm_open(&pcmStream->pcmDevice, defaultDeviceName, stream, 0) == 0) {
+				FPL_LOG("ALSA", "Successfully opened PCM %s device '%s'", streamName, defaultDeviceName);
 				isDeviceOpen = true;
-				fplCopyAnsiString(defaultDeviceName, deviceName, FPL_ARRAYCOUNT(deviceName));
+				fplCopyAnsiString(defaultDeviceName, deviceName, FPL_ARRAYCOUNT(pcmStream->deviceName));
 				break;
 			} else {
-				FPL_LOG("ALSA", "Failed opening PCM audio device '%s'!", defaultDeviceName);
+				FPL_LOG("ALSA", "Failed opening PCM %s device '%s'!", streamName, defaultDeviceName);
 			}
 		}
 		if(!isDeviceOpen) {
-			FPL__ALSA_INIT_ERROR(fplAudioResult_NoDeviceFound, "No PCM audio device found!");
+			FPL__ALSA_INIT_ERROR(fplAudioResult_NoDeviceFound, "No PCM %s device found!", streamName);
 		}
 	}
 
 	//
 	// Get hardware parameters
 	//
-	FPL_ASSERT(alsaState->pcmDevice != fpl_null);
+	FPL_ASSERT(pcmStream->pcmDevice != fpl_null);
 	FPL_ASSERT(fplGetAnsiStringLength(deviceName) > 0);
 
 	FPL_LOG("ALSA", "Get hardware parameters from device '%s'", deviceName);
 	size_t hardwareParamsSize = alsaApi->snd_pcm_hw_params_sizeof();
 	snd_pcm_hw_params_t *hardwareParams = (snd_pcm_hw_params_t *)FPL_STACKALLOCATE(hardwareParamsSize);
 	fplMemoryClear(hardwareParams, hardwareParamsSize);
-	if(alsaApi->snd_pcm_hw_params_any(alsaState->pcmDevice, hardwareParams) < 0) {
+	if(alsaApi->snd_pcm_hw_params_any(pcmStream->pcmDevice, hardwareParams) < 0) {
 		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed getting hardware parameters from device '%s'!", deviceName);
 	}
 	FPL_LOG("ALSA", "Successfullyy got hardware parameters from device '%s'", deviceName);
@@ -12875,16 +16831,16 @@ fpl_internal fplAudioResult fpl__AudioInitAlsa(const fplAudioSettings *audioSett
 	//
 	// Access mode (Interleaved MMap or Standard readi/writei)
 	//
-	alsaState->isUsingMMap = false;
+	pcmStream->isUsingMMap = false;
 	if(!audioSettings->specific.alsa.noMMap) {
-		if(alsaApi->snd_pcm_hw_params_set_access(alsaState->pcmDevice, hardwareParams, SND_PCM_ACCESS_MMAP_INTERLEAVED) == 0) {
-			alsaState->isUsingMMap = true;
+		if(alsaApi->snd_pcm_hw_params_set_access(pcmStream->pcmDevice, hardwareParams, SND_PCM_ACCESS_MMAP_INTERLEAVED) == 0) {
+			pcmStream->isUsingMMap = true;
 		} else {
 			FPL_LOG("ALSA", "Failed setting MMap access mode for device '%s', trying fallback to standard mode!", deviceName);
 		}
 	}
-	if(!alsaState->isUsingMMap) {
-		if(alsaApi->snd_pcm_hw_params_set_access(alsaState->pcmDevice, hardwareParams, SND_PCM_ACCESS_RW_INTERLEAVED) < 0) {
+	if(!pcmStream->isUsingMMap) {
+		if(alsaApi->snd_pcm_hw_params_set_access(pcmStream->pcmDevice, hardwareParams, SND_PCM_ACCESS_RW_INTERLEAVED) < 0) {
 			FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed setting default access mode for device '%s'!", deviceName);
 		}
 	}
@@ -12900,7 +16856,7 @@ fpl_internal fplAudioResult fpl__AudioInitAlsa(const fplAudioSettings *audioSett
 	alsaApi->snd_pcm_hw_params_get_format_mask(hardwareParams, formatMask);
 
 	snd_pcm_format_t foundFormat;
-	snd_pcm_format_t preferredFormat = fpl__MapAudioFormatToAlsaFormat(audioSettings->deviceFormat.type);
+	snd_pcm_format_t preferredFormat = fpl__MapAudioFormatToAlsaFormat(requestedFormat->type);
 	if(!alsaApi->snd_pcm_format_mask_test(formatMask, preferredFormat)) {
 		// The required format is not supported. Try a list of default formats.
 		snd_pcm_format_t defaultFormats[] = {
@@ -12929,103 +16885,466 @@ fpl_internal fplAudioResult fpl__AudioInitAlsa(const fplAudioSettings *audioSett
 	// Set format
 	//
 	fplAudioFormatType internalFormatType = fpl__MapAlsaFormatToAudioFormat(foundFormat);
-	if(alsaApi->snd_pcm_hw_params_set_format(alsaState->pcmDevice, hardwareParams, foundFormat) < 0) {
+	if(alsaApi->snd_pcm_hw_params_set_format(pcmStream->pcmDevice, hardwareParams, foundFormat) < 0) {
 		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed setting PCM format '%s' for device '%s'!", fplGetAudioFormatString(internalFormatType), deviceName);
 	}
 
-	//
-	// Set channels
-	//
-	uint32_t internalChannels = audioSettings->deviceFormat.channels;
-	if(alsaApi->snd_pcm_hw_params_set_channels_near(alsaState->pcmDevice, hardwareParams, &internalChannels) < 0) {
-		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed setting PCM channels '%lu' for device '%s'!", internalChannels, deviceName);
+	//
+	// Set channels
+	//
+	uint32_t internalChannels = requestedFormat->channels;
+	if(alsaApi->snd_pcm_hw_params_set_channels_near(pcmStream->pcmDevice, hardwareParams, &internalChannels) < 0) {
+		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed setting PCM channels '%lu' for device '%s'!", internalChannels, deviceName);
+	}
+
+	//
+	// Set sample rate
+	//
+
+	// @NOTE(final): We disable the resampling of the sample rate to not get caught into any driver bugs
+	alsaApi->snd_pcm_hw_params_set_rate_resample(pcmStream->pcmDevice, hardwareParams, 0);
+
+	uint32_t internalSampleRate = requestedFormat->sampleRate;
+	if(alsaApi->snd_pcm_hw_params_set_rate_near(pcmStream->pcmDevice, hardwareParams, &internalSampleRate, 0) < 0) {
+		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed setting PCM sample rate '%lu' for device '%s'!", internalSampleRate, deviceName);
+	}
+
+	//
+	// Set periods
+	//
+	uint32_t internalPeriods = requestedFormat->periods;
+	int periodsDir = 0;
+	if(alsaApi->snd_pcm_hw_params_set_periods_near(pcmStream->pcmDevice, hardwareParams, &internalPeriods, &periodsDir) < 0) {
+		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed setting PCM periods '%lu' for device '%s'!", internalPeriods, deviceName);
+	}
+
+	//
+	// Set buffer size
+	//
+	snd_pcm_uframes_t actualBufferSize = requestedFormat->bufferSizeInFrames;
+	if(alsaApi->snd_pcm_hw_params_set_buffer_size_near(pcmStream->pcmDevice, hardwareParams, &actualBufferSize) < 0) {
+		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed setting PCM buffer size '%lu' for device '%s'!", actualBufferSize, deviceName);
+	}
+	uint32_t internalBufferSizeInFrame = actualBufferSize;
+
+	//
+	// Set hardware parameters
+	//
+	if(alsaApi->snd_pcm_hw_params(pcmStream->pcmDevice, hardwareParams) < 0) {
+		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed to install PCM hardware parameters for device '%s'!", deviceName);
+	}
+
+	// Set internal format
+	fplAudioDeviceFormat internalFormat = FPL_ZERO_INIT;
+	internalFormat.type = internalFormatType;
+	internalFormat.channels = internalChannels;
+	internalFormat.sampleRate = internalSampleRate;
+	internalFormat.periods = internalPeriods;
+	internalFormat.bufferSizeInFrames = internalBufferSizeInFrame;
+	internalFormat.bufferSizeInBytes = internalFormat.bufferSizeInFrames * internalFormat.channels * fplGetAudioSampleSizeInBytes(internalFormat.type);
+	*outFormat = internalFormat;
+
+	//
+	// Software parameters
+	//
+	size_t softwareParamsSize = alsaApi->snd_pcm_sw_params_sizeof();
+	snd_pcm_sw_params_t *softwareParams = (snd_pcm_sw_params_t *)FPL_STACKALLOCATE(softwareParamsSize);
+	fplMemoryClear(softwareParams, softwareParamsSize);
+	if(alsaApi->snd_pcm_sw_params_current(pcmStream->pcmDevice, softwareParams) < 0) {
+		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed to get software parameters for device '%s'!", deviceName);
+	}
+	snd_pcm_uframes_t minAvailableFrames = (internalFormat.sampleRate / 1000) * 1;
+	if(alsaApi->snd_pcm_sw_params_set_avail_min(pcmStream->pcmDevice, softwareParams, minAvailableFrames) < 0) {
+		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed to set software available min for device '%s'!", deviceName);
+	}
+	if(!pcmStream->isUsingMMap && stream == SND_PCM_STREAM_PLAYBACK) {
+		if(alsaApi->snd_pcm_sw_params_set_start_threshold(pcmStream->pcmDevice, softwareParams, minAvailableFrames) < 0) {
+			FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed to set start threshold of '%lu' for device '%s'!", minAvailableFrames, deviceName);
+		}
+	}
+	if(alsaApi->snd_pcm_sw_params(pcmStream->pcmDevice, softwareParams) < 0) {
+		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed to install PCM software parameters for device '%s'!", deviceName);
+	}
+
+	if(!pcmStream->isUsingMMap) {
+		pcmStream->intermediaryBuffer = fplMemoryAllocate(internalFormat.bufferSizeInBytes);
+		if(pcmStream->intermediaryBuffer == fpl_null) {
+			FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed allocating intermediary buffer of size '%lu' for device '%s'!", internalFormat.bufferSizeInBytes, deviceName);
+		}
+	}
+
+	// @NOTE(final): We do not ALSA support channel mapping right know, so we limit it to mono or stereo
+	FPL_ASSERT(internalFormat.channels <= 2);
+
+#undef FPL__ALSA_INIT_ERROR
+
+	return fplAudioResult_Success;
+}
+
+fpl_internal fplAudioResult fpl__AlsaInitPcmStreams(const fplAudioSettings *audioSettings, const char *playbackDeviceName, const char *captureDeviceName, fpl__AlsaAudioState *alsaState, fplAudioDeviceFormat *outFormat) {
+	const fpl__AlsaAudioApi *alsaApi = &alsaState->api;
+	fplAudioDeviceType deviceType = audioSettings->deviceType;
+	bool hasPlayback = (deviceType == fplAudioDeviceType_Playback) || (deviceType == fplAudioDeviceType_Duplex);
+	bool hasCapture = (deviceType == fplAudioDeviceType_Capture) || (deviceType == fplAudioDeviceType_Duplex);
+
+	fplAudioDeviceFormat internalFormat = FPL_ZERO_INIT;
+	fplAudioResult streamResult;
+
+	//
+	// Playback device
+	//
+	if(hasPlayback) {
+		streamResult = fpl__AlsaInitPcmStream(audioSettings, &audioSettings->deviceFormat, playbackDeviceName, alsaApi, SND_PCM_STREAM_PLAYBACK, &alsaState->playback, &internalFormat);
+		if(streamResult != fplAudioResult_Success) {
+			return streamResult;
+		}
+	}
+
+	//
+	// Capture device
+	//
+	if(hasCapture) {
+		// @NOTE(final): In full-duplex mode we request the negotiated playback format, so both devices run with the same format and period size.
+		fplAudioDeviceFormat captureFormat = FPL_ZERO_INIT;
+		const fplAudioDeviceFormat *requestedFormat = hasPlayback ? &internalFormat : &audioSettings->deviceFormat;
+		streamResult = fpl__AlsaInitPcmStream(audioSettings, requestedFormat, captureDeviceName, alsaApi, SND_PCM_STREAM_CAPTURE, &alsaState->capture, &captureFormat);
+		if(streamResult != fplAudioResult_Success) {
+			return streamResult;
+		}
+		if(hasPlayback) {
+			if(captureFormat.type != internalFormat.type || captureFormat.channels != internalFormat.channels || captureFormat.sampleRate != internalFormat.sampleRate || captureFormat.bufferSizeInFrames != internalFormat.bufferSizeInFrames) {
+				FPL_LOG("ALSA", "Capture format '%s' with %u channels at %u Hz and %u frames does not match the playback format '%s' with %u channels at %u Hz and %u frames for full-duplex!",
+						fplGetAudioFormatString(captureFormat.type), captureFormat.channels, captureFormat.sampleRate, captureFormat.bufferSizeInFrames,
+						fplGetAudioFormatString(internalFormat.type), internalFormat.channels, internalFormat.sampleRate, internalFormat.bufferSizeInFrames);
+				return fplAudioResult_Failed;
+			}
+
+			// Link both devices, so they are started and stopped together and share the same clock
+			if(alsaApi->snd_pcm_link(alsaState->capture.pcmDevice, alsaState->playback.pcmDevice) == 0) {
+				alsaState->isLinked = true;
+			} else {
+				FPL_LOG("ALSA", "%s", "Failed linking the capture and playback device, running them unlinked!");
+			}
+		} else {
+			internalFormat = captureFormat;
+		}
+	}
+
+	*outFormat = internalFormat;
+
+	return fplAudioResult_Success;
+}
+
+fpl_internal fplAudioResult fpl__AudioInitAlsa(const fplAudioSettings *audioSettings, fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState) {
+	// Load ALSA library
+	fpl__AlsaAudioApi *alsaApi = &alsaState->api;
+	if(!fpl__LoadAlsaApi(alsaApi)) {
+		FPL_LOG("ALSA", "%s", "Failed loading ALSA api!");
+		fpl__AudioReleaseAlsa(commonAudio, alsaState);
+		return fplAudioResult_ApiFailed;
+	}
+	FPL_LOG("ALSA", "Loaded ALSA api in %.3f ms", (double)fpl__global__AlsaLibraryProbe.loadTime / 1000000.0);
+
+	// Keep the settings, so we can reopen the devices when they are lost
+	alsaState->audioSettings = *audioSettings;
+
+	fplAudioDeviceFormat internalFormat = FPL_ZERO_INIT;
+	fplAudioResult result = fpl__AlsaInitPcmStreams(audioSettings, fpl_null, fpl_null, alsaState, &internalFormat);
+	if(result != fplAudioResult_Success) {
+		fpl__AudioReleaseAlsa(commonAudio, alsaState);
+		return result;
+	}
+	commonAudio->internalFormat = internalFormat;
+
+	return fplAudioResult_Success;
+}
+
+fpl_internal bool fpl__AlsaReopenDevice(fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState) {
+	FPL_ASSERT(commonAudio != fpl_null && alsaState != fpl_null);
+
+	fplAtomicAddU32(&commonAudio->deviceLostCount, 1);
+	fpl__PushAudioEvent(commonAudio, fplAudioEventType_DeviceLost);
+
+	// Remember the devices which was used before, releasing clears them
+	char lastPlaybackDeviceName[256];
+	char lastCaptureDeviceName[256];
+	fplCopyAnsiString(alsaState->playback.deviceName, lastPlaybackDeviceName, FPL_ARRAYCOUNT(lastPlaybackDeviceName));
+	fplCopyAnsiString(alsaState->capture.deviceName, lastCaptureDeviceName, FPL_ARRAYCOUNT(lastCaptureDeviceName));
+	FPL_LOG("ALSA", "Lost audio device '%s%s', trying to reopen it!", lastPlaybackDeviceName, lastCaptureDeviceName);
+	fpl__AlsaReleasePcmStreams(alsaState);
+
+	uint32_t backoffInMilliseconds = FPL__ALSA_REOPEN_MIN_BACKOFF;
+	while(!alsaState->breakMainLoop && fpl__IsAudioDeviceStarted(commonAudio)) {
+		// Try the last device first, then fallback to the default device
+		for(int attempt = 0; attempt < 2; ++attempt) {
+			const char *playbackDeviceName = attempt == 0 ? lastPlaybackDeviceName : "default";
+			const char *captureDeviceName = attempt == 0 ? lastCaptureDeviceName : "default";
+			fplAudioDeviceFormat internalFormat = FPL_ZERO_INIT;
+			if(fpl__AlsaInitPcmStreams(&alsaState->audioSettings, playbackDeviceName, captureDeviceName, alsaState, &internalFormat) == fplAudioResult_Success) {
+				commonAudio->internalFormat = internalFormat;
+				if(fpl__AudioStartAlsa(commonAudio, alsaState) == fplAudioResult_Success) {
+					FPL_LOG("ALSA", "Reopened audio device '%s%s'", alsaState->playback.deviceName, alsaState->capture.deviceName);
+					alsaState->consecutiveXRuns = 0;
+					fpl__ResetAudioJitter(commonAudio);
+					fplAtomicAddU32(&commonAudio->reopenCount, 1);
+					fpl__PushAudioEvent(commonAudio, fplAudioEventType_DeviceChanged);
+					return true;
+				}
+			}
+			fpl__AlsaReleasePcmStreams(alsaState);
+		}
+
+		// Wait before trying again, but dont block stopping the device
+		for(uint32_t waited = 0; waited < backoffInMilliseconds && !alsaState->breakMainLoop; waited += 10) {
+			fplThreadSleep(10);
+		}
+		backoffInMilliseconds = FPL_MIN(backoffInMilliseconds * 2, FPL__ALSA_REOPEN_MAX_BACKOFF);
+	}
+	return false;
+}
+
+fpl_internal void fpl__AudioRunMainLoopAlsa(fpl__CommonAudioState *commonAudio, fpl__AlsaAudioState *alsaState) {
+	FPL_ASSERT(alsaState != fpl_null);
+	alsaState->breakMainLoop = false;
+	while(!alsaState->breakMainLoop) {
+		bool success = true;
+		alsaState->hasRecoveredXRun = false;
+
+		// @NOTE(final): In full-duplex mode the captured frames are delivered first, so the client can use them for the following playback period.
+		if(alsaState->capture.pcmDevice != fpl_null) {
+			success = fpl__SendAudioFramesToClientAlsa(commonAudio, alsaState);
+		}
+		if(success && alsaState->playback.pcmDevice != fpl_null) {
+			success = fpl__GetAudioFramesFromClientAlsa(commonAudio, alsaState);
+		}
+
+		// Only a period without any recovery breaks a series of xruns
+		if(success && !alsaState->hasRecoveredXRun) {
+			alsaState->consecutiveXRuns = 0;
+		}
+
+		if(!success) {
+			// The device is stopping or it is gone (Unplugged, too many xruns, etc.)
+			if(alsaState->breakMainLoop || !fpl__IsAudioDeviceStarted(commonAudio)) {
+				break;
+			}
+			if(!fpl__AlsaReopenDevice(commonAudio, alsaState)) {
+				break;
+			}
+		}
 	}
+}
 
-	//
-	// Set sample rate
-	//
+#endif // FPL_ENABLE_AUDIO_ALSA
 
-	// @NOTE(final): We disable the resampling of the sample rate to not get caught into any driver bugs
-	alsaApi->snd_pcm_hw_params_set_rate_resample(alsaState->pcmDevice, hardwareParams, 0);
+// ############################################################################
+//
+// > AUDIO_DRIVER_NULL
+//
+// ############################################################################
+#if defined(FPL_ENABLE_AUDIO_NULL)
+typedef struct fpl__NullAudioState {
+	fplNullAudioSettings settings;
+	fplNullAudioStats stats;
+	volatile uint32_t statsSequence;
+	fplFileHandle wavFile;
+	void *intermediaryBuffer;
+	uint64_t periodInNanoseconds;
+	uint64_t nextPeriodTime;
+	uint32_t wavDataSize;
+	bool isWavFileOpen;
+	bool breakMainLoop;
+} fpl__NullAudioState;
+
+fpl_internal void fpl__NullWriteU16(uint8_t *p, uint16_t value) {
+	p[0] = (uint8_t)(value & 0xFF);
+	p[1] = (uint8_t)((value >> 8) & 0xFF);
+}
+
+fpl_internal void fpl__NullWriteU32(uint8_t *p, uint32_t value) {
+	p[0] = (uint8_t)(value & 0xFF);
+	p[1] = (uint8_t)((value >> 8) & 0xFF);
+	p[2] = (uint8_t)((value >> 16) & 0xFF);
+	p[3] = (uint8_t)((value >> 24) & 0xFF);
+}
+
+fpl_internal bool fpl__NullWriteWavHeader(const fplFileHandle *file, const fplAudioDeviceFormat *format, const uint32_t dataSize) {
+	// @NOTE(final): Canonical 44 byte RIFF/WAVE header, all values are little-endian
+	uint8_t header[44];
+	uint32_t bytesPerSample = fplGetAudioSampleSizeInBytes(format->type);
+	bool isFloat = (format->type == fplAudioFormatType_F32) || (format->type == fplAudioFormatType_F64);
+	fplMemoryCopy("RIFF", 4, header + 0);
+	fpl__NullWriteU32(header + 4, 36 + dataSize);
+	fplMemoryCopy("WAVE", 4, header + 8);
+	fplMemoryCopy("fmt ", 4, header + 12);
+	fpl__NullWriteU32(header + 16, 16);
+	fpl__NullWriteU16(header + 20, isFloat ? 3 : 1);
+	fpl__NullWriteU16(header + 22, (uint16_t)format->channels);
+	fpl__NullWriteU32(header + 24, format->sampleRate);
+	fpl__NullWriteU32(header + 28, format->sampleRate * format->channels * bytesPerSample);
+	fpl__NullWriteU16(header + 32, (uint16_t)(format->channels * bytesPerSample));
+	fpl__NullWriteU16(header + 34, (uint16_t)(bytesPerSample * 8));
+	fplMemoryCopy("data", 4, header + 36);
+	fpl__NullWriteU32(header + 40, dataSize);
+	fplSetFilePosition32(file, 0, fplFilePositionMode_Beginning);
+	bool result = fplWriteFileBlock32(file, header, sizeof(header)) == sizeof(header);
+	return(result);
+}
 
-	uint32_t internalSampleRate = audioSettings->deviceFormat.sampleRate;
-	if(alsaApi->snd_pcm_hw_params_set_rate_near(alsaState->pcmDevice, hardwareParams, &internalSampleRate, 0) < 0) {
-		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed setting PCM sample rate '%lu' for device '%s'!", internalSampleRate, deviceName);
+fpl_internal bool fpl__AudioReleaseNull(const fpl__CommonAudioState *commonAudio, fpl__NullAudioState *nullState) {
+	FPL_ASSERT(commonAudio != fpl_null && nullState != fpl_null);
+	if(nullState->isWavFileOpen) {
+		// Patch the final sizes into the header
+		fpl__NullWriteWavHeader(&nullState->wavFile, &commonAudio->internalFormat, nullState->wavDataSize);
+		fplCloseFile(&nullState->wavFile);
+		nullState->isWavFileOpen = false;
+	}
+	if(nullState->intermediaryBuffer != fpl_null) {
+		fplMemoryFree(nullState->intermediaryBuffer);
+		nullState->intermediaryBuffer = fpl_null;
 	}
+	FPL_CLEAR_STRUCT(nullState);
+	return true;
+}
 
-	//
-	// Set periods
-	//
-	uint32_t internalPeriods = audioSettings->deviceFormat.periods;
-	int periodsDir = 0;
-	if(alsaApi->snd_pcm_hw_params_set_periods_near(alsaState->pcmDevice, hardwareParams, &internalPeriods, &periodsDir) < 0) {
-		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed setting PCM periods '%lu' for device '%s'!", internalPeriods, deviceName);
+fpl_internal fplAudioResult fpl__AudioInitNull(const fplAudioSettings *audioSettings, fpl__CommonAudioState *commonAudio, fpl__NullAudioState *nullState) {
+	FPL_ASSERT(audioSettings != fpl_null && commonAudio != fpl_null && nullState != fpl_null);
+	nullState->settings = audioSettings->specific.nullDriver;
+
+	// There is no hardware, so we just take whatever the client wants
+	fplAudioDeviceFormat internalFormat = audioSettings->deviceFormat;
+	if(internalFormat.type == fplAudioFormatType_None) {
+		internalFormat.type = fplAudioFormatType_S16;
+	}
+	internalFormat.periods = 2;
+	internalFormat.bufferSizeInFrames = fplGetAudioBufferSizeInFrames(internalFormat.sampleRate, audioSettings->bufferSizeInMilliSeconds);
+	internalFormat.bufferSizeInBytes = fplGetAudioBufferSizeInBytes(internalFormat.type, internalFormat.channels, internalFormat.bufferSizeInFrames);
+	if(internalFormat.bufferSizeInFrames < internalFormat.periods) {
+		FPL_LOG("Null", "Buffer size of '%lu' frames is too small!", internalFormat.bufferSizeInFrames);
+		return fplAudioResult_Failed;
 	}
 
-	//
-	// Set buffer size
-	//
-	snd_pcm_uframes_t actualBufferSize = audioSettings->deviceFormat.bufferSizeInFrames;
-	if(alsaApi->snd_pcm_hw_params_set_buffer_size_near(alsaState->pcmDevice, hardwareParams, &actualBufferSize) < 0) {
-		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed setting PCM buffer size '%lu' for device '%s'!", actualBufferSize, deviceName);
+	// One period is read from the client at a time
+	uint32_t periodSizeInFrames = internalFormat.bufferSizeInFrames / internalFormat.periods;
+	size_t periodSizeInBytes = fplGetAudioBufferSizeInBytes(internalFormat.type, internalFormat.channels, periodSizeInFrames);
+	nullState->intermediaryBuffer = fplMemoryAllocate(periodSizeInBytes);
+	if(nullState->intermediaryBuffer == fpl_null) {
+		return fplAudioResult_Failed;
 	}
-	uint32_t internalBufferSizeInFrame = actualBufferSize;
+	nullState->periodInNanoseconds = ((uint64_t)periodSizeInFrames * 1000000000ULL) / (uint64_t)internalFormat.sampleRate;
 
-	//
-	// Set hardware parameters
-	//
-	if(alsaApi->snd_pcm_hw_params(alsaState->pcmDevice, hardwareParams) < 0) {
-		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed to install PCM hardware parameters for device '%s'!", deviceName);
+	if(fplGetAnsiStringLength(nullState->settings.wavFilePath) > 0) {
+		if(!fplCreateAnsiBinaryFile(nullState->settings.wavFilePath, &nullState->wavFile)) {
+			FPL_LOG("Null", "Failed creating WAV file '%s'!", nullState->settings.wavFilePath);
+			return fplAudioResult_Failed;
+		}
+		nullState->isWavFileOpen = true;
+		if(!fpl__NullWriteWavHeader(&nullState->wavFile, &internalFormat, 0)) {
+			FPL_LOG("Null", "Failed writing WAV header to '%s'!", nullState->settings.wavFilePath);
+			return fplAudioResult_Failed;
+		}
 	}
 
-	// Set internal format
-	fplAudioDeviceFormat internalFormat = FPL_ZERO_INIT;
-	internalFormat.type = internalFormatType;
-	internalFormat.channels = internalChannels;
-	internalFormat.sampleRate = internalSampleRate;
-	internalFormat.periods = internalPeriods;
-	internalFormat.bufferSizeInFrames = internalBufferSizeInFrame;
-	internalFormat.bufferSizeInBytes = internalFormat.bufferSizeInFrames * internalFormat.channels * fplGetAudioSampleSizeInBytes(internalFormat.type);
 	commonAudio->internalFormat = internalFormat;
 
-	//
-	// Software parameters
-	//
-	size_t softwareParamsSize = alsaApi->snd_pcm_sw_params_sizeof();
-	snd_pcm_sw_params_t *softwareParams = (snd_pcm_sw_params_t *)FPL_STACKALLOCATE(softwareParamsSize);
-	fplMemoryClear(softwareParams, softwareParamsSize);
-	if(alsaApi->snd_pcm_sw_params_current(alsaState->pcmDevice, softwareParams) < 0) {
-		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed to get software parameters for device '%s'!", deviceName);
-	}
-	snd_pcm_uframes_t minAvailableFrames = (internalFormat.sampleRate / 1000) * 1;
-	if(alsaApi->snd_pcm_sw_params_set_avail_min(alsaState->pcmDevice, softwareParams, minAvailableFrames) < 0) {
-		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed to set software available min for device '%s'!", deviceName);
+	return fplAudioResult_Success;
+}
+
+fpl_internal fplAudioResult fpl__AudioStartNull(fpl__NullAudioState *nullState) {
+	FPL_ASSERT(nullState != fpl_null);
+	nullState->nextPeriodTime = fplGetTimeInNanoseconds() + nullState->periodInNanoseconds;
+	return fplAudioResult_Success;
+}
+
+fpl_internal bool fpl__AudioStopNull(fpl__NullAudioState *nullState) {
+	FPL_ASSERT(nullState != fpl_null);
+	// Nothing to stop, the main loop is stopped by fpl__AudioStopMainLoopNull()
+	(void)nullState;
+	return true;
+}
+
+fpl_internal_inline void fpl__AudioStopMainLoopNull(fpl__NullAudioState *nullState) {
+	FPL_ASSERT(nullState != fpl_null);
+	nullState->breakMainLoop = true;
+}
+
+fpl_internal void fpl__AudioWaitForPeriodNull(fpl__NullAudioState *nullState) {
+	// @NOTE(final): fplSleepPrecise() lets the OS sleep until shortly before the deadline and spins only the short rest, on the same clock as the period timer
+	uint64_t now = fplGetTimeInNanoseconds();
+	if(!nullState->breakMainLoop && now < nullState->nextPeriodTime) {
+		fplSleepPrecise(nullState->nextPeriodTime - now);
 	}
-	if(!alsaState->isUsingMMap) {
-		if(alsaApi->snd_pcm_sw_params_set_start_threshold(alsaState->pcmDevice, softwareParams, minAvailableFrames) < 0) {
-			FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed to set start threshold of '%lu' for device '%s'!", minAvailableFrames, deviceName);
+}
+
+fpl_internal void fpl__AudioRunMainLoopNull(fpl__CommonAudioState *commonAudio, fpl__NullAudioState *nullState) {
+	FPL_ASSERT(commonAudio != fpl_null && nullState != fpl_null);
+	const fplAudioDeviceFormat *format = &commonAudio->internalFormat;
+	uint32_t periodSizeInFrames = format->bufferSizeInFrames / format->periods;
+	uint32_t periodSizeInBytes = fplGetAudioBufferSizeInBytes(format->type, format->channels, periodSizeInFrames);
+	uint64_t bufferInNanoseconds = nullState->periodInNanoseconds * (uint64_t)format->periods;
+	bool hasPlayback = commonAudio->deviceType != fplAudioDeviceType_Capture;
+	bool hasCapture = commonAudio->deviceType != fplAudioDeviceType_Playback;
+	nullState->breakMainLoop = false;
+	while(!nullState->breakMainLoop) {
+		uint64_t latenessInMicroseconds = 0;
+		if(!nullState->settings.isUnthrottled) {
+			fpl__AudioWaitForPeriodNull(nullState);
+			if(nullState->breakMainLoop) {
+				break;
+			}
+			uint64_t wakeupTime = fplGetTimeInNanoseconds();
+			latenessInMicroseconds = wakeupTime > nullState->nextPeriodTime ? (wakeupTime - nullState->nextPeriodTime) / 1000ULL : 0;
 		}
-	}
-	if(alsaApi->snd_pcm_sw_params(alsaState->pcmDevice, softwareParams) < 0) {
-		FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed to install PCM software parameters for device '%s'!", deviceName);
-	}
 
-	if(!alsaState->isUsingMMap) {
-		alsaState->intermediaryBuffer = fplMemoryAllocate(internalFormat.bufferSizeInBytes);
-		if(alsaState->intermediaryBuffer == fpl_null) {
-			FPL__ALSA_INIT_ERROR(fplAudioResult_Failed, "Failed allocating intermediary buffer of size '%lu' for device '%s'!", internalFormat.bufferSizeInBytes, deviceName);
+		// Capture delivers silence, playback is read into the intermediary buffer
+		uint32_t framesRead = 0;
+		if(hasCapture) {
+			fplMemoryClear(nullState->intermediaryBuffer, periodSizeInBytes);
+			fpl__WriteAudioFramesToClient(commonAudio, periodSizeInFrames, nullState->intermediaryBuffer, 0);
 		}
-	}
+		if(hasPlayback) {
+			framesRead = fpl__ReadAudioFramesFromClient(commonAudio, periodSizeInFrames, nullState->intermediaryBuffer, 0);
+			FPL_ASSERT(framesRead <= periodSizeInFrames);
+		}
+		uint64_t callbackEnd = fplGetTimeInNanoseconds();
 
-	// @NOTE(final): We do not ALSA support channel mapping right know, so we limit it to mono or stereo
-	FPL_ASSERT(internalFormat.channels <= 2);
+		uint32_t bytesWritten = 0;
+		if(nullState->isWavFileOpen && framesRead > 0) {
+			uint32_t bytesToWrite = fplGetAudioBufferSizeInBytes(format->type, format->channels, framesRead);
+			bytesWritten = fplWriteFileBlock32(&nullState->wavFile, nullState->intermediaryBuffer, bytesToWrite);
+			nullState->wavDataSize += bytesWritten;
+		}
 
-#undef FPL__ALSA_INIT_ERROR
+		// Advance the period timer, resync when we have fallen behind more than one entire buffer
+		bool isUnderrun = false;
+		if(!nullState->settings.isUnthrottled) {
+			nullState->nextPeriodTime += nullState->periodInNanoseconds;
+			if(callbackEnd > nullState->nextPeriodTime && (callbackEnd - nullState->nextPeriodTime) > bufferInNanoseconds) {
+				nullState->nextPeriodTime = callbackEnd + nullState->periodInNanoseconds;
+				isUnderrun = true;
+				fplAtomicAddU32(&commonAudio->underrunCount, 1);
+			}
+		}
 
-	return fplAudioResult_Success;
+		fpl__BeginAudioStatsWrite(&nullState->statsSequence);
+		fplNullAudioStats *stats = &nullState->stats;
+		if(!nullState->settings.isUnthrottled) {
+			fpl__AddAudioTimingSample(&stats->periodLateness, latenessInMicroseconds);
+		}
+		stats->periodCount++;
+		stats->framesRead += framesRead;
+		stats->wavBytesWritten += bytesWritten;
+		if(isUnderrun) {
+			stats->underrunCount++;
+		}
+		fpl__EndAudioStatsWrite(&nullState->statsSequence);
+	}
 }
 
-#endif // FPL_ENABLE_AUDIO_ALSA
+fpl_internal void fpl__GetStatsNull(fpl__NullAudioState *nullState, fplNullAudioStats *outStats) {
+	fpl__ReadAudioStats(&nullState->statsSequence, &nullState->stats, sizeof(nullState->stats), outStats);
+}
+#endif // FPL_ENABLE_AUDIO_NULL
 
 #endif // FPL_AUDIO_DRIVERS_IMPLEMENTED
 
@@ -13060,6 +17379,9 @@ typedef struct fpl__AudioState {
 #	endif
 #	if defined(FPL_ENABLE_AUDIO_ALSA)
 		fpl__AlsaAudioState alsa;
+#	endif
+#	if defined(FPL_ENABLE_AUDIO_NULL)
+		fpl__NullAudioState nullDriver;
 #	endif
 	};
 } fpl__AudioState;
@@ -13073,6 +17395,27 @@ fpl_internal_inline fpl__AudioState *fpl__GetAudioState(fpl__PlatformAppState *a
 	return(result);
 }
 
+#if defined(FPL_ENABLE_WINDOW)
+fpl_internal void fpl__PushPendingAudioEvents() {
+	// @NOTE(final): The event queue is not thread-safe, so the audio thread pushes its events into a ring buffer and we move them here on the polling thread.
+	fpl__PlatformAppState *appState = fpl__global__AppState;
+	if(appState == fpl_null) {
+		return;
+	}
+	fpl__AudioState *audioState = fpl__GetAudioState(appState);
+	if(audioState == fpl_null || audioState->common.pendingEvents.data == fpl_null) {
+		return;
+	}
+	fplAudioEvent audioEvent;
+	while(fplRingBufferRead(&audioState->common.pendingEvents, &audioEvent, sizeof(audioEvent))) {
+		fplEvent ev = FPL_ZERO_INIT;
+		ev.type = fplEventType_Audio;
+		ev.audio = audioEvent;
+		fpl__PushEvent(&ev);
+	}
+}
+#endif // FPL_ENABLE_WINDOW
+
 fpl_internal void fpl__StopAudioDeviceMainLoop(fpl__AudioState *audioState) {
 	FPL_ASSERT(audioState->activeDriver > fplAudioDriverType_Auto);
 	switch(audioState->activeDriver) {
@@ -13091,6 +17434,13 @@ fpl_internal void fpl__StopAudioDeviceMainLoop(fpl__AudioState *audioState) {
 		} break;
 #	endif
 
+#	if defined(FPL_ENABLE_AUDIO_NULL)
+		case fplAudioDriverType_Null:
+		{
+			fpl__AudioStopMainLoopNull(&audioState->nullDriver);
+		} break;
+#	endif
+
 		default:
 			break;
 	}
@@ -13115,6 +17465,13 @@ fpl_internal bool fpl__ReleaseAudioDevice(fpl__AudioState *audioState) {
 		} break;
 #	endif
 
+#	if defined(FPL_ENABLE_AUDIO_NULL)
+		case fplAudioDriverType_Null:
+		{
+			result = fpl__AudioReleaseNull(&audioState->common, &audioState->nullDriver);
+		} break;
+#	endif
+
 		default:
 			break;
 	}
@@ -13140,6 +17497,13 @@ fpl_internal bool fpl__StopAudioDevice(fpl__AudioState *audioState) {
 		} break;
 #	endif
 
+#	if defined(FPL_ENABLE_AUDIO_NULL)
+		case fplAudioDriverType_Null:
+		{
+			result = fpl__AudioStopNull(&audioState->nullDriver);
+		} break;
+#	endif
+
 		default:
 			break;
 	}
@@ -13148,6 +17512,7 @@ fpl_internal bool fpl__StopAudioDevice(fpl__AudioState *audioState) {
 
 fpl_internal fplAudioResult fpl__StartAudioDevice(fpl__AudioState *audioState) {
 	FPL_ASSERT(audioState->activeDriver > fplAudioDriverType_Auto);
+	fpl__ResetAudioJitter(&audioState->common);
 	fplAudioResult result = fplAudioResult_Failed;
 	switch(audioState->activeDriver) {
 
@@ -13165,6 +17530,13 @@ fpl_internal fplAudioResult fpl__StartAudioDevice(fpl__AudioState *audioState) {
 		} break;
 #	endif
 
+#	if defined(FPL_ENABLE_AUDIO_NULL)
+		case fplAudioDriverType_Null:
+		{
+			result = fpl__AudioStartNull(&audioState->nullDriver);
+		} break;
+#	endif
+
 		default:
 			break;
 	}
@@ -13189,6 +17561,13 @@ fpl_internal void fpl__RunAudioDeviceMainLoop(fpl__AudioState *audioState) {
 		} break;
 #	endif
 
+#	if defined(FPL_ENABLE_AUDIO_NULL)
+		case fplAudioDriverType_Null:
+		{
+			fpl__AudioRunMainLoopNull(&audioState->common, &audioState->nullDriver);
+		} break;
+#	endif
+
 		default:
 			break;
 	}
@@ -13198,6 +17577,7 @@ fpl_internal_inline bool fpl__IsAudioDriverAsync(fplAudioDriverType audioDriver)
 	switch(audioDriver) {
 		case fplAudioDriverType_DirectSound:
 		case fplAudioDriverType_Alsa:
+		case fplAudioDriverType_Null:
 			return false;
 		default:
 			return false;
@@ -13244,6 +17624,11 @@ fpl_internal void fpl__AudioWorkerThread(const fplThreadHandle *thread, void *da
 	wapi->ole.CoInitializeEx(fpl_null, 0);
 #endif
 
+#if defined(FPL_ENABLE_LOGGING)
+	// Acquire the log ring up front, so logging from the audio callbacks never maps memory
+	fpl__GetLogThreadRing(&fpl__global__LogState);
+#endif
+
 	for(;;) {
 		// Stop the device at the start of the iteration always
 		fpl__StopAudioDevice(audioState);
@@ -13267,7 +17652,9 @@ fpl_internal void fpl__AudioWorkerThread(const fplThreadHandle *thread, void *da
 		FPL_ASSERT(fpl__AudioGetDeviceState(commonAudioState) == fpl__AudioDeviceState_Starting);
 
 		// Start audio device
+		FPL__PROFILE_BEGIN("AudioStartDevice");
 		audioState->workResult = fpl__StartAudioDevice(audioState);
+		FPL__PROFILE_END();
 		if(audioState->workResult != fplAudioResult_Success) {
 			fplSignalSet(&audioState->startSignal);
 			continue;
@@ -13326,8 +17713,15 @@ fpl_internal void fpl__ReleaseAudio(fpl__AudioState *audioState) {
 		// Release audio device
 		fpl__ReleaseAudioDevice(audioState);
 
+		// Release pending events and period records
+		fplRingBufferRelease(&commonAudioState->pendingEvents);
+		fplRingBufferRelease(&commonAudioState->periodRecords);
+
 		// Clear audio state
 		FPL_CLEAR_STRUCT(audioState);
+	} else {
+		fplRingBufferRelease(&commonAudioState->pendingEvents);
+		fplRingBufferRelease(&commonAudioState->periodRecords);
 	}
 
 #if defined(FPL_PLATFORM_WIN32)
@@ -13363,11 +17757,26 @@ fpl_internal fplAudioResult fpl__InitAudio(const fplAudioSettings *audioSettings
 
 	audioState->common.clientReadCallback = audioSettings->clientReadCallback;
 	audioState->common.clientUserData = audioSettings->userData;
+	audioState->common.clientCaptureCallback = audioSettings->clientCaptureCallback;
+	audioState->common.clientCaptureUserData = audioSettings->userData;
+	audioState->common.deviceType = audioSettings->deviceType;
 
 #if defined(FPL_PLATFORM_WIN32)
 	wapi->ole.CoInitializeEx(fpl_null, 0);
 #endif
 
+	// Create queue for events which are pushed from the audio thread
+	if(!fplRingBufferInit(&audioState->common.pendingEvents, sizeof(fplAudioEvent) * 64)) {
+		fpl__ReleaseAudio(audioState);
+		return fplAudioResult_Failed;
+	}
+
+	// Create period records queue
+	if(!fplRingBufferInit(&audioState->common.periodRecords, sizeof(fplAudioPeriodRecord) * FPL__AUDIO_MAX_PERIOD_RECORDS)) {
+		fpl__ReleaseAudio(audioState);
+		return fplAudioResult_Failed;
+	}
+
 	// Create mutex and signals
 	if(!fplMutexInit(&audioState->lock)) {
 		fpl__ReleaseAudio(audioState);
@@ -13391,6 +17800,7 @@ fpl_internal fplAudioResult fpl__InitAudio(const fplAudioSettings *audioSettings
 	uint32_t driverCount = 0;
 	if(audioSettings->driver == fplAudioDriverType_Auto) {
 		// @NOTE(final): Add all audio drivers here, regardless of the platform.
+		// The null driver is never auto detected, it must be forced.
 		propeDrivers[driverCount++] = fplAudioDriverType_DirectSound;
 		propeDrivers[driverCount++] = fplAudioDriverType_Alsa;
 	} else {
@@ -13424,6 +17834,16 @@ fpl_internal fplAudioResult fpl__InitAudio(const fplAudioSettings *audioSettings
 			} break;
 #		endif
 
+#		if defined(FPL_ENABLE_AUDIO_NULL)
+			case fplAudioDriverType_Null:
+			{
+				initResult = fpl__AudioInitNull(audioSettings, &audioState->common, &audioState->nullDriver);
+				if(initResult != fplAudioResult_Success) {
+					fpl__AudioReleaseNull(&audioState->common, &audioState->nullDriver);
+				}
+			} break;
+#		endif
+
 			default:
 				break;
 		}
@@ -13899,6 +18319,88 @@ fpl_common_api void fplSetAudioClientReadCallback(fpl_audio_client_read_callback
 	}
 }
 
+fpl_common_api void fplSetAudioClientCaptureCallback(fpl_audio_client_capture_callback *newCallback, void *userData) {
+	FPL_ASSERT(fpl__global__AppState != fpl_null);
+	fpl__AudioState *audioState = fpl__GetAudioState(fpl__global__AppState);
+	if(audioState == fpl_null) {
+		return;
+	}
+	if(audioState->activeDriver > fplAudioDriverType_Auto) {
+		if(fpl__AudioGetDeviceState(&audioState->common) == fpl__AudioDeviceState_Stopped) {
+			audioState->common.clientCaptureCallback = newCallback;
+			audioState->common.clientCaptureUserData = userData;
+		}
+	}
+}
+
+fpl_common_api fplAudioXRunCounters fplGetAudioXRunCounters() {
+	fplAudioXRunCounters result = FPL_ZERO_INIT;
+	FPL_ASSERT(fpl__global__AppState != fpl_null);
+	fpl__AudioState *audioState = fpl__GetAudioState(fpl__global__AppState);
+	if(audioState == fpl_null) {
+		return(result);
+	}
+	fpl__CommonAudioState *commonAudio = &audioState->common;
+	result.underrunCount = fplAtomicLoadU32(&commonAudio->underrunCount);
+	result.overrunCount = fplAtomicLoadU32(&commonAudio->overrunCount);
+	result.deviceLostCount = fplAtomicLoadU32(&commonAudio->deviceLostCount);
+	result.reopenCount = fplAtomicLoadU32(&commonAudio->reopenCount);
+	return(result);
+}
+
+fpl_common_api bool fplGetAudioStats(fplAudioStats *outStats) {
+	if(outStats == fpl_null) {
+		fpl__ArgumentNullError("Out stats");
+		return false;
+	}
+	FPL_CLEAR_STRUCT(outStats);
+	FPL_ASSERT(fpl__global__AppState != fpl_null);
+	fpl__AudioState *audioState = fpl__GetAudioState(fpl__global__AppState);
+	if(audioState == fpl_null || !fpl__IsAudioDeviceInitialized(&audioState->common)) {
+		return false;
+	}
+	fpl__CommonAudioState *commonAudio = &audioState->common;
+	fpl__ReadAudioStats(&commonAudio->statsSequence, &commonAudio->stats, sizeof(commonAudio->stats), outStats);
+	outStats->xruns = fplGetAudioXRunCounters();
+	return true;
+}
+
+fpl_common_api uint32_t fplReadAudioPeriodRecords(fplAudioPeriodRecord *outRecords, const uint32_t maxRecordCount) {
+	if(outRecords == fpl_null) {
+		fpl__ArgumentNullError("Out records");
+		return 0;
+	}
+	FPL_ASSERT(fpl__global__AppState != fpl_null);
+	fpl__AudioState *audioState = fpl__GetAudioState(fpl__global__AppState);
+	if(audioState == fpl_null || audioState->common.periodRecords.data == fpl_null) {
+		return 0;
+	}
+	fplRingBuffer *periodRecords = &audioState->common.periodRecords;
+	uint32_t result = 0;
+	while(result < maxRecordCount && fplRingBufferGetReadAvailable(periodRecords) >= sizeof(fplAudioPeriodRecord)) {
+		fplRingBufferRead(periodRecords, &outRecords[result], sizeof(fplAudioPeriodRecord));
+		++result;
+	}
+	return(result);
+}
+
+#if defined(FPL_ENABLE_AUDIO_NULL)
+fpl_common_api bool fplGetNullAudioStats(fplNullAudioStats *outStats) {
+	if(outStats == fpl_null) {
+		fpl__ArgumentNullError("Out stats");
+		return false;
+	}
+	FPL_CLEAR_STRUCT(outStats);
+	FPL_ASSERT(fpl__global__AppState != fpl_null);
+	fpl__AudioState *audioState = fpl__GetAudioState(fpl__global__AppState);
+	if(audioState == fpl_null || audioState->activeDriver != fplAudioDriverType_Null) {
+		return false;
+	}
+	fpl__GetStatsNull(&audioState->nullDriver, outStats);
+	return true;
+}
+#endif
+
 fpl_common_api uint32_t fplGetAudioDevices(fplAudioDeviceInfo *devices, uint32_t maxDeviceCount) {
 	if(devices == fpl_null) {
 		return 0;
@@ -13980,12 +18482,27 @@ fpl_common_api bool fplResizeVideoBackBuffer(const uint32_t width, const uint32_
 	return (result);
 }
 
+fpl_common_api uint64_t fplGetTimeToFirstFrame() {
+	FPL_ASSERT(fpl__global__AppState != fpl_null);
+	const fpl__PlatformAppState *appState = fpl__global__AppState;
+	uint64_t result = 0;
+	if(appState->firstFrameTime > 0) {
+		result = appState->firstFrameTime - appState->initStartTime;
+	}
+	return(result);
+}
+
 fpl_common_api void fplVideoFlip() {
 	FPL_ASSERT(fpl__global__AppState != fpl_null);
 	fpl__PlatformAppState *appState = fpl__global__AppState;
 	const fpl__VideoState *videoState = fpl__GetVideoState(appState);
 
 	if(videoState != fpl_null) {
+		FPL__PROFILE_BEGIN("fplVideoFlip");
+		if(appState->firstFrameTime == 0) {
+			appState->firstFrameTime = fplGetTimeInNanoseconds();
+			FPL_LOG("Core", "Time to first frame: %.3f ms", (double)(appState->firstFrameTime - appState->initStartTime) / 1000000.0);
+		}
 #	if defined(FPL_PLATFORM_WIN32)
 		const fpl__Win32AppState *win32AppState = &appState->win32;
 		const fpl__Win32WindowState *win32WindowState = &appState->window.win32;
@@ -14041,6 +18558,7 @@ fpl_common_api void fplVideoFlip() {
 				break;
 		}
 #	endif // FPL_PLATFORM || FPL_SUBPLATFORM
+		FPL__PROFILE_END();
 	}
 }
 #endif // FPL_ENABLE_VIDEO
@@ -14100,6 +18618,11 @@ fpl_internal void fpl__ReleasePlatformStates(fpl__PlatformInitState *initState,
 
 	// @TODO(final): Release audio state here?
 
+#	if defined(FPL_ENABLE_LOGGING)
+	// Threads are not available after the platform is released, so the log is written synchronously again
+	fpl__StopLogWriter();
+#	endif
+
 	if(appState != fpl_null) {
 		// Release actual platform (There can only be one platform!)
 		{
@@ -14144,9 +18667,61 @@ fpl_common_api void fplPlatformRelease() {
 	}
 	fpl__PlatformAppState *appState = fpl__global__AppState;
 	fpl__ReleasePlatformStates(initState, appState);
+#if defined(FPL_ENABLE_PROFILER)
+	if(fplGetAnsiStringLength(fpl__global__ProfilerState.traceFilePath) > 0) {
+		fplProfilerWriteChromeTrace(fpl__global__ProfilerState.traceFilePath);
+	}
+#endif
 	FPL_LOG("Core", "Platform released");
 }
 
+// @NOTE(final): DirectSound requires the window handle for its cooperative level, so on win32 the audio is always initialized after the window.
+#if defined(FPL_ENABLE_AUDIO) && defined(FPL_ENABLE_WINDOW) && !defined(FPL_PLATFORM_WIN32)
+#	define FPL__INIT_AUDIO_IN_PARALLEL
+#endif
+
+#if defined(FPL__INIT_AUDIO_IN_PARALLEL)
+typedef struct fpl__AudioInitJob {
+	char errorMessage[1024];
+	const fplAudioSettings *audioSettings;
+	fpl__AudioState *audioState;
+	uint64_t time;
+	fplAudioResult result;
+} fpl__AudioInitJob;
+
+fpl_internal void fpl__AudioInitThreadProc(const fplThreadHandle *thread, void *data) {
+	(void)thread;
+	fpl__AudioInitJob *job = (fpl__AudioInitJob *)data;
+	uint64_t startTime = fplGetTimeInNanoseconds();
+	job->result = fpl__InitAudio(job->audioSettings, job->audioState);
+	job->time = fplGetTimeInNanoseconds() - startTime;
+	if(job->result != fplAudioResult_Success) {
+		// Errors are stored per thread, so we need to pass it to the init thread
+		fplCopyAnsiString(fplGetPlatformError(), job->errorMessage, FPL_ARRAYCOUNT(job->errorMessage));
+	}
+}
+
+fpl_internal fplAudioResult fpl__WaitForAudioInit(fplThreadHandle *thread, fpl__AudioInitJob *job) {
+	fplThreadWaitForOne(thread, FPL_TIMEOUT_INFINITE);
+	fplThreadTerminate(thread);
+	if(job->result != fplAudioResult_Success && fplGetAnsiStringLength(job->errorMessage) > 0) {
+		fpl__PushError("%s", job->errorMessage);
+	}
+	return(job->result);
+}
+#endif // FPL__INIT_AUDIO_IN_PARALLEL
+
+// Returns the current time in nanoseconds, even when the platform is not initialized yet
+fpl_internal uint64_t fpl__GetInitTimeInNanoseconds() {
+#	if defined(FPL_PLATFORM_WIN32)
+	if(fpl__global__InitState.win32.performanceFrequency.QuadPart == 0) {
+		QueryPerformanceFrequency(&fpl__global__InitState.win32.performanceFrequency);
+	}
+#	endif
+	uint64_t result = fplGetTimeInNanoseconds();
+	return(result);
+}
+
 fpl_common_api fplInitResultType fplPlatformInit(const fplInitFlags initFlags, const fplSettings *initSettings) {
 	// Exit out if platform is already initialized
 	if(fpl__global__InitState.isInitialized) {
@@ -14154,6 +18729,8 @@ fpl_common_api fplInitResultType fplPlatformInit(const fplInitFlags initFlags, c
 		return fplInitResultType_AlreadyInitialized;
 	}
 
+	uint64_t initStartTime = fpl__GetInitTimeInNanoseconds();
+
 	// Allocate platform app state memory (By boundary of 16-bytes)
 	size_t platformAppStateSize = FPL_ALIGNED_SIZE(sizeof(fpl__PlatformAppState), 16);
 
@@ -14187,6 +18764,7 @@ fpl_common_api fplInitResultType fplPlatformInit(const fplInitFlags initFlags, c
 
 	fpl__PlatformAppState *appState = fpl__global__AppState = (fpl__PlatformAppState *)platformAppStateMemory;
 	appState->initFlags = initFlags;
+	appState->initStartTime = initStartTime;
 	if(initSettings != fpl_null) {
 		appState->initSettings = *initSettings;
 	} else {
@@ -14252,10 +18830,41 @@ fpl_common_api fplInitResultType fplPlatformInit(const fplInitFlags initFlags, c
 		return fplInitResultType_FailedPlatform;
 	}
 	FPL_LOG("Core", "Successfully initialized %s Platform", FPL_PLATFORM_NAME);
+	fplInitTimings *initTimings = &appState->initTimings;
+	uint64_t phaseStartTime = fplGetTimeInNanoseconds();
+	initTimings->platform = phaseStartTime - initStartTime;
+
+#	if defined(FPL_ENABLE_LOGGING)
+	// Threads are available now, so the log is written asynchronously from here on
+	fpl__StartLogWriter();
+#	endif
+
+	// Start initializing the audio on a separate thread, while we are creating the window and the video
+#	if defined(FPL__INIT_AUDIO_IN_PARALLEL)
+	fpl__AudioInitJob audioInitJob = FPL_ZERO_INIT;
+	fplThreadHandle *audioInitThread = fpl_null;
+	if((appState->initFlags & fplInitFlags_Audio) && (appState->initFlags & fplInitFlags_Window)) {
+		appState->audio.mem = (uint8_t *)platformAppStateMemory + audioMemoryOffset;
+		appState->audio.memSize = sizeof(fpl__AudioState);
+		audioInitJob.audioSettings = &appState->initSettings.audio;
+		audioInitJob.audioState = fpl__GetAudioState(appState);
+		audioInitJob.result = fplAudioResult_Failed;
+		FPL_LOG("Core", "Init Audio with Driver '%s' in parallel:", fplGetAudioDriverString(appState->initSettings.audio.driver));
+		audioInitThread = fplThreadCreate(fpl__AudioInitThreadProc, &audioInitJob);
+		initTimings->isAudioParallel = audioInitThread != fpl_null;
+	}
+#	define FPL__INIT_FAILED_WAIT_FOR_AUDIO() \
+		if(audioInitThread != fpl_null) { \
+			fpl__WaitForAudioInit(audioInitThread, &audioInitJob); \
+		}
+#	else
+#	define FPL__INIT_FAILED_WAIT_FOR_AUDIO()
+#	endif
 
 // Init video state
 #	if defined(FPL_ENABLE_VIDEO)
 	if(appState->initFlags & fplInitFlags_Video) {
+		phaseStartTime = fplGetTimeInNanoseconds();
 		FPL_LOG("Core", "Init video state:");
 		appState->video.mem = (uint8_t *)platformAppStateMemory + videoMemoryOffset;
 		appState->video.memSize = sizeof(fpl__VideoState);
@@ -14268,17 +18877,20 @@ fpl_common_api fplInitResultType fplPlatformInit(const fplInitFlags initFlags, c
 		{
 			if(!fpl__LoadVideoState(videoDriver, videoState)) {
 				FPL_LOG("Core", "Failed loading Video API for Driver '%s'!", videoDriverString);
+				FPL__INIT_FAILED_WAIT_FOR_AUDIO();
 				fpl__ReleasePlatformStates(initState, appState);
 				return fplInitResultType_FailedVideo;
 	}
 		}
 		FPL_LOG("Core", "Successfully loaded Video API for Driver '%s'", videoDriverString);
+		initTimings->video = fplGetTimeInNanoseconds() - phaseStartTime;
 	}
 #	endif // FPL_ENABLE_VIDEO
 
 	// Init Window & event queue
 #	if defined(FPL_ENABLE_WINDOW)
 	if(appState->initFlags & fplInitFlags_Window) {
+		phaseStartTime = fplGetTimeInNanoseconds();
 		FPL_LOG("Core", "Init Window:");
 		fpl__SetupWindowCallbacks winCallbacks = FPL_ZERO_INIT;
 		winCallbacks.postSetup = fpl__PostSetupWindowDefault;
@@ -14286,10 +18898,12 @@ fpl_common_api fplInitResultType fplPlatformInit(const fplInitFlags initFlags, c
 		if(!fpl__InitWindow(&appState->initSettings, &appState->currentSettings.window, appState, &winCallbacks)) {
 			FPL_LOG("Core", "Failed initializing Window!");
 			fpl__PushError("Failed initialization window");
+			FPL__INIT_FAILED_WAIT_FOR_AUDIO();
 			fpl__ReleasePlatformStates(initState, appState);
 			return fplInitResultType_FailedWindow;
 		}
 		FPL_LOG("Core", "Successfully initialized Window");
+		initTimings->window = fplGetTimeInNanoseconds() - phaseStartTime;
 	}
 #	endif // FPL_ENABLE_WINDOW
 
@@ -14307,14 +18921,17 @@ fpl_common_api fplInitResultType fplPlatformInit(const fplInitFlags initFlags, c
 			windowHeight = appState->currentSettings.window.windowWidth;
 		}
 		const char *videoDriverName = fplGetVideoDriverString(appState->initSettings.video.driver);
+		phaseStartTime = fplGetTimeInNanoseconds();
 		FPL_LOG("Core", "Init Video with Driver '%s':", videoDriverName);
 		if(!fpl__InitVideo(appState->initSettings.video.driver, &appState->initSettings.video, windowWidth, windowHeight, appState, videoState)) {
 			FPL_LOG("Core", "Failed initializing Video Driver '%s'!", videoDriverName);
 			fpl__PushError("Failed initialization video with settings (Driver=%s, Width=%d, Height=%d)", videoDriverName, windowWidth, windowHeight);
+			FPL__INIT_FAILED_WAIT_FOR_AUDIO();
 			fpl__ReleasePlatformStates(initState, appState);
 			return fplInitResultType_FailedVideo;
 		}
 		FPL_LOG("Core", "Successfully initialized Video Driver '%s'", videoDriverName);
+		initTimings->video += fplGetTimeInNanoseconds() - phaseStartTime;
 	}
 #	endif // FPL_ENABLE_VIDEO
 
@@ -14324,12 +18941,24 @@ fpl_common_api fplInitResultType fplPlatformInit(const fplInitFlags initFlags, c
 		appState->audio.mem = (uint8_t *)platformAppStateMemory + audioMemoryOffset;
 		appState->audio.memSize = sizeof(fpl__AudioState);
 		const char *audioDriverName = fplGetAudioDriverString(appState->initSettings.audio.driver);
-		FPL_LOG("Core", "Init Audio with Driver '%s':", audioDriverName);
 		fpl__AudioState *audioState = fpl__GetAudioState(appState);
 		FPL_ASSERT(audioState != fpl_null);
-		if(fpl__InitAudio(&appState->initSettings.audio, audioState) != fplAudioResult_Success) {
+		fplAudioResult audioResult;
+#		if defined(FPL__INIT_AUDIO_IN_PARALLEL)
+		if(audioInitThread != fpl_null) {
+			audioResult = fpl__WaitForAudioInit(audioInitThread, &audioInitJob);
+			initTimings->audio = audioInitJob.time;
+		} else
+#		endif
+		{
+			FPL_LOG("Core", "Init Audio with Driver '%s':", audioDriverName);
+			phaseStartTime = fplGetTimeInNanoseconds();
+			audioResult = fpl__InitAudio(&appState->initSettings.audio, audioState);
+			initTimings->audio = fplGetTimeInNanoseconds() - phaseStartTime;
+		}
+		if(audioResult != fplAudioResult_Success) {
 			FPL_LOG("Core", "Failed initializing Audio Driver '%s'!", audioDriverName);
-			fpl__PushError("Failed initialization audio with settings (Driver=%s, Format=%s, SampleRate=%d, Channels=%d, BufferSize=%d)", audioDriverName, fplGetAudioFormatString(initSettings->audio.deviceFormat.type), initSettings->audio.deviceFormat.sampleRate, initSettings->audio.deviceFormat.channels);
+			fpl__PushError("Failed initialization audio with settings (Driver=%s, Format=%s, SampleRate=%d, Channels=%d, BufferSize=%d)", audioDriverName, fplGetAudioFormatString(appState->initSettings.audio.deviceFormat.type), appState->initSettings.audio.deviceFormat.sampleRate, appState->initSettings.audio.deviceFormat.channels, appState->initSettings.audio.bufferSizeInMilliSeconds);
 			fpl__ReleasePlatformStates(initState, appState);
 			return fplInitResultType_FailedAudio;
 		}
@@ -14337,10 +18966,31 @@ fpl_common_api fplInitResultType fplPlatformInit(const fplInitFlags initFlags, c
 	}
 #	endif // FPL_ENABLE_AUDIO
 
+#	undef FPL__INIT_FAILED_WAIT_FOR_AUDIO
+
+	initTimings->total = fplGetTimeInNanoseconds() - initStartTime;
+	FPL_LOG("Core", "Initialized in %.3f ms (Platform: %.3f ms, Window: %.3f ms, Video: %.3f ms, Audio: %.3f ms)",
+			(double)initTimings->total / 1000000.0, (double)initTimings->platform / 1000000.0, (double)initTimings->window / 1000000.0,
+			(double)initTimings->video / 1000000.0, (double)initTimings->audio / 1000000.0);
+
 	initState->isInitialized = true;
 	return fplInitResultType_Success;
 }
 
+fpl_common_api bool fplGetInitTimings(fplInitTimings *outTimings) {
+	if(outTimings == fpl_null) {
+		fpl__ArgumentNullError("Out timings");
+		return false;
+	}
+	const fpl__PlatformAppState *appState = fpl__global__AppState;
+	if(appState == fpl_null || !fpl__global__InitState.isInitialized) {
+		fpl__PushError("Platform is not initialized");
+		return false;
+	}
+	*outTimings = appState->initTimings;
+	return true;
+}
+
 fpl_common_api fplPlatformType fplGetPlatformType() {
 	fplPlatformType result;
 #if defined(FPL_PLATFORM_WIN32)
@@ -1,6 +1,6 @@
 /**
 * @file final_tiletrace.hpp
-* @version v1.02
+* @version v1.03
 * @author Torsten Spaete
 * @brief Final TileTrace (FTT) - a open source single file header c++ contour tile tracing library.
 *
@@ -18,7 +18,7 @@ Open-Source Single-File Header C++ Library by Torsten Spaete
 This creates chainshapes out of any solid tilemap based on a contour tracing algorythmn.
 It will try to create as less chain shapes as possible.
 
-- Supports block tiles only!
+- Supports block tiles, half blocks and slopes (see TraceShapeLayers())
 
 # Requirements
 
@@ -30,10 +30,20 @@ It will try to create as less chain shapes as possible.
 
 # PREPROCESSOR OVERRIDES
 
+- FTT_API_AS_PRIVATE: Define as 1 to make all api functions static
+- FTT_NO_THREADS: Define as 1 to trace all chunks of TraceContoursChunked() on the calling thread, without including <thread>
+
 # FEATURES
 
 [X] Block tile contour tracing
 [X] Creating optimized chain segments
+[X] Single pass contour tracing
+[X] Incremental contour updates
+[X] Multithreaded chunk tracing
+[X] Chain segment simplification (Douglas-Peucker)
+[X] Half blocks, slopes and multiple collision layers
+[X] Triangulation and convex decomposition of the solid area (holes included)
+[X] Binary contour cache keyed by a hash of the tile map
 
 # TODO
 
@@ -62,6 +72,18 @@ SOFTWARE.
 
 # VERSION HISTORY
 
+- v1.03:
+	* Vertices and edges are looked up by their lattice position instead of searching the main lists, so tracing runs in linear time
+	* Added TraceContours() for tracing all chain segments in one linear pass over a bit-packed solid mask
+	* Added ContourMap for re-tracing only the contours around changed tiles
+	* Added TraceContoursChunked() for tracing chunks on multiple threads
+	* Changed: TileTracerData uses a compact layout (solid bits, 2-bit trace directions, tile and edge indices instead of pointers)
+	* Changed: All chain segments of the tile tracer share one vertex buffer, see ChainRange
+	* Added MemoryArena which can be passed to the tile tracer to avoid heap allocations
+	* Added SimplifyChainSegments() and SimplifyTileTracerChains() for Douglas-Peucker simplification with a tolerance
+	* Added TraceShapeLayers() for tracing half blocks and slopes into multiple collision layers
+	* Added TriangulateChainSegments() and DecomposeChainSegments() for turning the traced contours into triangles or convex polygons
+	* Added WriteContourCache() and ReadContourCache() for storing traced chain segments in a versioned binary blob, see ComputeContourCacheKey()
 - v1.01:
 	* Added additional C++ api
 - v1.0:
@@ -72,12 +94,18 @@ SOFTWARE.
 #define FTT_INCLUDE_HPP
 
 #include <vector>
+#include <type_traits> // std::true_type
+#include <stddef.h>
 #include <inttypes.h>
 
 #if !defined(FTT_API_AS_PRIVATE)
 #	define FTT_API_AS_PRIVATE 0
 #endif
 
+#if !defined(FTT_NO_THREADS)
+#	define FTT_NO_THREADS 0
+#endif
+
 #if FTT_API_AS_PRIVATE
 #	define ftt_api static
 #else
@@ -147,116 +175,342 @@ namespace ftt {
 	};
 	typedef Steps::StepEnum Step;
 
-	//! Tile infos like position, direction and its solid state
-	struct Tile {
-		int32_t x, y;
-		uint32_t traceDirection;
-		int32_t isSolid;
-	};
+	//! Invalid tile, edge or vertex index
+	static const uint32_t INVALID_INDEX = (uint32_t)-1;
 
+	//! Edge between two lattice vertices
 	struct Edge {
-		int32_t index;
-		int32_t vertIndex0, vertIndex1;
-		Vec2i tilePosition;
+		uint32_t vertIndex0, vertIndex1;
 		bool isInvalid;
 	};
 
 	struct TileVertices {
 		Vec2i verts[4];
 	};
-	struct TileIndices {
-		int32_t indices[4];
-	};
-	struct TileEdges {
-		Edge edges[4];
-		uint32_t count;
-	};
 
 	struct ChainSegment {
 		std::vector<Vec2i> vertices;
 	};
 
+	//! Range of a chain segment in the chain vertex buffer of the tile tracer
+	struct ChainRange {
+		uint32_t firstVertex;
+		uint32_t vertexCount;
+	};
+
+	//! Linear block of memory, which the tile tracer allocates from instead of the heap
+	struct MemoryArena {
+		uint8_t *base;
+		size_t size;
+		size_t used;
+	};
+
+	//! STL allocator which takes its memory from a arena. Falls back to the heap, when there is no arena or when it is full.
+	template <typename T>
+	struct ArenaAllocator {
+		typedef T value_type;
+		typedef std::true_type propagate_on_container_copy_assignment;
+		typedef std::true_type propagate_on_container_move_assignment;
+		typedef std::true_type propagate_on_container_swap;
+		template <typename U>
+		struct rebind {
+			typedef ArenaAllocator<U> other;
+		};
+
+		MemoryArena *arena;
+
+		ArenaAllocator(MemoryArena *arena = ftt_null) : arena(arena) {
+		}
+		template <typename U>
+		ArenaAllocator(const ArenaAllocator<U> &other) : arena(other.arena) {
+		}
+
+		T *allocate(size_t count) {
+			size_t byteCount = count * sizeof(T);
+			if (arena != ftt_null) {
+				uintptr_t address = ((uintptr_t)(arena->base + arena->used) + 15) & ~(uintptr_t)15;
+				size_t offset = (size_t)(address - (uintptr_t)arena->base);
+				if (offset + byteCount <= arena->size) {
+					arena->used = offset + byteCount;
+					return (T *)(arena->base + offset);
+				}
+			}
+			return (T *)::operator new(byteCount);
+		}
+		void deallocate(T *ptr, size_t count) {
+			uint8_t *bytes = (uint8_t *)ptr;
+			if (arena != ftt_null && bytes >= arena->base && bytes < arena->base + arena->size) {
+				// Only the last allocation can be given back, everything else is released with the arena
+				if (bytes + count * sizeof(T) == arena->base + arena->used) {
+					arena->used = (size_t)(bytes - arena->base);
+				}
+			} else {
+				::operator delete(ptr);
+			}
+		}
+	};
+	template <typename T, typename U>
+	inline bool operator == (const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+		return a.arena == b.arena;
+	}
+	template <typename T, typename U>
+	inline bool operator != (const ArenaAllocator<T> &a, const ArenaAllocator<U> &b) {
+		return a.arena != b.arena;
+	}
+
 	struct TileTracerData {
 		Vec2u tileCount;
-		std::vector<Tile> tiles;
+		uint32_t wordsPerRow;
 		Step curStep;
-		Tile *startTile;
-		Tile *curTile;
-		Tile *nextTile;
-		Edge *startEdge;
-		Edge *lastEdge;
-		ChainSegment *curChainSegment;
-		std::vector<Tile *> openList;
-		std::vector<Vec2i> mainVertices;
-		std::vector<Edge> mainEdges;
+		//! Tile indices (y * tileCount.w + x)
+		uint32_t startTile;
+		uint32_t curTile;
+		uint32_t nextTile;
+		//! Main edge indices
+		uint32_t startEdge;
+		uint32_t lastEdge;
+		//! Solid tiles which are not added yet, one bit per tile
+		std::vector<uint64_t, ArenaAllocator<uint64_t> > solidBits;
+		//! Trace direction of each tile, 2 bits per tile
+		std::vector<uint8_t, ArenaAllocator<uint8_t> > traceDirections;
+		std::vector<uint32_t, ArenaAllocator<uint32_t> > openList;
+		//! Edges as lattice index of the first vertex * 4 + direction to the second vertex (Up, Right, Down, Left). Vertex indices are lattice indices (y * (tileCount.w + 1) + x).
+		std::vector<uint32_t, ArenaAllocator<uint32_t> > mainEdges;
+		//! For each lattice point the valid edges leaving it (bits 0-3) and the direction of the oldest one (bits 4-5)
+		std::vector<uint8_t, ArenaAllocator<uint8_t> > edgeStates;
+		//! Vertices of all chain segments
+		std::vector<Vec2i, ArenaAllocator<Vec2i> > chainVertices;
+		std::vector<ChainRange, ArenaAllocator<ChainRange> > chainSegments;
+		//! All tiles before this index are not solid anymore
+		uint32_t solidSearchIndex;
+		//! All edges before this index are invalid
+		uint32_t edgeSearchIndex;
+	};
+
+	//! Rectangle with inclusive min and max coordinates
+	struct Rect2i {
+		Vec2i min;
+		Vec2i max;
+	};
+
+	//! Solid state of a tile map, one bit per tile
+	struct SolidMask {
+		std::vector<uint64_t> bits;
+		Vec2u tileCount;
+		uint32_t wordsPerRow;
+	};
+
+	//! Ids of the chain segments which was added, removed or modified by UpdateContourMap()
+	struct ContourChanges {
+		std::vector<uint32_t> addedIds;
+		std::vector<uint32_t> removedIds;
+		std::vector<uint32_t> modifiedIds;
+	};
+
+	//! Traced contours of a tile map, which are updated incrementally when tiles are changed
+	struct ContourMap {
+		//! Solid tiles
+		SolidMask mask;
+		//! Top edges of all traced contours, same layout as the solid mask
+		std::vector<uint64_t> visitedTopEdges;
+		//! Chain segments by id, removed chain segments have no vertices
+		std::vector<ChainSegment> chainSegments;
+		//! Vertex bounds of each chain segment
+		std::vector<Rect2i> chainBounds;
+		//! Ids of removed chain segments which are reused
+		std::vector<uint32_t> freeIds;
+		//! Changed tiles since the last update
+		std::vector<Rect2i> dirtyRects;
+		//! Scratch buffer for the corners of the current contour
+		std::vector<Vec2i> corners;
+	};
+
+	//! Shapes of a tile, vertices are on a grid of TILE_SHAPE_RESOLUTION steps per tile
+	namespace TileShapes {
+		//! Tile shape
+		enum TileShapeEnum {
+			Empty,
+			Block,
+			HalfBottom,
+			HalfTop,
+			HalfLeft,
+			HalfRight,
+			//! 45 degree floor rising to the right (solid bottom right)
+			SlopeUpRight,
+			//! 45 degree floor rising to the left (solid bottom left)
+			SlopeUpLeft,
+			//! 45 degree ceiling going down to the right (solid top right)
+			CeilingDownRight,
+			//! 45 degree ceiling going down to the left (solid top left)
+			CeilingDownLeft,
+			//! Lower and higher tile of a floor rising half a tile per tile to the right
+			SlopeUpRightLow,
+			SlopeUpRightHigh,
+			//! Lower and higher tile of a floor rising half a tile per tile to the left
+			SlopeUpLeftLow,
+			SlopeUpLeftHigh,
+			Count,
+		};
+	};
+	typedef TileShapes::TileShapeEnum TileShapeType;
+
+	//! Number of grid steps per tile for the vertices of tile shapes
+	static const int32_t TILE_SHAPE_RESOLUTION = 2;
+
+	//! Shape and collision layers of a tile value
+	struct TileDefinition {
+		TileShapeType shape;
+		//! Bit mask of the layers the tile is traced into
+		uint32_t layerMask;
+	};
+
+	//! Chain segments of a single collision layer
+	struct TileLayer {
 		std::vector<ChainSegment> chainSegments;
 	};
 
+	//! Triangle of a solid area, the vertices have the same winding as the chain segments
+	struct Triangle {
+		Vec2i verts[3];
+	};
+
+	//! Convex polygon of a solid area, the vertices have the same winding as the chain segments and the first vertex is not repeated
+	struct ConvexPolygon {
+		std::vector<Vec2i> vertices;
+	};
+
+	//! Version of the contour cache blob, blobs with another version are never loaded
+	static const uint32_t CONTOUR_CACHE_VERSION = 1;
+
+	//! Trace options which change the chain segments, so they are part of the contour cache key
+	struct ContourCacheOptions {
+		//! Tolerance of SimplifyChainSegments() or zero, when the chain segments are not simplified
+		float simplifyTolerance;
+		//! Any other value which changes the chain segments, e.g. the trace function or a hash of the tile definitions of TraceShapeLayers()
+		uint64_t userKey;
+	};
+
 	//! Tile tracer C++ API
 	class TileTracer {
 	private:
 		TileTracerData data;
 	public:
-		//! Constructs a tile tracer instance for the given tile map
-		TileTracer(const Vec2u &tileCount, uint8_t *mapTiles);
+		//! Constructs a tile tracer instance for the given tile map, all memory is taken from the arena when one is given
+		TileTracer(const Vec2u &tileCount, uint8_t *mapTiles, MemoryArena *arena = ftt_null);
 
 		//! Executes the next step for the tracer
 		bool Next();
 		//! Runs the full tracer until it is done.
 		void Run();
+		//! Simplifies all chain segments after the tracer is done, see SimplifyChainSegments()
+		void Simplify(float tolerance);
 
 		//! Returns the number of chain segments
 		inline size_t GetChainSegmentCount() const {
 			return data.chainSegments.size();
 		}
-		//! Returns a chain segment by the given index
-		inline const ChainSegment &GetChainSegment(uint32_t index) const {
+		//! Returns the vertex range of a chain segment by the given index
+		inline const ChainRange &GetChainSegment(uint32_t index) const {
 			return data.chainSegments[index];
 		}
-		//! Returns the number of vertices
-		inline size_t GetVertexCount() const {
-			return data.mainVertices.size();
+		//! Returns a chain vertex by the given index
+		inline const Vec2i &GetChainVertex(uint32_t index) const {
+			return data.chainVertices[index];
 		}
-		//! Returns a vertex by the given index
-		inline const Vec2i &GetVertex(uint32_t index) const {
-			return data.mainVertices[index];
+		//! Returns a vertex position by the given lattice index
+		inline Vec2i GetVertex(uint32_t index) const {
+			Vec2i result = { (int32_t)(index % (data.tileCount.w + 1)), (int32_t)(index / (data.tileCount.w + 1)) };
+			return(result);
 		}
 		//! Returns the number of edges
 		inline size_t GetEdgeCount() const {
 			return data.mainEdges.size();
 		}
 		//! Returns a edge by the given index
-		inline const Edge &GetEdge(uint32_t index) const {
-			return data.mainEdges[index];
+		inline Edge GetEdge(uint32_t index) const {
+			const int32_t directionOffsets[] = { -(int32_t)(data.tileCount.w + 1), 1, (int32_t)(data.tileCount.w + 1), -1 };
+			uint32_t edgeKey = data.mainEdges[index];
+			Edge result;
+			result.vertIndex0 = edgeKey >> 2;
+			result.vertIndex1 = (uint32_t)((int32_t)result.vertIndex0 + directionOffsets[edgeKey & 3]);
+			result.isInvalid = ((data.edgeStates[result.vertIndex0] >> (edgeKey & 3)) & 1) == 0;
+			return(result);
+		}
+		//! Returns true when the tile by the given coordinates is solid and was not added yet
+		inline bool IsTileSolid(uint32_t x, uint32_t y) const {
+			return ((data.solidBits[y * data.wordsPerRow + (x >> 6)] >> (x & 63)) & 1) != 0;
 		}
-		//! Returns a tile by the given coordinates
-		inline const Tile &GetTile(uint32_t x, uint32_t y) const {
-			return data.tiles[y * data.tileCount.w + x];
+		//! Returns the position of a tile by the given tile index
+		inline Vec2i GetTilePosition(uint32_t tileIndex) const {
+			Vec2i result = { (int32_t)(tileIndex % data.tileCount.w), (int32_t)(tileIndex / data.tileCount.w) };
+			return(result);
 		}
 		//! Returns the number of open tiles
 		inline size_t GetOpenTileCount() const {
 			return data.openList.size();
 		}
-		//! Returns a open tile pointer by the given index
-		inline Tile *GetOpenTile(uint32_t index) const {
+		//! Returns a open tile index by the given index
+		inline uint32_t GetOpenTile(uint32_t index) const {
 			return data.openList[index];
 		}
-		//! Returns the start tile pointer
-		inline Tile *GetStartTile() const {
+		//! Returns the start tile index or INVALID_INDEX
+		inline uint32_t GetStartTile() const {
 			return data.startTile;
 		}
-		//! Returns the current tile pointer
-		inline Tile *GetCurrentTile() const {
+		//! Returns the current tile index or INVALID_INDEX
+		inline uint32_t GetCurrentTile() const {
 			return data.curTile;
 		}
 	};
 
-	//! Initializes a tile tracer data so you can start tracing your tilemap
-	ftt_api void InitTileTracer(TileTracerData *tracer, const Vec2u &tileCount, uint8_t *mapTiles);
+	//! Initializes a tile tracer data so you can start tracing your tilemap. All memory is taken from the arena when one is given.
+	ftt_api void InitTileTracer(TileTracerData *tracer, const Vec2u &tileCount, uint8_t *mapTiles, MemoryArena *arena = ftt_null);
 	//! Executes the next step for the given tracer data
 	ftt_api bool NextTileTraceStep(TileTracerData *tracer);
 	//! Runs the full tracer until it is done for the the given tracer data.
 	ftt_api void RunTileTracer(TileTracerData *tracer);
+	//! Simplifies all finished chain segments of the tracer with the Douglas-Peucker algorithm, see SimplifyChainSegments()
+	ftt_api void SimplifyTileTracerChains(TileTracerData *tracer, float tolerance);
+
+	//! Simplifies the chain segments in place with the Douglas-Peucker algorithm. Vertices closer than the tolerance (in tiles) to the simplified chain are removed.
+	//! Closed chain segments stay closed and keep at least three vertices. A tolerance of zero removes collinear vertices only.
+	ftt_api void SimplifyChainSegments(std::vector<ChainSegment> *chainSegments, float tolerance);
+
+	//! Traces all contours of the given tile map in one linear pass, without the step by step state of the tile tracer.
+	//! Diagonal touching tiles always result in separate chain segments.
+	ftt_api void TraceContours(const Vec2u &tileCount, const uint8_t *mapTiles, std::vector<ChainSegment> *outChainSegments);
+	//! Traces all contours like TraceContours(), but the tile map is split into chunks which are traced on multiple threads and stitched together at the seams.
+	//! The result is identical to TraceContours(). The chunk width is rounded up to a multiple of 64 tiles and a thread count of zero uses all hardware threads.
+	ftt_api void TraceContoursChunked(const Vec2u &tileCount, const uint8_t *mapTiles, const Vec2u &chunkSize, uint32_t threadCount, std::vector<ChainSegment> *outChainSegments);
+
+	//! Initializes the contour map and traces all contours of the given tile map. The chain segment ids are the indices in ContourMap::chainSegments.
+	ftt_api void InitContourMap(ContourMap *contourMap, const Vec2u &tileCount, const uint8_t *mapTiles);
+	//! Changes a single tile of the contour map and marks it dirty, when the solid state has changed
+	ftt_api void SetContourMapTile(ContourMap *contourMap, uint32_t x, uint32_t y, uint8_t value);
+	//! Copies the tiles in the given rectangle from the full tile map and marks the changed ones dirty
+	ftt_api void SetContourMapTiles(ContourMap *contourMap, const Rect2i &tileRect, const uint8_t *mapTiles);
+	//! Re-traces the contours touching the dirty tiles only and returns which chain segments was added, removed or modified
+	ftt_api void UpdateContourMap(ContourMap *contourMap, ContourChanges *outChanges);
+
+	//! Traces the tile shapes of all layers in one pass over the tile map, each tile value is mapped to its shape and layers by the definitions.
+	//! Tile values without a definition are empty. The vertices are in TILE_SHAPE_RESOLUTION steps per tile.
+	//! One-way platforms are tiles in their own layer, the chain segments of that layer are then used for one-sided collision.
+	ftt_api void TraceShapeLayers(const Vec2u &tileCount, const uint8_t *mapTiles, const TileDefinition *definitions, uint32_t definitionCount, uint32_t layerCount, std::vector<TileLayer> *outLayers);
+
+	//! Triangulates the solid area of closed chain segments including its holes, by splitting it into y-monotone pieces with a sweep line in O(n log n).
+	//! The chain segments must not cross each other, which is always true for traced contours. Touching in a single point is allowed.
+	ftt_api void TriangulateChainSegments(const std::vector<ChainSegment> &chainSegments, std::vector<Triangle> *outTriangles);
+	//! Decomposes the solid area of closed chain segments into convex polygons, by merging the triangles of TriangulateChainSegments() (Hertel-Mehlhorn).
+	//! The result has at most four times the minimum number of convex polygons.
+	ftt_api void DecomposeChainSegments(const std::vector<ChainSegment> &chainSegments, std::vector<ConvexPolygon> *outPolygons);
+
+	//! Computes the contour cache key from a fast hash of the tile map and the trace options
+	ftt_api uint64_t ComputeContourCacheKey(const Vec2u &tileCount, const uint8_t *mapTiles, const ContourCacheOptions &options);
+	//! Writes the chain segments into a versioned binary blob with the given key. The vertices are stored as delta encoded varints.
+	ftt_api void WriteContourCache(uint64_t key, const std::vector<ChainSegment> &chainSegments, std::vector<uint8_t> *outBlob);
+	//! Reads the chain segments from a contour cache blob, which may be a memory mapped file.
+	//! Returns false when the blob is damaged or has a different version or key, then the tile map must be traced again.
+	ftt_api bool ReadContourCache(const void *blob, size_t blobSize, uint64_t key, std::vector<ChainSegment> *outChainSegments);
 };
 #endif
 
@@ -264,6 +518,13 @@ namespace ftt {
 #	define FTT_IMPLEMENTED
 
 #include <assert.h>
+#include <algorithm> // std::sort, std::lower_bound
+#include <set> // std::set
+#include <string.h> // memcpy
+#if !FTT_NO_THREADS
+#	include <thread>
+#	include <atomic>
+#endif
 
 namespace ftt {
 	/*
@@ -280,8 +541,8 @@ namespace ftt {
 	- Mark that Start-Tile as invalid, so we will never process it again
 	- Set the initial scan direction for this Start-Tile to Up
 	- This Start-Tile is pushed into the OpenTile-List
-	- Create all 4 vertices for that tile and push it into the Main-Verts-List, but dont push any vertex which is already in the list
-	- Remember each index to the Main-Verts-List you have pushed on or found when already exists
+	- Create all 4 vertices for that tile
+	(Vertices always lie on the tile grid, so the index of a vertex is its lattice position)
 	- Create 4 edges for that tile and store it in a local array with 4 entries long -> Each edge defines the first index and the following index is defined clockwise direction
 
 	A tile and its vertices and edge indices (Winding order is important!):
@@ -296,6 +557,9 @@ namespace ftt {
 
 	- Loop through all 4 edges and remove edges which overlaps any edge in the Main-Edge-List:
 	A overlap edge is detected when the follow criteria are met: (MainEdge->Index1 == CurrentEdge->Index0) and (MainEdge->Index0 == CurrentEdge->Index1)
+	(Each edge is a unit step on the lattice, so it is stored as the lattice position of v0 and the direction to v1.
+	The valid edges leaving each lattice point are kept as bits, so overlaps are found in constant time.
+	Overlapping edges are marked invalid instead of erased to keep the order, the list is compacted once all tiles are added)
 	- Add all non-overlapping edges to the Main-Edge-List
 	- Get next open tile from the Open-Tile-List, but leave list untouched and continue on "Get next tile forward"
 	or
@@ -352,222 +616,262 @@ namespace ftt {
 			return(result);
 		}
 
-		inline Tile MakeTile(int32_t x, int32_t y, int32_t isSolid) {
-			Tile tile = {};
-			tile.x = x;
-			tile.y = y;
-			tile.isSolid = isSolid;
-			return(tile);
+		inline uint64_t ComputeTileHash(uint32_t x, uint32_t y) {
+			uint64_t result = ((uint64_t)x << 32) | (uint64_t)y;
+			return(result);
 		}
 
-		inline Edge MakeTileEdge(int32_t index, int32_t vertIndex0, int32_t vertIndex1, const Vec2i &tilePosition) {
-			Edge result = {};
-			result.index = index;
-			result.vertIndex0 = vertIndex0;
-			result.vertIndex1 = vertIndex1;
-			result.tilePosition = tilePosition;
+		inline uint32_t ComputeTileIndex(const Vec2u &dimension, uint32_t x, uint32_t y) {
+			uint32_t result = y * dimension.w + x;
 			return(result);
 		}
 
-		inline uint64_t ComputeTileHash(uint32_t x, uint32_t y) {
-			uint64_t result = ((uint64_t)x << 32) | (uint64_t)y;
+		inline uint32_t ComputeLatticeIndex(const Vec2u &dimension, uint32_t x, uint32_t y) {
+			uint32_t result = y * (dimension.w + 1) + x;
 			return(result);
 		}
 
-		inline uint32_t ComputeTileIndex(const Vec2u &dimension, uint32_t x, uint32_t y) {
-			uint32_t result = y * dimension.w + x;
+		inline Vec2i GetTilePosition(const Vec2u &dimension, uint32_t tileIndex) {
+			Vec2i result = V2i((int32_t)(tileIndex % dimension.w), (int32_t)(tileIndex / dimension.w));
+			return(result);
+		}
+
+		inline Vec2i GetLatticePosition(const Vec2u &dimension, uint32_t latticeIndex) {
+			Vec2i result = V2i((int32_t)(latticeIndex % (dimension.w + 1)), (int32_t)(latticeIndex / (dimension.w + 1)));
 			return(result);
 		}
 
-		inline int32_t IsTileSolid(std::vector<Tile> &tiles, const Vec2u &dimension, int32_t x, int32_t y) {
-			int32_t result = false;
-			if ((x >= 0 && x < (int32_t)dimension.w) && (y >= 0 && y < (int32_t)dimension.h)) {
-				uint32_t tileIndex = ComputeTileIndex(dimension, x, y);
-				assert(tileIndex < dimension.w * dimension.h);
-				result = tiles[tileIndex].isSolid > 0;
+		inline uint32_t FindLowestBitIndex(uint64_t value) {
+			assert(value != 0);
+#if defined(__GNUC__) || defined(__clang__)
+			uint32_t result = (uint32_t)__builtin_ctzll(value);
+#else
+			uint32_t result = 0;
+			while (!((value >> result) & 1)) {
+				++result;
 			}
+#endif
 			return(result);
 		}
 
-		inline Tile *GetTile(std::vector<Tile> &tiles, const Vec2u &dimension, uint32_t x, uint32_t y) {
-			assert((x < (uint32_t)dimension.w) && (y < (uint32_t)dimension.h));
-			uint32_t tileIndex = ComputeTileIndex(dimension, x, y);
-			return &tiles[tileIndex];
+		template <typename T>
+		inline void ResetArenaVector(std::vector<T, ArenaAllocator<T> > &items, MemoryArena *arena) {
+			// The allocator is swapped as well, so all further allocations go into the arena
+			std::vector<T, ArenaAllocator<T> > emptyItems((ArenaAllocator<T>(arena)));
+			items.swap(emptyItems);
 		}
 
-		inline void SetTileSolid(std::vector<Tile> &tiles, const Vec2u &dimension, uint32_t x, uint32_t y, int32_t value) {
-			assert((x < (uint32_t)dimension.w) && (y < (uint32_t)dimension.h));
-			uint32_t tileIndex = ComputeTileIndex(dimension, x, y);
-			tiles[tileIndex].isSolid = value;
+		inline bool IsTileSolid(const TileTracerData *traceState, int32_t x, int32_t y) {
+			bool result = false;
+			if ((x >= 0 && x < (int32_t)traceState->tileCount.w) && (y >= 0 && y < (int32_t)traceState->tileCount.h)) {
+				result = ((traceState->solidBits[y * traceState->wordsPerRow + (x >> 6)] >> (x & 63)) & 1) != 0;
+			}
+			return(result);
 		}
-		inline void RemoveTile(std::vector<Tile> &tiles, const Vec2u &dimension, uint32_t x, uint32_t y) {
-			SetTileSolid(tiles, dimension, x, y, -1);
+
+		inline void RemoveTile(TileTracerData *traceState, uint32_t tileIndex) {
+			Vec2i tilePosition = GetTilePosition(traceState->tileCount, tileIndex);
+			traceState->solidBits[tilePosition.y * traceState->wordsPerRow + (tilePosition.x >> 6)] &= ~((uint64_t)1 << (tilePosition.x & 63));
 		}
 
-		static Tile *GetFirstSolidTile(std::vector<Tile> &tiles, const Vec2u &dimension) {
-			for (uint32_t tileY = 0; tileY < dimension.h; ++tileY) {
-				for (uint32_t tileX = 0; tileX < dimension.w; ++tileX) {
-					if (IsTileSolid(tiles, dimension, tileX, tileY)) {
-						Tile *tile = GetTile(tiles, dimension, tileX, tileY);
-						return tile;
-					}
-				}
-			}
-			return ftt_null;
+		inline uint32_t GetTraceDirection(const TileTracerData *traceState, uint32_t tileIndex) {
+			uint32_t result = (traceState->traceDirections[tileIndex >> 2] >> ((tileIndex & 3) * 2)) & 3;
+			return(result);
 		}
 
-		static TileVertices CreateTileVertices(Tile *tile) {
-			TileVertices result = {};
-			result.verts[0] = V2i(tile->x, tile->y + 1);
-			result.verts[1] = V2i(tile->x, tile->y);
-			result.verts[2] = V2i(tile->x + 1, tile->y);
-			result.verts[3] = V2i(tile->x + 1, tile->y + 1);
-			return(result);
-		}
-
-		static TileIndices PushTileVertices(TileTracerData *traceState, Tile *tile) {
-			TileIndices result = {};
-			TileVertices tileVerts = CreateTileVertices(tile);
-			assert(ArrayCount(tileVerts.verts) == ArrayCount(result.indices));
-			for (uint32_t vertIndex = 0; vertIndex < ArrayCount(tileVerts.verts); ++vertIndex) {
-				Vec2i vertex = tileVerts.verts[vertIndex];
-				int32_t matchedMainVertexIndex = -1;
-				for (uint32_t mainVertexIndex = 0; mainVertexIndex < traceState->mainVertices.size(); ++mainVertexIndex) {
-					if (IsEqual(traceState->mainVertices[mainVertexIndex], vertex)) {
-						matchedMainVertexIndex = mainVertexIndex;
-						break;
-					}
+		inline void SetTraceDirection(TileTracerData *traceState, uint32_t tileIndex, uint32_t direction) {
+			uint8_t &directions = traceState->traceDirections[tileIndex >> 2];
+			uint32_t shift = (tileIndex & 3) * 2;
+			directions = (uint8_t)((directions & ~(3 << shift)) | (direction << shift));
+		}
+
+		static uint32_t GetFirstSolidTile(TileTracerData *traceState) {
+			// Tiles are only ever removed, so the search continues where the last one has stopped
+			const Vec2u &dimension = traceState->tileCount;
+			uint32_t tileCount = dimension.w * dimension.h;
+			while (traceState->solidSearchIndex < tileCount) {
+				Vec2i tilePosition = GetTilePosition(dimension, traceState->solidSearchIndex);
+				uint64_t solidBits = traceState->solidBits[tilePosition.y * traceState->wordsPerRow + (tilePosition.x >> 6)] >> (tilePosition.x & 63);
+				if (solidBits != 0) {
+					// Bits after the end of a row are never set
+					traceState->solidSearchIndex += FindLowestBitIndex(solidBits);
+					return traceState->solidSearchIndex;
 				}
-				if (matchedMainVertexIndex == -1) {
-					result.indices[vertIndex] = (int32_t)traceState->mainVertices.size();
-					traceState->mainVertices.push_back(vertex);
-				} else {
-					result.indices[vertIndex] = matchedMainVertexIndex;
+				uint32_t skipCount = 64 - (tilePosition.x & 63);
+				if (tilePosition.x + skipCount > dimension.w) {
+					skipCount = dimension.w - tilePosition.x;
 				}
+				traceState->solidSearchIndex += skipCount;
 			}
+			return INVALID_INDEX;
+		}
+
+		inline uint32_t MakeEdgeKey(uint32_t vertIndex0, uint32_t direction) {
+			uint32_t result = vertIndex0 * TILETRACE_DIRECTION_COUNT + direction;
 			return(result);
 		}
 
-		static TileEdges CreateTileEdges(TileIndices tileIndices, const Vec2u &tileCount, Tile *tile) {
-			TileEdges result = {};
-			uint32_t indexCount = (uint32_t)ArrayCount(tileIndices.indices);
-			for (uint32_t index = 0; index < indexCount; ++index) {
-				int32_t e0 = tileIndices.indices[index];
-				int32_t e1 = tileIndices.indices[(index + 1) % indexCount];
-				result.edges[result.count++] = MakeTileEdge(index, e0, e1, V2i(tile->x, tile->y));
-			}
+		inline uint32_t GetEdgeVertex0(uint32_t edgeKey) {
+			uint32_t result = edgeKey / TILETRACE_DIRECTION_COUNT;
 			return(result);
 		}
 
-		static TileEdges RemoveOverlapEdges(TileTracerData *traceState, TileEdges inputEdges) {
-			TileEdges result = {};
-			for (uint32_t edgeIndex = 0; edgeIndex < inputEdges.count; ++edgeIndex) {
-				Edge inputEdge = inputEdges.edges[edgeIndex];
-				bool addIt = true;
-				for (uint32_t mainEdgeIndex = 0; mainEdgeIndex < traceState->mainEdges.size(); ++mainEdgeIndex) {
-					Edge mainEdge = traceState->mainEdges[mainEdgeIndex];
-					if (inputEdge.vertIndex0 == mainEdge.vertIndex1 && inputEdge.vertIndex1 == mainEdge.vertIndex0) {
-						addIt = false;
-						traceState->mainEdges.erase(traceState->mainEdges.begin() + mainEdgeIndex);
-						break;
-					}
-				}
-				if (addIt) {
-					result.edges[result.count++] = inputEdge;
-				}
+		inline uint32_t GetEdgeDirection(uint32_t edgeKey) {
+			uint32_t result = edgeKey % TILETRACE_DIRECTION_COUNT;
+			return(result);
+		}
+
+		inline uint32_t GetEdgeVertex1(const TileTracerData *traceState, uint32_t edgeKey) {
+			// Each edge is a unit step on the lattice
+			const Vec2i &direction = TILETRACE_DIRECTIONS[GetEdgeDirection(edgeKey)];
+			uint32_t result = (uint32_t)((int32_t)GetEdgeVertex0(edgeKey) + direction.y * (int32_t)(traceState->tileCount.w + 1) + direction.x);
+			return(result);
+		}
+
+		inline bool IsEdgeValid(const TileTracerData *traceState, uint32_t edgeKey) {
+			bool result = ((traceState->edgeStates[GetEdgeVertex0(edgeKey)] >> GetEdgeDirection(edgeKey)) & 1) != 0;
+			return(result);
+		}
+
+		static void AddEdgeState(TileTracerData *traceState, uint32_t edgeKey) {
+			uint8_t &edgeState = traceState->edgeStates[GetEdgeVertex0(edgeKey)];
+			uint32_t direction = GetEdgeDirection(edgeKey);
+			// Edges are added in the main edge order, so the first one of a lattice point is the oldest
+			if ((edgeState & 0xF) == 0) {
+				edgeState = (uint8_t)(direction << 4);
+			}
+			edgeState |= (uint8_t)(1 << direction);
+		}
+
+		static void InvalidateEdge(TileTracerData *traceState, uint32_t edgeKey) {
+			uint8_t &edgeState = traceState->edgeStates[GetEdgeVertex0(edgeKey)];
+			uint32_t direction = GetEdgeDirection(edgeKey);
+			uint32_t validDirections = (edgeState & 0xF) & ~(1u << direction);
+			uint32_t oldestDirection = (edgeState >> 4) & 3;
+			// At most two edges can leave a lattice point (two diagonal tiles), so the remaining one is the oldest now
+			if (oldestDirection == direction && validDirections != 0) {
+				oldestDirection = FindLowestBitIndex(validDirections);
 			}
+			edgeState = (uint8_t)((oldestDirection << 4) | validDirections);
+		}
+
+		static TileVertices CreateTileVertices(const Vec2i &tilePosition) {
+			TileVertices result = {};
+			result.verts[0] = V2i(tilePosition.x, tilePosition.y + 1);
+			result.verts[1] = V2i(tilePosition.x, tilePosition.y);
+			result.verts[2] = V2i(tilePosition.x + 1, tilePosition.y);
+			result.verts[3] = V2i(tilePosition.x + 1, tilePosition.y + 1);
 			return(result);
 		}
 
-		static bool IsTileSharesCommonEdges(TileTracerData *traceState, TileVertices tileVertices) {
-			uint32_t vertexCount = (uint32_t)ArrayCount(tileVertices.verts);
-			for (uint32_t vertIndex = 0; vertIndex < vertexCount; ++vertIndex) {
-				Vec2i tv0 = tileVertices.verts[vertIndex];
-				Vec2i tv1 = tileVertices.verts[(vertIndex + 1) % vertexCount];
-				for (uint32_t edgeIndex = 0; edgeIndex < traceState->mainEdges.size(); ++edgeIndex) {
-					Edge edge = traceState->mainEdges[edgeIndex];
-					Vec2i mv0 = traceState->mainVertices[edge.vertIndex0];
-					Vec2i mv1 = traceState->mainVertices[edge.vertIndex1];
-					if (IsEqual(tv0, mv1) && IsEqual(tv1, mv0)) {
-						return true;
-					}
+		inline uint32_t GetOverlapEdgeKey(const Vec2u &tileCount, const TileVertices &tileVertices, uint32_t edgeIndex) {
+			// The tile edge i goes from vertex i to vertex i + 1 in direction i, so the overlapping edge goes back in the opposite direction
+			const Vec2i &v1 = tileVertices.verts[(edgeIndex + 1) % ArrayCount(tileVertices.verts)];
+			uint32_t result = MakeEdgeKey(ComputeLatticeIndex(tileCount, v1.x, v1.y), (edgeIndex + 2) % TILETRACE_DIRECTION_COUNT);
+			return(result);
+		}
+
+		static bool IsTileSharesCommonEdges(TileTracerData *traceState, const TileVertices &tileVertices) {
+			for (uint32_t edgeIndex = 0; edgeIndex < ArrayCount(tileVertices.verts); ++edgeIndex) {
+				if (IsEdgeValid(traceState, GetOverlapEdgeKey(traceState->tileCount, tileVertices, edgeIndex))) {
+					return true;
 				}
 			}
 			return false;
 		}
 
-		inline void RemoveSegmentVertex(ChainSegment *chainSegment, uint32_t index) {
-			assert(index < chainSegment->vertices.size());
-			chainSegment->vertices.erase(chainSegment->vertices.begin() + index);
+		inline void RemoveSegmentVertex(TileTracerData *traceState, ChainRange *chainSegment, uint32_t index) {
+			assert(index < chainSegment->vertexCount);
+			// The current chain segment is always at the end of the vertex buffer
+			assert(chainSegment->firstVertex + chainSegment->vertexCount == traceState->chainVertices.size());
+			traceState->chainVertices.erase(traceState->chainVertices.begin() + chainSegment->firstVertex + index);
+			--chainSegment->vertexCount;
 		}
 
-		static void ClearLineSegmentPoints(ChainSegment *segment, uint32_t firstIndex, uint32_t middleIndex, uint32_t lastIndex) {
-			Vec2i last = segment->vertices[lastIndex];
-			Vec2i middle = segment->vertices[middleIndex];
-			Vec2i first = segment->vertices[firstIndex];
+		static void ClearLineSegmentPoints(TileTracerData *traceState, ChainRange *segment, uint32_t firstIndex, uint32_t middleIndex, uint32_t lastIndex) {
+			const Vec2i *vertices = &traceState->chainVertices[segment->firstVertex];
+			Vec2i last = vertices[lastIndex];
+			Vec2i middle = vertices[middleIndex];
+			Vec2i first = vertices[firstIndex];
 			Vec2i d1 = Subtract(last, middle);
 			Vec2i d2 = Subtract(middle, first);
 			int32_t d = Dot(d1, d2);
 			if (d > 0) {
-				RemoveSegmentVertex(segment, middleIndex);
+				RemoveSegmentVertex(traceState, segment, middleIndex);
 			}
 		}
 
-		static void OptimizeChainSegment(ChainSegment *segment) {
-			if (segment->vertices.size() > 2) {
-				uint32_t lastIndex = (uint32_t)(segment->vertices.size() - 1);
-				ClearLineSegmentPoints(segment, lastIndex - 2, lastIndex - 1, lastIndex);
+		static void OptimizeChainSegment(TileTracerData *traceState, ChainRange *segment) {
+			if (segment->vertexCount > 2) {
+				uint32_t lastIndex = segment->vertexCount - 1;
+				ClearLineSegmentPoints(traceState, segment, lastIndex - 2, lastIndex - 1, lastIndex);
 			}
 		}
 
-		static void FinalizeChainSegment(ChainSegment *chainSegment) {
-			if (chainSegment->vertices.size() > 2) {
-				ClearLineSegmentPoints(chainSegment, (uint32_t)(chainSegment->vertices.size() - 1), 0, 1);
+		static void FinalizeChainSegment(TileTracerData *traceState, ChainRange *chainSegment) {
+			if (chainSegment->vertexCount > 2) {
+				ClearLineSegmentPoints(traceState, chainSegment, chainSegment->vertexCount - 1, 0, 1);
 			}
-			if (chainSegment->vertices.size() > 2) {
-				ClearLineSegmentPoints(chainSegment, 0, (uint32_t)(chainSegment->vertices.size() - 1), (uint32_t)(chainSegment->vertices.size() - 2));
+			if (chainSegment->vertexCount > 2) {
+				ClearLineSegmentPoints(traceState, chainSegment, 0, chainSegment->vertexCount - 1, chainSegment->vertexCount - 2);
 			}
 		}
 
-		inline void AddChainSegmentVertex(ChainSegment *chainSegment, const Vec2i &vertex) {
-			chainSegment->vertices.push_back(vertex);
+		inline void AddChainSegmentVertex(TileTracerData *traceState, ChainRange *chainSegment, const Vec2i &vertex) {
+			assert(chainSegment->firstVertex + chainSegment->vertexCount == traceState->chainVertices.size());
+			traceState->chainVertices.push_back(vertex);
+			++chainSegment->vertexCount;
+		}
+
+		static uint32_t FindNextEdge(TileTracerData *traceState, uint32_t vertIndex0) {
+			// The next edge starts at the given vertex and ends at one of its four lattice neighbors.
+			// When two edges start there, the one which comes first in the main edge list wins.
+			uint8_t edgeState = traceState->edgeStates[vertIndex0];
+			uint32_t validDirections = edgeState & 0xF;
+			if (validDirections == 0) {
+				return INVALID_INDEX;
+			}
+			uint32_t direction = (validDirections & (validDirections - 1)) != 0 ? (uint32_t)((edgeState >> 4) & 3) : FindLowestBitIndex(validDirections);
+			uint32_t result = MakeEdgeKey(vertIndex0, direction);
+			return(result);
 		}
 
 		static bool ProcessTraverseNextEdge(TileTracerData *traceState) {
-			for (uint32_t mainEdgeIndex = 0; mainEdgeIndex < traceState->mainEdges.size(); ++mainEdgeIndex) {
-				Edge *curEdge = &traceState->mainEdges[mainEdgeIndex];
-				if (!curEdge->isInvalid && (curEdge->vertIndex0 == traceState->lastEdge->vertIndex1)) {
-					// If v0 from current edge equals starting edge - then we are finished
-					if (curEdge->vertIndex1 == traceState->startEdge->vertIndex0) {
-						// We are done with this line segment - Set cur step to find next starting edge
-						traceState->lastEdge = ftt_null;
-						traceState->curStep = Step::TraverseFindStartingEdge;
-						// Optimize and finalize shape
-						OptimizeChainSegment(traceState->curChainSegment);
-						FinalizeChainSegment(traceState->curChainSegment);
-						// Add list vertex to the end again, because we have a fully closed chain
-						AddChainSegmentVertex(traceState->curChainSegment, traceState->curChainSegment->vertices[0]);
-					} else {
-						// Now our current edge is the last edge
-						traceState->lastEdge = curEdge;
-						// Add always the first edge vertex to the list
-						AddChainSegmentVertex(traceState->curChainSegment, traceState->mainVertices[curEdge->vertIndex1]);
-						// Optimize shape
-						OptimizeChainSegment(traceState->curChainSegment);
-					}
-					curEdge->isInvalid = true;
-					return true;
+			ChainRange *curChainSegment = &traceState->chainSegments.back();
+			uint32_t nextEdge = FindNextEdge(traceState, GetEdgeVertex1(traceState, traceState->lastEdge));
+			if (nextEdge != INVALID_INDEX) {
+				uint32_t nextVertIndex1 = GetEdgeVertex1(traceState, nextEdge);
+				// If v0 from current edge equals starting edge - then we are finished
+				if (nextVertIndex1 == GetEdgeVertex0(traceState->startEdge)) {
+					// We are done with this line segment - Set cur step to find next starting edge
+					traceState->lastEdge = INVALID_INDEX;
+					traceState->curStep = Step::TraverseFindStartingEdge;
+					// Optimize and finalize shape
+					OptimizeChainSegment(traceState, curChainSegment);
+					FinalizeChainSegment(traceState, curChainSegment);
+					// Add list vertex to the end again, because we have a fully closed chain
+					Vec2i firstVertex = traceState->chainVertices[curChainSegment->firstVertex];
+					AddChainSegmentVertex(traceState, curChainSegment, firstVertex);
+				} else {
+					// Now our current edge is the last edge
+					traceState->lastEdge = nextEdge;
+					// Add always the first edge vertex to the list
+					AddChainSegmentVertex(traceState, curChainSegment, GetLatticePosition(traceState->tileCount, nextVertIndex1));
+					// Optimize shape
+					OptimizeChainSegment(traceState, curChainSegment);
 				}
+				InvalidateEdge(traceState, nextEdge);
+				return true;
 			}
 
 			// We will come here for a line segment which is not fully closed, may have holes or something
-			if (traceState->curChainSegment->vertices.size() > 0) {
+			if (curChainSegment->vertexCount > 0) {
 				// We are done with this line segment - Set cur step to find next starting edge
-				traceState->lastEdge = ftt_null;
+				traceState->lastEdge = INVALID_INDEX;
 				traceState->curStep = Step::TraverseFindStartingEdge;
 				// Optimize and finalize shape
-				OptimizeChainSegment(traceState->curChainSegment);
-				FinalizeChainSegment(traceState->curChainSegment);
+				OptimizeChainSegment(traceState, curChainSegment);
+				FinalizeChainSegment(traceState, curChainSegment);
 				return true;
 			}
 
@@ -581,27 +885,26 @@ namespace ftt {
 			bool result = false;
 
 			// Find next free starting edge - at the start this is always null
-			traceState->startEdge = ftt_null;
-			int32_t startEdgeIndex = -1;
-			for (uint32_t mainEdgeIndex = 0; mainEdgeIndex < traceState->mainEdges.size(); ++mainEdgeIndex) {
-				Edge *mainEdge = &traceState->mainEdges[mainEdgeIndex];
-				if (!mainEdge->isInvalid) {
-					startEdgeIndex = mainEdgeIndex;
+			traceState->startEdge = INVALID_INDEX;
+			for (; traceState->edgeSearchIndex < traceState->mainEdges.size(); ++traceState->edgeSearchIndex) {
+				uint32_t mainEdge = traceState->mainEdges[traceState->edgeSearchIndex];
+				if (IsEdgeValid(traceState, mainEdge)) {
 					traceState->startEdge = mainEdge;
 					break;
 				}
 			}
 
-			if (traceState->startEdge != ftt_null) {
+			if (traceState->startEdge != INVALID_INDEX) {
 				// Continue when we found a starting edge and create the actual line segment for it
 				result = true;
 				traceState->lastEdge = traceState->startEdge;
-				traceState->mainEdges[startEdgeIndex].isInvalid = true;
+				InvalidateEdge(traceState, traceState->startEdge);
 				traceState->curStep = Step::TraverseNextEdge;
-				traceState->chainSegments.push_back(ChainSegment());
-				traceState->curChainSegment = &traceState->chainSegments[traceState->chainSegments.size() - 1];
-				AddChainSegmentVertex(traceState->curChainSegment, traceState->mainVertices[traceState->startEdge->vertIndex0]);
-				AddChainSegmentVertex(traceState->curChainSegment, traceState->mainVertices[traceState->startEdge->vertIndex1]);
+				ChainRange chainSegment = { (uint32_t)traceState->chainVertices.size(), 0 };
+				traceState->chainSegments.push_back(chainSegment);
+				ChainRange *curChainSegment = &traceState->chainSegments.back();
+				AddChainSegmentVertex(traceState, curChainSegment, GetLatticePosition(traceState->tileCount, GetEdgeVertex0(traceState->startEdge)));
+				AddChainSegmentVertex(traceState, curChainSegment, GetLatticePosition(traceState->tileCount, GetEdgeVertex1(traceState, traceState->startEdge)));
 			} else {
 				// We are completely done
 				traceState->curStep = Step::Done;
@@ -620,8 +923,9 @@ namespace ftt {
 		}
 
 		static void RotateForward(TileTracerData *traceState) {
-			if (traceState->curTile->traceDirection < (TILETRACE_DIRECTION_COUNT - 1)) {
-				++traceState->curTile->traceDirection;
+			uint32_t traceDirection = GetTraceDirection(traceState, traceState->curTile);
+			if (traceDirection < (TILETRACE_DIRECTION_COUNT - 1)) {
+				SetTraceDirection(traceState, traceState->curTile, traceDirection + 1);
 				traceState->curStep = Step::FindNextTile;
 			} else {
 				traceState->openList.pop_back();
@@ -630,156 +934,2008 @@ namespace ftt {
 			}
 		}
 
-		static void AddTile(TileTracerData *traceState, Tile *tile) {
-			// Add the start tile to the open list and remove it from the map
-			traceState->openList.push_back(tile);
-			RemoveTile(traceState->tiles, traceState->tileCount, tile->x, tile->y);
+		static void CompactMainEdges(TileTracerData *traceState) {
+			// Remove the overlapped edges but keep the order, the edge states stay the same
+			uint32_t validCount = 0;
+			for (uint32_t mainEdgeIndex = 0; mainEdgeIndex < traceState->mainEdges.size(); ++mainEdgeIndex) {
+				if (IsEdgeValid(traceState, traceState->mainEdges[mainEdgeIndex])) {
+					traceState->mainEdges[validCount++] = traceState->mainEdges[mainEdgeIndex];
+				}
+			}
+			traceState->mainEdges.resize(validCount);
+			traceState->edgeSearchIndex = 0;
+		}
 
-			// Create tile vertices/indices and edges for the next tile
-			TileIndices tileIndices = PushTileVertices(traceState, tile);
-			TileEdges tileEdges = CreateTileEdges(tileIndices, traceState->tileCount, tile);
+		static void AddTile(TileTracerData *traceState, uint32_t tileIndex) {
+			// Add the start tile to the open list and remove it from the map
+			traceState->openList.push_back(tileIndex);
+			RemoveTile(traceState, tileIndex);
 
 			// Remove edges that overlap from the main edge list and the edge list for NextTile
-			tileEdges = RemoveOverlapEdges(traceState, tileEdges);
+			TileVertices tileVertices = CreateTileVertices(GetTilePosition(traceState->tileCount, tileIndex));
+			uint32_t edgeKeys[4];
+			uint32_t edgeCount = 0;
+			for (uint32_t edgeIndex = 0; edgeIndex < ArrayCount(tileVertices.verts); ++edgeIndex) {
+				uint32_t overlapEdgeKey = GetOverlapEdgeKey(traceState->tileCount, tileVertices, edgeIndex);
+				if (IsEdgeValid(traceState, overlapEdgeKey)) {
+					// Invalid edges are skipped everywhere and removed in CompactMainEdges()
+					InvalidateEdge(traceState, overlapEdgeKey);
+				} else {
+					const Vec2i &v0 = tileVertices.verts[edgeIndex];
+					edgeKeys[edgeCount++] = MakeEdgeKey(ComputeLatticeIndex(traceState->tileCount, v0.x, v0.y), edgeIndex);
+				}
+			}
 
 			// Push the remaining edges to the main edges list
-			for (uint32_t tileEdgeIndex = 0; tileEdgeIndex < tileEdges.count; ++tileEdgeIndex) {
-				traceState->mainEdges.push_back(tileEdges.edges[tileEdgeIndex]);
+			for (uint32_t edgeIndex = 0; edgeIndex < edgeCount; ++edgeIndex) {
+				AddEdgeState(traceState, edgeKeys[edgeIndex]);
+				traceState->mainEdges.push_back(edgeKeys[edgeIndex]);
 			}
 		}
-	};
-
-	ftt_api void InitTileTracer(TileTracerData *tracer, const Vec2u &tileCount, uint8_t *mapTiles) {
-		assert(tracer != ftt_null);
-		assert(mapTiles != ftt_null);
-
-		using namespace internals;
 
-		tracer->tileCount = tileCount;
-		tracer->tiles.resize(tileCount.x  * tileCount.y);
-		for (uint32_t tileY = 0; tileY < tileCount.h; ++tileY) {
-			for (uint32_t tileX = 0; tileX < tileCount.w; ++tileX) {
-				uint32_t tileIndex = ComputeTileIndex(tileCount, tileX, tileY);
-				int32_t isSolid = mapTiles[tileIndex];
-				Tile *tile = &tracer->tiles[tileIndex];
-				*tile = MakeTile(tileX, tileY, isSolid);
+		//
+		// Contour tracing (Single pass over a bit-packed solid mask)
+		//
+		static void InitSolidMask(SolidMask *mask, const Vec2u &tileCount, const uint8_t *mapTiles) {
+			mask->tileCount = tileCount;
+			mask->wordsPerRow = (tileCount.w + 63) / 64;
+			mask->bits.assign(mask->wordsPerRow * tileCount.h, 0);
+			for (uint32_t tileY = 0; tileY < tileCount.h; ++tileY) {
+				uint64_t *row = &mask->bits[tileY * mask->wordsPerRow];
+				const uint8_t *mapRow = mapTiles + tileY * tileCount.w;
+				for (uint32_t tileX = 0; tileX < tileCount.w; ++tileX) {
+					if (mapRow[tileX] > 0) {
+						row[tileX >> 6] |= (uint64_t)1 << (tileX & 63);
+					}
+				}
 			}
 		}
 
-		tracer->curStep = Step::FindStart;
-		tracer->openList.clear();
-		tracer->startTile = ftt_null;
-		tracer->mainVertices.clear();
-		tracer->mainEdges.clear();
-		tracer->chainSegments.clear();
-
-		tracer->curTile = ftt_null;
-		tracer->nextTile = ftt_null;
-	}
-
-	ftt_api bool NextTileTraceStep(TileTracerData *tracer) {
-		assert(tracer != ftt_null);
+		inline bool IsMaskSolid(const SolidMask *mask, int32_t x, int32_t y) {
+			bool result = false;
+			if ((x >= 0 && x < (int32_t)mask->tileCount.w) && (y >= 0 && y < (int32_t)mask->tileCount.h)) {
+				result = ((mask->bits[y * mask->wordsPerRow + (x >> 6)] >> (x & 63)) & 1) != 0;
+			}
+			return(result);
+		}
 
-		using namespace internals;
+		// Tiles on the right and left side of the edge which leaves the vertex (x, y) in the given direction
+		static const Vec2i CONTOUR_RIGHT_TILE_OFFSETS[] = { V2i(0, -1), V2i(0, 0), V2i(-1, 0), V2i(-1, -1) };
+		static const Vec2i CONTOUR_LEFT_TILE_OFFSETS[] = { V2i(-1, -1), V2i(0, -1), V2i(0, 0), V2i(-1, 0) };
 
-		bool result = true;
-		switch (tracer->curStep) {
-			case Step::Done:
-			{
-				result = false;
-			}; break;
-			case Step::TraverseNextEdge:
-			{
-				result = ProcessTraverseNextEdge(tracer);
-			}; break;
-			case Step::TraverseFindStartingEdge:
-			{
-				result = ProcessTraverseFindStartingEdge(tracer);
-			}; break;
-			case Step::FindStart:
-			{
-				tracer->openList.clear();
-				tracer->curTile = ftt_null;
-				tracer->startTile = GetFirstSolidTile(tracer->tiles, tracer->tileCount);
-				if (tracer->startTile != ftt_null) {
-					// Add the start tile to the open list and build vertices and edges from it
-					AddTile(tracer, tracer->startTile);
+		inline bool IsContourEdge(const SolidMask *mask, const Vec2i &vertex, uint32_t direction) {
+			// Contours are walked clockwise, so the solid tile is always on the right side
+			bool result =
+				IsMaskSolid(mask, vertex.x + CONTOUR_RIGHT_TILE_OFFSETS[direction].x, vertex.y + CONTOUR_RIGHT_TILE_OFFSETS[direction].y) &&
+				!IsMaskSolid(mask, vertex.x + CONTOUR_LEFT_TILE_OFFSETS[direction].x, vertex.y + CONTOUR_LEFT_TILE_OFFSETS[direction].y);
+			return(result);
+		}
 
-					// Set next step to get open tile and process it immediatitly
-					tracer->curStep = Step::GetNextOpenTile;
-					GetNextOpenTile(tracer);
-				} else {
-					// No start found, exit if we have not found any edges at all
-					if (tracer->mainEdges.size() == 0) {
-						result = false;
-					} else {
-						// Clear all chain segments
-						tracer->chainSegments.clear();
-						tracer->curStep = Step::TraverseFindStartingEdge;
-					}
+		inline uint32_t GetNextContourDirection(const SolidMask *mask, const Vec2i &vertex, uint32_t direction) {
+			// Prefer turning right, so diagonal touching tiles are separate contours
+			uint32_t result = (direction + 1) % TILETRACE_DIRECTION_COUNT;
+			if (!IsContourEdge(mask, vertex, result)) {
+				result = direction;
+				if (!IsContourEdge(mask, vertex, result)) {
+					result = (direction + TILETRACE_DIRECTION_COUNT - 1) % TILETRACE_DIRECTION_COUNT;
+					assert(IsContourEdge(mask, vertex, result));
 				}
-			}; break;
-			case Step::GetNextOpenTile:
-			{
-				GetNextOpenTile(tracer);
-			}; break;
-			case Step::FindNextTile:
-			{
-				assert(tracer->curTile != ftt_null);
+			}
+			return(result);
+		}
 
-				// Tile in the "forward" direction of the current tile
-				int32_t nx = tracer->curTile->x + TILETRACE_DIRECTIONS[tracer->curTile->traceDirection].x;
-				int32_t ny = tracer->curTile->y + TILETRACE_DIRECTIONS[tracer->curTile->traceDirection].y;
-				tracer->nextTile = IsTileSolid(tracer->tiles, tracer->tileCount, nx, ny) ? GetTile(tracer->tiles, tracer->tileCount, nx, ny) : ftt_null;
+		static void TraceContour(const SolidMask *mask, std::vector<uint64_t> &visitedTopEdges, const Vec2i &start, std::vector<Vec2i> &corners) {
+			// Every contour has at least one top edge, the first one found in scan order always starts at a corner
+			corners.clear();
+			corners.push_back(start);
+			Vec2i vertex = start;
+			uint32_t direction = Directions::Right;
+			for (;;) {
+				if (direction == Directions::Right) {
+					visitedTopEdges[vertex.y * mask->wordsPerRow + (vertex.x >> 6)] |= (uint64_t)1 << (vertex.x & 63);
+				}
+				vertex = V2i(vertex.x + TILETRACE_DIRECTIONS[direction].x, vertex.y + TILETRACE_DIRECTIONS[direction].y);
+				uint32_t nextDirection = GetNextContourDirection(mask, vertex, direction);
 
-				if (tracer->nextTile != ftt_null) {
-					// Create tile vertices for next tile and check if it shares common edges
-					TileVertices tileVertices = CreateTileVertices(tracer->nextTile);
-					bool sharesCommonEdge = IsTileSharesCommonEdges(tracer, tileVertices);
-					if (sharesCommonEdge) {
-						// Add the next tile to the open list and build vertices and edges from it
-						AddTile(tracer, tracer->nextTile);
+				if (IsEqual(vertex, start) && nextDirection == Directions::Right) {
+					break;
+				}
+				if (nextDirection != direction) {
+					corners.push_back(vertex);
+				}
+				direction = nextDirection;
+			}
+			// Add the first vertex to the end again, because we have a fully closed chain
+			corners.push_back(start);
+		}
 
-						// Set next step to get open tile and process it immediatitly
-						tracer->curStep = Step::GetNextOpenTile;
-						GetNextOpenTile(tracer);
-					} else {
-						tracer->curStep = Step::RotateForward;
-						RotateForward(tracer);
+		static bool FindNextContourStart(const SolidMask *mask, const std::vector<uint64_t> &visitedTopEdges, const Rect2i &tileRect, Vec2i *cursor) {
+			// Solid tiles without a solid tile above have a top edge, every unvisited one starts a new contour
+			uint32_t lastWordIndex = (uint32_t)tileRect.max.x >> 6;
+			for (int32_t tileY = cursor->y; tileY <= tileRect.max.y; ++tileY) {
+				int32_t firstX = (tileY == cursor->y) ? cursor->x : tileRect.min.x;
+				const uint64_t *row = &mask->bits[tileY * mask->wordsPerRow];
+				const uint64_t *rowAbove = tileY > 0 ? row - mask->wordsPerRow : ftt_null;
+				const uint64_t *visitedRow = &visitedTopEdges[tileY * mask->wordsPerRow];
+				for (uint32_t wordIndex = (uint32_t)firstX >> 6; wordIndex <= lastWordIndex; ++wordIndex) {
+					uint64_t topEdges = row[wordIndex] & ~(rowAbove != ftt_null ? rowAbove[wordIndex] : 0) & ~visitedRow[wordIndex];
+					if (wordIndex == ((uint32_t)firstX >> 6)) {
+						topEdges &= ~(uint64_t)0 << (firstX & 63);
+					}
+					if (wordIndex == lastWordIndex) {
+						topEdges &= ~(uint64_t)0 >> (63 - (tileRect.max.x & 63));
+					}
+					if (topEdges != 0) {
+						*cursor = V2i((int32_t)(wordIndex * 64 + FindLowestBitIndex(topEdges)), tileY);
+						return true;
 					}
-				} else {
-					tracer->curStep = Step::RotateForward;
-					RotateForward(tracer);
 				}
-			}; break;
-			case Step::RotateForward:
-			{
-				RotateForward(tracer);
-			}; break;
-			default:
-				assert(!"Invalid default case!");
+			}
+			return false;
 		}
-		return(result);
-	}
 
-	ftt_api void RunTileTracer(TileTracerData *tracer) {
-		assert(tracer != ftt_null);
-		while (NextTileTraceStep(tracer)) {
+		//
+		// Contour map
+		//
+		inline bool IsRectOverlap(const Rect2i &a, const Rect2i &b) {
+			bool result = (a.min.x <= b.max.x && a.max.x >= b.min.x) && (a.min.y <= b.max.y && a.max.y >= b.min.y);
+			return(result);
 		}
-	}
 
-	TileTracer::TileTracer(const Vec2u &tileCount, uint8_t *mapTiles) {
-		data = {};
-		InitTileTracer(&data, tileCount, mapTiles);
-	}
+		inline Rect2i RectUnion(const Rect2i &a, const Rect2i &b) {
+			Rect2i result;
+			result.min = V2i(a.min.x < b.min.x ? a.min.x : b.min.x, a.min.y < b.min.y ? a.min.y : b.min.y);
+			result.max = V2i(a.max.x > b.max.x ? a.max.x : b.max.x, a.max.y > b.max.y ? a.max.y : b.max.y);
+			return(result);
+		}
 
-	bool TileTracer::Next() {
-		bool result = NextTileTraceStep(&data);
-		return(result);
-	}
+		inline Rect2i MakeRect(const Vec2i &min, const Vec2i &max) {
+			Rect2i result;
+			result.min = min;
+			result.max = max;
+			return(result);
+		}
 
-	void TileTracer::Run() {
-		RunTileTracer(&data);
+		static Rect2i ComputeChainBounds(const std::vector<Vec2i> &vertices) {
+			Rect2i result = MakeRect(vertices[0], vertices[0]);
+			for (size_t vertexIndex = 1; vertexIndex < vertices.size(); ++vertexIndex) {
+				result = RectUnion(result, MakeRect(vertices[vertexIndex], vertices[vertexIndex]));
+			}
+			return(result);
+		}
+
+		static bool IsChainOverlapRect(const ChainSegment &chainSegment, const Rect2i &rect) {
+			// Chain segments are closed and axis aligned, so each line is its own bounding box
+			for (size_t vertexIndex = 0; vertexIndex + 1 < chainSegment.vertices.size(); ++vertexIndex) {
+				Rect2i lineRect = RectUnion(MakeRect(chainSegment.vertices[vertexIndex], chainSegment.vertices[vertexIndex]), MakeRect(chainSegment.vertices[vertexIndex + 1], chainSegment.vertices[vertexIndex + 1]));
+				if (IsRectOverlap(lineRect, rect)) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		static void MarkChainTopEdges(const SolidMask *mask, std::vector<uint64_t> &visitedTopEdges, const ChainSegment &chainSegment, const Rect2i &tileRect) {
+			// Top edges are all edges going right, marked by the tile below
+			for (size_t vertexIndex = 0; vertexIndex + 1 < chainSegment.vertices.size(); ++vertexIndex) {
+				const Vec2i &a = chainSegment.vertices[vertexIndex];
+				const Vec2i &b = chainSegment.vertices[vertexIndex + 1];
+				if (a.y == b.y && b.x > a.x && a.y >= tileRect.min.y && a.y <= tileRect.max.y) {
+					int32_t firstX = a.x > tileRect.min.x ? a.x : tileRect.min.x;
+					int32_t lastX = (b.x - 1) < tileRect.max.x ? (b.x - 1) : tileRect.max.x;
+					for (int32_t tileX = firstX; tileX <= lastX; ++tileX) {
+						visitedTopEdges[a.y * mask->wordsPerRow + (tileX >> 6)] |= (uint64_t)1 << (tileX & 63);
+					}
+				}
+			}
+		}
+
+		static void ClearTopEdges(const SolidMask *mask, std::vector<uint64_t> &visitedTopEdges, const Rect2i &tileRect) {
+			for (int32_t tileY = tileRect.min.y; tileY <= tileRect.max.y; ++tileY) {
+				for (int32_t tileX = tileRect.min.x; tileX <= tileRect.max.x; ++tileX) {
+					visitedTopEdges[tileY * mask->wordsPerRow + (tileX >> 6)] &= ~((uint64_t)1 << (tileX & 63));
+				}
+			}
+		}
+
+		inline uint32_t AllocateChainSegmentId(ContourMap *contourMap) {
+			uint32_t result;
+			if (contourMap->freeIds.size() > 0) {
+				result = contourMap->freeIds.back();
+				contourMap->freeIds.pop_back();
+			} else {
+				result = (uint32_t)contourMap->chainSegments.size();
+				contourMap->chainSegments.push_back(ChainSegment());
+				contourMap->chainBounds.push_back(Rect2i());
+			}
+			return(result);
+		}
+
+		namespace ContourStates {
+			enum ContourStateEnum {
+				Unaffected = 0,
+				Affected,
+				Matched,
+			};
+		};
+
+		struct ContourStart {
+			uint64_t key;
+			uint32_t id;
+
+			inline bool operator < (const ContourStart &other) const {
+				return key < other.key;
+			}
+		};
+
+		static void RetraceContourRegion(ContourMap *contourMap, const Rect2i &vertexRect, std::vector<uint8_t> &contourStates, ContourChanges *changes) {
+			const SolidMask *mask = &contourMap->mask;
+
+			// Top edges which are fully inside the vertex rectangle
+			Rect2i tileRect = MakeRect(vertexRect.min, V2i(vertexRect.max.x - 1, vertexRect.max.y));
+			tileRect = MakeRect(
+				V2i(tileRect.min.x > 0 ? tileRect.min.x : 0, tileRect.min.y > 0 ? tileRect.min.y : 0),
+				V2i(tileRect.max.x < (int32_t)mask->tileCount.w - 1 ? tileRect.max.x : (int32_t)mask->tileCount.w - 1, tileRect.max.y < (int32_t)mask->tileCount.h - 1 ? tileRect.max.y : (int32_t)mask->tileCount.h - 1));
+			if (tileRect.min.x > tileRect.max.x || tileRect.min.y > tileRect.max.y) {
+				return;
+			}
+
+			// Contours which are not affected keep their top edges, affected ones are matched by their start vertex.
+			// The start is the first top edge in scan order, so it stays the same when the contour is changed somewhere else.
+			ClearTopEdges(mask, contourMap->visitedTopEdges, tileRect);
+			std::vector<ContourStart> oldStarts;
+			for (uint32_t id = 0; id < contourMap->chainSegments.size(); ++id) {
+				const ChainSegment &chainSegment = contourMap->chainSegments[id];
+				if (chainSegment.vertices.size() > 0 && IsRectOverlap(contourMap->chainBounds[id], vertexRect)) {
+					if (contourStates[id] == ContourStates::Affected) {
+						ContourStart start;
+						start.key = ComputeTileHash(chainSegment.vertices[0].x, chainSegment.vertices[0].y);
+						start.id = id;
+						oldStarts.push_back(start);
+					} else {
+						MarkChainTopEdges(mask, contourMap->visitedTopEdges, chainSegment, tileRect);
+					}
+				}
+			}
+			std::sort(oldStarts.begin(), oldStarts.end());
+
+			Vec2i cursor = tileRect.min;
+			while (FindNextContourStart(mask, contourMap->visitedTopEdges, tileRect, &cursor)) {
+				TraceContour(mask, contourMap->visitedTopEdges, cursor, contourMap->corners);
+				ContourStart start;
+				start.key = ComputeTileHash(cursor.x, cursor.y);
+				std::vector<ContourStart>::iterator found = std::lower_bound(oldStarts.begin(), oldStarts.end(), start);
+				uint32_t id;
+				if (found != oldStarts.end() && found->key == start.key && contourStates[found->id] == ContourStates::Affected) {
+					id = found->id;
+					contourStates[id] = ContourStates::Matched;
+					changes->modifiedIds.push_back(id);
+				} else {
+					id = AllocateChainSegmentId(contourMap);
+					changes->addedIds.push_back(id);
+				}
+				contourMap->chainSegments[id].vertices.assign(contourMap->corners.begin(), contourMap->corners.end());
+				contourMap->chainBounds[id] = ComputeChainBounds(contourMap->corners);
+			}
+
+			// Affected contours without a match are gone, their ids are released after the update
+			for (size_t startIndex = 0; startIndex < oldStarts.size(); ++startIndex) {
+				uint32_t id = oldStarts[startIndex].id;
+				if (contourStates[id] == ContourStates::Affected) {
+					contourMap->chainSegments[id].vertices.clear();
+					changes->removedIds.push_back(id);
+				}
+				contourStates[id] = ContourStates::Unaffected;
+			}
+		}
+
+		//
+		// Chunked contour tracing
+		//
+		struct ContourRun {
+			Vec2i start;
+			uint32_t direction;
+		};
+
+		//! Part of a contour which is owned by a single chunk
+		struct ContourPiece {
+			uint64_t firstEdgeKey;
+			uint64_t nextEdgeKey;
+			uint32_t firstRun;
+			uint32_t runCount;
+		};
+
+		struct ContourChunk {
+			Rect2i tileRect;
+			std::vector<ContourRun> runs;
+			std::vector<ContourPiece> pieces;
+			//! Contours which are fully inside the chunk and need no stitching
+			std::vector<ChainSegment> loops;
+			std::vector<ContourStart> loopStarts;
+		};
+
+		struct ContourPieceRef {
+			uint64_t firstEdgeKey;
+			uint32_t chunkIndex;
+			uint32_t pieceIndex;
+
+			inline bool operator < (const ContourPieceRef &other) const {
+				return firstEdgeKey < other.firstEdgeKey;
+			}
+		};
+
+		struct ChunkedTraceState {
+			const SolidMask *mask;
+			std::vector<ContourChunk> *chunks;
+			//! Visited edges for each tile, one bit per side. Each edge is owned by the solid tile on its right, so chunks never write the same tile.
+			std::vector<uint8_t> *visitedSides;
+			//! Chunks are a multiple of 64 tiles wide, so they never share a word of the visited top edges
+			std::vector<uint64_t> *visitedTopEdges;
+#if !FTT_NO_THREADS
+			std::atomic<uint32_t> nextChunkIndex;
+#else
+			uint32_t nextChunkIndex;
+#endif
+		};
+
+		inline uint64_t ComputeContourEdgeKey(const Vec2u &tileCount, const Vec2i &vertex, uint32_t direction) {
+			uint64_t result = (uint64_t)ComputeLatticeIndex(tileCount, vertex.x, vertex.y) * TILETRACE_DIRECTION_COUNT + direction;
+			return(result);
+		}
+
+		static void AddContourLoop(const Vec2u &tileCount, std::vector<ContourRun> &loopRuns, std::vector<ChainSegment> *loops, std::vector<ContourStart> *loopStarts) {
+			if (loopRuns.size() > 1 && loopRuns.back().direction == loopRuns[0].direction) {
+				loopRuns[0].start = loopRuns.back().start;
+				loopRuns.pop_back();
+			}
+
+			// Start at the first top edge in scan order, the same corner TraceContours() starts at
+			size_t startRunIndex = loopRuns.size();
+			for (size_t runIndex = 0; runIndex < loopRuns.size(); ++runIndex) {
+				const ContourRun &run = loopRuns[runIndex];
+				if (run.direction == Directions::Right) {
+					if (startRunIndex == loopRuns.size() || run.start.y < loopRuns[startRunIndex].start.y || (run.start.y == loopRuns[startRunIndex].start.y && run.start.x < loopRuns[startRunIndex].start.x)) {
+						startRunIndex = runIndex;
+					}
+				}
+			}
+			assert(startRunIndex < loopRuns.size());
+
+			ContourStart loopStart;
+			loopStart.key = (uint64_t)ComputeTileIndex(tileCount, loopRuns[startRunIndex].start.x, loopRuns[startRunIndex].start.y);
+			loopStart.id = (uint32_t)loops->size();
+			loopStarts->push_back(loopStart);
+			loops->push_back(ChainSegment());
+			std::vector<Vec2i> &vertices = loops->back().vertices;
+			vertices.reserve(loopRuns.size() + 1);
+			for (size_t runIndex = 0; runIndex < loopRuns.size(); ++runIndex) {
+				vertices.push_back(loopRuns[(startRunIndex + runIndex) % loopRuns.size()].start);
+			}
+			vertices.push_back(vertices[0]);
+		}
+
+		static void TraceContourPieces(const SolidMask *mask, std::vector<uint8_t> &visitedSides, std::vector<uint64_t> &visitedTopEdges, int32_t tileX, int32_t tileY, std::vector<ContourRun> &loopRuns, ContourChunk *chunk) {
+			const Rect2i &tileRect = chunk->tileRect;
+			for (uint32_t side = 0; side < TILETRACE_DIRECTION_COUNT; ++side) {
+				// The side of a tile is the edge going in the same direction, which has this tile on the right
+				Vec2i vertex = V2i(tileX - CONTOUR_RIGHT_TILE_OFFSETS[side].x, tileY - CONTOUR_RIGHT_TILE_OFFSETS[side].y);
+				if (((visitedSides[ComputeTileIndex(mask->tileCount, tileX, tileY)] >> side) & 1) || !IsContourEdge(mask, vertex, side)) {
+					continue;
+				}
+
+				// Walk until the next edge is owned by another chunk or was walked already, which is always the first edge of another piece
+				ContourPiece piece = {};
+				piece.firstEdgeKey = ComputeContourEdgeKey(mask->tileCount, vertex, side);
+				piece.firstRun = (uint32_t)chunk->runs.size();
+				uint32_t direction = side;
+				for (;;) {
+					Vec2i owner = V2i(vertex.x + CONTOUR_RIGHT_TILE_OFFSETS[direction].x, vertex.y + CONTOUR_RIGHT_TILE_OFFSETS[direction].y);
+					visitedSides[ComputeTileIndex(mask->tileCount, owner.x, owner.y)] |= (uint8_t)(1 << direction);
+					if (direction == Directions::Right) {
+						visitedTopEdges[vertex.y * mask->wordsPerRow + (vertex.x >> 6)] |= (uint64_t)1 << (vertex.x & 63);
+					}
+					if (piece.runCount == 0 || chunk->runs.back().direction != direction) {
+						ContourRun run;
+						run.start = vertex;
+						run.direction = direction;
+						chunk->runs.push_back(run);
+						++piece.runCount;
+					}
+					vertex = V2i(vertex.x + TILETRACE_DIRECTIONS[direction].x, vertex.y + TILETRACE_DIRECTIONS[direction].y);
+					direction = GetNextContourDirection(mask, vertex, direction);
+					Vec2i nextOwner = V2i(vertex.x + CONTOUR_RIGHT_TILE_OFFSETS[direction].x, vertex.y + CONTOUR_RIGHT_TILE_OFFSETS[direction].y);
+					if ((nextOwner.x < tileRect.min.x || nextOwner.x > tileRect.max.x || nextOwner.y < tileRect.min.y || nextOwner.y > tileRect.max.y) ||
+						((visitedSides[ComputeTileIndex(mask->tileCount, nextOwner.x, nextOwner.y)] >> direction) & 1)) {
+						break;
+					}
+				}
+				piece.nextEdgeKey = ComputeContourEdgeKey(mask->tileCount, vertex, direction);
+				if (piece.nextEdgeKey == piece.firstEdgeKey) {
+					loopRuns.assign(chunk->runs.begin() + piece.firstRun, chunk->runs.end());
+					chunk->runs.resize(piece.firstRun);
+					AddContourLoop(mask->tileCount, loopRuns, &chunk->loops, &chunk->loopStarts);
+				} else {
+					chunk->pieces.push_back(piece);
+				}
+			}
+		}
+
+		static void TraceContourChunk(const SolidMask *mask, std::vector<uint8_t> &visitedSides, std::vector<uint64_t> &visitedTopEdges, ContourChunk *chunk) {
+			// Contours can only leave the chunk through a border tile, so walking all edges of the border tiles covers every contour crossing a seam
+			const Rect2i &tileRect = chunk->tileRect;
+			std::vector<ContourRun> loopRuns;
+			for (int32_t tileY = tileRect.min.y; tileY <= tileRect.max.y; ++tileY) {
+				int32_t stepX = (tileY == tileRect.min.y || tileY == tileRect.max.y) ? 1 : tileRect.max.x - tileRect.min.x;
+				for (int32_t tileX = tileRect.min.x; tileX <= tileRect.max.x; tileX += stepX > 0 ? stepX : 1) {
+					if (IsMaskSolid(mask, tileX, tileY)) {
+						TraceContourPieces(mask, visitedSides, visitedTopEdges, tileX, tileY, loopRuns, chunk);
+					}
+				}
+			}
+
+			// All remaining contours are fully inside the chunk
+			std::vector<Vec2i> corners;
+			Vec2i cursor = tileRect.min;
+			while (FindNextContourStart(mask, visitedTopEdges, tileRect, &cursor)) {
+				TraceContour(mask, visitedTopEdges, cursor, corners);
+				ContourStart loopStart;
+				loopStart.key = (uint64_t)ComputeTileIndex(mask->tileCount, cursor.x, cursor.y);
+				loopStart.id = (uint32_t)chunk->loops.size();
+				chunk->loopStarts.push_back(loopStart);
+				chunk->loops.push_back(ChainSegment());
+				chunk->loops.back().vertices.assign(corners.begin(), corners.end());
+			}
+		}
+
+		static void TraceContourChunks(ChunkedTraceState *state) {
+			for (;;) {
+				uint32_t chunkIndex = state->nextChunkIndex++;
+				if (chunkIndex >= state->chunks->size()) {
+					break;
+				}
+				TraceContourChunk(state->mask, *state->visitedSides, *state->visitedTopEdges, &(*state->chunks)[chunkIndex]);
+			}
+		}
+
+		static void StitchContourChunks(const Vec2u &tileCount, std::vector<ContourChunk> &chunks, std::vector<ChainSegment> *outChainSegments) {
+			std::vector<ContourPieceRef> pieceRefs;
+			for (uint32_t chunkIndex = 0; chunkIndex < chunks.size(); ++chunkIndex) {
+				for (uint32_t pieceIndex = 0; pieceIndex < chunks[chunkIndex].pieces.size(); ++pieceIndex) {
+					ContourPieceRef pieceRef;
+					pieceRef.firstEdgeKey = chunks[chunkIndex].pieces[pieceIndex].firstEdgeKey;
+					pieceRef.chunkIndex = chunkIndex;
+					pieceRef.pieceIndex = pieceIndex;
+					pieceRefs.push_back(pieceRef);
+				}
+			}
+			std::sort(pieceRefs.begin(), pieceRefs.end());
+
+			// Every piece continues with exactly one other piece, so they form closed cycles across the seams
+			std::vector<uint8_t> isPieceVisited(pieceRefs.size(), 0);
+			std::vector<ContourRun> loopRuns;
+			std::vector<ChainSegment> seamLoops;
+			std::vector<ContourStart> seamLoopStarts;
+			for (size_t firstRefIndex = 0; firstRefIndex < pieceRefs.size(); ++firstRefIndex) {
+				if (isPieceVisited[firstRefIndex]) {
+					continue;
+				}
+				loopRuns.clear();
+				size_t refIndex = firstRefIndex;
+				do {
+					isPieceVisited[refIndex] = 1;
+					const ContourChunk &chunk = chunks[pieceRefs[refIndex].chunkIndex];
+					const ContourPiece &piece = chunk.pieces[pieceRefs[refIndex].pieceIndex];
+					for (uint32_t runIndex = 0; runIndex < piece.runCount; ++runIndex) {
+						const ContourRun &run = chunk.runs[piece.firstRun + runIndex];
+						if (loopRuns.size() == 0 || loopRuns.back().direction != run.direction) {
+							loopRuns.push_back(run);
+						}
+					}
+					ContourPieceRef nextRef;
+					nextRef.firstEdgeKey = piece.nextEdgeKey;
+					std::vector<ContourPieceRef>::const_iterator found = std::lower_bound(pieceRefs.begin(), pieceRefs.end(), nextRef);
+					assert(found != pieceRefs.end() && found->firstEdgeKey == piece.nextEdgeKey);
+					refIndex = (size_t)(found - pieceRefs.begin());
+				} while (refIndex != firstRefIndex);
+				AddContourLoop(tileCount, loopRuns, &seamLoops, &seamLoopStarts);
+			}
+
+			// Same order as TraceContours(), by the start in scan order
+			std::vector<ChainSegment *> loops;
+			std::vector<ContourStart> loopStarts;
+			for (size_t chunkIndex = 0; chunkIndex <= chunks.size(); ++chunkIndex) {
+				std::vector<ChainSegment> &sourceLoops = chunkIndex < chunks.size() ? chunks[chunkIndex].loops : seamLoops;
+				std::vector<ContourStart> &sourceStarts = chunkIndex < chunks.size() ? chunks[chunkIndex].loopStarts : seamLoopStarts;
+				for (size_t loopIndex = 0; loopIndex < sourceStarts.size(); ++loopIndex) {
+					ContourStart loopStart = sourceStarts[loopIndex];
+					loops.push_back(&sourceLoops[loopStart.id]);
+					loopStart.id = (uint32_t)(loops.size() - 1);
+					loopStarts.push_back(loopStart);
+				}
+			}
+			std::sort(loopStarts.begin(), loopStarts.end());
+			outChainSegments->resize(loopStarts.size());
+			for (size_t loopIndex = 0; loopIndex < loopStarts.size(); ++loopIndex) {
+				(*outChainSegments)[loopIndex].vertices.swap(loops[loopStarts[loopIndex].id]->vertices);
+			}
+		}
+
+		//
+		// Tile shapes and layers
+		//
+		struct TileShapeTemplate {
+			Vec2i verts[4];
+			uint32_t count;
+		};
+
+		inline TileShapeTemplate MakeTileShapeTemplate(const Vec2i &v0, const Vec2i &v1, const Vec2i &v2, const Vec2i &v3, uint32_t count) {
+			TileShapeTemplate result = { { v0, v1, v2, v3 }, count };
+			return(result);
+		}
+
+		// Same winding as tile edges, so the solid side is always on the right. Units are TILE_SHAPE_RESOLUTION steps.
+		static const TileShapeTemplate TILE_SHAPE_TEMPLATES[TileShapes::Count] = {
+			MakeTileShapeTemplate(V2i(0, 0), V2i(0, 0), V2i(0, 0), V2i(0, 0), 0), // Empty
+			MakeTileShapeTemplate(V2i(0, 2), V2i(0, 0), V2i(2, 0), V2i(2, 2), 4), // Block
+			MakeTileShapeTemplate(V2i(0, 2), V2i(0, 1), V2i(2, 1), V2i(2, 2), 4), // HalfBottom
+			MakeTileShapeTemplate(V2i(0, 1), V2i(0, 0), V2i(2, 0), V2i(2, 1), 4), // HalfTop
+			MakeTileShapeTemplate(V2i(0, 2), V2i(0, 0), V2i(1, 0), V2i(1, 2), 4), // HalfLeft
+			MakeTileShapeTemplate(V2i(1, 2), V2i(1, 0), V2i(2, 0), V2i(2, 2), 4), // HalfRight
+			MakeTileShapeTemplate(V2i(0, 2), V2i(2, 0), V2i(2, 2), V2i(0, 0), 3), // SlopeUpRight
+			MakeTileShapeTemplate(V2i(0, 2), V2i(0, 0), V2i(2, 2), V2i(0, 0), 3), // SlopeUpLeft
+			MakeTileShapeTemplate(V2i(0, 0), V2i(2, 0), V2i(2, 2), V2i(0, 0), 3), // CeilingDownRight
+			MakeTileShapeTemplate(V2i(0, 2), V2i(0, 0), V2i(2, 0), V2i(0, 0), 3), // CeilingDownLeft
+			MakeTileShapeTemplate(V2i(0, 2), V2i(2, 1), V2i(2, 2), V2i(0, 0), 3), // SlopeUpRightLow
+			MakeTileShapeTemplate(V2i(0, 2), V2i(0, 1), V2i(2, 0), V2i(2, 2), 4), // SlopeUpRightHigh
+			MakeTileShapeTemplate(V2i(0, 2), V2i(0, 1), V2i(2, 2), V2i(0, 0), 3), // SlopeUpLeftLow
+			MakeTileShapeTemplate(V2i(0, 2), V2i(0, 0), V2i(2, 1), V2i(2, 2), 4), // SlopeUpLeftHigh
+		};
+
+		// Smallest steps of all shape edges, sorted clockwise. The opposite of a direction is always half the count ahead.
+		static const Vec2i SHAPE_EDGE_DIRECTIONS[] = {
+			V2i(1, 0), V2i(2, 1), V2i(1, 1), V2i(0, 1), V2i(-1, 1), V2i(-2, 1),
+			V2i(-1, 0), V2i(-2, -1), V2i(-1, -1), V2i(0, -1), V2i(1, -1), V2i(2, -1),
+		};
+		static const uint32_t SHAPE_EDGE_DIRECTION_COUNT = 12;
+
+		//! Edge of a tile shape, split into steps, so edges on tile borders always match the edges of the neighbor
+		struct ShapeEdge {
+			Vec2i start;
+			uint32_t direction;
+			uint32_t stepCount;
+		};
+
+		struct ShapeEdges {
+			ShapeEdge edges[4];
+			uint32_t count;
+		};
+
+		static ShapeEdges CreateShapeEdges(const TileShapeTemplate &shapeTemplate) {
+			ShapeEdges result = {};
+			for (uint32_t vertIndex = 0; vertIndex < shapeTemplate.count; ++vertIndex) {
+				const Vec2i &v0 = shapeTemplate.verts[vertIndex];
+				const Vec2i &v1 = shapeTemplate.verts[(vertIndex + 1) % shapeTemplate.count];
+				Vec2i delta = Subtract(v1, v0);
+				for (uint32_t direction = 0; direction < SHAPE_EDGE_DIRECTION_COUNT; ++direction) {
+					const Vec2i &step = SHAPE_EDGE_DIRECTIONS[direction];
+					int32_t stepCount = step.x != 0 ? delta.x / step.x : delta.y / step.y;
+					if (stepCount > 0 && delta.x == step.x * stepCount && delta.y == step.y * stepCount) {
+						ShapeEdge edge = { v0, direction, (uint32_t)stepCount };
+						result.edges[result.count++] = edge;
+						break;
+					}
+				}
+			}
+			assert(result.count == shapeTemplate.count);
+			return(result);
+		}
+
+		inline uint64_t MakeShapeEdgeKey(uint32_t latticeIndex, uint32_t direction) {
+			uint64_t result = (uint64_t)latticeIndex * SHAPE_EDGE_DIRECTION_COUNT + direction;
+			return(result);
+		}
+
+		inline uint32_t GetShapeEdgeEnd(const Vec2u &latticeCount, uint64_t edgeKey) {
+			const Vec2i &step = SHAPE_EDGE_DIRECTIONS[edgeKey % SHAPE_EDGE_DIRECTION_COUNT];
+			uint32_t result = (uint32_t)((int64_t)(edgeKey / SHAPE_EDGE_DIRECTION_COUNT) + step.y * (int64_t)latticeCount.w + step.x);
+			return(result);
+		}
+
+		//! Edge steps of a layer, grouped by their start lattice point
+		struct ShapeLayerEdges {
+			//! Edges as lattice index * SHAPE_EDGE_DIRECTION_COUNT + direction, sorted
+			std::vector<uint64_t> keys;
+			//! First edge of each lattice point, the last entry is the edge count
+			std::vector<uint32_t> firstEdges;
+		};
+
+		static void SortShapeEdges(const Vec2u &latticeCount, const std::vector<uint64_t> &keys, ShapeLayerEdges *outEdges) {
+			// Counting sort by the lattice point, the few edges of each point are then sorted by direction
+			uint32_t latticePointCount = latticeCount.w * latticeCount.h;
+			outEdges->firstEdges.assign(latticePointCount + 1, 0);
+			for (size_t keyIndex = 0; keyIndex < keys.size(); ++keyIndex) {
+				++outEdges->firstEdges[(uint32_t)(keys[keyIndex] / SHAPE_EDGE_DIRECTION_COUNT) + 1];
+			}
+			for (uint32_t latticeIndex = 0; latticeIndex < latticePointCount; ++latticeIndex) {
+				outEdges->firstEdges[latticeIndex + 1] += outEdges->firstEdges[latticeIndex];
+			}
+			outEdges->keys.resize(keys.size());
+			std::vector<uint32_t> writeIndices(outEdges->firstEdges.begin(), outEdges->firstEdges.end() - 1);
+			for (size_t keyIndex = 0; keyIndex < keys.size(); ++keyIndex) {
+				uint32_t latticeIndex = (uint32_t)(keys[keyIndex] / SHAPE_EDGE_DIRECTION_COUNT);
+				outEdges->keys[writeIndices[latticeIndex]++] = keys[keyIndex];
+			}
+			for (uint32_t latticeIndex = 0; latticeIndex < latticePointCount; ++latticeIndex) {
+				uint32_t firstEdge = outEdges->firstEdges[latticeIndex];
+				uint32_t lastEdge = outEdges->firstEdges[latticeIndex + 1];
+				if (lastEdge - firstEdge > 1) {
+					std::sort(outEdges->keys.begin() + firstEdge, outEdges->keys.begin() + lastEdge);
+				}
+			}
+		}
+
+		static uint32_t FindShapeEdge(const ShapeLayerEdges &edges, uint64_t edgeKey) {
+			uint32_t latticeIndex = (uint32_t)(edgeKey / SHAPE_EDGE_DIRECTION_COUNT);
+			for (uint32_t edgeIndex = edges.firstEdges[latticeIndex]; edgeIndex < edges.firstEdges[latticeIndex + 1]; ++edgeIndex) {
+				if (edges.keys[edgeIndex] == edgeKey) {
+					return edgeIndex;
+				}
+			}
+			return INVALID_INDEX;
+		}
+
+		static uint32_t FindNextShapeEdge(const ShapeLayerEdges &edges, const std::vector<uint8_t> &isRemoved, uint32_t latticeIndex, uint32_t direction) {
+			// Take the sharpest right turn, same as the block tile contours, so shapes touching in a single point are separate chain segments
+			uint32_t result = INVALID_INDEX;
+			uint32_t bestTurn = 0;
+			for (uint32_t edgeIndex = edges.firstEdges[latticeIndex]; edgeIndex < edges.firstEdges[latticeIndex + 1]; ++edgeIndex) {
+				if (isRemoved[edgeIndex]) {
+					continue;
+				}
+				uint32_t nextDirection = (uint32_t)(edges.keys[edgeIndex] % SHAPE_EDGE_DIRECTION_COUNT);
+				uint32_t turn = (nextDirection + SHAPE_EDGE_DIRECTION_COUNT * 3 / 2 - direction) % SHAPE_EDGE_DIRECTION_COUNT;
+				if (result == INVALID_INDEX || turn > bestTurn) {
+					result = edgeIndex;
+					bestTurn = turn;
+				}
+			}
+			return(result);
+		}
+
+		static void TraceShapeLayer(const Vec2u &latticeCount, const std::vector<uint64_t> &keys, ShapeLayerEdges *edges, std::vector<ChainSegment> *outChainSegments) {
+			SortShapeEdges(latticeCount, keys, edges);
+
+			// Edges shared by two shapes of the same layer are inside the layer and removed on both sides
+			std::vector<uint8_t> isRemoved(edges->keys.size(), 0);
+			for (size_t edgeIndex = 0; edgeIndex < edges->keys.size(); ++edgeIndex) {
+				uint32_t direction = (uint32_t)(edges->keys[edgeIndex] % SHAPE_EDGE_DIRECTION_COUNT);
+				uint64_t overlapEdgeKey = MakeShapeEdgeKey(GetShapeEdgeEnd(latticeCount, edges->keys[edgeIndex]), (direction + SHAPE_EDGE_DIRECTION_COUNT / 2) % SHAPE_EDGE_DIRECTION_COUNT);
+				if (FindShapeEdge(*edges, overlapEdgeKey) != INVALID_INDEX) {
+					isRemoved[edgeIndex] = 1;
+				}
+			}
+
+			// Walk each contour once and merge steps with the same direction. Removed edges are marked as visited.
+			std::vector<uint8_t> isVisited(isRemoved);
+			std::vector<ContourRun> loopRuns;
+			for (size_t startIndex = 0; startIndex < edges->keys.size(); ++startIndex) {
+				if (isVisited[startIndex]) {
+					continue;
+				}
+				loopRuns.clear();
+				uint32_t edgeIndex = (uint32_t)startIndex;
+				do {
+					assert(!isVisited[edgeIndex]);
+					isVisited[edgeIndex] = 1;
+					uint64_t edgeKey = edges->keys[edgeIndex];
+					uint32_t latticeIndex = (uint32_t)(edgeKey / SHAPE_EDGE_DIRECTION_COUNT);
+					uint32_t direction = (uint32_t)(edgeKey % SHAPE_EDGE_DIRECTION_COUNT);
+					if (loopRuns.size() == 0 || loopRuns.back().direction != direction) {
+						ContourRun run;
+						run.start = V2i((int32_t)(latticeIndex % latticeCount.w), (int32_t)(latticeIndex / latticeCount.w));
+						run.direction = direction;
+						loopRuns.push_back(run);
+					}
+					edgeIndex = FindNextShapeEdge(*edges, isRemoved, GetShapeEdgeEnd(latticeCount, edgeKey), direction);
+					assert(edgeIndex != INVALID_INDEX);
+				} while (edgeIndex != startIndex);
+				if (loopRuns.size() > 1 && loopRuns.back().direction == loopRuns[0].direction) {
+					loopRuns[0].start = loopRuns.back().start;
+					loopRuns.pop_back();
+				}
+
+				outChainSegments->push_back(ChainSegment());
+				std::vector<Vec2i> &vertices = outChainSegments->back().vertices;
+				vertices.reserve(loopRuns.size() + 1);
+				for (size_t runIndex = 0; runIndex < loopRuns.size(); ++runIndex) {
+					vertices.push_back(loopRuns[runIndex].start);
+				}
+				// Add the first vertex to the end again, because we have a fully closed chain
+				vertices.push_back(vertices[0]);
+			}
+		}
+
+		//
+		// Chain simplification (Douglas-Peucker)
+		//
+		struct SimplifyScratch {
+			std::vector<uint8_t> isKept;
+			std::vector<uint32_t> ranges;
+		};
+
+		inline double GetSegmentDistanceSquared(const Vec2i &point, const Vec2i &a, const Vec2i &b) {
+			double abX = (double)(b.x - a.x);
+			double abY = (double)(b.y - a.y);
+			double apX = (double)(point.x - a.x);
+			double apY = (double)(point.y - a.y);
+			double lengthSquared = abX * abX + abY * abY;
+			double t = lengthSquared > 0.0 ? (apX * abX + apY * abY) / lengthSquared : 0.0;
+			t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+			double dX = apX - t * abX;
+			double dY = apY - t * abY;
+			double result = dX * dX + dY * dY;
+			return(result);
+		}
+
+		static uint32_t FindFarthestVertex(const Vec2i *vertices, uint32_t firstIndex, uint32_t lastIndex, const std::vector<uint8_t> &isKept, double *outDistanceSquared) {
+			uint32_t result = firstIndex;
+			*outDistanceSquared = -1.0;
+			for (uint32_t vertexIndex = firstIndex + 1; vertexIndex < lastIndex; ++vertexIndex) {
+				double distanceSquared = GetSegmentDistanceSquared(vertices[vertexIndex], vertices[firstIndex], vertices[lastIndex]);
+				if (!isKept[vertexIndex] && distanceSquared > *outDistanceSquared) {
+					*outDistanceSquared = distanceSquared;
+					result = vertexIndex;
+				}
+			}
+			return(result);
+		}
+
+		static void SimplifyRanges(const Vec2i *vertices, double toleranceSquared, SimplifyScratch *scratch) {
+			// Keep the farthest vertex of each range when it is outside the tolerance and split the range there, without recursion
+			std::vector<uint32_t> &ranges = scratch->ranges;
+			while (ranges.size() > 0) {
+				uint32_t lastIndex = ranges.back();
+				ranges.pop_back();
+				uint32_t firstIndex = ranges.back();
+				ranges.pop_back();
+				if (lastIndex - firstIndex < 2) {
+					continue;
+				}
+				double distanceSquared;
+				uint32_t farthestIndex = FindFarthestVertex(vertices, firstIndex, lastIndex, scratch->isKept, &distanceSquared);
+				if (distanceSquared > toleranceSquared) {
+					scratch->isKept[farthestIndex] = 1;
+					ranges.push_back(firstIndex);
+					ranges.push_back(farthestIndex);
+					ranges.push_back(farthestIndex);
+					ranges.push_back(lastIndex);
+				}
+			}
+		}
+
+		static uint32_t SimplifyVertices(Vec2i *vertices, uint32_t vertexCount, float tolerance, SimplifyScratch *scratch) {
+			// Closed chains repeat the first vertex at the end and need at least a triangle to stay closed
+			bool isClosed = vertexCount > 1 && IsEqual(vertices[0], vertices[vertexCount - 1]);
+			if (vertexCount < (isClosed ? 5u : 3u)) {
+				return vertexCount;
+			}
+
+			std::vector<uint8_t> &isKept = scratch->isKept;
+			std::vector<uint32_t> &ranges = scratch->ranges;
+			isKept.assign(vertexCount, 0);
+			ranges.clear();
+			isKept[0] = 1;
+			isKept[vertexCount - 1] = 1;
+			uint32_t splitIndex = 0;
+			if (isClosed) {
+				// Split the loop at the vertex farthest from the first one, so no range starts and ends at the same point
+				double maxDistanceSquared = 0.0;
+				for (uint32_t vertexIndex = 1; vertexIndex < vertexCount - 1; ++vertexIndex) {
+					double distanceSquared = GetSegmentDistanceSquared(vertices[vertexIndex], vertices[0], vertices[0]);
+					if (distanceSquared > maxDistanceSquared) {
+						maxDistanceSquared = distanceSquared;
+						splitIndex = vertexIndex;
+					}
+				}
+				assert(splitIndex > 0);
+				isKept[splitIndex] = 1;
+				ranges.push_back(0);
+				ranges.push_back(splitIndex);
+				ranges.push_back(splitIndex);
+				ranges.push_back(vertexCount - 1);
+			} else {
+				ranges.push_back(0);
+				ranges.push_back(vertexCount - 1);
+			}
+
+			double toleranceSquared = (double)tolerance * (double)tolerance;
+			SimplifyRanges(vertices, toleranceSquared, scratch);
+
+			if (isClosed) {
+				// A closed chain must not collapse into a line, so keep the vertex farthest from the split line and simplify both sides of it again
+				uint32_t keptCount = 0;
+				for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+					keptCount += isKept[vertexIndex];
+				}
+				if (keptCount < 4) {
+					double firstDistanceSquared, lastDistanceSquared;
+					uint32_t firstFarthestIndex = FindFarthestVertex(vertices, 0, splitIndex, isKept, &firstDistanceSquared);
+					uint32_t lastFarthestIndex = FindFarthestVertex(vertices, splitIndex, vertexCount - 1, isKept, &lastDistanceSquared);
+					bool isFirstSide = firstDistanceSquared > lastDistanceSquared;
+					uint32_t farthestIndex = isFirstSide ? firstFarthestIndex : lastFarthestIndex;
+					isKept[farthestIndex] = 1;
+					ranges.push_back(isFirstSide ? 0 : splitIndex);
+					ranges.push_back(farthestIndex);
+					ranges.push_back(farthestIndex);
+					ranges.push_back(isFirstSide ? splitIndex : vertexCount - 1);
+					SimplifyRanges(vertices, toleranceSquared, scratch);
+				}
+			}
+
+			// Compact the kept vertices in place
+			uint32_t result = 0;
+			for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+				if (isKept[vertexIndex]) {
+					vertices[result++] = vertices[vertexIndex];
+				}
+			}
+			return(result);
+		}
+
+		//
+		// Triangulation (Monotone partition)
+		//
+		// With the y axis going down, the solid area is on the right side of the chain segments as seen on screen,
+		// which is the left side in the math convention of "Computational Geometry" by de Berg et al.
+		// So "above" and "left turn" are used in that convention and the sweep line goes from max y to min y.
+		//
+		struct PolygonVertex {
+			Vec2i position;
+			uint32_t prev;
+			uint32_t next;
+		};
+
+		namespace PolygonVertexTypes {
+			enum PolygonVertexTypeEnum {
+				Start = 0,
+				End,
+				Split,
+				Merge,
+				Regular,
+			};
+		};
+
+		//! Returns the cross product of (b - a) and (c - a), which is positive for a left turn a -> b -> c
+		inline int64_t GetTurn(const Vec2i &a, const Vec2i &b, const Vec2i &c) {
+			int64_t result = (int64_t)(b.x - a.x) * (int64_t)(c.y - a.y) - (int64_t)(b.y - a.y) * (int64_t)(c.x - a.x);
+			return(result);
+		}
+
+		inline bool IsAbove(const Vec2i &a, const Vec2i &b) {
+			bool result = (a.y > b.y) || ((a.y == b.y) && (a.x < b.x));
+			return(result);
+		}
+
+		//! Sweep order of two vertices, vertices at the same position (diagonal touching contours) are ordered by index
+		inline bool IsSweptBefore(const std::vector<PolygonVertex> &vertices, uint32_t a, uint32_t b) {
+			const Vec2i &positionA = vertices[a].position;
+			const Vec2i &positionB = vertices[b].position;
+			bool result = IsAbove(positionA, positionB) || (IsEqual(positionA, positionB) && a < b);
+			return(result);
+		}
+
+		//! Status of the sweep line, the edge index is the index of its first vertex
+		struct MonotoneSweep {
+			const std::vector<PolygonVertex> *vertices;
+			Vec2i sweepPoint;
+		};
+
+		//! Edge index which stands for the current sweep point in the status queries
+		static const uint32_t SWEEP_POINT_EDGE = INVALID_INDEX;
+
+		struct SweepEdgeCompare {
+			const MonotoneSweep *sweep;
+
+			explicit SweepEdgeCompare(const MonotoneSweep *sweep) : sweep(sweep) {}
+
+			inline void GetEdgePoints(uint32_t edgeIndex, Vec2i *outUpper, Vec2i *outLower) const {
+				const std::vector<PolygonVertex> &vertices = *sweep->vertices;
+				const Vec2i &first = vertices[edgeIndex].position;
+				const Vec2i &second = vertices[vertices[edgeIndex].next].position;
+				bool isFirstUpper = IsAbove(first, second);
+				*outUpper = isFirstUpper ? first : second;
+				*outLower = isFirstUpper ? second : first;
+			}
+
+			//! Exact x position of the edge at the sweep line as a fraction with a positive denominator
+			inline void GetSweepX(uint32_t edgeIndex, int64_t *outNumerator, int64_t *outDenominator) const {
+				const Vec2i &point = sweep->sweepPoint;
+				if (edgeIndex == SWEEP_POINT_EDGE) {
+					*outNumerator = point.x;
+					*outDenominator = 1;
+					return;
+				}
+				Vec2i upper, lower;
+				GetEdgePoints(edgeIndex, &upper, &lower);
+				if (upper.y == lower.y) {
+					// Horizontal edges are in the status only while the sweep point is one of their end points
+					*outNumerator = point.x < upper.x ? upper.x : (point.x > lower.x ? lower.x : point.x);
+					*outDenominator = 1;
+				} else {
+					int64_t height = (int64_t)upper.y - (int64_t)lower.y;
+					*outNumerator = (int64_t)upper.x * height + ((int64_t)upper.y - (int64_t)point.y) * ((int64_t)lower.x - (int64_t)upper.x);
+					*outDenominator = height;
+				}
+			}
+
+			bool operator()(uint32_t a, uint32_t b) const {
+				int64_t numeratorA, denominatorA, numeratorB, denominatorB;
+				GetSweepX(a, &numeratorA, &denominatorA);
+				GetSweepX(b, &numeratorB, &denominatorB);
+				int64_t left = numeratorA * denominatorB;
+				int64_t right = numeratorB * denominatorA;
+				if (left != right || a == SWEEP_POINT_EDGE || b == SWEEP_POINT_EDGE) {
+					return left < right;
+				}
+
+				// Both edges meet at the sweep line, so they are ordered by their direction away from the meeting point.
+				// Edges ending there are compared just above the sweep line, edges starting there just below.
+				Vec2i upperA, lowerA, upperB, lowerB;
+				GetEdgePoints(a, &upperA, &lowerA);
+				GetEdgePoints(b, &upperB, &lowerB);
+				const Vec2i &point = sweep->sweepPoint;
+				bool isBelowA = !(lowerA.y == point.y && lowerA.x <= point.x);
+				bool isBelowB = !(lowerB.y == point.y && lowerB.x <= point.x);
+				if (isBelowA != isBelowB) {
+					return !isBelowA;
+				}
+				Vec2i directionA = isBelowA ? V2i(lowerA.x - upperA.x, lowerA.y - upperA.y) : V2i(upperA.x - lowerA.x, upperA.y - lowerA.y);
+				Vec2i directionB = isBelowB ? V2i(lowerB.x - upperB.x, lowerB.y - upperB.y) : V2i(upperB.x - lowerB.x, upperB.y - lowerB.y);
+				int64_t turn = GetTurn(V2i(0, 0), directionA, directionB);
+				return isBelowA ? (turn > 0) : (turn < 0);
+			}
+		};
+
+		static void AddPolygonLoops(const std::vector<ChainSegment> &chainSegments, std::vector<PolygonVertex> *outVertices) {
+			for (size_t segmentIndex = 0; segmentIndex < chainSegments.size(); ++segmentIndex) {
+				const std::vector<Vec2i> &chainVertices = chainSegments[segmentIndex].vertices;
+				assert(chainVertices.size() == 0 || IsEqual(chainVertices[0], chainVertices.back()));
+				if (chainVertices.size() < 4) {
+					continue;
+				}
+				uint32_t firstIndex = (uint32_t)outVertices->size();
+				uint32_t loopCount = (uint32_t)chainVertices.size() - 1;
+				for (uint32_t vertexIndex = 0; vertexIndex < loopCount; ++vertexIndex) {
+					PolygonVertex vertex;
+					vertex.position = chainVertices[vertexIndex];
+					vertex.prev = firstIndex + (vertexIndex + loopCount - 1) % loopCount;
+					vertex.next = firstIndex + (vertexIndex + 1) % loopCount;
+					outVertices->push_back(vertex);
+				}
+			}
+		}
+
+		static PolygonVertexTypes::PolygonVertexTypeEnum GetPolygonVertexType(const std::vector<PolygonVertex> &vertices, uint32_t vertexIndex) {
+			const PolygonVertex &vertex = vertices[vertexIndex];
+			const Vec2i &prev = vertices[vertex.prev].position;
+			const Vec2i &next = vertices[vertex.next].position;
+			bool isPrevBelow = IsAbove(vertex.position, prev);
+			bool isNextBelow = IsAbove(vertex.position, next);
+			if (isPrevBelow != isNextBelow) {
+				return PolygonVertexTypes::Regular;
+			}
+			bool isConvex = GetTurn(prev, vertex.position, next) > 0;
+			if (isPrevBelow) {
+				return isConvex ? PolygonVertexTypes::Start : PolygonVertexTypes::Split;
+			} else {
+				return isConvex ? PolygonVertexTypes::End : PolygonVertexTypes::Merge;
+			}
+		}
+
+		//! Adds diagonals which split the polygons into y-monotone pieces, as vertex index pairs
+		static void AddMonotoneDiagonals(const std::vector<PolygonVertex> &vertices, std::vector<uint32_t> *outDiagonals) {
+			typedef std::set<uint32_t, SweepEdgeCompare> SweepStatus;
+
+			uint32_t vertexCount = (uint32_t)vertices.size();
+			std::vector<uint32_t> sweepOrder(vertexCount);
+			std::vector<uint8_t> vertexTypes(vertexCount);
+			for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+				sweepOrder[vertexIndex] = vertexIndex;
+				vertexTypes[vertexIndex] = (uint8_t)GetPolygonVertexType(vertices, vertexIndex);
+			}
+			std::sort(sweepOrder.begin(), sweepOrder.end(), [&vertices](uint32_t a, uint32_t b) { return IsSweptBefore(vertices, a, b); });
+
+			// Only edges with the solid area on their right side are in the status, each one with the last vertex (helper) left of the area below it
+			MonotoneSweep sweep;
+			sweep.vertices = &vertices;
+			SweepStatus status = SweepStatus(SweepEdgeCompare(&sweep));
+			std::vector<SweepStatus::iterator> statusEdges(vertexCount, status.end());
+			std::vector<uint32_t> helpers(vertexCount, INVALID_INDEX);
+
+			for (uint32_t orderIndex = 0; orderIndex < vertexCount; ++orderIndex) {
+				uint32_t vertexIndex = sweepOrder[orderIndex];
+				const PolygonVertex &vertex = vertices[vertexIndex];
+				sweep.sweepPoint = vertex.position;
+				uint8_t vertexType = vertexTypes[vertexIndex];
+
+				// Finish the edge ending in this vertex
+				bool isPrevEdgeEnding = vertexType == PolygonVertexTypes::End || vertexType == PolygonVertexTypes::Merge || (vertexType == PolygonVertexTypes::Regular && IsAbove(vertices[vertex.prev].position, vertex.position));
+				if (isPrevEdgeEnding) {
+					uint32_t prevEdge = vertex.prev;
+					assert(statusEdges[prevEdge] != status.end());
+					if (vertexTypes[helpers[prevEdge]] == PolygonVertexTypes::Merge) {
+						outDiagonals->push_back(vertexIndex);
+						outDiagonals->push_back(helpers[prevEdge]);
+					}
+					status.erase(statusEdges[prevEdge]);
+					statusEdges[prevEdge] = status.end();
+				}
+
+				// Connect to the edge left of this vertex
+				bool isLeftEdgeHelped = vertexType == PolygonVertexTypes::Split || vertexType == PolygonVertexTypes::Merge || (vertexType == PolygonVertexTypes::Regular && !isPrevEdgeEnding);
+				if (isLeftEdgeHelped) {
+					SweepStatus::iterator leftEdge = status.lower_bound(SWEEP_POINT_EDGE);
+					assert(leftEdge != status.begin());
+					--leftEdge;
+					uint32_t leftHelper = helpers[*leftEdge];
+					if (vertexType == PolygonVertexTypes::Split || vertexTypes[leftHelper] == PolygonVertexTypes::Merge) {
+						outDiagonals->push_back(vertexIndex);
+						outDiagonals->push_back(leftHelper);
+					}
+					helpers[*leftEdge] = vertexIndex;
+				}
+
+				// Start the edge going down from this vertex
+				if (vertexType == PolygonVertexTypes::Start || vertexType == PolygonVertexTypes::Split || (vertexType == PolygonVertexTypes::Regular && isPrevEdgeEnding)) {
+					statusEdges[vertexIndex] = status.insert(vertexIndex).first;
+					helpers[vertexIndex] = vertexIndex;
+				}
+			}
+			assert(status.size() == 0);
+		}
+
+		//! Half edges of the polygon edges and diagonals. Half edge 2*i and 2*i+1 are twins.
+		struct PolygonHalfEdges {
+			std::vector<uint32_t> origins;
+			std::vector<uint8_t> isSolid;
+			//! Outgoing half edges of each vertex, sorted counter-clockwise
+			std::vector<uint32_t> outgoing;
+			std::vector<uint32_t> firstOutgoing;
+			//! Position of each half edge in the outgoing list of its origin
+			std::vector<uint32_t> outgoingPositions;
+		};
+
+		inline bool IsDirectionAngleLess(const Vec2i &a, const Vec2i &b) {
+			bool isLowerA = a.y < 0 || (a.y == 0 && a.x < 0);
+			bool isLowerB = b.y < 0 || (b.y == 0 && b.x < 0);
+			if (isLowerA != isLowerB) {
+				return isLowerB;
+			}
+			bool result = GetTurn(V2i(0, 0), a, b) > 0;
+			return(result);
+		}
+
+		static void BuildPolygonHalfEdges(const std::vector<PolygonVertex> &vertices, const std::vector<uint32_t> &diagonals, PolygonHalfEdges *outHalfEdges) {
+			uint32_t vertexCount = (uint32_t)vertices.size();
+			uint32_t halfEdgeCount = vertexCount * 2 + (uint32_t)diagonals.size();
+			outHalfEdges->origins.resize(halfEdgeCount);
+			outHalfEdges->isSolid.resize(halfEdgeCount);
+			for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+				// The polygon edge has the solid area on its left side, its twin does not
+				outHalfEdges->origins[vertexIndex * 2 + 0] = vertexIndex;
+				outHalfEdges->origins[vertexIndex * 2 + 1] = vertices[vertexIndex].next;
+				outHalfEdges->isSolid[vertexIndex * 2 + 0] = 1;
+				outHalfEdges->isSolid[vertexIndex * 2 + 1] = 0;
+			}
+			for (size_t diagonalIndex = 0; diagonalIndex < diagonals.size(); ++diagonalIndex) {
+				outHalfEdges->origins[vertexCount * 2 + diagonalIndex] = diagonals[diagonalIndex];
+				outHalfEdges->isSolid[vertexCount * 2 + diagonalIndex] = 1;
+			}
+
+			outHalfEdges->firstOutgoing.assign(vertexCount + 1, 0);
+			for (uint32_t halfEdgeIndex = 0; halfEdgeIndex < halfEdgeCount; ++halfEdgeIndex) {
+				++outHalfEdges->firstOutgoing[outHalfEdges->origins[halfEdgeIndex] + 1];
+			}
+			for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+				outHalfEdges->firstOutgoing[vertexIndex + 1] += outHalfEdges->firstOutgoing[vertexIndex];
+			}
+			outHalfEdges->outgoing.resize(halfEdgeCount);
+			std::vector<uint32_t> writeIndices(outHalfEdges->firstOutgoing.begin(), outHalfEdges->firstOutgoing.end() - 1);
+			for (uint32_t halfEdgeIndex = 0; halfEdgeIndex < halfEdgeCount; ++halfEdgeIndex) {
+				outHalfEdges->outgoing[writeIndices[outHalfEdges->origins[halfEdgeIndex]]++] = halfEdgeIndex;
+			}
+
+			outHalfEdges->outgoingPositions.resize(halfEdgeCount);
+			const std::vector<uint32_t> &origins = outHalfEdges->origins;
+			for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+				uint32_t firstIndex = outHalfEdges->firstOutgoing[vertexIndex];
+				uint32_t lastIndex = outHalfEdges->firstOutgoing[vertexIndex + 1];
+				const Vec2i &origin = vertices[vertexIndex].position;
+				std::sort(outHalfEdges->outgoing.begin() + firstIndex, outHalfEdges->outgoing.begin() + lastIndex, [&](uint32_t a, uint32_t b) {
+					const Vec2i &targetA = vertices[origins[a ^ 1]].position;
+					const Vec2i &targetB = vertices[origins[b ^ 1]].position;
+					return IsDirectionAngleLess(V2i(targetA.x - origin.x, targetA.y - origin.y), V2i(targetB.x - origin.x, targetB.y - origin.y));
+				});
+				for (uint32_t outgoingIndex = firstIndex; outgoingIndex < lastIndex; ++outgoingIndex) {
+					outHalfEdges->outgoingPositions[outHalfEdges->outgoing[outgoingIndex]] = outgoingIndex;
+				}
+			}
+		}
+
+		//! Returns the next half edge around the face on the left side of the given half edge
+		inline uint32_t GetNextFaceHalfEdge(const PolygonHalfEdges &halfEdges, uint32_t halfEdgeIndex) {
+			uint32_t twinIndex = halfEdgeIndex ^ 1;
+			uint32_t vertexIndex = halfEdges.origins[twinIndex];
+			uint32_t firstIndex = halfEdges.firstOutgoing[vertexIndex];
+			uint32_t lastIndex = halfEdges.firstOutgoing[vertexIndex + 1];
+			uint32_t position = halfEdges.outgoingPositions[twinIndex];
+			uint32_t result = halfEdges.outgoing[position > firstIndex ? position - 1 : lastIndex - 1];
+			return(result);
+		}
+
+		struct MonotoneScratch {
+			std::vector<uint32_t> sortedVertices;
+			std::vector<uint8_t> isLeftChain;
+			std::vector<uint32_t> stack;
+		};
+
+		inline void AddTriangle(const std::vector<PolygonVertex> &vertices, uint32_t a, uint32_t b, uint32_t c, std::vector<uint32_t> *outTriangles) {
+			int64_t turn = GetTurn(vertices[a].position, vertices[b].position, vertices[c].position);
+			if (turn == 0) {
+				return;
+			}
+			outTriangles->push_back(a);
+			outTriangles->push_back(turn > 0 ? b : c);
+			outTriangles->push_back(turn > 0 ? c : b);
+		}
+
+		//! Triangulates a y-monotone face given counter-clockwise in linear time
+		static void TriangulateMonotoneFace(const std::vector<PolygonVertex> &vertices, const std::vector<uint32_t> &face, MonotoneScratch *scratch, std::vector<uint32_t> *outTriangles) {
+			uint32_t faceCount = (uint32_t)face.size();
+			if (faceCount < 3) {
+				return;
+			}
+			uint32_t topIndex = 0;
+			uint32_t bottomIndex = 0;
+			for (uint32_t faceIndex = 1; faceIndex < faceCount; ++faceIndex) {
+				if (IsSweptBefore(vertices, face[faceIndex], face[topIndex])) {
+					topIndex = faceIndex;
+				}
+				if (IsSweptBefore(vertices, face[bottomIndex], face[faceIndex])) {
+					bottomIndex = faceIndex;
+				}
+			}
+
+			// Merge the left chain (counter-clockwise from the top) and the right chain (clockwise from the top) into sweep order
+			std::vector<uint32_t> &sortedVertices = scratch->sortedVertices;
+			std::vector<uint8_t> &isLeftChain = scratch->isLeftChain;
+			sortedVertices.clear();
+			isLeftChain.clear();
+			uint32_t leftIndex = (topIndex + 1) % faceCount;
+			uint32_t rightIndex = (topIndex + faceCount - 1) % faceCount;
+			sortedVertices.push_back(face[topIndex]);
+			isLeftChain.push_back(1);
+			while (leftIndex != bottomIndex || rightIndex != bottomIndex) {
+				bool isLeft = rightIndex == bottomIndex || (leftIndex != bottomIndex && IsSweptBefore(vertices, face[leftIndex], face[rightIndex]));
+				if (isLeft) {
+					sortedVertices.push_back(face[leftIndex]);
+					leftIndex = (leftIndex + 1) % faceCount;
+				} else {
+					sortedVertices.push_back(face[rightIndex]);
+					rightIndex = (rightIndex + faceCount - 1) % faceCount;
+				}
+				isLeftChain.push_back(isLeft ? 1 : 0);
+			}
+			sortedVertices.push_back(face[bottomIndex]);
+			isLeftChain.push_back(!isLeftChain.back());
+
+			std::vector<uint32_t> &stack = scratch->stack;
+			stack.clear();
+			stack.push_back(0);
+			stack.push_back(1);
+			for (uint32_t sortedIndex = 2; sortedIndex < faceCount; ++sortedIndex) {
+				uint32_t vertexIndex = sortedVertices[sortedIndex];
+				if (isLeftChain[sortedIndex] != isLeftChain[stack.back()]) {
+					// Opposite chain: Connect to all vertices on the stack
+					for (size_t stackIndex = 0; stackIndex + 1 < stack.size(); ++stackIndex) {
+						AddTriangle(vertices, vertexIndex, sortedVertices[stack[stackIndex]], sortedVertices[stack[stackIndex + 1]], outTriangles);
+					}
+					uint32_t lastIndex = stack.back();
+					stack.clear();
+					stack.push_back(lastIndex);
+				} else {
+					// Same chain: Cut off the triangles which are inside, until the chain on the stack is reflex again
+					uint32_t lastIndex = stack.back();
+					stack.pop_back();
+					while (stack.size() > 0) {
+						const Vec2i &topPosition = vertices[sortedVertices[stack.back()]].position;
+						int64_t turn = GetTurn(topPosition, vertices[sortedVertices[lastIndex]].position, vertices[vertexIndex].position);
+						if (isLeftChain[sortedIndex] ? turn <= 0 : turn >= 0) {
+							break;
+						}
+						AddTriangle(vertices, sortedVertices[stack.back()], sortedVertices[lastIndex], vertexIndex, outTriangles);
+						lastIndex = stack.back();
+						stack.pop_back();
+					}
+					stack.push_back(lastIndex);
+				}
+				stack.push_back(sortedIndex);
+			}
+		}
+
+		//! Triangulates the solid area of the closed chain segments, the triangles are vertex index triples in counter-clockwise order
+		static void TriangulatePolygons(const std::vector<ChainSegment> &chainSegments, std::vector<PolygonVertex> *outVertices, std::vector<uint32_t> *outTriangles) {
+			AddPolygonLoops(chainSegments, outVertices);
+			const std::vector<PolygonVertex> &vertices = *outVertices;
+
+			std::vector<uint32_t> diagonals;
+			AddMonotoneDiagonals(vertices, &diagonals);
+
+			PolygonHalfEdges halfEdges;
+			BuildPolygonHalfEdges(vertices, diagonals, &halfEdges);
+
+			// Walk each face of the solid area once, every face is y-monotone
+			std::vector<uint8_t> isVisited(halfEdges.isSolid.size(), 0);
+			std::vector<uint32_t> face;
+			MonotoneScratch scratch;
+			for (uint32_t startIndex = 0; startIndex < (uint32_t)halfEdges.isSolid.size(); ++startIndex) {
+				if (!halfEdges.isSolid[startIndex] || isVisited[startIndex]) {
+					continue;
+				}
+				face.clear();
+				uint32_t halfEdgeIndex = startIndex;
+				do {
+					assert(halfEdges.isSolid[halfEdgeIndex] && !isVisited[halfEdgeIndex]);
+					isVisited[halfEdgeIndex] = 1;
+					face.push_back(halfEdges.origins[halfEdgeIndex]);
+					halfEdgeIndex = GetNextFaceHalfEdge(halfEdges, halfEdgeIndex);
+				} while (halfEdgeIndex != startIndex);
+				TriangulateMonotoneFace(vertices, face, &scratch, outTriangles);
+			}
+		}
+
+		//
+		// Contour cache
+		//
+		static const uint8_t CONTOUR_CACHE_MAGIC[4] = { 'F', 'T', 'T', 'C' };
+		static const size_t CONTOUR_CACHE_HEADER_SIZE = 40;
+		static const uint64_t CACHE_HASH_PRIME1 = 0x9E3779B185EBCA87ULL;
+		static const uint64_t CACHE_HASH_PRIME2 = 0xC2B2AE3D27D4EB4FULL;
+
+		inline uint64_t MixCacheHash(uint64_t hash, uint64_t value) {
+			hash ^= value * CACHE_HASH_PRIME2;
+			hash = ((hash << 31) | (hash >> 33)) * CACHE_HASH_PRIME1;
+			return(hash);
+		}
+
+		//! Hashes 8 bytes per step. The words are read in host byte order, so big endian machines have other keys and simply miss the cache.
+		static uint64_t HashCacheBytes(uint64_t hash, const void *data, size_t size) {
+			const uint8_t *bytes = (const uint8_t *)data;
+			hash = MixCacheHash(hash, (uint64_t)size);
+			size_t wordCount = size / 8;
+			for (size_t wordIndex = 0; wordIndex < wordCount; ++wordIndex) {
+				uint64_t word;
+				memcpy(&word, bytes + wordIndex * 8, 8);
+				hash = MixCacheHash(hash, word);
+			}
+			uint64_t tail = 0;
+			for (size_t byteIndex = wordCount * 8; byteIndex < size; ++byteIndex) {
+				tail = (tail << 8) | bytes[byteIndex];
+			}
+			hash = MixCacheHash(hash, tail);
+			hash ^= hash >> 33;
+			hash *= CACHE_HASH_PRIME2;
+			hash ^= hash >> 29;
+			return(hash);
+		}
+
+		inline void WriteCacheU32(uint8_t *target, uint32_t value) {
+			for (uint32_t byteIndex = 0; byteIndex < 4; ++byteIndex) {
+				target[byteIndex] = (uint8_t)(value >> (byteIndex * 8));
+			}
+		}
+
+		inline void WriteCacheU64(uint8_t *target, uint64_t value) {
+			for (uint32_t byteIndex = 0; byteIndex < 8; ++byteIndex) {
+				target[byteIndex] = (uint8_t)(value >> (byteIndex * 8));
+			}
+		}
+
+		inline uint32_t ReadCacheU32(const uint8_t *source) {
+			uint32_t result = 0;
+			for (uint32_t byteIndex = 0; byteIndex < 4; ++byteIndex) {
+				result |= (uint32_t)source[byteIndex] << (byteIndex * 8);
+			}
+			return(result);
+		}
+
+		inline uint64_t ReadCacheU64(const uint8_t *source) {
+			uint64_t result = 0;
+			for (uint32_t byteIndex = 0; byteIndex < 8; ++byteIndex) {
+				result |= (uint64_t)source[byteIndex] << (byteIndex * 8);
+			}
+			return(result);
+		}
+
+		inline void WriteCacheVarint(std::vector<uint8_t> *blob, uint32_t value) {
+			while (value >= 0x80) {
+				blob->push_back((uint8_t)(value | 0x80));
+				value >>= 7;
+			}
+			blob->push_back((uint8_t)value);
+		}
+
+		inline bool ReadCacheVarint(const uint8_t **cursor, const uint8_t *end, uint32_t *outValue) {
+			uint32_t result = 0;
+			for (uint32_t shift = 0; shift < 35; shift += 7) {
+				if (*cursor == end) {
+					return false;
+				}
+				uint8_t byte = *(*cursor)++;
+				result |= (uint32_t)(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) {
+					*outValue = result;
+					return true;
+				}
+			}
+			return false;
+		}
+
+		//! Small negative and positive deltas are both encoded in a few bytes
+		inline uint32_t EncodeZigZag(int32_t value) {
+			uint32_t result = ((uint32_t)value << 1) ^ (uint32_t)-(int32_t)((uint32_t)value >> 31);
+			return(result);
+		}
+
+		inline int32_t DecodeZigZag(uint32_t value) {
+			int32_t result = (int32_t)(value >> 1) ^ -(int32_t)(value & 1);
+			return(result);
+		}
+	};
+
+	ftt_api void InitTileTracer(TileTracerData *tracer, const Vec2u &tileCount, uint8_t *mapTiles, MemoryArena *arena) {
+		assert(tracer != ftt_null);
+		assert(mapTiles != ftt_null);
+
+		using namespace internals;
+
+		ResetArenaVector(tracer->solidBits, arena);
+		ResetArenaVector(tracer->traceDirections, arena);
+		ResetArenaVector(tracer->openList, arena);
+		ResetArenaVector(tracer->mainEdges, arena);
+		ResetArenaVector(tracer->edgeStates, arena);
+		ResetArenaVector(tracer->chainVertices, arena);
+		ResetArenaVector(tracer->chainSegments, arena);
+
+		tracer->tileCount = tileCount;
+		tracer->wordsPerRow = (tileCount.w + 63) / 64;
+		tracer->solidBits.assign(tracer->wordsPerRow * tileCount.h, 0);
+		for (uint32_t tileY = 0; tileY < tileCount.h; ++tileY) {
+			for (uint32_t tileX = 0; tileX < tileCount.w; ++tileX) {
+				if (mapTiles[ComputeTileIndex(tileCount, tileX, tileY)] > 0) {
+					tracer->solidBits[tileY * tracer->wordsPerRow + (tileX >> 6)] |= (uint64_t)1 << (tileX & 63);
+				}
+			}
+		}
+		tracer->traceDirections.assign((tileCount.w * tileCount.h + 3) / 4, 0);
+		tracer->edgeStates.assign((tileCount.w + 1) * (tileCount.h + 1), 0);
+
+		tracer->curStep = Step::FindStart;
+		tracer->startTile = INVALID_INDEX;
+		tracer->startEdge = INVALID_INDEX;
+		tracer->lastEdge = INVALID_INDEX;
+		tracer->solidSearchIndex = 0;
+		tracer->edgeSearchIndex = 0;
+
+		tracer->curTile = INVALID_INDEX;
+		tracer->nextTile = INVALID_INDEX;
+	}
+
+	ftt_api bool NextTileTraceStep(TileTracerData *tracer) {
+		assert(tracer != ftt_null);
+
+		using namespace internals;
+
+		bool result = true;
+		switch (tracer->curStep) {
+			case Step::Done:
+			{
+				result = false;
+			}; break;
+			case Step::TraverseNextEdge:
+			{
+				result = ProcessTraverseNextEdge(tracer);
+			}; break;
+			case Step::TraverseFindStartingEdge:
+			{
+				result = ProcessTraverseFindStartingEdge(tracer);
+			}; break;
+			case Step::FindStart:
+			{
+				tracer->openList.clear();
+				tracer->curTile = INVALID_INDEX;
+				tracer->startTile = GetFirstSolidTile(tracer);
+				if (tracer->startTile != INVALID_INDEX) {
+					// Add the start tile to the open list and build vertices and edges from it
+					AddTile(tracer, tracer->startTile);
+
+					// Set next step to get open tile and process it immediatitly
+					tracer->curStep = Step::GetNextOpenTile;
+					GetNextOpenTile(tracer);
+				} else {
+					// No start found, exit if we have not found any edges at all
+					if (tracer->mainEdges.size() == 0) {
+						result = false;
+					} else {
+						// Clear all chain segments
+						tracer->chainSegments.clear();
+						CompactMainEdges(tracer);
+						tracer->curStep = Step::TraverseFindStartingEdge;
+					}
+				}
+			}; break;
+			case Step::GetNextOpenTile:
+			{
+				GetNextOpenTile(tracer);
+			}; break;
+			case Step::FindNextTile:
+			{
+				assert(tracer->curTile != INVALID_INDEX);
+
+				// Tile in the "forward" direction of the current tile
+				Vec2i curTilePosition = GetTilePosition(tracer->tileCount, tracer->curTile);
+				uint32_t traceDirection = GetTraceDirection(tracer, tracer->curTile);
+				int32_t nx = curTilePosition.x + TILETRACE_DIRECTIONS[traceDirection].x;
+				int32_t ny = curTilePosition.y + TILETRACE_DIRECTIONS[traceDirection].y;
+				tracer->nextTile = IsTileSolid(tracer, nx, ny) ? ComputeTileIndex(tracer->tileCount, nx, ny) : INVALID_INDEX;
+
+				if (tracer->nextTile != INVALID_INDEX) {
+					// Create tile vertices for next tile and check if it shares common edges
+					TileVertices tileVertices = CreateTileVertices(V2i(nx, ny));
+					bool sharesCommonEdge = IsTileSharesCommonEdges(tracer, tileVertices);
+					if (sharesCommonEdge) {
+						// Add the next tile to the open list and build vertices and edges from it
+						AddTile(tracer, tracer->nextTile);
+
+						// Set next step to get open tile and process it immediatitly
+						tracer->curStep = Step::GetNextOpenTile;
+						GetNextOpenTile(tracer);
+					} else {
+						tracer->curStep = Step::RotateForward;
+						RotateForward(tracer);
+					}
+				} else {
+					tracer->curStep = Step::RotateForward;
+					RotateForward(tracer);
+				}
+			}; break;
+			case Step::RotateForward:
+			{
+				RotateForward(tracer);
+			}; break;
+			default:
+				assert(!"Invalid default case!");
+		}
+		return(result);
+	}
+
+	ftt_api void RunTileTracer(TileTracerData *tracer) {
+		assert(tracer != ftt_null);
+		while (NextTileTraceStep(tracer)) {
+		}
+	}
+
+	ftt_api void SimplifyChainSegments(std::vector<ChainSegment> *chainSegments, float tolerance) {
+		assert(chainSegments != ftt_null);
+		assert(tolerance >= 0.0f);
+
+		using namespace internals;
+
+		SimplifyScratch scratch;
+		for (size_t chainIndex = 0; chainIndex < chainSegments->size(); ++chainIndex) {
+			std::vector<Vec2i> &vertices = (*chainSegments)[chainIndex].vertices;
+			if (vertices.size() > 0) {
+				vertices.resize(SimplifyVertices(&vertices[0], (uint32_t)vertices.size(), tolerance, &scratch));
+			}
+		}
+	}
+
+	ftt_api void SimplifyTileTracerChains(TileTracerData *tracer, float tolerance) {
+		assert(tracer != ftt_null);
+		// The current chain segment must be finished, because the traversal appends to the end of the vertex buffer
+		assert(tracer->curStep != Step::TraverseNextEdge);
+		assert(tolerance >= 0.0f);
+
+		using namespace internals;
+
+		// Chain segments are stored in order, so each one can be moved down into the gap left by the previous ones
+		SimplifyScratch scratch;
+		uint32_t writeIndex = 0;
+		for (size_t chainIndex = 0; chainIndex < tracer->chainSegments.size(); ++chainIndex) {
+			ChainRange &chainSegment = tracer->chainSegments[chainIndex];
+			if (chainSegment.vertexCount > 0) {
+				Vec2i *vertices = &tracer->chainVertices[chainSegment.firstVertex];
+				uint32_t vertexCount = SimplifyVertices(vertices, chainSegment.vertexCount, tolerance, &scratch);
+				std::copy(vertices, vertices + vertexCount, tracer->chainVertices.begin() + writeIndex);
+				chainSegment.vertexCount = vertexCount;
+			}
+			chainSegment.firstVertex = writeIndex;
+			writeIndex += chainSegment.vertexCount;
+		}
+		tracer->chainVertices.resize(writeIndex);
+	}
+
+	ftt_api void TraceContours(const Vec2u &tileCount, const uint8_t *mapTiles, std::vector<ChainSegment> *outChainSegments) {
+		assert(mapTiles != ftt_null);
+		assert(outChainSegments != ftt_null);
+
+		using namespace internals;
+
+		outChainSegments->clear();
+		if (tileCount.w == 0 || tileCount.h == 0) {
+			return;
+		}
+
+		SolidMask mask = {};
+		InitSolidMask(&mask, tileCount, mapTiles);
+
+		std::vector<uint64_t> visitedTopEdges(mask.bits.size(), 0);
+		std::vector<Vec2i> corners;
+		Rect2i tileRect = MakeRect(V2i(0, 0), V2i((int32_t)tileCount.w - 1, (int32_t)tileCount.h - 1));
+		Vec2i cursor = tileRect.min;
+		while (FindNextContourStart(&mask, visitedTopEdges, tileRect, &cursor)) {
+			TraceContour(&mask, visitedTopEdges, cursor, corners);
+			outChainSegments->push_back(ChainSegment());
+			outChainSegments->back().vertices.assign(corners.begin(), corners.end());
+		}
+	}
+
+	ftt_api void TraceContoursChunked(const Vec2u &tileCount, const uint8_t *mapTiles, const Vec2u &chunkSize, uint32_t threadCount, std::vector<ChainSegment> *outChainSegments) {
+		assert(mapTiles != ftt_null);
+		assert(outChainSegments != ftt_null);
+		assert(chunkSize.w > 0 && chunkSize.h > 0);
+
+		using namespace internals;
+
+		outChainSegments->clear();
+		if (tileCount.w == 0 || tileCount.h == 0) {
+			return;
+		}
+
+		SolidMask mask = {};
+		InitSolidMask(&mask, tileCount, mapTiles);
+
+		// Round the chunk width up to whole mask words, so no two chunks write into the same word
+		uint32_t chunkWidth = (chunkSize.w + 63) & ~63u;
+		std::vector<ContourChunk> chunks;
+		for (uint32_t chunkY = 0; chunkY < tileCount.h; chunkY += chunkSize.h) {
+			for (uint32_t chunkX = 0; chunkX < tileCount.w; chunkX += chunkWidth) {
+				ContourChunk chunk;
+				chunk.tileRect.min = V2i((int32_t)chunkX, (int32_t)chunkY);
+				chunk.tileRect.max = V2i((int32_t)(chunkX + chunkWidth < tileCount.w ? chunkX + chunkWidth : tileCount.w) - 1, (int32_t)(chunkY + chunkSize.h < tileCount.h ? chunkY + chunkSize.h : tileCount.h) - 1);
+				chunks.push_back(chunk);
+			}
+		}
+
+		std::vector<uint8_t> visitedSides(tileCount.w * tileCount.h, 0);
+		std::vector<uint64_t> visitedTopEdges(mask.bits.size(), 0);
+		ChunkedTraceState state;
+		state.mask = &mask;
+		state.chunks = &chunks;
+		state.visitedSides = &visitedSides;
+		state.visitedTopEdges = &visitedTopEdges;
+		state.nextChunkIndex = 0;
+#if !FTT_NO_THREADS
+		if (threadCount == 0) {
+			threadCount = std::thread::hardware_concurrency();
+		}
+		if (threadCount > chunks.size()) {
+			threadCount = (uint32_t)chunks.size();
+		}
+		// The calling thread is one of the workers
+		std::vector<std::thread> threads;
+		for (uint32_t threadIndex = 1; threadIndex < threadCount; ++threadIndex) {
+			threads.push_back(std::thread(TraceContourChunks, &state));
+		}
+		TraceContourChunks(&state);
+		for (size_t threadIndex = 0; threadIndex < threads.size(); ++threadIndex) {
+			threads[threadIndex].join();
+		}
+#else
+		(void)threadCount;
+		TraceContourChunks(&state);
+#endif
+
+		StitchContourChunks(tileCount, chunks, outChainSegments);
+	}
+
+	ftt_api void InitContourMap(ContourMap *contourMap, const Vec2u &tileCount, const uint8_t *mapTiles) {
+		assert(contourMap != ftt_null);
+		assert(mapTiles != ftt_null);
+
+		using namespace internals;
+
+		InitSolidMask(&contourMap->mask, tileCount, mapTiles);
+		contourMap->visitedTopEdges.assign(contourMap->mask.bits.size(), 0);
+		contourMap->chainSegments.clear();
+		contourMap->chainBounds.clear();
+		contourMap->freeIds.clear();
+		contourMap->dirtyRects.clear();
+
+		ContourChanges changes = {};
+		std::vector<uint8_t> contourStates;
+		RetraceContourRegion(contourMap, MakeRect(V2i(0, 0), V2i((int32_t)tileCount.w, (int32_t)tileCount.h)), contourStates, &changes);
+	}
+
+	ftt_api void SetContourMapTile(ContourMap *contourMap, uint32_t x, uint32_t y, uint8_t value) {
+		assert(contourMap != ftt_null);
+		assert((x < contourMap->mask.tileCount.w) && (y < contourMap->mask.tileCount.h));
+
+		using namespace internals;
+
+		uint64_t &word = contourMap->mask.bits[y * contourMap->mask.wordsPerRow + (x >> 6)];
+		uint64_t bit = (uint64_t)1 << (x & 63);
+		bool wasSolid = (word & bit) != 0;
+		bool isSolid = value > 0;
+		if (wasSolid == isSolid) {
+			return;
+		}
+		if (isSolid) {
+			word |= bit;
+		} else {
+			word &= ~bit;
+		}
+
+		// Neighbor tiles are merged into the last dirty rectangle, so a explosion does not produce hundreds of them
+		Rect2i tileRect = MakeRect(V2i((int32_t)x, (int32_t)y), V2i((int32_t)x, (int32_t)y));
+		if (contourMap->dirtyRects.size() > 0) {
+			Rect2i &lastRect = contourMap->dirtyRects.back();
+			Rect2i nearRect = MakeRect(V2i(lastRect.min.x - 1, lastRect.min.y - 1), V2i(lastRect.max.x + 1, lastRect.max.y + 1));
+			if (IsRectOverlap(nearRect, tileRect)) {
+				lastRect = RectUnion(lastRect, tileRect);
+				return;
+			}
+		}
+		contourMap->dirtyRects.push_back(tileRect);
+	}
+
+	ftt_api void SetContourMapTiles(ContourMap *contourMap, const Rect2i &tileRect, const uint8_t *mapTiles) {
+		assert(contourMap != ftt_null);
+		assert(mapTiles != ftt_null);
+		for (int32_t tileY = tileRect.min.y; tileY <= tileRect.max.y; ++tileY) {
+			for (int32_t tileX = tileRect.min.x; tileX <= tileRect.max.x; ++tileX) {
+				SetContourMapTile(contourMap, tileX, tileY, mapTiles[tileY * contourMap->mask.tileCount.w + tileX]);
+			}
+		}
+	}
+
+	ftt_api void UpdateContourMap(ContourMap *contourMap, ContourChanges *outChanges) {
+		assert(contourMap != ftt_null);
+		assert(outChanges != ftt_null);
+
+		using namespace internals;
+
+		outChanges->addedIds.clear();
+		outChanges->removedIds.clear();
+		outChanges->modifiedIds.clear();
+		if (contourMap->dirtyRects.size() == 0) {
+			return;
+		}
+
+		// A contour is affected when it passes any vertex of a dirty tile, because only there the edges or the turns can change.
+		// Each region covers its dirty tiles and all contours affected by it, overlapping regions are merged.
+		std::vector<uint8_t> contourStates(contourMap->chainSegments.size(), ContourStates::Unaffected);
+		std::vector<Rect2i> regions;
+		for (size_t dirtyIndex = 0; dirtyIndex < contourMap->dirtyRects.size(); ++dirtyIndex) {
+			const Rect2i &dirtyRect = contourMap->dirtyRects[dirtyIndex];
+			Rect2i vertexRect = MakeRect(dirtyRect.min, V2i(dirtyRect.max.x + 1, dirtyRect.max.y + 1));
+			Rect2i region = vertexRect;
+			for (uint32_t id = 0; id < contourMap->chainSegments.size(); ++id) {
+				const ChainSegment &chainSegment = contourMap->chainSegments[id];
+				if (chainSegment.vertices.size() > 0 && IsRectOverlap(contourMap->chainBounds[id], vertexRect) && IsChainOverlapRect(chainSegment, vertexRect)) {
+					contourStates[id] = ContourStates::Affected;
+					region = RectUnion(region, contourMap->chainBounds[id]);
+				}
+			}
+			regions.push_back(region);
+		}
+		bool wasMerged;
+		do {
+			wasMerged = false;
+			for (size_t i = 0; i < regions.size() && !wasMerged; ++i) {
+				for (size_t j = i + 1; j < regions.size(); ++j) {
+					if (IsRectOverlap(regions[i], regions[j])) {
+						regions[i] = RectUnion(regions[i], regions[j]);
+						regions.erase(regions.begin() + j);
+						wasMerged = true;
+						break;
+					}
+				}
+			}
+		} while (wasMerged);
+
+		for (size_t regionIndex = 0; regionIndex < regions.size(); ++regionIndex) {
+			contourStates.resize(contourMap->chainSegments.size(), ContourStates::Unaffected);
+			RetraceContourRegion(contourMap, regions[regionIndex], contourStates, outChanges);
+		}
+
+		for (size_t removedIndex = 0; removedIndex < outChanges->removedIds.size(); ++removedIndex) {
+			contourMap->freeIds.push_back(outChanges->removedIds[removedIndex]);
+		}
+		contourMap->dirtyRects.clear();
+	}
+
+	ftt_api void TraceShapeLayers(const Vec2u &tileCount, const uint8_t *mapTiles, const TileDefinition *definitions, uint32_t definitionCount, uint32_t layerCount, std::vector<TileLayer> *outLayers) {
+		assert(mapTiles != ftt_null);
+		assert(definitions != ftt_null);
+		assert(layerCount <= 32);
+		assert(outLayers != ftt_null);
+
+		using namespace internals;
+
+		outLayers->clear();
+		outLayers->resize(layerCount);
+
+		ShapeEdges shapeEdges[TileShapes::Count];
+		for (uint32_t shapeIndex = 0; shapeIndex < TileShapes::Count; ++shapeIndex) {
+			shapeEdges[shapeIndex] = CreateShapeEdges(TILE_SHAPE_TEMPLATES[shapeIndex]);
+		}
+
+		// Collect the edge steps of all layers in one pass over the tile map
+		Vec2u latticeCount = { tileCount.w * TILE_SHAPE_RESOLUTION + 1, tileCount.h * TILE_SHAPE_RESOLUTION + 1 };
+		std::vector<std::vector<uint64_t> > layerEdges(layerCount);
+		for (uint32_t tileY = 0; tileY < tileCount.h; ++tileY) {
+			for (uint32_t tileX = 0; tileX < tileCount.w; ++tileX) {
+				uint8_t tileValue = mapTiles[ComputeTileIndex(tileCount, tileX, tileY)];
+				if (tileValue >= definitionCount) {
+					continue;
+				}
+				const TileDefinition &definition = definitions[tileValue];
+				assert(definition.shape >= 0 && definition.shape < TileShapes::Count);
+				const ShapeEdges &edges = shapeEdges[definition.shape];
+				for (uint32_t layerIndex = 0; layerIndex < layerCount; ++layerIndex) {
+					if (!((definition.layerMask >> layerIndex) & 1)) {
+						continue;
+					}
+					for (uint32_t edgeIndex = 0; edgeIndex < edges.count; ++edgeIndex) {
+						const ShapeEdge &edge = edges.edges[edgeIndex];
+						const Vec2i &step = SHAPE_EDGE_DIRECTIONS[edge.direction];
+						Vec2i vertex = V2i((int32_t)tileX * TILE_SHAPE_RESOLUTION + edge.start.x, (int32_t)tileY * TILE_SHAPE_RESOLUTION + edge.start.y);
+						for (uint32_t stepIndex = 0; stepIndex < edge.stepCount; ++stepIndex) {
+							layerEdges[layerIndex].push_back(MakeShapeEdgeKey(ComputeTileIndex(latticeCount, vertex.x, vertex.y), edge.direction));
+							vertex = V2i(vertex.x + step.x, vertex.y + step.y);
+						}
+					}
+				}
+			}
+		}
+
+		ShapeLayerEdges edges;
+		for (uint32_t layerIndex = 0; layerIndex < layerCount; ++layerIndex) {
+			TraceShapeLayer(latticeCount, layerEdges[layerIndex], &edges, &(*outLayers)[layerIndex].chainSegments);
+		}
+	}
+
+	ftt_api void TriangulateChainSegments(const std::vector<ChainSegment> &chainSegments, std::vector<Triangle> *outTriangles) {
+		assert(outTriangles != ftt_null);
+
+		using namespace internals;
+
+		outTriangles->clear();
+
+		std::vector<PolygonVertex> vertices;
+		std::vector<uint32_t> triangleIndices;
+		TriangulatePolygons(chainSegments, &vertices, &triangleIndices);
+
+		outTriangles->resize(triangleIndices.size() / 3);
+		for (size_t triangleIndex = 0; triangleIndex < outTriangles->size(); ++triangleIndex) {
+			Triangle &triangle = (*outTriangles)[triangleIndex];
+			for (uint32_t cornerIndex = 0; cornerIndex < 3; ++cornerIndex) {
+				triangle.verts[cornerIndex] = vertices[triangleIndices[triangleIndex * 3 + cornerIndex]].position;
+			}
+		}
+	}
+
+	ftt_api void DecomposeChainSegments(const std::vector<ChainSegment> &chainSegments, std::vector<ConvexPolygon> *outPolygons) {
+		assert(outPolygons != ftt_null);
+
+		using namespace internals;
+
+		outPolygons->clear();
+
+		std::vector<PolygonVertex> vertices;
+		std::vector<uint32_t> triangleIndices;
+		TriangulatePolygons(chainSegments, &vertices, &triangleIndices);
+
+		// Half edge i is the edge from corner i to the next corner of triangle i / 3
+		uint32_t halfEdgeCount = (uint32_t)triangleIndices.size();
+		std::vector<uint32_t> nextEdges(halfEdgeCount);
+		std::vector<uint32_t> prevEdges(halfEdgeCount);
+		std::vector<uint64_t> edgeKeys(halfEdgeCount);
+		for (uint32_t halfEdgeIndex = 0; halfEdgeIndex < halfEdgeCount; ++halfEdgeIndex) {
+			uint32_t firstCorner = halfEdgeIndex - halfEdgeIndex % 3;
+			nextEdges[halfEdgeIndex] = firstCorner + (halfEdgeIndex + 1) % 3;
+			prevEdges[halfEdgeIndex] = firstCorner + (halfEdgeIndex + 2) % 3;
+			edgeKeys[halfEdgeIndex] = ((uint64_t)triangleIndices[halfEdgeIndex] << 32) | triangleIndices[nextEdges[halfEdgeIndex]];
+		}
+		std::vector<uint32_t> sortedEdges(halfEdgeCount);
+		for (uint32_t halfEdgeIndex = 0; halfEdgeIndex < halfEdgeCount; ++halfEdgeIndex) {
+			sortedEdges[halfEdgeIndex] = halfEdgeIndex;
+		}
+		std::sort(sortedEdges.begin(), sortedEdges.end(), [&edgeKeys](uint32_t a, uint32_t b) { return edgeKeys[a] < edgeKeys[b]; });
+
+		// Remove each inner edge, when both of its vertices stay convex in the merged polygon
+		std::vector<uint8_t> isRemoved(halfEdgeCount, 0);
+		for (uint32_t halfEdgeIndex = 0; halfEdgeIndex < halfEdgeCount; ++halfEdgeIndex) {
+			uint64_t twinKey = (edgeKeys[halfEdgeIndex] << 32) | (edgeKeys[halfEdgeIndex] >> 32);
+			std::vector<uint32_t>::iterator twinIt = std::lower_bound(sortedEdges.begin(), sortedEdges.end(), twinKey, [&edgeKeys](uint32_t a, uint64_t key) { return edgeKeys[a] < key; });
+			if (twinIt == sortedEdges.end() || edgeKeys[*twinIt] != twinKey || *twinIt < halfEdgeIndex) {
+				continue;
+			}
+			uint32_t twinIndex = *twinIt;
+			uint32_t a = triangleIndices[halfEdgeIndex];
+			uint32_t b = triangleIndices[twinIndex];
+			uint32_t beforeA = triangleIndices[prevEdges[halfEdgeIndex]];
+			uint32_t afterA = triangleIndices[nextEdges[nextEdges[twinIndex]]];
+			uint32_t beforeB = triangleIndices[prevEdges[twinIndex]];
+			uint32_t afterB = triangleIndices[nextEdges[nextEdges[halfEdgeIndex]]];
+			if (GetTurn(vertices[beforeA].position, vertices[a].position, vertices[afterA].position) < 0 ||
+				GetTurn(vertices[beforeB].position, vertices[b].position, vertices[afterB].position) < 0) {
+				continue;
+			}
+			nextEdges[prevEdges[halfEdgeIndex]] = nextEdges[twinIndex];
+			prevEdges[nextEdges[twinIndex]] = prevEdges[halfEdgeIndex];
+			nextEdges[prevEdges[twinIndex]] = nextEdges[halfEdgeIndex];
+			prevEdges[nextEdges[halfEdgeIndex]] = prevEdges[twinIndex];
+			isRemoved[halfEdgeIndex] = 1;
+			isRemoved[twinIndex] = 1;
+		}
+
+		// Collect the merged polygons without the collinear vertices left over from the merges
+		std::vector<uint8_t> isVisited(isRemoved);
+		for (uint32_t startIndex = 0; startIndex < halfEdgeCount; ++startIndex) {
+			if (isVisited[startIndex]) {
+				continue;
+			}
+			outPolygons->push_back(ConvexPolygon());
+			std::vector<Vec2i> &polygonVertices = outPolygons->back().vertices;
+			uint32_t halfEdgeIndex = startIndex;
+			do {
+				assert(!isVisited[halfEdgeIndex]);
+				isVisited[halfEdgeIndex] = 1;
+				uint32_t vertexIndex = triangleIndices[halfEdgeIndex];
+				uint32_t prevIndex = triangleIndices[prevEdges[halfEdgeIndex]];
+				uint32_t nextIndex = triangleIndices[nextEdges[halfEdgeIndex]];
+				if (GetTurn(vertices[prevIndex].position, vertices[vertexIndex].position, vertices[nextIndex].position) != 0) {
+					polygonVertices.push_back(vertices[vertexIndex].position);
+				}
+				halfEdgeIndex = nextEdges[halfEdgeIndex];
+			} while (halfEdgeIndex != startIndex);
+		}
+	}
+
+	ftt_api uint64_t ComputeContourCacheKey(const Vec2u &tileCount, const uint8_t *mapTiles, const ContourCacheOptions &options) {
+		assert(mapTiles != ftt_null);
+
+		using namespace internals;
+
+		uint32_t toleranceBits;
+		memcpy(&toleranceBits, &options.simplifyTolerance, sizeof(toleranceBits));
+		uint64_t result = MixCacheHash(CACHE_HASH_PRIME1, ((uint64_t)tileCount.w << 32) | tileCount.h);
+		result = MixCacheHash(result, toleranceBits);
+		result = MixCacheHash(result, options.userKey);
+		result = HashCacheBytes(result, mapTiles, (size_t)tileCount.w * tileCount.h);
+		return(result);
+	}
+
+	ftt_api void WriteContourCache(uint64_t key, const std::vector<ChainSegment> &chainSegments, std::vector<uint8_t> *outBlob) {
+		assert(outBlob != ftt_null);
+
+		using namespace internals;
+
+		// Tile contours mostly take two bytes per vertex
+		size_t vertexCount = 0;
+		for (size_t segmentIndex = 0; segmentIndex < chainSegments.size(); ++segmentIndex) {
+			vertexCount += chainSegments[segmentIndex].vertices.size();
+		}
+		outBlob->clear();
+		outBlob->reserve(CONTOUR_CACHE_HEADER_SIZE + chainSegments.size() + vertexCount * 3);
+		outBlob->resize(CONTOUR_CACHE_HEADER_SIZE, 0);
+		for (size_t segmentIndex = 0; segmentIndex < chainSegments.size(); ++segmentIndex) {
+			const std::vector<Vec2i> &vertices = chainSegments[segmentIndex].vertices;
+			WriteCacheVarint(outBlob, (uint32_t)vertices.size());
+			Vec2i lastVertex = V2i(0, 0);
+			for (size_t vertexIndex = 0; vertexIndex < vertices.size(); ++vertexIndex) {
+				WriteCacheVarint(outBlob, EncodeZigZag((int32_t)((uint32_t)vertices[vertexIndex].x - (uint32_t)lastVertex.x)));
+				WriteCacheVarint(outBlob, EncodeZigZag((int32_t)((uint32_t)vertices[vertexIndex].y - (uint32_t)lastVertex.y)));
+				lastVertex = vertices[vertexIndex];
+			}
+		}
+
+		// Header: Magic, version, key, payload size, payload hash, chain segment count and a reserved zero
+		uint8_t *header = outBlob->data();
+		size_t payloadSize = outBlob->size() - CONTOUR_CACHE_HEADER_SIZE;
+		memcpy(header, CONTOUR_CACHE_MAGIC, sizeof(CONTOUR_CACHE_MAGIC));
+		WriteCacheU32(header + 4, CONTOUR_CACHE_VERSION);
+		WriteCacheU64(header + 8, key);
+		WriteCacheU64(header + 16, (uint64_t)payloadSize);
+		WriteCacheU64(header + 24, HashCacheBytes(key, header + CONTOUR_CACHE_HEADER_SIZE, payloadSize));
+		WriteCacheU32(header + 32, (uint32_t)chainSegments.size());
+	}
+
+	ftt_api bool ReadContourCache(const void *blob, size_t blobSize, uint64_t key, std::vector<ChainSegment> *outChainSegments) {
+		assert(blob != ftt_null);
+		assert(outChainSegments != ftt_null);
+
+		using namespace internals;
+
+		outChainSegments->clear();
+
+		const uint8_t *header = (const uint8_t *)blob;
+		if (blobSize < CONTOUR_CACHE_HEADER_SIZE || memcmp(header, CONTOUR_CACHE_MAGIC, sizeof(CONTOUR_CACHE_MAGIC)) != 0) {
+			return false;
+		}
+		if (ReadCacheU32(header + 4) != CONTOUR_CACHE_VERSION || ReadCacheU64(header + 8) != key) {
+			return false;
+		}
+		uint64_t payloadSize = ReadCacheU64(header + 16);
+		if (payloadSize != blobSize - CONTOUR_CACHE_HEADER_SIZE) {
+			return false;
+		}
+		const uint8_t *cursor = header + CONTOUR_CACHE_HEADER_SIZE;
+		const uint8_t *end = cursor + payloadSize;
+		if (ReadCacheU64(header + 24) != HashCacheBytes(key, cursor, (size_t)payloadSize)) {
+			return false;
+		}
+
+		// Every vertex takes at least two bytes, so damaged counts are rejected before any allocation
+		uint32_t segmentCount = ReadCacheU32(header + 32);
+		if (segmentCount > payloadSize) {
+			return false;
+		}
+		outChainSegments->resize(segmentCount);
+		for (uint32_t segmentIndex = 0; segmentIndex < segmentCount; ++segmentIndex) {
+			uint32_t vertexCount;
+			if (!ReadCacheVarint(&cursor, end, &vertexCount) || vertexCount > (size_t)(end - cursor) / 2) {
+				outChainSegments->clear();
+				return false;
+			}
+			std::vector<Vec2i> &vertices = (*outChainSegments)[segmentIndex].vertices;
+			vertices.resize(vertexCount);
+			Vec2i lastVertex = V2i(0, 0);
+			for (uint32_t vertexIndex = 0; vertexIndex < vertexCount; ++vertexIndex) {
+				uint32_t deltaX, deltaY;
+				if (!ReadCacheVarint(&cursor, end, &deltaX) || !ReadCacheVarint(&cursor, end, &deltaY)) {
+					outChainSegments->clear();
+					return false;
+				}
+				lastVertex = V2i((int32_t)((uint32_t)lastVertex.x + (uint32_t)DecodeZigZag(deltaX)), (int32_t)((uint32_t)lastVertex.y + (uint32_t)DecodeZigZag(deltaY)));
+				vertices[vertexIndex] = lastVertex;
+			}
+		}
+		if (cursor != end) {
+			outChainSegments->clear();
+			return false;
+		}
+		return true;
+	}
+
+	TileTracer::TileTracer(const Vec2u &tileCount, uint8_t *mapTiles, MemoryArena *arena) {
+		data = {};
+		InitTileTracer(&data, tileCount, mapTiles, arena);
+	}
+
+	bool TileTracer::Next() {
+		bool result = NextTileTraceStep(&data);
+		return(result);
+	}
+
+	void TileTracer::Run() {
+		RunTileTracer(&data);
+	}
+
+	void TileTracer::Simplify(float tolerance) {
+		SimplifyTileTracerChains(&data, tolerance);
 	}
 
 }